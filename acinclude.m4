@@ -6,6 +6,9 @@ dnl Function to detect if libbfoverlay dependencies are available
 AC_DEFUN([AX_LIBBFOVERLAY_CHECK_LOCAL],
   [dnl Check for internationalization functions in libbfoverlay/libbfoverlay_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
+
+  dnl Check for monotonic clock functions in libbfoverlay/libbfoverlay_io_statistics.c
+  AC_CHECK_FUNCS([clock_gettime])
 ])
 
 dnl Function to check if DLL support is needed
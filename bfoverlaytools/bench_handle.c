@@ -0,0 +1,1551 @@
+/*
+ * Benchmark handle
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bench_handle.h"
+#include "bfoverlaytools_libbfoverlay.h"
+#include "bfoverlaytools_libcerror.h"
+#include "bfoverlaytools_system_string.h"
+#include "bfoverlaytools_timestamp.h"
+#include "bfoverlaytools_workers.h"
+
+/* Creates a benchmark handle
+ * Make sure the value bench_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_initialize(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_initialize";
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid benchmark handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*bench_handle = memory_allocate_structure(
+	                 bench_handle_t );
+
+	if( *bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create benchmark handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *bench_handle,
+	     0,
+	     sizeof( bench_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear benchmark handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *bench_handle )->block_size           = 4096;
+	( *bench_handle )->access_pattern       = BENCH_ACCESS_PATTERN_SEQUENTIAL;
+	( *bench_handle )->read_percentage      = 100;
+	( *bench_handle )->number_of_threads    = 1;
+	( *bench_handle )->number_of_operations = 10000;
+	( *bench_handle )->notify_stream        = stdout;
+
+	return( 1 );
+
+on_error:
+	if( *bench_handle != NULL )
+	{
+		memory_free(
+		 *bench_handle );
+
+		*bench_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a benchmark handle
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_free(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_free";
+	int result            = 1;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_handle != NULL )
+	{
+		if( ( *bench_handle )->input_handle != NULL )
+		{
+			if( libbfoverlay_handle_free(
+			     &( ( *bench_handle )->input_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *bench_handle )->latencies != NULL )
+		{
+			memory_free(
+			 ( *bench_handle )->latencies );
+		}
+		memory_free(
+		 *bench_handle );
+
+		*bench_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the benchmark handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_signal_abort(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_signal_abort";
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->abort = 1;
+
+	if( bench_handle->input_handle != NULL )
+	{
+		if( libbfoverlay_handle_signal_abort(
+		     bench_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input handle to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the access pattern
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_access_pattern(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_access_pattern";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 6 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "random" ),
+		     6 ) == 0 )
+		{
+			bench_handle->access_pattern = BENCH_ACCESS_PATTERN_RANDOM;
+
+			result = 1;
+		}
+	}
+	else if( string_length == 10 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "sequential" ),
+		     10 ) == 0 )
+		{
+			bench_handle->access_pattern = BENCH_ACCESS_PATTERN_SEQUENTIAL;
+
+			result = 1;
+		}
+	}
+	return( result );
+}
+
+/* Sets the block size
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_block_size(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_block_size";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( bfoverlaytools_system_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit value.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) BENCH_HANDLE_MAXIMUM_BLOCK_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->block_size = (size_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the number of operations per thread
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_number_of_operations(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_number_of_operations";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( bfoverlaytools_system_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit value.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint64_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of operations value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->number_of_operations = value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the number of threads
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_number_of_threads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_number_of_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( bfoverlaytools_system_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit value.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) BENCH_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( value_64bit > 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	bench_handle->number_of_threads = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the percentage of operations that are reads
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_read_percentage(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_read_percentage";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( bfoverlaytools_system_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit value.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > 100 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read percentage value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->read_percentage = (uint8_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Opens the benchmark handle
+ * The descriptor file is opened read-write if the benchmark contains write operations
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_open(
+     bench_handle_t *bench_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_open";
+	int access_flags      = LIBBFOVERLAY_OPEN_READ;
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->input_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid benchmark handle - input handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->read_percentage < 100 )
+	{
+		access_flags = LIBBFOVERLAY_OPEN_READ_WRITE;
+	}
+	if( libbfoverlay_handle_initialize(
+	     &( bench_handle->input_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfoverlay_handle_open_wide(
+	          bench_handle->input_handle,
+	          filename,
+	          access_flags,
+	          error );
+#else
+	result = libbfoverlay_handle_open(
+	          bench_handle->input_handle,
+	          filename,
+	          access_flags,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_handle_open_data_files(
+	     bench_handle->input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open data files.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_handle_set_record_latency_histograms(
+	     bench_handle->input_handle,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to enable latency histograms.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_handle_get_size(
+	     bench_handle->input_handle,
+	     &( bench_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( bench_handle->input_handle != NULL )
+	{
+		libbfoverlay_handle_free(
+		 &( bench_handle->input_handle ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes the benchmark handle
+ * Returns the 0 if successful or -1 on error
+ */
+int bench_handle_close(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_close";
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->input_handle != NULL )
+	{
+		if( libbfoverlay_handle_close(
+		     bench_handle->input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close input handle.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfoverlay_handle_free(
+		     &( bench_handle->input_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Runs the operations of a benchmark worker
+ * This function is used as a thread callback function
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_run_worker(
+     void *arguments )
+{
+	bench_handle_t *bench_handle = NULL;
+	bench_worker_t *bench_worker = NULL;
+	static char *function        = "bench_handle_run_worker";
+	size_t io_size               = 0;
+	ssize_t io_count             = 0;
+	uint64_t end_timestamp       = 0;
+	uint64_t number_of_blocks    = 0;
+	uint64_t operation_index     = 0;
+	uint64_t random_value        = 0;
+	uint64_t start_timestamp     = 0;
+	off64_t current_offset       = 0;
+	off64_t offset               = 0;
+	int is_read                  = 0;
+
+	if( arguments == NULL )
+	{
+		return( -1 );
+	}
+	bench_worker = (bench_worker_t *) arguments;
+	bench_handle = bench_worker->bench_handle;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 &( bench_worker->error ),
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark worker - missing benchmark handle.",
+		 function );
+
+		goto on_error;
+	}
+	number_of_blocks = ( bench_handle->media_size + bench_handle->block_size - 1 ) / bench_handle->block_size;
+	current_offset   = bench_worker->range_start_offset;
+
+	for( operation_index = 0;
+	     operation_index < bench_handle->number_of_operations;
+	     operation_index++ )
+	{
+		if( bench_handle->abort != 0 )
+		{
+			break;
+		}
+		/* xorshift64* pseudo random number generator
+		 */
+		bench_worker->random_state ^= bench_worker->random_state >> 12;
+		bench_worker->random_state ^= bench_worker->random_state << 25;
+		bench_worker->random_state ^= bench_worker->random_state >> 27;
+
+		random_value = bench_worker->random_state * 0x2545f4914f6cdd1dULL;
+
+		if( bench_handle->access_pattern == BENCH_ACCESS_PATTERN_RANDOM )
+		{
+			offset = (off64_t) ( ( ( random_value >> 16 ) % number_of_blocks ) * bench_handle->block_size );
+		}
+		else
+		{
+			offset          = current_offset;
+			current_offset += bench_handle->block_size;
+
+			if( current_offset >= bench_worker->range_end_offset )
+			{
+				current_offset = bench_worker->range_start_offset;
+			}
+		}
+		io_size = bench_handle->block_size;
+
+		if( io_size > (size_t) ( bench_handle->media_size - offset ) )
+		{
+			io_size = (size_t) ( bench_handle->media_size - offset );
+		}
+		is_read = (int) ( ( random_value & 0xffff ) % 100 ) < (int) bench_handle->read_percentage;
+
+		if( bfoverlaytools_timestamp_get(
+		     &start_timestamp,
+		     &( bench_worker->error ) ) != 1 )
+		{
+			libcerror_error_set(
+			 &( bench_worker->error ),
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
+
+			goto on_error;
+		}
+		if( is_read != 0 )
+		{
+			io_count = libbfoverlay_handle_read_buffer_at_offset(
+			            bench_handle->input_handle,
+			            bench_worker->buffer,
+			            io_size,
+			            offset,
+			            &( bench_worker->error ) );
+		}
+		else
+		{
+			io_count = libbfoverlay_handle_write_buffer_at_offset(
+			            bench_handle->input_handle,
+			            bench_worker->buffer,
+			            io_size,
+			            offset,
+			            &( bench_worker->error ) );
+		}
+		if( bfoverlaytools_timestamp_get(
+		     &end_timestamp,
+		     &( bench_worker->error ) ) != 1 )
+		{
+			libcerror_error_set(
+			 &( bench_worker->error ),
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve end timestamp.",
+			 function );
+
+			goto on_error;
+		}
+		if( io_count != (ssize_t) io_size )
+		{
+			libcerror_error_set(
+			 &( bench_worker->error ),
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 ( is_read != 0 ) ? LIBCERROR_IO_ERROR_READ_FAILED : LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to %s: %" PRIzd " bytes at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 ( is_read != 0 ) ? "read" : "write",
+			 io_size,
+			 offset,
+			 offset );
+
+			goto on_error;
+		}
+		if( is_read != 0 )
+		{
+			bench_worker->number_of_read_operations += 1;
+			bench_worker->read_size                 += io_size;
+		}
+		else
+		{
+			bench_worker->number_of_write_operations += 1;
+			bench_worker->write_size                 += io_size;
+		}
+		bench_worker->latencies[ operation_index ] = end_timestamp - start_timestamp;
+		bench_worker->number_of_operations        += 1;
+	}
+	bench_worker->result = 1;
+
+	return( 1 );
+
+on_error:
+	bench_worker->result = -1;
+
+	return( -1 );
+}
+
+/* Runs the benchmark
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_run(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	bench_worker_t *bench_workers           = NULL;
+	static char *function                   = "bench_handle_run";
+	size_t latencies_size                   = 0;
+	uint64_t blocks_per_worker              = 0;
+	uint64_t end_timestamp                  = 0;
+	uint64_t number_of_blocks               = 0;
+	uint64_t number_of_latencies            = 0;
+	uint64_t start_timestamp                = 0;
+	int result                              = 1;
+	int worker_index                        = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->input_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid benchmark handle - missing input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->latencies != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid benchmark handle - latencies value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bench_handle->number_of_threads <= 0 )
+	 || ( bench_handle->number_of_threads > BENCH_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid benchmark handle - number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->media_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid benchmark handle - media size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_latencies = bench_handle->number_of_operations * (uint64_t) bench_handle->number_of_threads;
+
+	if( ( bench_handle->number_of_operations == 0 )
+	 || ( number_of_latencies > (uint64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint64_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of latencies value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	latencies_size = (size_t) number_of_latencies * sizeof( uint64_t );
+
+	bench_handle->latencies = (uint64_t *) memory_allocate(
+	                                        latencies_size );
+
+	if( bench_handle->latencies == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create latencies.",
+		 function );
+
+		goto on_error;
+	}
+	bench_workers = (bench_worker_t *) memory_allocate(
+	                                    sizeof( bench_worker_t ) * bench_handle->number_of_threads );
+
+	if( bench_workers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create workers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     bench_workers,
+	     0,
+	     sizeof( bench_worker_t ) * bench_handle->number_of_threads ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear workers.",
+		 function );
+
+		memory_free(
+		 bench_workers );
+
+		bench_workers = NULL;
+
+		goto on_error;
+	}
+	/* Every worker accesses its own part of the data sequentially
+	 */
+	number_of_blocks  = ( bench_handle->media_size + bench_handle->block_size - 1 ) / bench_handle->block_size;
+	blocks_per_worker = number_of_blocks / (uint64_t) bench_handle->number_of_threads;
+
+	if( blocks_per_worker == 0 )
+	{
+		blocks_per_worker = 1;
+	}
+	for( worker_index = 0;
+	     worker_index < bench_handle->number_of_threads;
+	     worker_index++ )
+	{
+		bench_workers[ worker_index ].bench_handle       = bench_handle;
+		bench_workers[ worker_index ].latencies          = &( bench_handle->latencies[ (uint64_t) worker_index * bench_handle->number_of_operations ] );
+		bench_workers[ worker_index ].range_start_offset = (off64_t) ( ( ( (uint64_t) worker_index * blocks_per_worker ) % number_of_blocks ) * bench_handle->block_size );
+		bench_workers[ worker_index ].range_end_offset   = bench_workers[ worker_index ].range_start_offset + (off64_t) ( blocks_per_worker * bench_handle->block_size );
+		bench_workers[ worker_index ].random_state       = 0x9e3779b97f4a7c15ULL * (uint64_t) ( worker_index + 1 );
+
+		if( ( worker_index == ( bench_handle->number_of_threads - 1 ) )
+		 || ( bench_workers[ worker_index ].range_end_offset > (off64_t) bench_handle->media_size ) )
+		{
+			bench_workers[ worker_index ].range_end_offset = (off64_t) bench_handle->media_size;
+		}
+		bench_workers[ worker_index ].buffer = (uint8_t *) memory_allocate(
+		                                                    sizeof( uint8_t ) * bench_handle->block_size );
+
+		if( bench_workers[ worker_index ].buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create worker: %d buffer.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     bench_workers[ worker_index ].buffer,
+		     (int) ( 'A' + ( worker_index % 26 ) ),
+		     bench_handle->block_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear worker: %d buffer.",
+			 function,
+			 worker_index );
+
+			goto on_error;
+		}
+	}
+	if( bfoverlaytools_timestamp_get(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	if( bfoverlaytools_workers_run(
+	     &bench_handle_run_worker,
+	     (uint8_t *) bench_workers,
+	     sizeof( bench_worker_t ),
+	     bench_handle->number_of_threads,
+	     &( bench_handle->abort ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to run workers.",
+		 function );
+
+		goto on_error;
+	}
+	if( bfoverlaytools_timestamp_get(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	bench_handle->elapsed_time               = end_timestamp - start_timestamp;
+	bench_handle->number_of_latencies        = 0;
+	bench_handle->number_of_read_operations  = 0;
+	bench_handle->number_of_write_operations = 0;
+	bench_handle->read_size                  = 0;
+	bench_handle->write_size                 = 0;
+
+	for( worker_index = 0;
+	     worker_index < bench_handle->number_of_threads;
+	     worker_index++ )
+	{
+		if( bench_workers[ worker_index ].result != 1 )
+		{
+			if( bench_workers[ worker_index ].error != NULL )
+			{
+				if( ( error != NULL )
+				 && ( *error == NULL ) )
+				{
+					*error = bench_workers[ worker_index ].error;
+
+					bench_workers[ worker_index ].error = NULL;
+				}
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: worker: %d failed.",
+			 function,
+			 worker_index );
+
+			result = -1;
+		}
+		/* Pack the latencies of the completed operations
+		 */
+		if( ( bench_handle->number_of_latencies != ( (uint64_t) worker_index * bench_handle->number_of_operations ) )
+		 && ( bench_workers[ worker_index ].number_of_operations > 0 ) )
+		{
+			if( memory_copy(
+			     &( bench_handle->latencies[ bench_handle->number_of_latencies ] ),
+			     bench_workers[ worker_index ].latencies,
+			     sizeof( uint64_t ) * (size_t) bench_workers[ worker_index ].number_of_operations ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy worker: %d latencies.",
+				 function,
+				 worker_index );
+
+				result = -1;
+			}
+		}
+		bench_handle->number_of_latencies        += bench_workers[ worker_index ].number_of_operations;
+		bench_handle->number_of_read_operations  += bench_workers[ worker_index ].number_of_read_operations;
+		bench_handle->number_of_write_operations += bench_workers[ worker_index ].number_of_write_operations;
+		bench_handle->read_size                  += bench_workers[ worker_index ].read_size;
+		bench_handle->write_size                 += bench_workers[ worker_index ].write_size;
+	}
+	for( worker_index = 0;
+	     worker_index < bench_handle->number_of_threads;
+	     worker_index++ )
+	{
+		if( bench_workers[ worker_index ].error != NULL )
+		{
+			libcerror_error_free(
+			 &( bench_workers[ worker_index ].error ) );
+		}
+		memory_free(
+		 bench_workers[ worker_index ].buffer );
+	}
+	memory_free(
+	 bench_workers );
+
+	return( result );
+
+on_error:
+	if( bench_workers != NULL )
+	{
+		for( worker_index = 0;
+		     worker_index < bench_handle->number_of_threads;
+		     worker_index++ )
+		{
+			if( bench_workers[ worker_index ].error != NULL )
+			{
+				libcerror_error_free(
+				 &( bench_workers[ worker_index ].error ) );
+			}
+			if( bench_workers[ worker_index ].buffer != NULL )
+			{
+				memory_free(
+				 bench_workers[ worker_index ].buffer );
+			}
+		}
+		memory_free(
+		 bench_workers );
+	}
+	if( bench_handle->latencies != NULL )
+	{
+		memory_free(
+		 bench_handle->latencies );
+
+		bench_handle->latencies = NULL;
+	}
+	return( -1 );
+}
+
+/* Determines a percentile from a latency histogram
+ * The percentile is in per mille (1/1000)
+ * Returns the upper bound of the latency bucket that contains the percentile in nanoseconds
+ */
+uint64_t bench_handle_get_histogram_percentile(
+          const uint64_t *bucket_counts,
+          int percentile )
+{
+	uint64_t cumulative_count  = 0;
+	uint64_t number_of_samples = 0;
+	uint64_t threshold         = 0;
+	int bucket_index           = 0;
+
+	for( bucket_index = 0;
+	     bucket_index < LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS;
+	     bucket_index++ )
+	{
+		number_of_samples += bucket_counts[ bucket_index ];
+	}
+	threshold = ( ( number_of_samples * (uint64_t) percentile ) + 999 ) / 1000;
+
+	if( threshold == 0 )
+	{
+		threshold = 1;
+	}
+	for( bucket_index = 0;
+	     bucket_index < LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS;
+	     bucket_index++ )
+	{
+		cumulative_count += bucket_counts[ bucket_index ];
+
+		if( cumulative_count >= threshold )
+		{
+			break;
+		}
+	}
+	if( bucket_index == 0 )
+	{
+		return( 0 );
+	}
+	if( bucket_index >= LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS )
+	{
+		bucket_index = LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS - 1;
+	}
+	return( (uint64_t) 1 << bucket_index );
+}
+
+/* Prints the latency histograms of the input handle per latency path
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_latency_histograms_fprint(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	uint64_t bucket_counts[ LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS ];
+
+	const char *latency_path_strings[ 6 ] = {
+		"Read sparse", "Read base layer", "Read overlay layer",
+		"Read COW", "Write COW hit", "Write COW allocate" };
+
+	static char *function      = "bench_handle_latency_histograms_fprint";
+	uint64_t number_of_samples = 0;
+	int bucket_index           = 0;
+	int latency_path           = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tLatency per path (upper bound of histogram bucket):\n" );
+
+	for( latency_path = LIBBFOVERLAY_LATENCY_PATH_READ_SPARSE;
+	     latency_path <= LIBBFOVERLAY_LATENCY_PATH_WRITE_COW_ALLOCATE;
+	     latency_path++ )
+	{
+		if( libbfoverlay_handle_get_latency_histogram(
+		     bench_handle->input_handle,
+		     latency_path,
+		     bucket_counts,
+		     LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve latency histogram: %d.",
+			 function,
+			 latency_path );
+
+			return( -1 );
+		}
+		number_of_samples = 0;
+
+		for( bucket_index = 0;
+		     bucket_index < LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS;
+		     bucket_index++ )
+		{
+			number_of_samples += bucket_counts[ bucket_index ];
+		}
+		if( number_of_samples == 0 )
+		{
+			continue;
+		}
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\t\t%-18s\t: %" PRIu64 " samples, p50 <= %.3f us, p99 <= %.3f us, p99.9 <= %.3f us\n",
+		 latency_path_strings[ latency_path - 1 ],
+		 number_of_samples,
+		 (double) bench_handle_get_histogram_percentile( bucket_counts, 500 ) / 1000.0,
+		 (double) bench_handle_get_histogram_percentile( bucket_counts, 990 ) / 1000.0,
+		 (double) bench_handle_get_histogram_percentile( bucket_counts, 999 ) / 1000.0 );
+	}
+	return( 1 );
+}
+
+/* Prints the benchmark results
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_results_fprint(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	const char *access_pattern_string = "sequential";
+	static char *function             = "bench_handle_results_fprint";
+	double elapsed_seconds            = 0.0;
+	double total_latency              = 0.0;
+	uint64_t latency_index            = 0;
+	uint64_t number_of_operations     = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid benchmark handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->access_pattern == BENCH_ACCESS_PATTERN_RANDOM )
+	{
+		access_pattern_string = "random";
+	}
+	number_of_operations = bench_handle->number_of_read_operations
+	                     + bench_handle->number_of_write_operations;
+
+	elapsed_seconds = (double) bench_handle->elapsed_time / 1000000000.0;
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "Benchmark results:\n" );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tMedia size\t\t\t: %" PRIu64 " bytes\n",
+	 bench_handle->media_size );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tBlock size\t\t\t: %" PRIzd " bytes\n",
+	 bench_handle->block_size );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tAccess pattern\t\t\t: %s\n",
+	 access_pattern_string );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tRead percentage\t\t\t: %" PRIu8 "%%\n",
+	 bench_handle->read_percentage );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tNumber of threads\t\t: %d\n",
+	 bench_handle->number_of_threads );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tNumber of operations\t\t: %" PRIu64 " (%" PRIu64 " reads, %" PRIu64 " writes)\n",
+	 number_of_operations,
+	 bench_handle->number_of_read_operations,
+	 bench_handle->number_of_write_operations );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tElapsed time\t\t\t: %.6f seconds\n",
+	 elapsed_seconds );
+
+	if( elapsed_seconds > 0.0 )
+	{
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tRead throughput\t\t\t: %.2f MiB/s\n",
+		 ( (double) bench_handle->read_size / ( 1024.0 * 1024.0 ) ) / elapsed_seconds );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tWrite throughput\t\t: %.2f MiB/s\n",
+		 ( (double) bench_handle->write_size / ( 1024.0 * 1024.0 ) ) / elapsed_seconds );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tOperations per second (IOPS)\t: %.0f\n",
+		 (double) number_of_operations / elapsed_seconds );
+	}
+	if( ( bench_handle->latencies != NULL )
+	 && ( bench_handle->number_of_latencies > 0 ) )
+	{
+		qsort(
+		 bench_handle->latencies,
+		 (size_t) bench_handle->number_of_latencies,
+		 sizeof( uint64_t ),
+		 &bfoverlaytools_workers_compare_latencies );
+
+		for( latency_index = 0;
+		     latency_index < bench_handle->number_of_latencies;
+		     latency_index++ )
+		{
+			total_latency += (double) bench_handle->latencies[ latency_index ];
+		}
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tLatency minimum\t\t\t: %.3f us\n",
+		 (double) bench_handle->latencies[ 0 ] / 1000.0 );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tLatency average\t\t\t: %.3f us\n",
+		 ( total_latency / (double) bench_handle->number_of_latencies ) / 1000.0 );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tLatency 50th percentile\t\t: %.3f us\n",
+		 (double) bench_handle->latencies[ ( ( bench_handle->number_of_latencies - 1 ) * 500 ) / 1000 ] / 1000.0 );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tLatency 90th percentile\t\t: %.3f us\n",
+		 (double) bench_handle->latencies[ ( ( bench_handle->number_of_latencies - 1 ) * 900 ) / 1000 ] / 1000.0 );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tLatency 99th percentile\t\t: %.3f us\n",
+		 (double) bench_handle->latencies[ ( ( bench_handle->number_of_latencies - 1 ) * 990 ) / 1000 ] / 1000.0 );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tLatency 99.9th percentile\t: %.3f us\n",
+		 (double) bench_handle->latencies[ ( ( bench_handle->number_of_latencies - 1 ) * 999 ) / 1000 ] / 1000.0 );
+
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\tLatency maximum\t\t\t: %.3f us\n",
+		 (double) bench_handle->latencies[ bench_handle->number_of_latencies - 1 ] / 1000.0 );
+	}
+	if( bench_handle->input_handle != NULL )
+	{
+		if( bench_handle_latency_histograms_fprint(
+		     bench_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print latency histograms.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+}
+
@@ -0,0 +1,241 @@
+/*
+ * Benchmark handle
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BENCH_HANDLE_H )
+#define _BENCH_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "bfoverlaytools_libbfoverlay.h"
+#include "bfoverlaytools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define BENCH_HANDLE_MAXIMUM_BLOCK_SIZE			( 64 * 1024 * 1024 )
+#define BENCH_HANDLE_MAXIMUM_NUMBER_OF_THREADS		256
+
+enum BENCH_ACCESS_PATTERNS
+{
+	BENCH_ACCESS_PATTERN_SEQUENTIAL			= (int) 's',
+	BENCH_ACCESS_PATTERN_RANDOM			= (int) 'r'
+};
+
+typedef struct bench_handle bench_handle_t;
+
+struct bench_handle
+{
+	/* The input handle
+	 */
+	libbfoverlay_handle_t *input_handle;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The block size
+	 */
+	size_t block_size;
+
+	/* The access pattern
+	 */
+	int access_pattern;
+
+	/* The percentage of operations that are reads
+	 */
+	uint8_t read_percentage;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The number of operations per thread
+	 */
+	uint64_t number_of_operations;
+
+	/* The number of read operations
+	 */
+	uint64_t number_of_read_operations;
+
+	/* The number of write operations
+	 */
+	uint64_t number_of_write_operations;
+
+	/* The number of bytes read
+	 */
+	uint64_t read_size;
+
+	/* The number of bytes written
+	 */
+	uint64_t write_size;
+
+	/* The elapsed time in nanoseconds
+	 */
+	uint64_t elapsed_time;
+
+	/* The operation latencies in nanoseconds
+	 */
+	uint64_t *latencies;
+
+	/* The number of latencies
+	 */
+	uint64_t number_of_latencies;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+typedef struct bench_worker bench_worker_t;
+
+struct bench_worker
+{
+	/* The benchmark handle
+	 */
+	bench_handle_t *bench_handle;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The operation latencies in nanoseconds
+	 */
+	uint64_t *latencies;
+
+	/* The number of completed operations
+	 */
+	uint64_t number_of_operations;
+
+	/* The number of read operations
+	 */
+	uint64_t number_of_read_operations;
+
+	/* The number of write operations
+	 */
+	uint64_t number_of_write_operations;
+
+	/* The number of bytes read
+	 */
+	uint64_t read_size;
+
+	/* The number of bytes written
+	 */
+	uint64_t write_size;
+
+	/* The start offset of the sequential access range
+	 */
+	off64_t range_start_offset;
+
+	/* The end offset of the sequential access range
+	 */
+	off64_t range_end_offset;
+
+	/* The pseudo random number generator state
+	 */
+	uint64_t random_state;
+
+	/* The result
+	 */
+	int result;
+
+	/* The error
+	 */
+	libcerror_error_t *error;
+};
+
+int bench_handle_initialize(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_free(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_signal_abort(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_set_access_pattern(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_block_size(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_number_of_operations(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_number_of_threads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_read_percentage(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_open(
+     bench_handle_t *bench_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int bench_handle_close(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_run_worker(
+     void *arguments );
+
+int bench_handle_run(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+uint64_t bench_handle_get_histogram_percentile(
+          const uint64_t *bucket_counts,
+          int percentile );
+
+int bench_handle_latency_histograms_fprint(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_results_fprint(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BENCH_HANDLE_H ) */
+
@@ -0,0 +1,101 @@
+/*
+ * The IO trace file format
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BFOVERLAY_IO_TRACE_H )
+#define _BFOVERLAY_IO_TRACE_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct bfoverlay_io_trace_file_header bfoverlay_io_trace_file_header_t;
+
+struct bfoverlay_io_trace_file_header
+{
+	/* Signature
+	 * Consists of 8 bytes
+	 * "BFO-IOTR"
+	 */
+	uint8_t signature[ 8 ];
+
+	/* Format version
+	 * Consists of 4 bytes
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* Record size
+	 * Consists of 4 bytes
+	 */
+	uint8_t record_size[ 4 ];
+};
+
+typedef struct bfoverlay_io_trace_record bfoverlay_io_trace_record_t;
+
+struct bfoverlay_io_trace_record
+{
+	/* Timestamp
+	 * Consists of 8 bytes
+	 * Contains the number of nanoseconds since the start of the trace
+	 */
+	uint8_t timestamp[ 8 ];
+
+	/* Offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t offset[ 8 ];
+
+	/* Size
+	 * Consists of 8 bytes
+	 */
+	uint8_t size[ 8 ];
+
+	/* Result
+	 * Consists of 8 bytes
+	 * Contains a signed value, -1 represents an error
+	 */
+	uint8_t result[ 8 ];
+
+	/* Latency
+	 * Consists of 8 bytes
+	 * Contains the number of nanoseconds
+	 */
+	uint8_t latency[ 8 ];
+
+	/* Operation
+	 * Consists of 1 byte
+	 */
+	uint8_t operation;
+
+	/* Unknown (reserved)
+	 * Consists of 7 bytes
+	 */
+	uint8_t unknown1[ 7 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BFOVERLAY_IO_TRACE_H ) */
+
@@ -0,0 +1,453 @@
+/*
+ * Benchmarks basic file overlays.
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bench_handle.h"
+#include "bfoverlaytools_getopt.h"
+#include "bfoverlaytools_i18n.h"
+#include "bfoverlaytools_libbfoverlay.h"
+#include "bfoverlaytools_libcerror.h"
+#include "bfoverlaytools_libclocale.h"
+#include "bfoverlaytools_libcnotify.h"
+#include "bfoverlaytools_output.h"
+#include "bfoverlaytools_signal.h"
+#include "bfoverlaytools_unused.h"
+
+bench_handle_t *bfoverlaybench_bench_handle = NULL;
+int bfoverlaybench_abort                    = 0;
+
+/* Signal handler for bfoverlaybench
+ */
+void bfoverlaybench_signal_handler(
+      bfoverlaytools_signal_t signal BFOVERLAYTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "bfoverlaybench_signal_handler";
+
+	BFOVERLAYTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	bfoverlaybench_abort = 1;
+
+	if( bfoverlaybench_bench_handle != NULL )
+	{
+		if( bench_handle_signal_abort(
+		     bfoverlaybench_bench_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal benchmark handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	const char *description                = \
+		"Use bfoverlaybench to measure the throughput and latency of basic file overlays.";
+
+	bfoverlaytools_option_t options[ ] = {
+		{ 'b', "block_size", "size of the data accessed per operation, default is 4096" },
+		{ 'h', NULL, "shows this help" },
+		{ 'n', "operations", "number of operations per thread, default is 10000" },
+		{ 'p', "pattern", "access pattern, options: random, sequential (default)" },
+		{ 'r', "percentage", "percentage of operations that are reads, default is 100. Any other operation is a write, which modifies the overlay" },
+		{ 't', "threads", "number of threads accessing the overlay concurrently, default is 1" },
+		{ 'v', NULL, "verbose output to stderr" },
+		{ 'V', NULL, "print version" },
+		{ 0, "descriptor file", "basic file overlay descriptor file" },
+	};
+	system_character_t options_string[ 32 ];
+
+	libbfoverlay_error_t *error                     = NULL;
+	system_character_t *option_access_pattern       = NULL;
+	system_character_t *option_block_size           = NULL;
+	system_character_t *option_number_of_operations = NULL;
+	system_character_t *option_number_of_threads    = NULL;
+	system_character_t *option_read_percentage      = NULL;
+	system_character_t *source                      = NULL;
+	char *program                                   = "bfoverlaybench";
+	system_integer_t option                         = 0;
+	int number_of_options                           = (int) ( sizeof( options ) / sizeof( bfoverlaytools_option_t ) );
+	int result                                      = 0;
+	int verbose                                     = 0;
+
+#if defined( __MINGW32__ ) && defined( HAVE_MINGW_BINMODE )
+	_setmode( _fileno( stdout ), _O_BINARY );
+	_setmode( _fileno( stderr ), _O_BINARY );
+#endif
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "bfoverlaytools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( bfoverlaytools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	bfoverlaytools_output_version_fprint(
+	 stdout,
+	 program );
+
+	if( bfoverlaytools_getopt_get_options_string(
+	     options,
+	     number_of_options,
+	     options_string,
+	     32 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to determine options string.\n" );
+
+		goto on_error;
+	}
+	while( ( option = bfoverlaytools_getopt(
+	                   argc,
+	                   argv,
+	                   options_string ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				bfoverlaytools_getopt_usage_fprint(
+				 stdout,
+				 program,
+				 description,
+				 options,
+				 number_of_options );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_block_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				bfoverlaytools_getopt_usage_fprint(
+				 stdout,
+				 program,
+				 description,
+				 options,
+				 number_of_options );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'n':
+				option_number_of_operations = optarg;
+
+				break;
+
+			case (system_integer_t) 'p':
+				option_access_pattern = optarg;
+
+				break;
+
+			case (system_integer_t) 'r':
+				option_read_percentage = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_number_of_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				bfoverlaytools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source descriptor file.\n" );
+
+		bfoverlaytools_getopt_usage_fprint(
+		 stdout,
+		 program,
+		 description,
+		 options,
+		 number_of_options );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libbfoverlay_notify_set_stream(
+	 stderr,
+	 NULL );
+	libbfoverlay_notify_set_verbose(
+	 verbose );
+
+	if( bench_handle_initialize(
+	     &bfoverlaybench_bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize benchmark handle.\n" );
+
+		goto on_error;
+	}
+	if( option_access_pattern != NULL )
+	{
+		result = bench_handle_set_access_pattern(
+		          bfoverlaybench_bench_handle,
+		          option_access_pattern,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set access pattern.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported access pattern.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_block_size != NULL )
+	{
+		if( bench_handle_set_block_size(
+		     bfoverlaybench_bench_handle,
+		     option_block_size,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set block size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_operations != NULL )
+	{
+		if( bench_handle_set_number_of_operations(
+		     bfoverlaybench_bench_handle,
+		     option_number_of_operations,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of operations.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_threads != NULL )
+	{
+		if( bench_handle_set_number_of_threads(
+		     bfoverlaybench_bench_handle,
+		     option_number_of_threads,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_read_percentage != NULL )
+	{
+		if( bench_handle_set_read_percentage(
+		     bfoverlaybench_bench_handle,
+		     option_read_percentage,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set read percentage.\n" );
+
+			goto on_error;
+		}
+	}
+	if( bench_handle_open(
+	     bfoverlaybench_bench_handle,
+	     source,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open source descriptor file.\n" );
+
+		goto on_error;
+	}
+	if( bfoverlaytools_signal_attach(
+	     bfoverlaybench_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = bench_handle_run(
+	          bfoverlaybench_bench_handle,
+	          &error );
+
+	if( bfoverlaytools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to run benchmark.\n" );
+
+		goto on_error;
+	}
+	if( bfoverlaybench_abort != 0 )
+	{
+		fprintf(
+		 stdout,
+		 "Benchmark aborted.\n\n" );
+	}
+	if( bench_handle_results_fprint(
+	     bfoverlaybench_bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to print benchmark results.\n" );
+
+		goto on_error;
+	}
+	if( bench_handle_close(
+	     bfoverlaybench_bench_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close benchmark handle.\n" );
+
+		goto on_error;
+	}
+	if( bench_handle_free(
+	     &bfoverlaybench_bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free benchmark handle.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( bfoverlaybench_bench_handle != NULL )
+	{
+		bench_handle_free(
+		 &bfoverlaybench_bench_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,354 @@
+/*
+ * Compacts the copy-on-write (COW) file of basic file overlays.
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bfoverlaytools_getopt.h"
+#include "bfoverlaytools_i18n.h"
+#include "bfoverlaytools_libbfoverlay.h"
+#include "bfoverlaytools_libcerror.h"
+#include "bfoverlaytools_libclocale.h"
+#include "bfoverlaytools_libcnotify.h"
+#include "bfoverlaytools_output.h"
+#include "bfoverlaytools_signal.h"
+#include "bfoverlaytools_unused.h"
+#include "compact_handle.h"
+
+compact_handle_t *bfoverlaycompact_compact_handle = NULL;
+int bfoverlaycompact_abort                         = 0;
+
+/* Signal handler for bfoverlaycompact
+ */
+void bfoverlaycompact_signal_handler(
+      bfoverlaytools_signal_t signal BFOVERLAYTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "bfoverlaycompact_signal_handler";
+
+	BFOVERLAYTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	bfoverlaycompact_abort = 1;
+
+	if( bfoverlaycompact_compact_handle != NULL )
+	{
+		if( compact_handle_signal_abort(
+		     bfoverlaycompact_compact_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal compaction handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	const char *description     = \
+		"Use bfoverlaycompact to write a compacted copy of the copy-on-write (COW) file of a basic file overlay, with the data blocks in logical order.";
+
+	bfoverlaytools_option_t options[ ] = {
+		{ 'h', NULL, "shows this help" },
+		{ 'v', NULL, "verbose output to stderr" },
+		{ 'V', NULL, "print version" },
+		{ 0, "descriptor file", "basic file overlay descriptor file" },
+		{ 0, "target file", "compacted COW file, which must not exist" },
+	};
+	system_character_t options_string[ 32 ];
+
+	libbfoverlay_error_t *error = NULL;
+	system_character_t *source  = NULL;
+	system_character_t *target  = NULL;
+	char *program               = "bfoverlaycompact";
+	system_integer_t option     = 0;
+	int number_of_options       = (int) ( sizeof( options ) / sizeof( bfoverlaytools_option_t ) );
+	int result                  = 0;
+	int verbose                 = 0;
+
+#if defined( __MINGW32__ ) && defined( HAVE_MINGW_BINMODE )
+	_setmode( _fileno( stdout ), _O_BINARY );
+	_setmode( _fileno( stderr ), _O_BINARY );
+#endif
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "bfoverlaytools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( bfoverlaytools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	bfoverlaytools_output_version_fprint(
+	 stdout,
+	 program );
+
+	if( bfoverlaytools_getopt_get_options_string(
+	     options,
+	     number_of_options,
+	     options_string,
+	     32 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to determine options string.\n" );
+
+		goto on_error;
+	}
+	while( ( option = bfoverlaytools_getopt(
+	                   argc,
+	                   argv,
+	                   options_string ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				bfoverlaytools_getopt_usage_fprint(
+				 stdout,
+				 program,
+				 description,
+				 options,
+				 number_of_options );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'h':
+				bfoverlaytools_getopt_usage_fprint(
+				 stdout,
+				 program,
+				 description,
+				 options,
+				 number_of_options );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				bfoverlaytools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source descriptor file.\n" );
+
+		bfoverlaytools_getopt_usage_fprint(
+		 stdout,
+		 program,
+		 description,
+		 options,
+		 number_of_options );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind++ ];
+
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing target file.\n" );
+
+		bfoverlaytools_getopt_usage_fprint(
+		 stdout,
+		 program,
+		 description,
+		 options,
+		 number_of_options );
+
+		return( EXIT_FAILURE );
+	}
+	target = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libbfoverlay_notify_set_stream(
+	 stderr,
+	 NULL );
+	libbfoverlay_notify_set_verbose(
+	 verbose );
+
+	if( compact_handle_initialize(
+	     &bfoverlaycompact_compact_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize compaction handle.\n" );
+
+		goto on_error;
+	}
+	if( compact_handle_open(
+	     bfoverlaycompact_compact_handle,
+	     source,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open source descriptor file.\n" );
+
+		goto on_error;
+	}
+	if( bfoverlaytools_signal_attach(
+	     bfoverlaycompact_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = compact_handle_write_compacted_cow_file(
+	          bfoverlaycompact_compact_handle,
+	          target,
+	          &error );
+
+	if( bfoverlaytools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( bfoverlaycompact_abort != 0 )
+	{
+		fprintf(
+		 stdout,
+		 "Compaction aborted.\n" );
+
+		goto on_error;
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write compacted COW file.\n" );
+
+		goto on_error;
+	}
+	if( compact_handle_close(
+	     bfoverlaycompact_compact_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close compaction handle.\n" );
+
+		goto on_error;
+	}
+	if( compact_handle_free(
+	     &bfoverlaycompact_compact_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free compaction handle.\n" );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Compaction completed.\n" );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( bfoverlaycompact_compact_handle != NULL )
+	{
+		compact_handle_free(
+		 &bfoverlaycompact_compact_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
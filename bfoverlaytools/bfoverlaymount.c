@@ -116,6 +116,10 @@ int main( int argc, char * const argv[] )
 
 	bfoverlaytools_option_t options[ ] = {
 		{ 'h', NULL, "shows this help" },
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
+		{ 'j', "threads", "number of threads used to process file system requests, default is 1" },
+#endif
+		{ 't', "format", "IO trace format, options: binary, text (default)" },
 		{ 'T', "file", "track IO traces in a seperate file" },
 		{ 'v', NULL, "verbose output to stderr, while bfoverlaymount will remain running in the foreground" },
 		{ 'V', NULL, "print version" },
@@ -129,6 +133,8 @@ int main( int argc, char * const argv[] )
 
 	libbfoverlay_error_t *error                    = NULL;
 	system_character_t *option_io_trace_file       = NULL;
+	system_character_t *option_io_trace_format     = NULL;
+	system_character_t *option_number_of_threads   = NULL;
 	const system_character_t *path_prefix          = NULL;
 	const system_character_t *path_suffix          = NULL;
 	system_character_t *source                     = NULL;
@@ -137,17 +143,22 @@ int main( int argc, char * const argv[] )
 	size_t path_prefix_size                        = 0;
 	size_t path_suffix_size                        = 0;
 	int number_of_options                          = (int) ( sizeof( options ) / sizeof( bfoverlaytools_option_t ) );
+	int result                                     = 0;
 	int verbose                                    = 0;
 
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE ) || defined( HAVE_LIBDOKAN )
 	system_character_t *mount_point                = NULL;
-	int result                                     = 0;
 #endif
 
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
 	struct fuse_operations bfoverlaymount_fuse_operations;
 
 	system_character_t *option_extended_options    = NULL;
+	int number_of_threads                          = 1;
+
+#if defined( HAVE_LIBFUSE3 ) && ( FUSE_USE_VERSION >= 32 )
+	struct fuse_loop_config bfoverlaymount_fuse_loop_config;
+#endif
 
 #if defined( HAVE_LIBFUSE3 )
 	/* Need to set this to 1 even if there no arguments, otherwise this causes
@@ -246,6 +257,18 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
+			case (system_integer_t) 'j':
+				option_number_of_threads = optarg;
+
+				break;
+#endif
+
+			case (system_integer_t) 't':
+				option_io_trace_format = optarg;
+
+				break;
+
 			case (system_integer_t) 'T':
 				option_io_trace_file = optarg;
 
@@ -323,6 +346,30 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( option_io_trace_format != NULL )
+	{
+		result = mount_handle_set_io_trace_format(
+		          bfoverlaymount_mount_handle,
+		          option_io_trace_format,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set IO trace format.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported IO trace format.\n" );
+
+			goto on_error;
+		}
+	}
 	if( option_io_trace_file != NULL )
 	{
 		if( mount_handle_set_io_trace_file(
@@ -337,6 +384,20 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_number_of_threads != NULL )
+	{
+		if( mount_handle_set_number_of_threads(
+		     bfoverlaymount_mount_handle,
+		     option_number_of_threads,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+	}
 #if defined( WINAPI )
 	path_prefix = _SYSTEM_STRING( "\\BFOVERLAY" );
 #else
@@ -449,6 +510,13 @@ int main( int argc, char * const argv[] )
 	bfoverlaymount_fuse_operations.getattr    = &mount_fuse_getattr;
 	bfoverlaymount_fuse_operations.destroy    = &mount_fuse_destroy;
 
+#if defined( HAVE_MOUNT_FUSE_LSEEK )
+	bfoverlaymount_fuse_operations.lseek      = &mount_fuse_lseek;
+#endif
+#if defined( HAVE_MOUNT_FUSE_FALLOCATE )
+	bfoverlaymount_fuse_operations.fallocate  = &mount_fuse_fallocate;
+#endif
+
 #if defined( HAVE_LIBFUSE3 )
 	bfoverlaymount_fuse_handle = fuse_new(
 	                              &bfoverlaymount_fuse_arguments,
@@ -518,8 +586,50 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
-	result = fuse_loop(
-	          bfoverlaymount_fuse_handle );
+	if( mount_handle_get_number_of_threads(
+	     bfoverlaymount_mount_handle,
+	     &number_of_threads,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve number of threads.\n" );
+
+		goto on_error;
+	}
+	if( number_of_threads > 1 )
+	{
+#if defined( HAVE_LIBFUSE3 ) && ( FUSE_USE_VERSION >= 32 )
+		if( memory_set(
+		     &bfoverlaymount_fuse_loop_config,
+		     0,
+		     sizeof( struct fuse_loop_config ) ) == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to clear fuse loop configuration.\n" );
+
+			goto on_error;
+		}
+		bfoverlaymount_fuse_loop_config.clone_fd         = 0;
+		bfoverlaymount_fuse_loop_config.max_idle_threads = (unsigned int) number_of_threads;
+
+		result = fuse_loop_mt(
+		          bfoverlaymount_fuse_handle,
+		          &bfoverlaymount_fuse_loop_config );
+
+#else
+		/* The number of threads is managed by fuse
+		 */
+		result = fuse_loop_mt(
+		          bfoverlaymount_fuse_handle );
+#endif
+	}
+	else
+	{
+		result = fuse_loop(
+		          bfoverlaymount_fuse_handle );
+	}
 
 	if( result != 0 )
 	{
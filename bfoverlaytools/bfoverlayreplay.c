@@ -0,0 +1,438 @@
+/*
+ * Replays IO traces of basic file overlays.
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bfoverlaytools_getopt.h"
+#include "bfoverlaytools_i18n.h"
+#include "bfoverlaytools_libbfoverlay.h"
+#include "bfoverlaytools_libcerror.h"
+#include "bfoverlaytools_libclocale.h"
+#include "bfoverlaytools_libcnotify.h"
+#include "bfoverlaytools_output.h"
+#include "bfoverlaytools_signal.h"
+#include "bfoverlaytools_unused.h"
+#include "replay_handle.h"
+
+replay_handle_t *bfoverlayreplay_replay_handle = NULL;
+int bfoverlayreplay_abort                       = 0;
+
+/* Signal handler for bfoverlayreplay
+ */
+void bfoverlayreplay_signal_handler(
+      bfoverlaytools_signal_t signal BFOVERLAYTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "bfoverlayreplay_signal_handler";
+
+	BFOVERLAYTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	bfoverlayreplay_abort = 1;
+
+	if( bfoverlayreplay_replay_handle != NULL )
+	{
+		if( replay_handle_signal_abort(
+		     bfoverlayreplay_replay_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal replay handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	const char *description                      = \
+		"Use bfoverlayreplay to replay a binary IO trace, created with bfoverlaymount -t binary, against a basic file overlay.";
+
+	bfoverlaytools_option_t options[ ] = {
+		{ 'h', NULL, "shows this help" },
+		{ 'm', "mode", "replay mode, options: fast (default), timed" },
+		{ 't', "threads", "number of threads replaying operations concurrently, default is 1" },
+		{ 'v', NULL, "verbose output to stderr" },
+		{ 'V', NULL, "print version" },
+		{ 'w', NULL, "replay write, resize, discard and write zeroes operations, which modifies the overlay. The written data is zero-filled since it is not part of the IO trace" },
+		{ 0, "trace file", "binary IO trace file" },
+		{ 0, "descriptor file", "basic file overlay descriptor file" },
+	};
+	system_character_t options_string[ 32 ];
+
+	libbfoverlay_error_t *error                  = NULL;
+	system_character_t *option_mode              = NULL;
+	system_character_t *option_number_of_threads = NULL;
+	system_character_t *source                   = NULL;
+	system_character_t *trace_file               = NULL;
+	char *program                                = "bfoverlayreplay";
+	system_integer_t option                      = 0;
+	uint8_t replay_writes                        = 0;
+	int number_of_options                        = (int) ( sizeof( options ) / sizeof( bfoverlaytools_option_t ) );
+	int result                                   = 0;
+	int verbose                                  = 0;
+
+#if defined( __MINGW32__ ) && defined( HAVE_MINGW_BINMODE )
+	_setmode( _fileno( stdout ), _O_BINARY );
+	_setmode( _fileno( stderr ), _O_BINARY );
+#endif
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "bfoverlaytools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( bfoverlaytools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	bfoverlaytools_output_version_fprint(
+	 stdout,
+	 program );
+
+	if( bfoverlaytools_getopt_get_options_string(
+	     options,
+	     number_of_options,
+	     options_string,
+	     32 ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to determine options string.\n" );
+
+		goto on_error;
+	}
+	while( ( option = bfoverlaytools_getopt(
+	                   argc,
+	                   argv,
+	                   options_string ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				bfoverlaytools_getopt_usage_fprint(
+				 stdout,
+				 program,
+				 description,
+				 options,
+				 number_of_options );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'h':
+				bfoverlaytools_getopt_usage_fprint(
+				 stdout,
+				 program,
+				 description,
+				 options,
+				 number_of_options );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'm':
+				option_mode = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_number_of_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				bfoverlaytools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'w':
+				replay_writes = 1;
+
+				break;
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing trace file.\n" );
+
+		bfoverlaytools_getopt_usage_fprint(
+		 stdout,
+		 program,
+		 description,
+		 options,
+		 number_of_options );
+
+		return( EXIT_FAILURE );
+	}
+	trace_file = argv[ optind++ ];
+
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source descriptor file.\n" );
+
+		bfoverlaytools_getopt_usage_fprint(
+		 stdout,
+		 program,
+		 description,
+		 options,
+		 number_of_options );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libbfoverlay_notify_set_stream(
+	 stderr,
+	 NULL );
+	libbfoverlay_notify_set_verbose(
+	 verbose );
+
+	if( replay_handle_initialize(
+	     &bfoverlayreplay_replay_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize replay handle.\n" );
+
+		goto on_error;
+	}
+	if( option_mode != NULL )
+	{
+		result = replay_handle_set_mode(
+		          bfoverlayreplay_replay_handle,
+		          option_mode,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set replay mode.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported replay mode.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_threads != NULL )
+	{
+		if( replay_handle_set_number_of_threads(
+		     bfoverlayreplay_replay_handle,
+		     option_number_of_threads,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+	}
+	if( replay_handle_set_replay_writes(
+	     bfoverlayreplay_replay_handle,
+	     replay_writes,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set replay writes.\n" );
+
+		goto on_error;
+	}
+	if( replay_handle_open_trace(
+	     bfoverlayreplay_replay_handle,
+	     trace_file,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open trace file.\n" );
+
+		goto on_error;
+	}
+	if( replay_handle_open_input(
+	     bfoverlayreplay_replay_handle,
+	     source,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open source descriptor file.\n" );
+
+		goto on_error;
+	}
+	if( bfoverlaytools_signal_attach(
+	     bfoverlayreplay_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = replay_handle_run(
+	          bfoverlayreplay_replay_handle,
+	          &error );
+
+	if( bfoverlaytools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to replay trace.\n" );
+
+		goto on_error;
+	}
+	if( bfoverlayreplay_abort != 0 )
+	{
+		fprintf(
+		 stdout,
+		 "Replay aborted.\n\n" );
+	}
+	if( replay_handle_results_fprint(
+	     bfoverlayreplay_replay_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to print replay results.\n" );
+
+		goto on_error;
+	}
+	if( replay_handle_close(
+	     bfoverlayreplay_replay_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close replay handle.\n" );
+
+		goto on_error;
+	}
+	if( replay_handle_free(
+	     &bfoverlayreplay_replay_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free replay handle.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( bfoverlayreplay_replay_handle != NULL )
+	{
+		replay_handle_free(
+		 &bfoverlayreplay_replay_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,209 @@
+/*
+ * Worker functions
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "bfoverlaytools_libcerror.h"
+#include "bfoverlaytools_libcthreads.h"
+#include "bfoverlaytools_workers.h"
+
+/* Runs the workers
+ * The workers are stored consecutively, every worker is passed to the callback function
+ * If more than 1 worker is specified every worker is run in a separate thread
+ * On error abort is set so that the workers that were started stop
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlaytools_workers_run(
+     int (*callback_function)( void *arguments ),
+     uint8_t *workers,
+     size_t worker_size,
+     int number_of_workers,
+     int *abort,
+     libcerror_error_t **error )
+{
+	static char *function          = "bfoverlaytools_workers_run";
+	int result                     = 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_t **threads = NULL;
+	int number_of_threads_created  = 0;
+	int worker_index               = 0;
+#endif
+
+	if( callback_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid callback function.",
+		 function );
+
+		return( -1 );
+	}
+	if( workers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid workers.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( worker_size == 0 )
+	 || ( worker_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid worker size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_workers <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of workers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( abort == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid abort.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( number_of_workers > 1 )
+	{
+		threads = (libcthreads_thread_t **) memory_allocate(
+		                                     sizeof( libcthreads_thread_t * ) * number_of_workers );
+
+		if( threads == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create threads.",
+			 function );
+
+			return( -1 );
+		}
+		for( worker_index = 0;
+		     worker_index < number_of_workers;
+		     worker_index++ )
+		{
+			threads[ worker_index ] = NULL;
+
+			if( libcthreads_thread_create(
+			     &( threads[ worker_index ] ),
+			     NULL,
+			     callback_function,
+			     (void *) &( workers[ worker_index * worker_size ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create thread: %d.",
+				 function,
+				 worker_index );
+
+				/* Make sure the threads that were created are stopped
+				 */
+				*abort = 1;
+
+				result = -1;
+
+				break;
+			}
+			number_of_threads_created++;
+		}
+		for( worker_index = 0;
+		     worker_index < number_of_threads_created;
+		     worker_index++ )
+		{
+			if( libcthreads_thread_join(
+			     &( threads[ worker_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread: %d.",
+				 function,
+				 worker_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 threads );
+	}
+	else
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+	{
+		callback_function(
+		 (void *) workers );
+	}
+	return( result );
+}
+
+/* Compares two latencies
+ * This function is used as a qsort compare function
+ * Returns -1 if the first latency is smaller, 1 if larger or 0 if equal
+ */
+int bfoverlaytools_workers_compare_latencies(
+     const void *first_latency,
+     const void *second_latency )
+{
+	uint64_t first_value  = *( (const uint64_t *) first_latency );
+	uint64_t second_value = *( (const uint64_t *) second_latency );
+
+	if( first_value < second_value )
+	{
+		return( -1 );
+	}
+	else if( first_value > second_value )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
@@ -0,0 +1,51 @@
+/*
+ * Worker functions
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BFOVERLAYTOOLS_WORKERS_H )
+#define _BFOVERLAYTOOLS_WORKERS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "bfoverlaytools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+int bfoverlaytools_workers_run(
+     int (*callback_function)( void *arguments ),
+     uint8_t *workers,
+     size_t worker_size,
+     int number_of_workers,
+     int *abort,
+     libcerror_error_t **error );
+
+int bfoverlaytools_workers_compare_latencies(
+     const void *first_latency,
+     const void *second_latency );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BFOVERLAYTOOLS_WORKERS_H ) */
+
@@ -0,0 +1,421 @@
+/*
+ * Compaction handle
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "bfoverlaytools_libbfoverlay.h"
+#include "bfoverlaytools_libcerror.h"
+#include "compact_handle.h"
+
+/* Creates a compaction handle
+ * Make sure the value compact_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int compact_handle_initialize(
+     compact_handle_t **compact_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "compact_handle_initialize";
+
+	if( compact_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compaction handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compact_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compaction handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*compact_handle = memory_allocate_structure(
+	                 compact_handle_t );
+
+	if( *compact_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compaction handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compact_handle,
+	     0,
+	     sizeof( compact_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compaction handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *compact_handle )->notify_stream = stdout;
+
+	return( 1 );
+
+on_error:
+	if( *compact_handle != NULL )
+	{
+		memory_free(
+		 *compact_handle );
+
+		*compact_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a compaction handle
+ * Returns 1 if successful or -1 on error
+ */
+int compact_handle_free(
+     compact_handle_t **compact_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "compact_handle_free";
+	int result            = 1;
+
+	if( compact_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compaction handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compact_handle != NULL )
+	{
+		if( ( *compact_handle )->input_handle != NULL )
+		{
+			if( libbfoverlay_handle_free(
+			     &( ( *compact_handle )->input_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *compact_handle );
+
+		*compact_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the compaction handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int compact_handle_signal_abort(
+     compact_handle_t *compact_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "compact_handle_signal_abort";
+
+	if( compact_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compaction handle.",
+		 function );
+
+		return( -1 );
+	}
+	compact_handle->abort = 1;
+
+	if( compact_handle->input_handle != NULL )
+	{
+		if( libbfoverlay_handle_signal_abort(
+		     compact_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input handle to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Opens the compaction handle
+ * Returns 1 if successful or -1 on error
+ */
+int compact_handle_open(
+     compact_handle_t *compact_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "compact_handle_open";
+	int result            = 0;
+
+	if( compact_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compaction handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( compact_handle->input_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compaction handle - input handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfoverlay_handle_initialize(
+	     &( compact_handle->input_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfoverlay_handle_open_wide(
+	          compact_handle->input_handle,
+	          filename,
+	          LIBBFOVERLAY_OPEN_READ,
+	          error );
+#else
+	result = libbfoverlay_handle_open(
+	          compact_handle->input_handle,
+	          filename,
+	          LIBBFOVERLAY_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_handle_open_data_files(
+	     compact_handle->input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open data files.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( compact_handle->input_handle != NULL )
+	{
+		libbfoverlay_handle_free(
+		 &( compact_handle->input_handle ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes the compaction handle
+ * Returns the 0 if successful or -1 on error
+ */
+int compact_handle_close(
+     compact_handle_t *compact_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "compact_handle_close";
+	int result            = 0;
+
+	if( compact_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compaction handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( compact_handle->input_handle != NULL )
+	{
+		if( libbfoverlay_handle_close(
+		     compact_handle->input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close input handle.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfoverlay_handle_free(
+		     &( compact_handle->input_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Writes a compacted copy of the COW file
+ * Returns 1 if successful or -1 on error
+ */
+int compact_handle_write_compacted_cow_file(
+     compact_handle_t *compact_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "compact_handle_write_compacted_cow_file";
+	int result            = 0;
+
+	if( compact_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compaction handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( compact_handle->input_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid compaction handle - missing input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfoverlay_handle_write_compacted_cow_file_wide(
+	          compact_handle->input_handle,
+	          filename,
+	          error );
+#else
+	result = libbfoverlay_handle_write_compacted_cow_file(
+	          compact_handle->input_handle,
+	          filename,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write compacted COW file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,84 @@
+/*
+ * Compaction handle
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _COMPACT_HANDLE_H )
+#define _COMPACT_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "bfoverlaytools_libbfoverlay.h"
+#include "bfoverlaytools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct compact_handle compact_handle_t;
+
+struct compact_handle
+{
+	/* The input handle
+	 */
+	libbfoverlay_handle_t *input_handle;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int compact_handle_initialize(
+     compact_handle_t **compact_handle,
+     libcerror_error_t **error );
+
+int compact_handle_free(
+     compact_handle_t **compact_handle,
+     libcerror_error_t **error );
+
+int compact_handle_signal_abort(
+     compact_handle_t *compact_handle,
+     libcerror_error_t **error );
+
+int compact_handle_open(
+     compact_handle_t *compact_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int compact_handle_close(
+     compact_handle_t *compact_handle,
+     libcerror_error_t **error );
+
+int compact_handle_write_compacted_cow_file(
+     compact_handle_t *compact_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _COMPACT_HANDLE_H ) */
+
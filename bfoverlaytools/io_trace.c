@@ -0,0 +1,460 @@
+/*
+ * IO trace functions
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "bfoverlay_io_trace.h"
+#include "bfoverlaytools_libcerror.h"
+#include "io_trace.h"
+
+/* Retrieves a string representation of an IO trace operation
+ * Returns the string or "unknown" if not available
+ */
+const char *io_trace_get_operation_string(
+             uint8_t operation )
+{
+	switch( operation )
+	{
+		case IO_TRACE_OPERATION_READ:
+			return( "read" );
+
+		case IO_TRACE_OPERATION_WRITE:
+			return( "write" );
+
+		case IO_TRACE_OPERATION_RESIZE:
+			return( "resize" );
+
+		case IO_TRACE_OPERATION_DISCARD:
+			return( "discard" );
+
+		case IO_TRACE_OPERATION_WRITE_ZEROES:
+			return( "write zeroes" );
+
+		default:
+			break;
+	}
+	return( "unknown" );
+}
+
+/* Writes the IO trace file header
+ * Returns 1 if successful or -1 on error
+ */
+int io_trace_write_file_header(
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	uint8_t file_header_data[ sizeof( bfoverlay_io_trace_file_header_t ) ];
+
+	static char *function = "io_trace_write_file_header";
+	ssize_t write_count   = 0;
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     file_header_data,
+	     "BFO-IOTR",
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy IO trace file signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 ( (bfoverlay_io_trace_file_header_t *) file_header_data )->format_version,
+	 IO_TRACE_FORMAT_VERSION );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 ( (bfoverlay_io_trace_file_header_t *) file_header_data )->record_size,
+	 sizeof( bfoverlay_io_trace_record_t ) );
+
+	write_count = file_stream_write(
+	               stream,
+	               file_header_data,
+	               sizeof( bfoverlay_io_trace_file_header_t ) );
+
+	if( write_count != (ssize_t) sizeof( bfoverlay_io_trace_file_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write IO trace file header.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the IO trace file header
+ * Returns 1 if successful or -1 on error
+ */
+int io_trace_read_file_header(
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	uint8_t file_header_data[ sizeof( bfoverlay_io_trace_file_header_t ) ];
+
+	static char *function   = "io_trace_read_file_header";
+	ssize_t read_count      = 0;
+	uint32_t format_version = 0;
+	uint32_t record_size    = 0;
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = file_stream_read(
+	              stream,
+	              file_header_data,
+	              sizeof( bfoverlay_io_trace_file_header_t ) );
+
+	if( read_count != (ssize_t) sizeof( bfoverlay_io_trace_file_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read IO trace file header.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     ( (bfoverlay_io_trace_file_header_t *) file_header_data )->signature,
+	     "BFO-IOTR",
+	     8 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 ( (bfoverlay_io_trace_file_header_t *) file_header_data )->format_version,
+	 format_version );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 ( (bfoverlay_io_trace_file_header_t *) file_header_data )->record_size,
+	 record_size );
+
+	if( format_version != IO_TRACE_FORMAT_VERSION )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version: %" PRIu32 ".",
+		 function,
+		 format_version );
+
+		return( -1 );
+	}
+	if( record_size != (uint32_t) sizeof( bfoverlay_io_trace_record_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported record size: %" PRIu32 ".",
+		 function,
+		 record_size );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes an IO trace record to data
+ * Returns 1 if successful or -1 on error
+ */
+int io_trace_record_write_data(
+     const io_trace_record_t *io_trace_record,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "io_trace_record_write_data";
+
+	if( io_trace_record == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO trace record.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( bfoverlay_io_trace_record_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     sizeof( bfoverlay_io_trace_record_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 ( (bfoverlay_io_trace_record_t *) data )->timestamp,
+	 io_trace_record->timestamp );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 ( (bfoverlay_io_trace_record_t *) data )->offset,
+	 (uint64_t) io_trace_record->offset );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 ( (bfoverlay_io_trace_record_t *) data )->size,
+	 io_trace_record->size );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 ( (bfoverlay_io_trace_record_t *) data )->result,
+	 (uint64_t) io_trace_record->result );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 ( (bfoverlay_io_trace_record_t *) data )->latency,
+	 io_trace_record->latency );
+
+	( (bfoverlay_io_trace_record_t *) data )->operation = io_trace_record->operation;
+
+	return( 1 );
+}
+
+/* Reads an IO trace record from data
+ * Returns 1 if successful or -1 on error
+ */
+int io_trace_record_read_data(
+     io_trace_record_t *io_trace_record,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "io_trace_record_read_data";
+	uint64_t value_64bit  = 0;
+
+	if( io_trace_record == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO trace record.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( bfoverlay_io_trace_record_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint64_big_endian(
+	 ( (bfoverlay_io_trace_record_t *) data )->timestamp,
+	 io_trace_record->timestamp );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 ( (bfoverlay_io_trace_record_t *) data )->offset,
+	 value_64bit );
+
+	io_trace_record->offset = (off64_t) value_64bit;
+
+	byte_stream_copy_to_uint64_big_endian(
+	 ( (bfoverlay_io_trace_record_t *) data )->size,
+	 io_trace_record->size );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 ( (bfoverlay_io_trace_record_t *) data )->result,
+	 value_64bit );
+
+	io_trace_record->result = (int64_t) value_64bit;
+
+	byte_stream_copy_to_uint64_big_endian(
+	 ( (bfoverlay_io_trace_record_t *) data )->latency,
+	 io_trace_record->latency );
+
+	io_trace_record->operation = ( (bfoverlay_io_trace_record_t *) data )->operation;
+
+	return( 1 );
+}
+
+/* Reads an IO trace record from a file stream
+ * Returns 1 if successful, 0 if no more records are available or -1 on error
+ */
+int io_trace_record_read_file_stream(
+     io_trace_record_t *io_trace_record,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	uint8_t record_data[ sizeof( bfoverlay_io_trace_record_t ) ];
+
+	static char *function = "io_trace_record_read_file_stream";
+	ssize_t read_count    = 0;
+
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = file_stream_read(
+	              stream,
+	              record_data,
+	              sizeof( bfoverlay_io_trace_record_t ) );
+
+	/* A trace that was not closed cleanly can end with a partial record
+	 */
+	if( read_count != (ssize_t) sizeof( bfoverlay_io_trace_record_t ) )
+	{
+		if( file_stream_at_end(
+		     stream ) != 0 )
+		{
+			return( 0 );
+		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read IO trace record.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_trace_record_read_data(
+	     io_trace_record,
+	     record_data,
+	     sizeof( bfoverlay_io_trace_record_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read IO trace record data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+
+/* Compares the timestamps of two IO trace records
+ * This function is used as a qsort compare function
+ * Returns -1 if the first timestamp is smaller, 1 if larger or 0 if equal
+ */
+int io_trace_record_compare_timestamps(
+     const void *first_io_trace_record,
+     const void *second_io_trace_record )
+{
+	uint64_t first_timestamp  = ( (const io_trace_record_t *) first_io_trace_record )->timestamp;
+	uint64_t second_timestamp = ( (const io_trace_record_t *) second_io_trace_record )->timestamp;
+
+	if( first_timestamp < second_timestamp )
+	{
+		return( -1 );
+	}
+	else if( first_timestamp > second_timestamp )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
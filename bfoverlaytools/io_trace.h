@@ -0,0 +1,120 @@
+/*
+ * IO trace functions
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _IO_TRACE_H )
+#define _IO_TRACE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "bfoverlay_io_trace.h"
+#include "bfoverlaytools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define IO_TRACE_FORMAT_VERSION			1
+
+enum IO_TRACE_FORMATS
+{
+	IO_TRACE_FORMAT_BINARY			= (int) 'b',
+	IO_TRACE_FORMAT_TEXT			= (int) 't'
+};
+
+enum IO_TRACE_OPERATIONS
+{
+	IO_TRACE_OPERATION_READ			= 1,
+	IO_TRACE_OPERATION_WRITE		= 2,
+	IO_TRACE_OPERATION_RESIZE		= 3,
+	IO_TRACE_OPERATION_DISCARD		= 4,
+	IO_TRACE_OPERATION_WRITE_ZEROES		= 5
+};
+
+typedef struct io_trace_record io_trace_record_t;
+
+struct io_trace_record
+{
+	/* The timestamp in nanoseconds since the start of the trace
+	 */
+	uint64_t timestamp;
+
+	/* The offset
+	 * For a resize operation this contains the new size
+	 */
+	off64_t offset;
+
+	/* The request size
+	 */
+	size64_t size;
+
+	/* The result, which contains the number of bytes read or written or -1 on error
+	 */
+	int64_t result;
+
+	/* The latency in nanoseconds
+	 */
+	uint64_t latency;
+
+	/* The operation
+	 */
+	uint8_t operation;
+};
+
+const char *io_trace_get_operation_string(
+             uint8_t operation );
+
+int io_trace_write_file_header(
+     FILE *stream,
+     libcerror_error_t **error );
+
+int io_trace_read_file_header(
+     FILE *stream,
+     libcerror_error_t **error );
+
+int io_trace_record_write_data(
+     const io_trace_record_t *io_trace_record,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int io_trace_record_read_data(
+     io_trace_record_t *io_trace_record,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int io_trace_record_read_file_stream(
+     io_trace_record_t *io_trace_record,
+     FILE *stream,
+     libcerror_error_t **error );
+
+int io_trace_record_compare_timestamps(
+     const void *first_io_trace_record,
+     const void *second_io_trace_record );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _IO_TRACE_H ) */
+
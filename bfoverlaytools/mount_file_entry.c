@@ -32,6 +32,7 @@
 
 #include "bfoverlaytools_libbfoverlay.h"
 #include "bfoverlaytools_libcerror.h"
+#include "io_trace.h"
 #include "mount_file_entry.h"
 #include "mount_file_system.h"
 
@@ -844,8 +845,9 @@ ssize_t mount_file_entry_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error )
 {
-	static char *function = "mount_file_entry_read_buffer_at_offset";
-	ssize_t read_count    = 0;
+	static char *function    = "mount_file_entry_read_buffer_at_offset";
+	uint64_t start_timestamp = 0;
+	ssize_t read_count       = 0;
 
 	if( file_entry == NULL )
 	{
@@ -858,6 +860,11 @@ ssize_t mount_file_entry_read_buffer_at_offset(
 
 		return( -1 );
 	}
+	mount_file_system_get_io_trace_timestamp(
+	 file_entry->file_system,
+	 &start_timestamp,
+	 NULL );
+
 	read_count = libbfoverlay_handle_read_buffer_at_offset(
 	              file_entry->bfoverlay_handle,
 	              buffer,
@@ -865,6 +872,16 @@ ssize_t mount_file_entry_read_buffer_at_offset(
 	              offset,
 	              error );
 
+	mount_file_system_write_io_trace(
+	 file_entry->file_system,
+	 IO_TRACE_OPERATION_READ,
+	 offset,
+	 buffer_size,
+	 buffer,
+	 (int64_t) read_count,
+	 start_timestamp,
+	 NULL );
+
 	if( read_count < 0 )
 	{
 		libcerror_error_set(
@@ -878,15 +895,6 @@ ssize_t mount_file_entry_read_buffer_at_offset(
 
 		return( -1 );
 	}
-	mount_file_system_write_io_trace(
-	 file_entry->file_system,
-	 "read",
-	 offset,
-	 buffer_size,
-	 buffer,
-	 (size_t) read_count,
-	 NULL );
-
 	return( read_count );
 }
 
@@ -900,8 +908,9 @@ ssize_t mount_file_entry_write_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error )
 {
-	static char *function = "mount_file_entry_write_buffer_at_offset";
-	ssize_t write_count   = 0;
+	static char *function    = "mount_file_entry_write_buffer_at_offset";
+	uint64_t start_timestamp = 0;
+	ssize_t write_count      = 0;
 
 	if( file_entry == NULL )
 	{
@@ -914,6 +923,11 @@ ssize_t mount_file_entry_write_buffer_at_offset(
 
 		return( -1 );
 	}
+	mount_file_system_get_io_trace_timestamp(
+	 file_entry->file_system,
+	 &start_timestamp,
+	 NULL );
+
 	write_count = libbfoverlay_handle_write_buffer_at_offset(
 	               file_entry->bfoverlay_handle,
 	               buffer,
@@ -921,6 +935,16 @@ ssize_t mount_file_entry_write_buffer_at_offset(
 	               offset,
 	               error );
 
+	mount_file_system_write_io_trace(
+	 file_entry->file_system,
+	 IO_TRACE_OPERATION_WRITE,
+	 offset,
+	 buffer_size,
+	 buffer,
+	 (int64_t) write_count,
+	 start_timestamp,
+	 NULL );
+
 	if( write_count < 0 )
 	{
 		libcerror_error_set(
@@ -934,18 +958,51 @@ ssize_t mount_file_entry_write_buffer_at_offset(
 
 		return( -1 );
 	}
-	mount_file_system_write_io_trace(
-	 file_entry->file_system,
-	 "write",
-	 offset,
-	 buffer_size,
-	 buffer,
-	 (size_t) write_count,
-	 NULL );
-
 	return( write_count );
 }
 
+/* Seeks a specific offset
+ * Returns the offset if successful or -1 on error
+ */
+off64_t mount_file_entry_seek_offset(
+         mount_file_entry_t *file_entry,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "mount_file_entry_seek_offset";
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	offset = libbfoverlay_handle_seek_offset(
+	          file_entry->bfoverlay_handle,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset in handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( offset );
+}
+
 /* Resizes a file entry
  * Returns 1 if successful or -1 on error
  */
@@ -954,7 +1011,9 @@ int mount_file_entry_resize(
      size64_t size,
      libcerror_error_t **error )
 {
-	static char *function = "mount_file_entry_resize";
+	static char *function    = "mount_file_entry_resize";
+	uint64_t start_timestamp = 0;
+	int result               = 0;
 
 	if( file_entry == NULL )
 	{
@@ -967,10 +1026,27 @@ int mount_file_entry_resize(
 
 		return( -1 );
 	}
-	if( libbfoverlay_handle_resize(
-	     file_entry->bfoverlay_handle,
-	     size,
-	     error ) != 1 )
+	mount_file_system_get_io_trace_timestamp(
+	 file_entry->file_system,
+	 &start_timestamp,
+	 NULL );
+
+	result = libbfoverlay_handle_resize(
+	          file_entry->bfoverlay_handle,
+	          size,
+	          error );
+
+	mount_file_system_write_io_trace(
+	 file_entry->file_system,
+	 IO_TRACE_OPERATION_RESIZE,
+	 (off64_t) size,
+	 0,
+	 NULL,
+	 ( result == 1 ) ? 0 : -1,
+	 start_timestamp,
+	 NULL );
+
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -981,15 +1057,65 @@ int mount_file_entry_resize(
 
 		return( -1 );
 	}
+	return( 1 );
+}
+
+/* Writes zero bytes within a specific range of a file entry
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_entry_write_zeroes(
+     mount_file_entry_t *file_entry,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	static char *function    = "mount_file_entry_write_zeroes";
+	uint64_t start_timestamp = 0;
+	int result               = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	mount_file_system_get_io_trace_timestamp(
+	 file_entry->file_system,
+	 &start_timestamp,
+	 NULL );
+
+	result = libbfoverlay_handle_write_zeroes(
+	          file_entry->bfoverlay_handle,
+	          offset,
+	          size,
+	          error );
+
 	mount_file_system_write_io_trace(
 	 file_entry->file_system,
-	 "resize",
-	 size,
-	 0,
+	 IO_TRACE_OPERATION_WRITE_ZEROES,
+	 offset,
+	 (size_t) size,
 	 NULL,
-	 0,
+	 ( result == 1 ) ? 0 : -1,
+	 start_timestamp,
 	 NULL );
 
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write zeroes to handle.",
+		 function );
+
+		return( -1 );
+	}
 	return( 1 );
 }
 
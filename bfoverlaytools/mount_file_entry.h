@@ -132,11 +132,23 @@ ssize_t mount_file_entry_write_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+off64_t mount_file_entry_seek_offset(
+         mount_file_entry_t *file_entry,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
 int mount_file_entry_resize(
      mount_file_entry_t *file_entry,
      size64_t size,
      libcerror_error_t **error );
 
+int mount_file_entry_write_zeroes(
+     mount_file_entry_t *file_entry,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
 int mount_file_entry_get_size(
      mount_file_entry_t *file_entry,
      size64_t *size,
@@ -40,6 +40,9 @@
 #include "bfoverlaytools_libbfoverlay.h"
 #include "bfoverlaytools_libcdata.h"
 #include "bfoverlaytools_libcerror.h"
+#include "bfoverlaytools_libcthreads.h"
+#include "bfoverlaytools_timestamp.h"
+#include "io_trace.h"
 #include "mount_file_system.h"
 
 /* Creates a file system
@@ -135,6 +138,36 @@ int mount_file_system_initialize(
 
 		goto on_error;
 	}
+	( *file_system )->io_trace_format = IO_TRACE_FORMAT_TEXT;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *file_system )->io_trace_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize IO trace mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *file_system )->io_trace_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize IO trace condition.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 #if defined( WINAPI )
 	if( memory_set(
 	     &systemtime,
@@ -214,6 +247,27 @@ int mount_file_system_initialize(
 on_error:
 	if( *file_system != NULL )
 	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *file_system )->io_trace_condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *file_system )->io_trace_condition ),
+			 NULL );
+		}
+		if( ( *file_system )->io_trace_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *file_system )->io_trace_mutex ),
+			 NULL );
+		}
+#endif
+		if( ( *file_system )->handles_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *file_system )->handles_array ),
+			 NULL,
+			 NULL );
+		}
 		memory_free(
 		 *file_system );
 
@@ -269,22 +323,47 @@ int mount_file_system_free(
 
 			result = -1;
 		}
-		if( ( *file_system )->io_trace_file_stream != NULL )
+		if( mount_file_system_close_io_trace(
+		     *file_system,
+		     error ) != 1 )
 		{
-			if( file_stream_close(
-			     ( *file_system )->io_trace_file_stream ) != 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-				 "%s: unable to close IO trace file stream.",
-				 function );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close IO trace.",
+			 function );
 
-				result = -1;
-			}
-			( *file_system )->io_trace_file_stream = NULL;
+			result = -1;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_condition_free(
+		     &( ( *file_system )->io_trace_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free IO trace condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *file_system )->io_trace_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free IO trace mutex.",
+			 function );
+
+			result = -1;
 		}
+#endif
 		memory_free(
 		 *file_system );
 
@@ -368,6 +447,56 @@ int mount_file_system_signal_abort(
 	return( 1 );
 }
 
+/* Sets the IO trace format
+ * The format must be set before the IO trace file
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_set_io_trace_format(
+     mount_file_system_t *file_system,
+     int io_trace_format,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_set_io_trace_format";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system->io_trace_file_stream != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file system - IO trace file stream value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_trace_format != IO_TRACE_FORMAT_BINARY )
+	 && ( io_trace_format != IO_TRACE_FORMAT_TEXT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported IO trace format.",
+		 function );
+
+		return( -1 );
+	}
+	file_system->io_trace_format = io_trace_format;
+
+	return( 1 );
+}
+
 /* Sets the IO trace file
  * Returns 1 if successful or -1 on error
  */
@@ -431,7 +560,91 @@ int mount_file_system_set_io_trace_file(
 
 		return( -1 );
 	}
+	if( file_system->io_trace_format == IO_TRACE_FORMAT_BINARY )
+	{
+		if( io_trace_write_file_header(
+		     file_system->io_trace_file_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write IO trace file header.",
+			 function );
+
+			goto on_error;
+		}
+		file_system->io_trace_buffer = (uint8_t *) memory_allocate(
+		                                            sizeof( uint8_t ) * MOUNT_FILE_SYSTEM_IO_TRACE_BUFFER_SIZE );
+
+		if( file_system->io_trace_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create IO trace buffer.",
+			 function );
+
+			goto on_error;
+		}
+		file_system->io_trace_buffer_offset    = 0;
+		file_system->io_trace_buffer_data_size = 0;
+
+		if( bfoverlaytools_timestamp_get(
+		     &( file_system->io_trace_start_timestamp ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve IO trace start timestamp.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* The buffered records are written by a separate thread so that
+		 * the IO operations do not wait for the IO trace file
+		 */
+		file_system->io_trace_writer_stop = 0;
+
+		if( libcthreads_thread_create(
+		     &( file_system->io_trace_writer_thread ),
+		     NULL,
+		     &mount_file_system_run_io_trace_writer,
+		     (void *) file_system,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create IO trace writer thread.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+	}
 	return( 1 );
+
+on_error:
+	if( file_system->io_trace_buffer != NULL )
+	{
+		memory_free(
+		 file_system->io_trace_buffer );
+
+		file_system->io_trace_buffer = NULL;
+	}
+	file_stream_close(
+	 file_system->io_trace_file_stream );
+
+	file_system->io_trace_file_stream = NULL;
+
+	return( -1 );
 }
 
 /* Sets the path prefix
@@ -1417,19 +1630,469 @@ int mount_file_system_print_data(
 	return( total_print_count );
 }
 
+/* Retrieves a timestamp to mark the start of an IO operation
+ * The timestamp is 0 if the IO trace does not record latencies
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_get_io_trace_timestamp(
+     mount_file_system_t *file_system,
+     uint64_t *timestamp,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_get_io_trace_timestamp";
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = 0;
+
+	if( file_system->io_trace_buffer != NULL )
+	{
+		if( bfoverlaytools_timestamp_get(
+		     timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve timestamp.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes a part of the IO trace buffer to the IO trace file
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_write_io_trace_buffer(
+     mount_file_system_t *file_system,
+     size_t buffer_offset,
+     size_t write_size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_write_io_trace_buffer";
+	ssize_t write_count   = 0;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system->io_trace_file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file system - missing IO trace file stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_system->io_trace_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file system - missing IO trace buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_offset > MOUNT_FILE_SYSTEM_IO_TRACE_BUFFER_SIZE )
+	 || ( write_size > ( MOUNT_FILE_SYSTEM_IO_TRACE_BUFFER_SIZE - buffer_offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid write size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = file_stream_write(
+	               file_system->io_trace_file_stream,
+	               &( file_system->io_trace_buffer[ buffer_offset ] ),
+	               write_size );
+
+	if( write_count != (ssize_t) write_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write IO trace records.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure the records are not lost if the mount is terminated
+	 */
+	if( file_stream_flush(
+	     file_system->io_trace_file_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush IO trace file stream.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Flushes the buffered IO trace records to the IO trace file
+ * The caller must hold the IO trace mutex if operations can be dispatched concurrently
+ * and make sure the IO trace writer is not running
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_flush_io_trace(
+     mount_file_system_t *file_system,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_flush_io_trace";
+	size_t write_size     = 0;
+	int result            = 1;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_system->io_trace_file_stream == NULL )
+	 || ( file_system->io_trace_buffer == NULL ) )
+	{
+		return( 1 );
+	}
+	while( file_system->io_trace_buffer_data_size > 0 )
+	{
+		/* The buffered records can wrap around the end of the ring buffer
+		 */
+		write_size = MOUNT_FILE_SYSTEM_IO_TRACE_BUFFER_SIZE - file_system->io_trace_buffer_offset;
+
+		if( write_size > file_system->io_trace_buffer_data_size )
+		{
+			write_size = file_system->io_trace_buffer_data_size;
+		}
+		/* Discard the buffered records on error so that tracing does not stall
+		 */
+		if( mount_file_system_write_io_trace_buffer(
+		     file_system,
+		     file_system->io_trace_buffer_offset,
+		     write_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write IO trace buffer.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		file_system->io_trace_buffer_offset     = ( file_system->io_trace_buffer_offset + write_size ) % MOUNT_FILE_SYSTEM_IO_TRACE_BUFFER_SIZE;
+		file_system->io_trace_buffer_data_size -= write_size;
+	}
+	file_system->io_trace_buffer_offset    = 0;
+	file_system->io_trace_buffer_data_size = 0;
+
+	return( result );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Writes the buffered IO trace records until the IO trace writer is stopped
+ * This function is used as the IO trace writer thread callback function
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_run_io_trace_writer(
+     void *arguments )
+{
+	mount_file_system_t *file_system = NULL;
+	libcerror_error_t *error         = NULL;
+	size_t buffer_offset             = 0;
+	size_t write_size                = 0;
+
+	if( arguments == NULL )
+	{
+		return( -1 );
+	}
+	file_system = (mount_file_system_t *) arguments;
+
+	if( libcthreads_mutex_grab(
+	     file_system->io_trace_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	while( 1 )
+	{
+		while( ( file_system->io_trace_buffer_data_size == 0 )
+		    && ( file_system->io_trace_writer_stop == 0 ) )
+		{
+			if( libcthreads_condition_wait(
+			     file_system->io_trace_condition,
+			     file_system->io_trace_mutex,
+			     NULL ) != 1 )
+			{
+				libcthreads_mutex_release(
+				 file_system->io_trace_mutex,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+		/* The remaining records are written before the IO trace writer stops
+		 */
+		if( file_system->io_trace_buffer_data_size == 0 )
+		{
+			break;
+		}
+		buffer_offset = file_system->io_trace_buffer_offset;
+		write_size    = MOUNT_FILE_SYSTEM_IO_TRACE_BUFFER_SIZE - buffer_offset;
+
+		if( write_size > file_system->io_trace_buffer_data_size )
+		{
+			write_size = file_system->io_trace_buffer_data_size;
+		}
+		/* The records are written without holding the mutex, the IO operations
+		 * only add records to the part of the ring buffer that is not being written
+		 */
+		if( libcthreads_mutex_release(
+		     file_system->io_trace_mutex,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+		/* Discard the records on error so that tracing does not stall
+		 */
+		if( mount_file_system_write_io_trace_buffer(
+		     file_system,
+		     buffer_offset,
+		     write_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_free(
+			 &error );
+		}
+		if( libcthreads_mutex_grab(
+		     file_system->io_trace_mutex,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+		file_system->io_trace_buffer_offset     = ( buffer_offset + write_size ) % MOUNT_FILE_SYSTEM_IO_TRACE_BUFFER_SIZE;
+		file_system->io_trace_buffer_data_size -= write_size;
+
+		if( libcthreads_condition_broadcast(
+		     file_system->io_trace_condition,
+		     NULL ) != 1 )
+		{
+			libcthreads_mutex_release(
+			 file_system->io_trace_mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     file_system->io_trace_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Closes the IO trace
+ * The buffered IO trace records are written before the IO trace file is closed
+ * Returns 1 if successful or -1 on error
+ */
+int mount_file_system_close_io_trace(
+     mount_file_system_t *file_system,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_system_close_io_trace";
+	int result            = 1;
+
+	if( file_system == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file system.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( file_system->io_trace_writer_thread != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     file_system->io_trace_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab IO trace mutex.",
+			 function );
+
+			return( -1 );
+		}
+		file_system->io_trace_writer_stop = 1;
+
+		if( libcthreads_condition_broadcast(
+		     file_system->io_trace_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast IO trace condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_release(
+		     file_system->io_trace_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release IO trace mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( result != 1 )
+		{
+			return( -1 );
+		}
+		if( libcthreads_thread_join(
+		     &( file_system->io_trace_writer_thread ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join IO trace writer thread.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	if( file_system->io_trace_buffer != NULL )
+	{
+		if( mount_file_system_flush_io_trace(
+		     file_system,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush IO trace.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 file_system->io_trace_buffer );
+
+		file_system->io_trace_buffer = NULL;
+	}
+	if( file_system->io_trace_file_stream != NULL )
+	{
+		if( file_stream_close(
+		     file_system->io_trace_file_stream ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close IO trace file stream.",
+			 function );
+
+			result = -1;
+		}
+		file_system->io_trace_file_stream = NULL;
+	}
+	return( result );
+}
+
 /* Write an IO operation to the IO trace file
+ * The start timestamp should be retrieved with mount_file_system_get_io_trace_timestamp
+ * The result contains the number of bytes read or written, 0 for a resize or -1 on error
  * Returns 1 if successful or -1 on error
  */
 int mount_file_system_write_io_trace(
      mount_file_system_t *file_system,
-     const char *operation,
+     uint8_t operation,
      off64_t offset,
      size_t size,
      const uint8_t *data,
-     size_t data_size,
+     int64_t result,
+     uint64_t start_timestamp,
      libcerror_error_t **error )
 {
-	static char *function = "mount_file_system_write_io_trace";
+	io_trace_record_t io_trace_record;
+
+	static char *function  = "mount_file_system_write_io_trace";
+	uint64_t end_timestamp = 0;
+	size_t buffer_offset   = 0;
+	int flush_result       = 1;
 
 	if( file_system == NULL )
 	{
@@ -1442,26 +2105,187 @@ int mount_file_system_write_io_trace(
 
 		return( -1 );
 	}
-	if( file_system->io_trace_file_stream != NULL )
+	if( file_system->io_trace_file_stream == NULL )
+	{
+		return( 1 );
+	}
+	if( file_system->io_trace_buffer != NULL )
+	{
+		if( bfoverlaytools_timestamp_get(
+		     &end_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve end timestamp.",
+			 function );
+
+			return( -1 );
+		}
+		if( start_timestamp < file_system->io_trace_start_timestamp )
+		{
+			start_timestamp = file_system->io_trace_start_timestamp;
+		}
+		if( end_timestamp < start_timestamp )
+		{
+			end_timestamp = start_timestamp;
+		}
+		io_trace_record.timestamp = start_timestamp - file_system->io_trace_start_timestamp;
+		io_trace_record.offset    = offset;
+		io_trace_record.size      = (size64_t) size;
+		io_trace_record.result    = result;
+		io_trace_record.latency   = end_timestamp - start_timestamp;
+		io_trace_record.operation = operation;
+	}
+	else if( result < 0 )
+	{
+		return( 1 );
+	}
+	/* The IO operations can be dispatched concurrently, make sure
+	 * the trace output of an operation is not interleaved with another
+	 */
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     file_system->io_trace_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab IO trace mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( file_system->io_trace_buffer != NULL )
+	{
+		/* The records are added to the ring buffer and written to the IO trace file
+		 * by the IO trace writer, an IO operation only waits if the ring buffer is full
+		 */
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		while( ( file_system->io_trace_writer_thread != NULL )
+		    && ( ( file_system->io_trace_buffer_data_size + sizeof( bfoverlay_io_trace_record_t ) ) > MOUNT_FILE_SYSTEM_IO_TRACE_BUFFER_SIZE ) )
+		{
+			if( libcthreads_condition_wait(
+			     file_system->io_trace_condition,
+			     file_system->io_trace_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for IO trace condition.",
+				 function );
+
+				flush_result = -1;
+
+				break;
+			}
+		}
+#endif
+		/* Without an IO trace writer the records are written when the ring buffer is full
+		 */
+		if( ( flush_result == 1 )
+		 && ( ( file_system->io_trace_buffer_data_size + sizeof( bfoverlay_io_trace_record_t ) ) > MOUNT_FILE_SYSTEM_IO_TRACE_BUFFER_SIZE ) )
+		{
+			flush_result = mount_file_system_flush_io_trace(
+			                file_system,
+			                error );
+
+			if( flush_result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to flush IO trace.",
+				 function );
+			}
+		}
+		/* The ring buffer size is a multiple of the record size, hence a record
+		 * does not wrap around the end of the ring buffer
+		 */
+		buffer_offset = ( file_system->io_trace_buffer_offset + file_system->io_trace_buffer_data_size ) % MOUNT_FILE_SYSTEM_IO_TRACE_BUFFER_SIZE;
+
+		/* The record is discarded if the ring buffer is still full
+		 */
+		if( ( ( file_system->io_trace_buffer_data_size + sizeof( bfoverlay_io_trace_record_t ) ) <= MOUNT_FILE_SYSTEM_IO_TRACE_BUFFER_SIZE )
+		 && ( io_trace_record_write_data(
+		      &io_trace_record,
+		      &( file_system->io_trace_buffer[ buffer_offset ] ),
+		      MOUNT_FILE_SYSTEM_IO_TRACE_BUFFER_SIZE - buffer_offset,
+		      NULL ) == 1 ) )
+		{
+			file_system->io_trace_buffer_data_size += sizeof( bfoverlay_io_trace_record_t );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			/* The IO trace writer only waits if the ring buffer was empty
+			 */
+			if( ( file_system->io_trace_writer_thread != NULL )
+			 && ( file_system->io_trace_buffer_data_size == sizeof( bfoverlay_io_trace_record_t ) ) )
+			{
+				if( libcthreads_condition_broadcast(
+				     file_system->io_trace_condition,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to broadcast IO trace condition.",
+					 function );
+
+					flush_result = -1;
+				}
+			}
+#endif
+		}
+	}
+	else
 	{
 		fprintf(
 		 file_system->io_trace_file_stream,
-		 "operation: %s at offset: %" PRIi64 " (0x%08" PRIx64 ") with request size: %" PRIzd " and result size: %" PRIzd "\n\n",
-		 operation,
+		 "operation: %s at offset: %" PRIi64 " (0x%08" PRIx64 ") with request size: %" PRIzd " and result size: %" PRIi64 "\n\n",
+		 io_trace_get_operation_string(
+		  operation ),
 		 offset,
 		 offset,
 		 size,
-		 data_size );
+		 result );
 
 		if( ( data != NULL )
-		 && ( data_size > 0 ) )
+		 && ( result > 0 ) )
 		{
 			mount_file_system_print_data(
 			 file_system->io_trace_file_stream,
 			 data,
-			 data_size );
+			 (size_t) result );
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     file_system->io_trace_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release IO trace mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( flush_result != 1 )
+	{
+		return( -1 );
+	}
 	return( 1 );
 }
 
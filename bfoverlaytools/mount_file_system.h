@@ -27,11 +27,17 @@
 
 #include "bfoverlaytools_libcdata.h"
 #include "bfoverlaytools_libcerror.h"
+#include "bfoverlaytools_libcthreads.h"
+#include "io_trace.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The size of the IO trace ring buffer, which holds 1024 binary IO trace records
+ */
+#define MOUNT_FILE_SYSTEM_IO_TRACE_BUFFER_SIZE	( 1024 * sizeof( bfoverlay_io_trace_record_t ) )
+
 typedef struct mount_file_system mount_file_system_t;
 
 struct mount_file_system
@@ -63,6 +69,45 @@ struct mount_file_system
 	/* The IO trace file stream
 	 */
 	FILE *io_trace_file_stream;
+
+	/* The IO trace format
+	 */
+	int io_trace_format;
+
+	/* The IO trace start timestamp
+	 */
+	uint64_t io_trace_start_timestamp;
+
+	/* The IO trace buffer, which is used as a ring buffer of binary IO trace records
+	 */
+	uint8_t *io_trace_buffer;
+
+	/* The offset of the first IO trace record in the IO trace buffer that has not been written
+	 */
+	size_t io_trace_buffer_offset;
+
+	/* The size of the IO trace records in the IO trace buffer that have not been written
+	 */
+	size_t io_trace_buffer_data_size;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The IO trace mutex
+	 */
+	libcthreads_mutex_t *io_trace_mutex;
+
+	/* The IO trace condition, which signals the IO trace writer that records were added
+	 * and the IO operations that records were written
+	 */
+	libcthreads_condition_t *io_trace_condition;
+
+	/* The IO trace writer thread, which writes the buffered IO trace records
+	 */
+	libcthreads_thread_t *io_trace_writer_thread;
+
+	/* Value to indicate the IO trace writer should stop
+	 */
+	uint8_t io_trace_writer_stop;
+#endif
 };
 
 int mount_file_system_initialize(
@@ -77,6 +122,11 @@ int mount_file_system_signal_abort(
      mount_file_system_t *file_system,
      libcerror_error_t **error );
 
+int mount_file_system_set_io_trace_format(
+     mount_file_system_t *file_system,
+     int io_trace_format,
+     libcerror_error_t **error );
+
 int mount_file_system_set_io_trace_file(
      mount_file_system_t *file_system,
      const system_character_t *filename,
@@ -150,13 +200,40 @@ int mount_file_system_print_data(
      const uint8_t *data,
      size_t data_size );
 
+int mount_file_system_get_io_trace_timestamp(
+     mount_file_system_t *file_system,
+     uint64_t *timestamp,
+     libcerror_error_t **error );
+
+int mount_file_system_write_io_trace_buffer(
+     mount_file_system_t *file_system,
+     size_t buffer_offset,
+     size_t write_size,
+     libcerror_error_t **error );
+
+int mount_file_system_flush_io_trace(
+     mount_file_system_t *file_system,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int mount_file_system_run_io_trace_writer(
+     void *arguments );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+int mount_file_system_close_io_trace(
+     mount_file_system_t *file_system,
+     libcerror_error_t **error );
+
 int mount_file_system_write_io_trace(
      mount_file_system_t *file_system,
-     const char *operation,
+     uint8_t operation,
      off64_t offset,
      size_t size,
      const uint8_t *data,
-     size_t data_size,
+     int64_t result,
+     uint64_t start_timestamp,
      libcerror_error_t **error );
 
 #if defined( __cplusplus )
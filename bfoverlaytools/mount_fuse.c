@@ -709,6 +709,321 @@ on_error:
 	return( result );
 }
 
+#if defined( HAVE_MOUNT_FUSE_LSEEK )
+
+/* Seeks the next data or hole at or after a specific offset
+ * Returns the offset if successful or a negative errno value otherwise
+ */
+off_t mount_fuse_lseek(
+       const char *path,
+       off_t offset,
+       int whence,
+       struct fuse_file_info *file_info )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "mount_fuse_lseek";
+	size64_t size            = 0;
+	off64_t seek_offset      = 0;
+	off_t result             = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: %s\n",
+		 function,
+		 path );
+	}
+#endif
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( whence == SEEK_DATA )
+	{
+		whence = LIBBFOVERLAY_SEEK_DATA;
+	}
+	else if( whence == SEEK_HOLE )
+	{
+		whence = LIBBFOVERLAY_SEEK_HOLE;
+	}
+	else
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file information.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info->fh == (uint64_t) NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file information - missing file handle.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( mount_file_entry_get_size(
+	     (mount_file_entry_t *) file_info->fh,
+	     &size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file entry size.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	/* There is no data or hole at or after the end of the data
+	 */
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= size ) )
+	{
+		return( -ENXIO );
+	}
+	seek_offset = mount_file_entry_seek_offset(
+	               (mount_file_entry_t *) file_info->fh,
+	               (off64_t) offset,
+	               whence,
+	               &error );
+
+	if( seek_offset == -1 )
+	{
+		/* The offset is in a hole at the end of the data
+		 */
+		if( ( whence == LIBBFOVERLAY_SEEK_DATA )
+		 && ( libcerror_error_matches(
+		       error,
+		       LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		       LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS ) != 0 ) )
+		{
+			libcerror_error_free(
+			 &error );
+
+			return( -ENXIO );
+		}
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset in file entry.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	return( (off_t) seek_offset );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MOUNT_FUSE_LSEEK ) */
+
+#if defined( HAVE_MOUNT_FUSE_FALLOCATE )
+
+/* Manipulates the allocated space of a file entry
+ * Only punching holes and zeroing ranges are supported
+ * Both write zeroes to the range, the COW blocks that are fully contained in the range
+ * are marked as zero blocks so that the range reads as zeroes
+ * Returns 0 if successful or a negative errno value otherwise
+ */
+int mount_fuse_fallocate(
+     const char *path,
+     int mode,
+     off_t offset,
+     off_t length,
+     struct fuse_file_info *file_info )
+{
+	libcerror_error_t *error       = NULL;
+	mount_file_entry_t *file_entry = NULL;
+	static char *function          = "mount_fuse_fallocate";
+	size64_t file_size             = 0;
+	size64_t size                  = 0;
+	int result                     = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: %s\n",
+		 function,
+		 path );
+	}
+#endif
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	/* Punching a hole requires the size to be kept, zeroing a range optionally keeps the size
+	 */
+	if( ( mode != ( FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE ) )
+	 && ( ( mode & ~FALLOC_FL_KEEP_SIZE ) != FALLOC_FL_ZERO_RANGE ) )
+	{
+		return( -EOPNOTSUPP );
+	}
+	if( ( offset < 0 )
+	 || ( length <= 0 ) )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset or length value out of bounds.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file information.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info->fh == (uint64_t) NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file information - missing file handle.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	file_entry = (mount_file_entry_t *) file_info->fh;
+
+	size = (size64_t) length;
+
+	/* Punching a hole or zeroing a range with the size kept does not extend the file entry
+	 */
+	if( ( mode & FALLOC_FL_KEEP_SIZE ) != 0 )
+	{
+		if( mount_file_entry_get_size(
+		     file_entry,
+		     &file_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file entry size.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		if( (size64_t) offset >= file_size )
+		{
+			size = 0;
+		}
+		else if( size > ( file_size - (size64_t) offset ) )
+		{
+			size = file_size - (size64_t) offset;
+		}
+	}
+	if( size > 0 )
+	{
+		if( mount_file_entry_write_zeroes(
+		     file_entry,
+		     (off64_t) offset,
+		     size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write zeroes to file entry.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+	}
+	return( 0 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MOUNT_FUSE_FALLOCATE ) */
+
 /* Releases a file entry
  * Returns 0 if successful or a negative errno value otherwise
  */
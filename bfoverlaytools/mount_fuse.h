@@ -32,7 +32,7 @@
 /* Ensure FUSE_USE_VERSION is defined before including fuse.h
  */
 #if defined( HAVE_LIBFUSE3 )
-#define FUSE_USE_VERSION	30
+#define FUSE_USE_VERSION	32
 #else
 #define FUSE_USE_VERSION	26
 #endif
@@ -49,6 +49,62 @@
 
 #endif /* defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE ) */
 
+#if defined( HAVE_LIBFUSE3 )
+
+/* The lseek operation is supported as of libfuse 3.8
+ */
+#if defined( FUSE_VERSION ) && defined( FUSE_MAKE_VERSION )
+#if FUSE_VERSION >= FUSE_MAKE_VERSION( 3, 8 )
+#define HAVE_MOUNT_FUSE_LSEEK
+#endif
+#endif
+
+#endif /* defined( HAVE_LIBFUSE3 ) */
+
+#if defined( HAVE_MOUNT_FUSE_LSEEK ) && defined( __linux__ )
+
+/* SEEK_DATA and SEEK_HOLE are only defined when _GNU_SOURCE is set
+ */
+#if !defined( SEEK_DATA )
+#define SEEK_DATA	3
+#endif
+
+#if !defined( SEEK_HOLE )
+#define SEEK_HOLE	4
+#endif
+
+#endif /* defined( HAVE_MOUNT_FUSE_LSEEK ) && defined( __linux__ ) */
+
+#if ( defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) ) && defined( __linux__ )
+
+/* The fallocate operation is supported as of libfuse 2.9
+ */
+#if defined( FUSE_VERSION ) && defined( FUSE_MAKE_VERSION )
+#if FUSE_VERSION >= FUSE_MAKE_VERSION( 2, 9 )
+#define HAVE_MOUNT_FUSE_FALLOCATE
+#endif
+#endif
+
+#endif /* ( defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) ) && defined( __linux__ ) */
+
+#if defined( HAVE_MOUNT_FUSE_FALLOCATE )
+
+/* FALLOC_FL_KEEP_SIZE, FALLOC_FL_PUNCH_HOLE and FALLOC_FL_ZERO_RANGE are only defined when _GNU_SOURCE is set
+ */
+#if !defined( FALLOC_FL_KEEP_SIZE )
+#define FALLOC_FL_KEEP_SIZE	0x01
+#endif
+
+#if !defined( FALLOC_FL_PUNCH_HOLE )
+#define FALLOC_FL_PUNCH_HOLE	0x02
+#endif
+
+#if !defined( FALLOC_FL_ZERO_RANGE )
+#define FALLOC_FL_ZERO_RANGE	0x10
+#endif
+
+#endif /* defined( HAVE_MOUNT_FUSE_FALLOCATE ) */
+
 #include "bfoverlaytools_libbfoverlay.h"
 #include "bfoverlaytools_libcerror.h"
 #include "mount_file_entry.h"
@@ -120,6 +176,23 @@ int mount_fuse_write(
      off_t offset,
      struct fuse_file_info *file_info );
 
+#if defined( HAVE_MOUNT_FUSE_LSEEK )
+off_t mount_fuse_lseek(
+       const char *path,
+       off_t offset,
+       int whence,
+       struct fuse_file_info *file_info );
+#endif
+
+#if defined( HAVE_MOUNT_FUSE_FALLOCATE )
+int mount_fuse_fallocate(
+     const char *path,
+     int mode,
+     off_t offset,
+     off_t length,
+     struct fuse_file_info *file_info );
+#endif
+
 int mount_fuse_release(
      const char *path,
      struct fuse_file_info *file_info );
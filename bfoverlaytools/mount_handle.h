@@ -35,6 +35,8 @@
 extern "C" {
 #endif
 
+#define MOUNT_HANDLE_MAXIMUM_NUMBER_OF_THREADS	256
+
 typedef struct mount_handle mount_handle_t;
 
 struct mount_handle
@@ -46,6 +48,10 @@ struct mount_handle
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
+
+	/* The number of threads used to process file system requests
+	 */
+	int number_of_threads;
 };
 
 int mount_handle_initialize(
@@ -60,11 +66,26 @@ int mount_handle_signal_abort(
      mount_handle_t *mount_handle,
      libcerror_error_t **error );
 
+int mount_handle_set_io_trace_format(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int mount_handle_set_io_trace_file(
      mount_handle_t *mount_handle,
      const system_character_t *filename,
      libcerror_error_t **error );
 
+int mount_handle_set_number_of_threads(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int mount_handle_get_number_of_threads(
+     mount_handle_t *mount_handle,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
 int mount_handle_set_path_prefix(
      mount_handle_t *mount_handle,
      const system_character_t *path_prefix,
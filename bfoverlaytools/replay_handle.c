@@ -0,0 +1,1857 @@
+/*
+ * Replay handle
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#endif
+
+#include <time.h>
+
+#include "bfoverlaytools_libbfoverlay.h"
+#include "bfoverlaytools_libcerror.h"
+#include "bfoverlaytools_libcnotify.h"
+#include "bfoverlaytools_libcthreads.h"
+#include "bfoverlaytools_system_string.h"
+#include "bfoverlaytools_timestamp.h"
+#include "bfoverlaytools_workers.h"
+#include "io_trace.h"
+#include "replay_handle.h"
+
+/* Creates a replay handle
+ * Make sure the value replay_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_initialize(
+     replay_handle_t **replay_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "replay_handle_initialize";
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *replay_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid replay handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*replay_handle = memory_allocate_structure(
+	                  replay_handle_t );
+
+	if( *replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create replay handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *replay_handle,
+	     0,
+	     sizeof( replay_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear replay handle.",
+		 function );
+
+		memory_free(
+		 *replay_handle );
+
+		*replay_handle = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *replay_handle )->records_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize records mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *replay_handle )->mode              = REPLAY_MODE_FAST;
+	( *replay_handle )->number_of_threads = 1;
+	( *replay_handle )->notify_stream     = stdout;
+
+	return( 1 );
+
+on_error:
+	if( *replay_handle != NULL )
+	{
+		memory_free(
+		 *replay_handle );
+
+		*replay_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a replay handle
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_free(
+     replay_handle_t **replay_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "replay_handle_free";
+	int result            = 1;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *replay_handle != NULL )
+	{
+		if( ( *replay_handle )->input_handle != NULL )
+		{
+			if( libbfoverlay_handle_free(
+			     &( ( *replay_handle )->input_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *replay_handle )->records != NULL )
+		{
+			memory_free(
+			 ( *replay_handle )->records );
+		}
+		if( ( *replay_handle )->latencies != NULL )
+		{
+			memory_free(
+			 ( *replay_handle )->latencies );
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *replay_handle )->records_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free records mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *replay_handle );
+
+		*replay_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the replay handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_signal_abort(
+     replay_handle_t *replay_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "replay_handle_signal_abort";
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	replay_handle->abort = 1;
+
+	if( replay_handle->input_handle != NULL )
+	{
+		if( libbfoverlay_handle_signal_abort(
+		     replay_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input handle to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the replay mode
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int replay_handle_set_mode(
+     replay_handle_t *replay_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "replay_handle_set_mode";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 4 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "fast" ),
+		     4 ) == 0 )
+		{
+			replay_handle->mode = REPLAY_MODE_FAST;
+
+			result = 1;
+		}
+	}
+	else if( string_length == 5 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "timed" ),
+		     5 ) == 0 )
+		{
+			replay_handle->mode = REPLAY_MODE_TIMED;
+
+			result = 1;
+		}
+	}
+	return( result );
+}
+
+/* Sets the number of threads
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_set_number_of_threads(
+     replay_handle_t *replay_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "replay_handle_set_number_of_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( bfoverlaytools_system_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit value.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) REPLAY_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( value_64bit > 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	replay_handle->number_of_threads = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the value to indicate if write, resize, discard and write zeroes operations should be replayed
+ * The value must be set before the input is opened
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_set_replay_writes(
+     replay_handle_t *replay_handle,
+     uint8_t replay_writes,
+     libcerror_error_t **error )
+{
+	static char *function = "replay_handle_set_replay_writes";
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( replay_handle->input_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid replay handle - input handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	replay_handle->replay_writes = replay_writes;
+
+	return( 1 );
+}
+
+/* Opens the IO trace file and reads its records
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_open_trace(
+     replay_handle_t *replay_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	FILE *trace_file_stream    = NULL;
+	static char *function      = "replay_handle_open_trace";
+	void *reallocation         = NULL;
+	uint64_t maximum_records   = 0;
+	uint64_t number_of_records = 0;
+	int result                 = 0;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( replay_handle->records != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid replay handle - records value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	trace_file_stream = file_stream_open_wide(
+	                     filename,
+	                     L"rb" );
+#else
+	trace_file_stream = file_stream_open(
+	                     filename,
+	                     "rb" );
+#endif
+	if( trace_file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open trace file stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_trace_read_file_header(
+	     trace_file_stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read IO trace file header.",
+		 function );
+
+		goto on_error;
+	}
+	/* The records are read upfront so that reading the IO trace
+	 * does not affect the replayed operations
+	 */
+	do
+	{
+		if( number_of_records >= maximum_records )
+		{
+			if( maximum_records == 0 )
+			{
+				maximum_records = 1024;
+			}
+			else
+			{
+				maximum_records *= 2;
+			}
+			if( maximum_records > (uint64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( io_trace_record_t ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid number of records value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			reallocation = memory_reallocate(
+			                replay_handle->records,
+			                sizeof( io_trace_record_t ) * (size_t) maximum_records );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize records.",
+				 function );
+
+				goto on_error;
+			}
+			replay_handle->records = (io_trace_record_t *) reallocation;
+		}
+		result = io_trace_record_read_file_stream(
+		          &( replay_handle->records[ number_of_records ] ),
+		          trace_file_stream,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read IO trace record: %" PRIu64 ".",
+			 function,
+			 number_of_records );
+
+			goto on_error;
+		}
+		else if( result == 1 )
+		{
+			number_of_records++;
+		}
+	}
+	while( result == 1 );
+
+	if( file_stream_close(
+	     trace_file_stream ) != 0 )
+	{
+		trace_file_stream = NULL;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close trace file stream.",
+		 function );
+
+		goto on_error;
+	}
+	/* The records are written when the IO operation completes, hence the records
+	 * of IO operations that overlap are not stored in the order they started.
+	 * The records are sorted by their start timestamp so that a timed replay
+	 * issues them in the order they started.
+	 */
+	if( number_of_records > 1 )
+	{
+		qsort(
+		 replay_handle->records,
+		 (size_t) number_of_records,
+		 sizeof( io_trace_record_t ),
+		 &io_trace_record_compare_timestamps );
+	}
+	replay_handle->number_of_records = number_of_records;
+
+	return( 1 );
+
+on_error:
+	if( replay_handle->records != NULL )
+	{
+		memory_free(
+		 replay_handle->records );
+
+		replay_handle->records = NULL;
+	}
+	if( trace_file_stream != NULL )
+	{
+		file_stream_close(
+		 trace_file_stream );
+	}
+	return( -1 );
+}
+
+/* Opens the input
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_open_input(
+     replay_handle_t *replay_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "replay_handle_open_input";
+	int access_flags      = LIBBFOVERLAY_OPEN_READ;
+	int result            = 0;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( replay_handle->input_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid replay handle - input handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( replay_handle->replay_writes != 0 )
+	{
+		access_flags = LIBBFOVERLAY_OPEN_READ_WRITE;
+	}
+	if( libbfoverlay_handle_initialize(
+	     &( replay_handle->input_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfoverlay_handle_open_wide(
+	          replay_handle->input_handle,
+	          filename,
+	          access_flags,
+	          error );
+#else
+	result = libbfoverlay_handle_open(
+	          replay_handle->input_handle,
+	          filename,
+	          access_flags,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_handle_open_data_files(
+	     replay_handle->input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open data files.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( replay_handle->input_handle != NULL )
+	{
+		libbfoverlay_handle_free(
+		 &( replay_handle->input_handle ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes the replay handle
+ * Returns the 0 if successful or -1 on error
+ */
+int replay_handle_close(
+     replay_handle_t *replay_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "replay_handle_close";
+	int result            = 0;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( replay_handle->input_handle != NULL )
+	{
+		if( libbfoverlay_handle_close(
+		     replay_handle->input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close input handle.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfoverlay_handle_free(
+		     &( replay_handle->input_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the index of the next IO trace record to replay
+ * The records are handed out in trace order to the workers
+ * Returns 1 if successful, 0 if no more records are available or -1 on error
+ */
+int replay_handle_get_next_record_index(
+     replay_handle_t *replay_handle,
+     uint64_t *record_index,
+     libcerror_error_t **error )
+{
+	static char *function = "replay_handle_get_next_record_index";
+	int result            = 0;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record index.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     replay_handle->records_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab records mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( replay_handle->next_record_index < replay_handle->number_of_records )
+	{
+		*record_index = replay_handle->next_record_index;
+
+		replay_handle->next_record_index += 1;
+
+		result = 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     replay_handle->records_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release records mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Waits until a monotonic timestamp is reached or abort was signalled
+ * The timestamp is in number of nanoseconds
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_wait_for_timestamp(
+     replay_handle_t *replay_handle,
+     uint64_t timestamp,
+     libcerror_error_t **error )
+{
+#if !defined( WINAPI ) && defined( HAVE_NANOSLEEP )
+	struct timespec time_structure;
+#endif
+
+	static char *function      = "replay_handle_wait_for_timestamp";
+	uint64_t current_timestamp = 0;
+	uint64_t sleep_time        = 0;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	while( replay_handle->abort == 0 )
+	{
+		if( bfoverlaytools_timestamp_get(
+		     &current_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve current timestamp.",
+			 function );
+
+			return( -1 );
+		}
+		if( current_timestamp >= timestamp )
+		{
+			break;
+		}
+		sleep_time = timestamp - current_timestamp;
+
+		if( sleep_time > REPLAY_HANDLE_MAXIMUM_SLEEP_TIME )
+		{
+			sleep_time = REPLAY_HANDLE_MAXIMUM_SLEEP_TIME;
+		}
+#if defined( WINAPI )
+		Sleep(
+		 (DWORD) ( sleep_time / 1000000 ) );
+
+#elif defined( HAVE_NANOSLEEP )
+		time_structure.tv_sec  = (time_t) ( sleep_time / 1000000000 );
+		time_structure.tv_nsec = (long) ( sleep_time % 1000000000 );
+
+		nanosleep(
+		 &time_structure,
+		 NULL );
+
+#endif /* defined( WINAPI ) */
+	}
+	return( 1 );
+}
+
+/* Re-issues the IO operation of an IO trace record against the input handle
+ * An IO operation that fails is counted but does not stop the replay
+ * Returns 1 if successful, 0 if the operation was skipped or -1 on error
+ */
+int replay_handle_replay_record(
+     replay_worker_t *replay_worker,
+     const io_trace_record_t *io_trace_record,
+     uint64_t *latency,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *io_error    = NULL;
+	replay_handle_t *replay_handle = NULL;
+	static char *function          = "replay_handle_replay_record";
+	void *reallocation             = NULL;
+	ssize_t io_count               = 0;
+	uint64_t end_timestamp         = 0;
+	uint64_t start_timestamp       = 0;
+	int result                     = 0;
+
+	if( replay_worker == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay worker.",
+		 function );
+
+		return( -1 );
+	}
+	replay_handle = replay_worker->replay_handle;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid replay worker - missing replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( replay_handle->input_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid replay handle - missing input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_trace_record == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO trace record.",
+		 function );
+
+		return( -1 );
+	}
+	if( latency == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid latency.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_trace_record->operation != IO_TRACE_OPERATION_READ )
+	 && ( replay_handle->replay_writes == 0 ) )
+	{
+		replay_worker->number_of_skipped_operations += 1;
+
+		return( 0 );
+	}
+	if( ( io_trace_record->operation == IO_TRACE_OPERATION_READ )
+	 || ( io_trace_record->operation == IO_TRACE_OPERATION_WRITE ) )
+	{
+		if( ( io_trace_record->offset < 0 )
+		 || ( io_trace_record->size == 0 )
+		 || ( io_trace_record->size > (size64_t) REPLAY_HANDLE_MAXIMUM_REQUEST_SIZE ) )
+		{
+			replay_worker->number_of_skipped_operations += 1;
+
+			return( 0 );
+		}
+		if( (size_t) io_trace_record->size > replay_worker->buffer_size )
+		{
+			reallocation = memory_reallocate(
+			                replay_worker->buffer,
+			                sizeof( uint8_t ) * (size_t) io_trace_record->size );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize buffer.",
+				 function );
+
+				return( -1 );
+			}
+			replay_worker->buffer      = (uint8_t *) reallocation;
+			replay_worker->buffer_size = (size_t) io_trace_record->size;
+
+			/* The data of write operations is not part of the IO trace
+			 */
+			if( memory_set(
+			     replay_worker->buffer,
+			     0,
+			     replay_worker->buffer_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	else if( ( io_trace_record->operation != IO_TRACE_OPERATION_RESIZE )
+	      && ( io_trace_record->operation != IO_TRACE_OPERATION_DISCARD )
+	      && ( io_trace_record->operation != IO_TRACE_OPERATION_WRITE_ZEROES ) )
+	{
+		replay_worker->number_of_skipped_operations += 1;
+
+		return( 0 );
+	}
+	if( bfoverlaytools_timestamp_get(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	switch( io_trace_record->operation )
+	{
+		case IO_TRACE_OPERATION_READ:
+			io_count = libbfoverlay_handle_read_buffer_at_offset(
+			            replay_handle->input_handle,
+			            replay_worker->buffer,
+			            (size_t) io_trace_record->size,
+			            io_trace_record->offset,
+			            &io_error );
+			break;
+
+		case IO_TRACE_OPERATION_WRITE:
+			io_count = libbfoverlay_handle_write_buffer_at_offset(
+			            replay_handle->input_handle,
+			            replay_worker->buffer,
+			            (size_t) io_trace_record->size,
+			            io_trace_record->offset,
+			            &io_error );
+			break;
+
+		case IO_TRACE_OPERATION_RESIZE:
+			result = libbfoverlay_handle_resize(
+			          replay_handle->input_handle,
+			          (size64_t) io_trace_record->offset,
+			          &io_error );
+
+			io_count = ( result == 1 ) ? 0 : -1;
+
+			break;
+
+		case IO_TRACE_OPERATION_DISCARD:
+			result = libbfoverlay_handle_discard(
+			          replay_handle->input_handle,
+			          io_trace_record->offset,
+			          io_trace_record->size,
+			          &io_error );
+
+			io_count = ( result == 1 ) ? 0 : -1;
+
+			break;
+
+		case IO_TRACE_OPERATION_WRITE_ZEROES:
+			result = libbfoverlay_handle_write_zeroes(
+			          replay_handle->input_handle,
+			          io_trace_record->offset,
+			          io_trace_record->size,
+			          &io_error );
+
+			io_count = ( result == 1 ) ? 0 : -1;
+
+			break;
+	}
+	if( bfoverlaytools_timestamp_get(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		libcerror_error_free(
+		 &io_error );
+
+		return( -1 );
+	}
+	*latency = end_timestamp - start_timestamp;
+
+	if( io_count < 0 )
+	{
+		replay_worker->number_of_failed_operations += 1;
+
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: %s at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIu64 " failed.\n",
+			 function,
+			 io_trace_get_operation_string(
+			  io_trace_record->operation ),
+			 io_trace_record->offset,
+			 io_trace_record->offset,
+			 io_trace_record->size );
+
+			libcnotify_print_error_backtrace(
+			 io_error );
+		}
+		libcerror_error_free(
+		 &io_error );
+	}
+	else if( io_trace_record->operation == IO_TRACE_OPERATION_READ )
+	{
+		replay_worker->number_of_read_operations += 1;
+		replay_worker->read_size                 += (uint64_t) io_count;
+	}
+	else if( io_trace_record->operation == IO_TRACE_OPERATION_WRITE )
+	{
+		replay_worker->number_of_write_operations += 1;
+		replay_worker->write_size                 += (uint64_t) io_count;
+	}
+	else if( io_trace_record->operation == IO_TRACE_OPERATION_RESIZE )
+	{
+		replay_worker->number_of_resize_operations += 1;
+	}
+	else if( io_trace_record->operation == IO_TRACE_OPERATION_DISCARD )
+	{
+		replay_worker->number_of_discard_operations += 1;
+	}
+	else
+	{
+		replay_worker->number_of_write_zeroes_operations += 1;
+	}
+	replay_worker->traced_latency += io_trace_record->latency;
+
+	return( 1 );
+}
+
+/* Replays IO trace records until no more records are available
+ * This function is used as a thread callback function
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_run_worker(
+     void *arguments )
+{
+	io_trace_record_t *io_trace_record = NULL;
+	replay_handle_t *replay_handle     = NULL;
+	replay_worker_t *replay_worker     = NULL;
+	static char *function              = "replay_handle_run_worker";
+	uint64_t current_timestamp         = 0;
+	uint64_t latency                   = 0;
+	uint64_t record_index              = 0;
+	uint64_t schedule_lag              = 0;
+	uint64_t scheduled_timestamp       = 0;
+	int result                         = 0;
+
+	if( arguments == NULL )
+	{
+		return( -1 );
+	}
+	replay_worker = (replay_worker_t *) arguments;
+	replay_handle = replay_worker->replay_handle;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 &( replay_worker->error ),
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay worker - missing replay handle.",
+		 function );
+
+		goto on_error;
+	}
+	while( replay_handle->abort == 0 )
+	{
+		result = replay_handle_get_next_record_index(
+		          replay_handle,
+		          &record_index,
+		          &( replay_worker->error ) );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &( replay_worker->error ),
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next record index.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		io_trace_record = &( replay_handle->records[ record_index ] );
+
+		/* In timed mode an operation is not issued before its traced timestamp
+		 * relative to the start of the replay
+		 */
+		if( replay_handle->mode == REPLAY_MODE_TIMED )
+		{
+			scheduled_timestamp = replay_handle->start_timestamp + io_trace_record->timestamp;
+
+			if( replay_handle_wait_for_timestamp(
+			     replay_handle,
+			     scheduled_timestamp,
+			     &( replay_worker->error ) ) != 1 )
+			{
+				libcerror_error_set(
+				 &( replay_worker->error ),
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to wait for record: %" PRIu64 " timestamp.",
+				 function,
+				 record_index );
+
+				goto on_error;
+			}
+			if( replay_handle->abort != 0 )
+			{
+				break;
+			}
+			if( bfoverlaytools_timestamp_get(
+			     &current_timestamp,
+			     &( replay_worker->error ) ) != 1 )
+			{
+				libcerror_error_set(
+				 &( replay_worker->error ),
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve current timestamp.",
+				 function );
+
+				goto on_error;
+			}
+			schedule_lag = current_timestamp - scheduled_timestamp;
+
+			replay_worker->schedule_lag += schedule_lag;
+
+			if( schedule_lag > replay_worker->maximum_schedule_lag )
+			{
+				replay_worker->maximum_schedule_lag = schedule_lag;
+			}
+		}
+		result = replay_handle_replay_record(
+		          replay_worker,
+		          io_trace_record,
+		          &latency,
+		          &( replay_worker->error ) );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &( replay_worker->error ),
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to replay record: %" PRIu64 ".",
+			 function,
+			 record_index );
+
+			goto on_error;
+		}
+		else if( result == 1 )
+		{
+			/* Every record index is handed out once hence the workers
+			 * do not store latencies in the same location
+			 */
+			replay_handle->latencies[ record_index ] = latency;
+		}
+	}
+	replay_worker->result = 1;
+
+	return( 1 );
+
+on_error:
+	replay_worker->result = -1;
+
+	return( -1 );
+}
+
+/* Replays the IO trace against the input handle
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_run(
+     replay_handle_t *replay_handle,
+     libcerror_error_t **error )
+{
+	replay_worker_t *replay_workers = NULL;
+	static char *function           = "replay_handle_run";
+	uint64_t end_timestamp          = 0;
+	uint64_t record_index           = 0;
+	int result                      = 1;
+	int worker_index                = 0;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( replay_handle->input_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid replay handle - missing input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( replay_handle->records == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid replay handle - missing records.",
+		 function );
+
+		return( -1 );
+	}
+	if( replay_handle->latencies != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid replay handle - latencies value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( replay_handle->number_of_threads <= 0 )
+	 || ( replay_handle->number_of_threads > REPLAY_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid replay handle - number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( replay_handle->number_of_records > (uint64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint64_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid replay handle - number of records value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( replay_handle->number_of_records > 0 )
+	{
+		replay_handle->latencies = (uint64_t *) memory_allocate(
+		                                         sizeof( uint64_t ) * (size_t) replay_handle->number_of_records );
+
+		if( replay_handle->latencies == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create latencies.",
+			 function );
+
+			goto on_error;
+		}
+		for( record_index = 0;
+		     record_index < replay_handle->number_of_records;
+		     record_index++ )
+		{
+			replay_handle->latencies[ record_index ] = REPLAY_HANDLE_LATENCY_NOT_SET;
+		}
+	}
+	replay_workers = (replay_worker_t *) memory_allocate(
+	                                      sizeof( replay_worker_t ) * replay_handle->number_of_threads );
+
+	if( replay_workers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create workers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     replay_workers,
+	     0,
+	     sizeof( replay_worker_t ) * replay_handle->number_of_threads ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear workers.",
+		 function );
+
+		memory_free(
+		 replay_workers );
+
+		replay_workers = NULL;
+
+		goto on_error;
+	}
+	for( worker_index = 0;
+	     worker_index < replay_handle->number_of_threads;
+	     worker_index++ )
+	{
+		replay_workers[ worker_index ].replay_handle = replay_handle;
+	}
+	replay_handle->next_record_index = 0;
+
+	if( bfoverlaytools_timestamp_get(
+	     &( replay_handle->start_timestamp ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	if( bfoverlaytools_workers_run(
+	     &replay_handle_run_worker,
+	     (uint8_t *) replay_workers,
+	     sizeof( replay_worker_t ),
+	     replay_handle->number_of_threads,
+	     &( replay_handle->abort ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to run workers.",
+		 function );
+
+		goto on_error;
+	}
+	if( bfoverlaytools_timestamp_get(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	replay_handle->elapsed_time                      = end_timestamp - replay_handle->start_timestamp;
+	replay_handle->number_of_read_operations         = 0;
+	replay_handle->number_of_write_operations        = 0;
+	replay_handle->number_of_resize_operations       = 0;
+	replay_handle->number_of_discard_operations      = 0;
+	replay_handle->number_of_write_zeroes_operations = 0;
+	replay_handle->number_of_skipped_operations      = 0;
+	replay_handle->number_of_failed_operations       = 0;
+	replay_handle->read_size                         = 0;
+	replay_handle->write_size                        = 0;
+	replay_handle->traced_latency                    = 0;
+	replay_handle->schedule_lag                      = 0;
+	replay_handle->maximum_schedule_lag              = 0;
+
+	for( worker_index = 0;
+	     worker_index < replay_handle->number_of_threads;
+	     worker_index++ )
+	{
+		if( replay_workers[ worker_index ].result != 1 )
+		{
+			if( replay_workers[ worker_index ].error != NULL )
+			{
+				if( ( error != NULL )
+				 && ( *error == NULL ) )
+				{
+					*error = replay_workers[ worker_index ].error;
+
+					replay_workers[ worker_index ].error = NULL;
+				}
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: worker: %d failed.",
+			 function,
+			 worker_index );
+
+			result = -1;
+		}
+		replay_handle->number_of_read_operations         += replay_workers[ worker_index ].number_of_read_operations;
+		replay_handle->number_of_write_operations        += replay_workers[ worker_index ].number_of_write_operations;
+		replay_handle->number_of_resize_operations       += replay_workers[ worker_index ].number_of_resize_operations;
+		replay_handle->number_of_discard_operations      += replay_workers[ worker_index ].number_of_discard_operations;
+		replay_handle->number_of_write_zeroes_operations += replay_workers[ worker_index ].number_of_write_zeroes_operations;
+		replay_handle->number_of_skipped_operations      += replay_workers[ worker_index ].number_of_skipped_operations;
+		replay_handle->number_of_failed_operations       += replay_workers[ worker_index ].number_of_failed_operations;
+		replay_handle->read_size                         += replay_workers[ worker_index ].read_size;
+		replay_handle->write_size                        += replay_workers[ worker_index ].write_size;
+		replay_handle->traced_latency                    += replay_workers[ worker_index ].traced_latency;
+		replay_handle->schedule_lag                      += replay_workers[ worker_index ].schedule_lag;
+
+		if( replay_workers[ worker_index ].maximum_schedule_lag > replay_handle->maximum_schedule_lag )
+		{
+			replay_handle->maximum_schedule_lag = replay_workers[ worker_index ].maximum_schedule_lag;
+		}
+	}
+	/* Pack the latencies of the replayed operations
+	 */
+	replay_handle->number_of_latencies = 0;
+
+	for( record_index = 0;
+	     record_index < replay_handle->number_of_records;
+	     record_index++ )
+	{
+		if( replay_handle->latencies[ record_index ] != REPLAY_HANDLE_LATENCY_NOT_SET )
+		{
+			replay_handle->latencies[ replay_handle->number_of_latencies ] = replay_handle->latencies[ record_index ];
+
+			replay_handle->number_of_latencies += 1;
+		}
+	}
+	for( worker_index = 0;
+	     worker_index < replay_handle->number_of_threads;
+	     worker_index++ )
+	{
+		if( replay_workers[ worker_index ].error != NULL )
+		{
+			libcerror_error_free(
+			 &( replay_workers[ worker_index ].error ) );
+		}
+		if( replay_workers[ worker_index ].buffer != NULL )
+		{
+			memory_free(
+			 replay_workers[ worker_index ].buffer );
+		}
+	}
+	memory_free(
+	 replay_workers );
+
+	return( result );
+
+on_error:
+	if( replay_workers != NULL )
+	{
+		for( worker_index = 0;
+		     worker_index < replay_handle->number_of_threads;
+		     worker_index++ )
+		{
+			if( replay_workers[ worker_index ].error != NULL )
+			{
+				libcerror_error_free(
+				 &( replay_workers[ worker_index ].error ) );
+			}
+			if( replay_workers[ worker_index ].buffer != NULL )
+			{
+				memory_free(
+				 replay_workers[ worker_index ].buffer );
+			}
+		}
+		memory_free(
+		 replay_workers );
+	}
+	if( replay_handle->latencies != NULL )
+	{
+		memory_free(
+		 replay_handle->latencies );
+
+		replay_handle->latencies = NULL;
+	}
+	return( -1 );
+}
+
+/* Prints the replay results
+ * Returns 1 if successful or -1 on error
+ */
+int replay_handle_results_fprint(
+     replay_handle_t *replay_handle,
+     libcerror_error_t **error )
+{
+	const char *mode_string       = "fast";
+	static char *function         = "replay_handle_results_fprint";
+	double elapsed_seconds        = 0.0;
+	double total_latency          = 0.0;
+	uint64_t latency_index        = 0;
+	uint64_t number_of_operations = 0;
+	uint64_t trace_duration       = 0;
+
+	if( replay_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid replay handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( replay_handle->mode == REPLAY_MODE_TIMED )
+	{
+		mode_string = "timed";
+	}
+	if( replay_handle->number_of_records > 0 )
+	{
+		trace_duration = replay_handle->records[ replay_handle->number_of_records - 1 ].timestamp
+		               + replay_handle->records[ replay_handle->number_of_records - 1 ].latency;
+	}
+	number_of_operations = replay_handle->number_of_read_operations
+	                     + replay_handle->number_of_write_operations
+	                     + replay_handle->number_of_resize_operations
+	                     + replay_handle->number_of_discard_operations
+	                     + replay_handle->number_of_write_zeroes_operations;
+
+	elapsed_seconds = (double) replay_handle->elapsed_time / 1000000000.0;
+
+	fprintf(
+	 replay_handle->notify_stream,
+	 "Replay results:\n" );
+
+	fprintf(
+	 replay_handle->notify_stream,
+	 "\tReplay mode\t\t\t: %s\n",
+	 mode_string );
+
+	fprintf(
+	 replay_handle->notify_stream,
+	 "\tNumber of threads\t\t: %d\n",
+	 replay_handle->number_of_threads );
+
+	fprintf(
+	 replay_handle->notify_stream,
+	 "\tNumber of records\t\t: %" PRIu64 "\n",
+	 replay_handle->number_of_records );
+
+	fprintf(
+	 replay_handle->notify_stream,
+	 "\tNumber of operations\t\t: %" PRIu64 " (%" PRIu64 " reads, %" PRIu64 " writes, %" PRIu64 " resizes, %" PRIu64 " discards, %" PRIu64 " write zeroes)\n",
+	 number_of_operations,
+	 replay_handle->number_of_read_operations,
+	 replay_handle->number_of_write_operations,
+	 replay_handle->number_of_resize_operations,
+	 replay_handle->number_of_discard_operations,
+	 replay_handle->number_of_write_zeroes_operations );
+
+	fprintf(
+	 replay_handle->notify_stream,
+	 "\tNumber of skipped operations\t: %" PRIu64 "\n",
+	 replay_handle->number_of_skipped_operations );
+
+	fprintf(
+	 replay_handle->notify_stream,
+	 "\tNumber of failed operations\t: %" PRIu64 "\n",
+	 replay_handle->number_of_failed_operations );
+
+	fprintf(
+	 replay_handle->notify_stream,
+	 "\tTrace duration\t\t\t: %.6f seconds\n",
+	 (double) trace_duration / 1000000000.0 );
+
+	fprintf(
+	 replay_handle->notify_stream,
+	 "\tElapsed time\t\t\t: %.6f seconds\n",
+	 elapsed_seconds );
+
+	if( elapsed_seconds > 0.0 )
+	{
+		fprintf(
+		 replay_handle->notify_stream,
+		 "\tRead throughput\t\t\t: %.2f MiB/s\n",
+		 ( (double) replay_handle->read_size / ( 1024.0 * 1024.0 ) ) / elapsed_seconds );
+
+		fprintf(
+		 replay_handle->notify_stream,
+		 "\tWrite throughput\t\t: %.2f MiB/s\n",
+		 ( (double) replay_handle->write_size / ( 1024.0 * 1024.0 ) ) / elapsed_seconds );
+
+		fprintf(
+		 replay_handle->notify_stream,
+		 "\tOperations per second (IOPS)\t: %.0f\n",
+		 (double) number_of_operations / elapsed_seconds );
+	}
+	if( ( replay_handle->latencies != NULL )
+	 && ( replay_handle->number_of_latencies > 0 ) )
+	{
+		qsort(
+		 replay_handle->latencies,
+		 (size_t) replay_handle->number_of_latencies,
+		 sizeof( uint64_t ),
+		 &bfoverlaytools_workers_compare_latencies );
+
+		for( latency_index = 0;
+		     latency_index < replay_handle->number_of_latencies;
+		     latency_index++ )
+		{
+			total_latency += (double) replay_handle->latencies[ latency_index ];
+		}
+		fprintf(
+		 replay_handle->notify_stream,
+		 "\tLatency minimum\t\t\t: %.3f us\n",
+		 (double) replay_handle->latencies[ 0 ] / 1000.0 );
+
+		fprintf(
+		 replay_handle->notify_stream,
+		 "\tLatency average\t\t\t: %.3f us\n",
+		 ( total_latency / (double) replay_handle->number_of_latencies ) / 1000.0 );
+
+		fprintf(
+		 replay_handle->notify_stream,
+		 "\tLatency 50th percentile\t\t: %.3f us\n",
+		 (double) replay_handle->latencies[ ( ( replay_handle->number_of_latencies - 1 ) * 500 ) / 1000 ] / 1000.0 );
+
+		fprintf(
+		 replay_handle->notify_stream,
+		 "\tLatency 90th percentile\t\t: %.3f us\n",
+		 (double) replay_handle->latencies[ ( ( replay_handle->number_of_latencies - 1 ) * 900 ) / 1000 ] / 1000.0 );
+
+		fprintf(
+		 replay_handle->notify_stream,
+		 "\tLatency 99th percentile\t\t: %.3f us\n",
+		 (double) replay_handle->latencies[ ( ( replay_handle->number_of_latencies - 1 ) * 990 ) / 1000 ] / 1000.0 );
+
+		fprintf(
+		 replay_handle->notify_stream,
+		 "\tLatency 99.9th percentile\t: %.3f us\n",
+		 (double) replay_handle->latencies[ ( ( replay_handle->number_of_latencies - 1 ) * 999 ) / 1000 ] / 1000.0 );
+
+		fprintf(
+		 replay_handle->notify_stream,
+		 "\tLatency maximum\t\t\t: %.3f us\n",
+		 (double) replay_handle->latencies[ replay_handle->number_of_latencies - 1 ] / 1000.0 );
+
+		/* The traced latency includes the overhead of the file system layer
+		 */
+		fprintf(
+		 replay_handle->notify_stream,
+		 "\tTraced latency average\t\t: %.3f us\n",
+		 ( (double) replay_handle->traced_latency / (double) replay_handle->number_of_latencies ) / 1000.0 );
+
+		if( replay_handle->mode == REPLAY_MODE_TIMED )
+		{
+			fprintf(
+			 replay_handle->notify_stream,
+			 "\tSchedule lag average\t\t: %.3f us\n",
+			 ( (double) replay_handle->schedule_lag / (double) replay_handle->number_of_latencies ) / 1000.0 );
+
+			fprintf(
+			 replay_handle->notify_stream,
+			 "\tSchedule lag maximum\t\t: %.3f us\n",
+			 (double) replay_handle->maximum_schedule_lag / 1000.0 );
+		}
+	}
+	fprintf(
+	 replay_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+}
+
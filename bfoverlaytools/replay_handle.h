@@ -0,0 +1,313 @@
+/*
+ * Replay handle
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _REPLAY_HANDLE_H )
+#define _REPLAY_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "bfoverlaytools_libbfoverlay.h"
+#include "bfoverlaytools_libcerror.h"
+#include "bfoverlaytools_libcthreads.h"
+#include "io_trace.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define REPLAY_HANDLE_MAXIMUM_NUMBER_OF_THREADS		256
+#define REPLAY_HANDLE_MAXIMUM_REQUEST_SIZE		( 64 * 1024 * 1024 )
+
+/* The maximum time to sleep in nanoseconds before checking if abort was signalled
+ */
+#define REPLAY_HANDLE_MAXIMUM_SLEEP_TIME		100000000
+
+/* Value to indicate a record was not replayed
+ */
+#define REPLAY_HANDLE_LATENCY_NOT_SET			( (uint64_t) -1 )
+
+enum REPLAY_MODES
+{
+	REPLAY_MODE_FAST				= (int) 'f',
+	REPLAY_MODE_TIMED				= (int) 't'
+};
+
+typedef struct replay_handle replay_handle_t;
+
+struct replay_handle
+{
+	/* The input handle
+	 */
+	libbfoverlay_handle_t *input_handle;
+
+	/* The IO trace records
+	 */
+	io_trace_record_t *records;
+
+	/* The number of IO trace records
+	 */
+	uint64_t number_of_records;
+
+	/* The index of the next IO trace record to replay
+	 */
+	uint64_t next_record_index;
+
+	/* The replay mode
+	 */
+	int mode;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* Value to indicate if write, resize, discard and write zeroes operations should be replayed
+	 */
+	uint8_t replay_writes;
+
+	/* The start timestamp of the replay
+	 */
+	uint64_t start_timestamp;
+
+	/* The number of read operations
+	 */
+	uint64_t number_of_read_operations;
+
+	/* The number of write operations
+	 */
+	uint64_t number_of_write_operations;
+
+	/* The number of resize operations
+	 */
+	uint64_t number_of_resize_operations;
+
+	/* The number of discard operations
+	 */
+	uint64_t number_of_discard_operations;
+
+	/* The number of write zeroes operations
+	 */
+	uint64_t number_of_write_zeroes_operations;
+
+	/* The number of skipped operations
+	 */
+	uint64_t number_of_skipped_operations;
+
+	/* The number of failed operations
+	 */
+	uint64_t number_of_failed_operations;
+
+	/* The number of bytes read
+	 */
+	uint64_t read_size;
+
+	/* The number of bytes written
+	 */
+	uint64_t write_size;
+
+	/* The elapsed time in nanoseconds
+	 */
+	uint64_t elapsed_time;
+
+	/* The operation latencies in nanoseconds, which are stored by record index
+	 */
+	uint64_t *latencies;
+
+	/* The number of latencies
+	 */
+	uint64_t number_of_latencies;
+
+	/* The sum of the traced latencies of the replayed operations in nanoseconds
+	 */
+	uint64_t traced_latency;
+
+	/* The sum of the schedule lag in nanoseconds
+	 * The schedule lag is the time an operation was issued after its traced timestamp
+	 */
+	uint64_t schedule_lag;
+
+	/* The maximum schedule lag in nanoseconds
+	 */
+	uint64_t maximum_schedule_lag;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The records mutex
+	 */
+	libcthreads_mutex_t *records_mutex;
+#endif
+};
+
+typedef struct replay_worker replay_worker_t;
+
+struct replay_worker
+{
+	/* The replay handle
+	 */
+	replay_handle_t *replay_handle;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The number of read operations
+	 */
+	uint64_t number_of_read_operations;
+
+	/* The number of write operations
+	 */
+	uint64_t number_of_write_operations;
+
+	/* The number of resize operations
+	 */
+	uint64_t number_of_resize_operations;
+
+	/* The number of discard operations
+	 */
+	uint64_t number_of_discard_operations;
+
+	/* The number of write zeroes operations
+	 */
+	uint64_t number_of_write_zeroes_operations;
+
+	/* The number of skipped operations
+	 */
+	uint64_t number_of_skipped_operations;
+
+	/* The number of failed operations
+	 */
+	uint64_t number_of_failed_operations;
+
+	/* The number of bytes read
+	 */
+	uint64_t read_size;
+
+	/* The number of bytes written
+	 */
+	uint64_t write_size;
+
+	/* The sum of the traced latencies of the replayed operations in nanoseconds
+	 */
+	uint64_t traced_latency;
+
+	/* The sum of the schedule lag in nanoseconds
+	 */
+	uint64_t schedule_lag;
+
+	/* The maximum schedule lag in nanoseconds
+	 */
+	uint64_t maximum_schedule_lag;
+
+	/* The result
+	 */
+	int result;
+
+	/* The error
+	 */
+	libcerror_error_t *error;
+};
+
+int replay_handle_initialize(
+     replay_handle_t **replay_handle,
+     libcerror_error_t **error );
+
+int replay_handle_free(
+     replay_handle_t **replay_handle,
+     libcerror_error_t **error );
+
+int replay_handle_signal_abort(
+     replay_handle_t *replay_handle,
+     libcerror_error_t **error );
+
+int replay_handle_set_mode(
+     replay_handle_t *replay_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int replay_handle_set_number_of_threads(
+     replay_handle_t *replay_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int replay_handle_set_replay_writes(
+     replay_handle_t *replay_handle,
+     uint8_t replay_writes,
+     libcerror_error_t **error );
+
+int replay_handle_open_trace(
+     replay_handle_t *replay_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int replay_handle_open_input(
+     replay_handle_t *replay_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int replay_handle_close(
+     replay_handle_t *replay_handle,
+     libcerror_error_t **error );
+
+int replay_handle_get_next_record_index(
+     replay_handle_t *replay_handle,
+     uint64_t *record_index,
+     libcerror_error_t **error );
+
+int replay_handle_wait_for_timestamp(
+     replay_handle_t *replay_handle,
+     uint64_t timestamp,
+     libcerror_error_t **error );
+
+int replay_handle_replay_record(
+     replay_worker_t *replay_worker,
+     const io_trace_record_t *io_trace_record,
+     uint64_t *latency,
+     libcerror_error_t **error );
+
+int replay_handle_run_worker(
+     void *arguments );
+
+int replay_handle_run(
+     replay_handle_t *replay_handle,
+     libcerror_error_t **error );
+
+int replay_handle_results_fprint(
+     replay_handle_t *replay_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _REPLAY_HANDLE_H ) */
+
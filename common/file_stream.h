@@ -90,6 +90,11 @@ extern "C" {
 	fwrite( data, 1, size, stream )
 #endif
 
+/* FILE stream flush
+ */
+#define file_stream_flush( stream ) \
+	fflush( stream )
+
 /* FILE stream seek
  */
 #if defined( WINAPI )
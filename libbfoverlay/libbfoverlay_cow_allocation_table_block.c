@@ -66,7 +66,8 @@ int libbfoverlay_cow_allocation_table_block_initialize(
 
 		return( -1 );
 	}
-	if( (size_t) block_size < sizeof( bfoverlay_cow_allocation_table_block_header_t ) )
+	if( ( (size_t) block_size < sizeof( bfoverlay_cow_allocation_table_block_header_t ) )
+	 || ( (size_t) block_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -117,8 +118,42 @@ int libbfoverlay_cow_allocation_table_block_initialize(
 		 "%s: unable to clear COW allocation table block.",
 		 function );
 
+		memory_free(
+		 *cow_allocation_table_block );
+
+		*cow_allocation_table_block = NULL;
+
+		return( -1 );
+	}
+	( *cow_allocation_table_block )->data = (uint8_t *) memory_allocate(
+	                                                     (size_t) block_size );
+
+	if( ( *cow_allocation_table_block )->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
 		goto on_error;
 	}
+	if( memory_set(
+	     ( *cow_allocation_table_block )->data,
+	     0,
+	     (size_t) block_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		goto on_error;
+	}
+	( *cow_allocation_table_block )->data_size         = (size_t) block_size;
 	( *cow_allocation_table_block )->number_of_entries = (int) number_of_entries;
 
 	return( 1 );
@@ -126,6 +161,11 @@ int libbfoverlay_cow_allocation_table_block_initialize(
 on_error:
 	if( *cow_allocation_table_block != NULL )
 	{
+		if( ( *cow_allocation_table_block )->data != NULL )
+		{
+			memory_free(
+			 ( *cow_allocation_table_block )->data );
+		}
 		memory_free(
 		 *cow_allocation_table_block );
 
@@ -156,6 +196,11 @@ int libbfoverlay_cow_allocation_table_block_free(
 	}
 	if( *cow_allocation_table_block != NULL )
 	{
+		if( ( *cow_allocation_table_block )->data != NULL )
+		{
+			memory_free(
+			 ( *cow_allocation_table_block )->data );
+		}
 		memory_free(
 		 *cow_allocation_table_block );
 
@@ -164,23 +209,67 @@ int libbfoverlay_cow_allocation_table_block_free(
 	return( 1 );
 }
 
-/* Retrieves a specific block number
+/* Clears COW allocation table block
  * Returns 1 if successful or -1 on error
  */
-int libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
+int libbfoverlay_cow_allocation_table_block_clear(
      libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block,
-     libbfio_pool_t *file_io_pool,
-     int file_io_pool_entry,
-     off64_t file_offset,
-     int entry_index,
-     uint32_t *block_number,
      libcerror_error_t **error )
 {
-	uint8_t cow_allocation_table_block_entry_data[ sizeof( bfoverlay_cow_allocation_table_block_entry_t ) ];
+	static char *function = "libbfoverlay_cow_allocation_table_block_clear";
+
+	if( cow_allocation_table_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW allocation table block.",
+		 function );
 
-	static char *function      = "libbfoverlay_cow_allocation_table_block_get_block_number_by_index";
-	ssize_t read_count         = 0;
-	uint32_t safe_block_number = 0;
+		return( -1 );
+	}
+	if( cow_allocation_table_block->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid COW allocation table block - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     cow_allocation_table_block->data,
+	     0,
+	     cow_allocation_table_block->data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		return( -1 );
+	}
+	cow_allocation_table_block->block_number = 0;
+
+	return( 1 );
+}
+
+/* Reads the COW allocation table block
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_allocation_table_block_read_data(
+     libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function   = "libbfoverlay_cow_allocation_table_block_read_data";
+	uint32_t format_version = 0;
 
 	if( cow_allocation_table_block == NULL )
 	{
@@ -193,79 +282,340 @@ int libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
 
 		return( -1 );
 	}
-	if( ( entry_index < 0 )
-	 || ( entry_index >= cow_allocation_table_block->number_of_entries ) )
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( bfoverlay_cow_allocation_table_block_header_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid entry index value out of bounds.",
+		 "%s: invalid data size value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( block_number == NULL )
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: COW allocation table block header data:\n",
+		 function );
+		libcnotify_print_data(
+		 data,
+		 sizeof( bfoverlay_cow_allocation_table_block_header_t ),
+		 0 );
+	}
+#endif
+	if( memory_compare(
+	     ( (bfoverlay_cow_allocation_table_block_header_t *) data )->signature,
+	     "# BFO-COW-AB",
+	     12 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 ( (bfoverlay_cow_allocation_table_block_header_t *) data )->format_version,
+	 format_version );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: format version\t\t\t: %" PRIu32 "\n",
+		 function,
+		 format_version );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+	if( format_version != LIBBFOVERLAY_COW_FILE_FORMAT_VERSION )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: unsupported format version: %" PRIu32 ".",
+		 function,
+		 format_version );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the COW allocation table block
+ * The level 1 allocation table is stored in the block that contains the COW file header
+ * hence the signature is only checked for blocks at a file offset other than 0
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_allocation_table_block_read_file_io_pool(
+     libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t file_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_cow_allocation_table_block_read_file_io_pool";
+	ssize_t read_count    = 0;
+
+	if( cow_allocation_table_block == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid block number.",
+		 "%s: invalid COW allocation table block.",
 		 function );
 
 		return( -1 );
 	}
-	file_offset += entry_index * sizeof( bfoverlay_cow_allocation_table_block_entry_t );
+	if( cow_allocation_table_block->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid COW allocation table block - missing data.",
+		 function );
 
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading COW allocation table block at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 file_offset,
+		 file_offset );
+	}
+#endif
 	read_count = libbfio_pool_read_buffer_at_offset(
-	             file_io_pool,
-	             file_io_pool_entry,
-	             cow_allocation_table_block_entry_data,
-	             sizeof( bfoverlay_cow_allocation_table_block_entry_t ),
-	             file_offset,
-	             error );
+	              file_io_pool,
+	              file_io_pool_entry,
+	              cow_allocation_table_block->data,
+	              cow_allocation_table_block->data_size,
+	              file_offset,
+	              error );
 
-	if( read_count != (ssize_t) sizeof( bfoverlay_cow_allocation_table_block_entry_t ) )
+	if( read_count != (ssize_t) cow_allocation_table_block->data_size )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read COW allocation table block entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 "%s: unable to read COW allocation table block data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
 		 function,
-		 entry_index,
 		 file_offset,
 		 file_offset );
 
 		return( -1 );
 	}
-	byte_stream_copy_to_uint32_big_endian(
-	 cow_allocation_table_block_entry_data,
-	 safe_block_number );
+	if( file_offset != 0 )
+	{
+		if( libbfoverlay_cow_allocation_table_block_read_data(
+		     cow_allocation_table_block,
+		     cow_allocation_table_block->data,
+		     cow_allocation_table_block->data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read COW allocation table block.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes the COW allocation table block including its header
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_allocation_table_block_write_file_io_pool(
+     libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t file_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_cow_allocation_table_block_write_file_io_pool";
+	ssize_t write_count   = 0;
+
+	if( cow_allocation_table_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW allocation table block.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_allocation_table_block->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid COW allocation table block - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     ( (bfoverlay_cow_allocation_table_block_header_t *) cow_allocation_table_block->data )->signature,
+	     "# BFO-COW-AB",
+	     12 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy COW allocation table block signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 ( (bfoverlay_cow_allocation_table_block_header_t *) cow_allocation_table_block->data )->format_version,
+	 LIBBFOVERLAY_COW_FILE_FORMAT_VERSION );
 
-	*block_number = safe_block_number;
+	if( memory_set(
+	     ( (bfoverlay_cow_allocation_table_block_header_t *) cow_allocation_table_block->data )->padding,
+	     0,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear COW allocation table block header padding.",
+		 function );
 
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: writing COW allocation table block at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 file_offset,
+		 file_offset );
+	}
+#endif
+	write_count = libbfio_pool_write_buffer_at_offset(
+	               file_io_pool,
+	               file_io_pool_entry,
+	               cow_allocation_table_block->data,
+	               cow_allocation_table_block->data_size,
+	               file_offset,
+	               error );
+
+	if( write_count != (ssize_t) cow_allocation_table_block->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write COW allocation table block data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
 	return( 1 );
 }
 
-/* Sets a specific block number
+/* Writes a specific entry of the COW allocation table block
+ * The file offset is the offset of the start of the block
  * Returns 1 if successful or -1 on error
  */
-int libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
+int libbfoverlay_cow_allocation_table_block_write_entry_file_io_pool(
      libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block,
      libbfio_pool_t *file_io_pool,
      int file_io_pool_entry,
      off64_t file_offset,
      int entry_index,
-     uint32_t block_number,
-     uint8_t write_header,
      libcerror_error_t **error )
 {
-	uint8_t cow_allocation_table_block_entry_data[ sizeof( bfoverlay_cow_allocation_table_block_entry_t ) ];
-	uint8_t cow_allocation_table_block_header_data[ sizeof( bfoverlay_cow_allocation_table_block_header_t ) ];
+	static char *function = "libbfoverlay_cow_allocation_table_block_write_entry_file_io_pool";
+
+	if( libbfoverlay_cow_allocation_table_block_write_entries_file_io_pool(
+	     cow_allocation_table_block,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     file_offset,
+	     entry_index,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write COW allocation table block entry: %d.",
+		 function,
+		 entry_index );
 
-	static char *function = "libbfoverlay_cow_allocation_table_block_set_block_number_by_index";
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes a range of consecutive entries of the COW allocation table block
+ * The file offset is the offset of the start of the block
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_allocation_table_block_write_entries_file_io_pool(
+     libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t file_offset,
+     int entry_index,
+     int number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_cow_allocation_table_block_write_entries_file_io_pool";
+	size_t data_offset    = 0;
+	size_t write_size     = 0;
 	ssize_t write_count   = 0;
 
 	if( cow_allocation_table_block == NULL )
@@ -279,6 +629,17 @@ int libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
 
 		return( -1 );
 	}
+	if( cow_allocation_table_block->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid COW allocation table block - missing data.",
+		 function );
+
+		return( -1 );
+	}
 	if( ( entry_index < 0 )
 	 || ( entry_index >= cow_allocation_table_block->number_of_entries ) )
 	{
@@ -291,95 +652,40 @@ int libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
 
 		return( -1 );
 	}
-	if( write_header != 0 )
+	if( ( number_of_entries <= 0 )
+	 || ( number_of_entries > ( cow_allocation_table_block->number_of_entries - entry_index ) ) )
 	{
-		if( memory_copy(
-		     cow_allocation_table_block_header_data,
-		     "# BFO-COW-AB",
-		     12 ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy COW allocation table block signature.",
-			 function );
-
-			return( -1 );
-		}
-		if( memory_set(
-		     &( cow_allocation_table_block_header_data[ 12 ] ),
-		     0,
-		     sizeof( bfoverlay_cow_allocation_table_block_header_t ) - 12 ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to clear COW allocation table block header data.",
-			 function );
-
-			return( -1 );
-		}
-		byte_stream_copy_from_uint32_big_endian(
-		 ( (bfoverlay_cow_allocation_table_block_header_t *) cow_allocation_table_block_header_data )->format_version,
-		 LIBBFOVERLAY_COW_FILE_FORMAT_VERSION );
-
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: writing COW allocation table block header at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-			 function,
-			 file_offset,
-			 file_offset );
-		}
-#endif
-		write_count = libbfio_pool_write_buffer_at_offset(
-		              file_io_pool,
-		              file_io_pool_entry,
-		              cow_allocation_table_block_header_data,
-		              sizeof( bfoverlay_cow_allocation_table_block_header_t ),
-		              file_offset,
-		              error );
-
-		if( write_count != (ssize_t) sizeof( bfoverlay_cow_allocation_table_block_header_t ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write COW allocation table block header data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 file_offset,
-			 file_offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	byte_stream_copy_from_uint32_big_endian(
-	 cow_allocation_table_block_entry_data,
-	 block_number );
-
-	file_offset += entry_index * sizeof( bfoverlay_cow_allocation_table_block_entry_t );
+	data_offset  = sizeof( bfoverlay_cow_allocation_table_block_header_t ) + ( (size_t) entry_index * sizeof( bfoverlay_cow_allocation_table_block_entry_t ) );
+	write_size   = (size_t) number_of_entries * sizeof( bfoverlay_cow_allocation_table_block_entry_t );
+	file_offset += (off64_t) data_offset;
 
 	write_count = libbfio_pool_write_buffer_at_offset(
-	              file_io_pool,
-	              file_io_pool_entry,
-	              cow_allocation_table_block_entry_data,
-	              sizeof( bfoverlay_cow_allocation_table_block_entry_t ),
-	              file_offset,
-	              error );
-
-	if( write_count != (ssize_t) sizeof( bfoverlay_cow_allocation_table_block_entry_t ) )
+	               file_io_pool,
+	               file_io_pool_entry,
+	               &( cow_allocation_table_block->data[ data_offset ] ),
+	               write_size,
+	               file_offset,
+	               error );
+
+	if( write_count != (ssize_t) write_size )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write COW allocation table block entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 "%s: unable to write COW allocation table block entries: %d - %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
 		 function,
 		 entry_index,
+		 entry_index + number_of_entries - 1,
 		 file_offset,
 		 file_offset );
 
@@ -388,3 +694,124 @@ int libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
 	return( 1 );
 }
 
+/* Retrieves a specific block number
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
+     libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block,
+     int entry_index,
+     uint32_t *block_number,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_cow_allocation_table_block_get_block_number_by_index";
+	size_t data_offset    = 0;
+
+	if( cow_allocation_table_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW allocation table block.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_allocation_table_block->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid COW allocation table block - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= cow_allocation_table_block->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block number.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset = sizeof( bfoverlay_cow_allocation_table_block_header_t ) + ( (size_t) entry_index * sizeof( bfoverlay_cow_allocation_table_block_entry_t ) );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( cow_allocation_table_block->data[ data_offset ] ),
+	 *block_number );
+
+	return( 1 );
+}
+
+/* Sets a specific block number
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
+     libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block,
+     int entry_index,
+     uint32_t block_number,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_cow_allocation_table_block_set_block_number_by_index";
+	size_t data_offset    = 0;
+
+	if( cow_allocation_table_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW allocation table block.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_allocation_table_block->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid COW allocation table block - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry_index < 0 )
+	 || ( entry_index >= cow_allocation_table_block->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset = sizeof( bfoverlay_cow_allocation_table_block_header_t ) + ( (size_t) entry_index * sizeof( bfoverlay_cow_allocation_table_block_entry_t ) );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( cow_allocation_table_block->data[ data_offset ] ),
+	 block_number );
+
+	return( 1 );
+}
+
@@ -36,9 +36,25 @@ typedef struct libbfoverlay_cow_allocation_table_block libbfoverlay_cow_allocati
 
 struct libbfoverlay_cow_allocation_table_block
 {
+	/* Block number
+	 */
+	uint32_t block_number;
+
+	/* Data
+	 */
+	uint8_t *data;
+
+	/* Data size
+	 */
+	size_t data_size;
+
 	/* Number of entries
 	 */
 	int number_of_entries;
+
+	/* Value to indicate the block contains changes that have not been written
+	 */
+	uint8_t is_dirty;
 };
 
 int libbfoverlay_cow_allocation_table_block_initialize(
@@ -50,23 +66,57 @@ int libbfoverlay_cow_allocation_table_block_free(
      libbfoverlay_cow_allocation_table_block_t **cow_allocation_table_block,
      libcerror_error_t **error );
 
-int libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
+int libbfoverlay_cow_allocation_table_block_clear(
+     libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_allocation_table_block_read_data(
+     libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_allocation_table_block_read_file_io_pool(
+     libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t file_offset,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_allocation_table_block_write_file_io_pool(
+     libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t file_offset,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_allocation_table_block_write_entry_file_io_pool(
      libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block,
      libbfio_pool_t *file_io_pool,
      int file_io_pool_entry,
      off64_t file_offset,
      int entry_index,
-     uint32_t *block_number,
      libcerror_error_t **error );
 
-int libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
+int libbfoverlay_cow_allocation_table_block_write_entries_file_io_pool(
      libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block,
      libbfio_pool_t *file_io_pool,
      int file_io_pool_entry,
      off64_t file_offset,
      int entry_index,
+     int number_of_entries,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
+     libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block,
+     int entry_index,
+     uint32_t *block_number,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
+     libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block,
+     int entry_index,
      uint32_t block_number,
-     uint8_t write_header,
      libcerror_error_t **error );
 
 #if defined( __cplusplus )
@@ -27,9 +27,13 @@
 #include "libbfoverlay_cow_file.h"
 #include "libbfoverlay_cow_file_header.h"
 #include "libbfoverlay_definitions.h"
+#include "libbfoverlay_io_statistics.h"
 #include "libbfoverlay_libbfio.h"
+#include "libbfoverlay_libcdata.h"
 #include "libbfoverlay_libcerror.h"
 #include "libbfoverlay_libcnotify.h"
+#include "libbfoverlay_libcthreads.h"
+#include "libbfoverlay_unused.h"
 
 #include "bfoverlay_cow_allocation_table_block.h"
 #include "bfoverlay_cow_file_header.h"
@@ -100,8 +104,24 @@ int libbfoverlay_cow_file_initialize(
 
 		return( -1 );
 	}
-	( *cow_file )->data_size  = data_size;
-	( *cow_file )->block_size = 4096;
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *cow_file )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *cow_file )->data_size          = data_size;
+	( *cow_file )->block_size         = LIBBFOVERLAY_COW_DEFAULT_BLOCK_SIZE;
+	( *cow_file )->maximum_cache_size = LIBBFOVERLAY_DEFAULT_MAXIMUM_CACHE_SIZE;
 
 	return( 1 );
 
@@ -139,7 +159,7 @@ int libbfoverlay_cow_file_free(
 	}
 	if( *cow_file != NULL )
 	{
-		if( ( *cow_file )->allocation_table_block != NULL )
+		if( ( *cow_file )->l1_allocation_table_block != NULL )
 		{
 			if( libbfoverlay_cow_file_close(
 			     *cow_file,
@@ -155,6 +175,31 @@ int libbfoverlay_cow_file_free(
 				result = -1;
 			}
 		}
+		if( ( *cow_file )->free_blocks_bitmap != NULL )
+		{
+			memory_free(
+			 ( *cow_file )->free_blocks_bitmap );
+		}
+		if( ( *cow_file )->pending_free_blocks != NULL )
+		{
+			memory_free(
+			 ( *cow_file )->pending_free_blocks );
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *cow_file )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *cow_file );
 
@@ -175,6 +220,7 @@ int libbfoverlay_cow_file_open(
 	libbfoverlay_cow_file_header_t *file_header = NULL;
 	static char *function                       = "libbfoverlay_cow_file_open";
 	size64_t file_size                          = 0;
+	size_t number_of_cache_entries              = 0;
 	uint64_t number_of_blocks                   = 0;
 
 	if( cow_file == NULL )
@@ -188,13 +234,24 @@ int libbfoverlay_cow_file_open(
 
 		return( -1 );
 	}
-	if( cow_file->allocation_table_block != NULL )
+	if( cow_file->l1_allocation_table_block != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid COW file - level 1 allocation table block value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_file->allocation_table_block_cache != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid COW file - allocation table block value already set.",
+		 "%s: invalid COW file - allocation table block cache value already set.",
 		 function );
 
 		return( -1 );
@@ -229,7 +286,8 @@ int libbfoverlay_cow_file_open(
 	}
 	if( file_size == 0 )
 	{
-		file_header->data_size = cow_file->data_size;
+		file_header->block_size = cow_file->block_size;
+		file_header->data_size  = cow_file->data_size;
 
 		if( libbfoverlay_cow_file_header_write_file_io_pool(
 		     file_header,
@@ -247,6 +305,7 @@ int libbfoverlay_cow_file_open(
 
 			goto on_error;
 		}
+		file_size = (size64_t) file_header->block_size;
 	}
 	else
 	{
@@ -267,8 +326,9 @@ int libbfoverlay_cow_file_open(
 			goto on_error;
 		}
 	}
-	if( ( (size_t) file_header->block_size < sizeof( bfoverlay_cow_file_header_t ) )
-	 || ( file_header->block_size != cow_file->block_size ) )
+	if( ( file_header->block_size < LIBBFOVERLAY_COW_MINIMUM_BLOCK_SIZE )
+	 || ( file_header->block_size > LIBBFOVERLAY_COW_MAXIMUM_BLOCK_SIZE )
+	 || ( ( file_header->block_size & ( file_header->block_size - 1 ) ) != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -279,6 +339,10 @@ int libbfoverlay_cow_file_open(
 
 		goto on_error;
 	}
+	/* An existing COW file determines the block size
+	 */
+	cow_file->block_size = file_header->block_size;
+
 	number_of_blocks = (uint64_t) file_header->data_size / file_header->block_size;
 
 	if( number_of_blocks > ( (uint64_t) UINT32_MAX - 1 ) )
@@ -292,10 +356,35 @@ int libbfoverlay_cow_file_open(
 
 		goto on_error;
 	}
+	if( file_header->number_of_allocated_blocks == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of allocated blocks value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	/* The last block number is that of the last (partial) block in the COW file
+	 */
+	number_of_blocks = ( file_size - 1 ) / file_header->block_size;
+
+	if( number_of_blocks >= (uint64_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
 	cow_file->data_size                  = file_header->data_size;
 	cow_file->number_of_allocated_blocks = file_header->number_of_allocated_blocks;
-	cow_file->last_data_block_number     = (uint32_t) ( file_size / cow_file->block_size );
-	cow_file->l1_allocation_table_offset = (off64_t) sizeof( bfoverlay_cow_file_header_t );
+	cow_file->last_data_block_number     = (uint32_t) number_of_blocks;
 
 	if( libbfoverlay_cow_file_header_free(
 	     &file_header,
@@ -311,7 +400,7 @@ int libbfoverlay_cow_file_open(
 		goto on_error;
 	}
 	if( libbfoverlay_cow_allocation_table_block_initialize(
-	     &( cow_file->allocation_table_block ),
+	     &( cow_file->l1_allocation_table_block ),
 	     cow_file->block_size,
 	     error ) != 1 )
 	{
@@ -319,7 +408,58 @@ int libbfoverlay_cow_file_open(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create COW allocation table block.",
+		 "%s: unable to create level 1 COW allocation table block.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_cow_allocation_table_block_read_file_io_pool(
+	     cow_file->l1_allocation_table_block,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read level 1 COW allocation table block.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( cow_file->number_of_allocated_blocks % cow_file->l1_allocation_table_block->number_of_entries ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of allocated blocks value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	number_of_cache_entries = cow_file->maximum_cache_size / cow_file->block_size;
+
+	if( number_of_cache_entries == 0 )
+	{
+		number_of_cache_entries = 1;
+	}
+	else if( number_of_cache_entries > (size_t) INT_MAX )
+	{
+		number_of_cache_entries = (size_t) INT_MAX;
+	}
+	if( libcdata_array_initialize(
+	     &( cow_file->allocation_table_block_cache ),
+	     (int) number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create allocation table block cache.",
 		 function );
 
 		goto on_error;
@@ -333,23 +473,24 @@ on_error:
 		 &file_header,
 		 NULL );
 	}
-	if( cow_file->allocation_table_block != NULL )
+	if( cow_file->l1_allocation_table_block != NULL )
 	{
 		libbfoverlay_cow_allocation_table_block_free(
-		 &( cow_file->allocation_table_block ),
+		 &( cow_file->l1_allocation_table_block ),
 		 NULL );
 	}
 	return( -1 );
 }
 
 /* Closes a COW file
- * Returns 1 if successful or -1 on error
+ * Returns 0 if successful or -1 on error
  */
 int libbfoverlay_cow_file_close(
      libbfoverlay_cow_file_t *cow_file,
      libcerror_error_t **error )
 {
 	static char *function = "libbfoverlay_cow_file_close";
+	int result            = 0;
 
 	if( cow_file == NULL )
 	{
@@ -362,37 +503,70 @@ int libbfoverlay_cow_file_close(
 
 		return( -1 );
 	}
+	if( cow_file->allocation_table_block_cache != NULL )
+	{
+		if( libcdata_array_free(
+		     &( cow_file->allocation_table_block_cache ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libbfoverlay_cow_allocation_table_block_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free allocation table block cache.",
+			 function );
+
+			result = -1;
+		}
+	}
 	if( libbfoverlay_cow_allocation_table_block_free(
-	     &( cow_file->allocation_table_block ),
+	     &( cow_file->l1_allocation_table_block ),
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free COW allocation table block.",
+		 "%s: unable to free level 1 COW allocation table block.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	return( 1 );
+	if( cow_file->free_blocks_bitmap != NULL )
+	{
+		memory_free(
+		 cow_file->free_blocks_bitmap );
+
+		cow_file->free_blocks_bitmap = NULL;
+	}
+	if( cow_file->pending_free_blocks != NULL )
+	{
+		memory_free(
+		 cow_file->pending_free_blocks );
+
+		cow_file->pending_free_blocks = NULL;
+	}
+	cow_file->number_of_dirty_blocks              = 0;
+	cow_file->free_blocks_bitmap_number_of_blocks = 0;
+	cow_file->number_of_free_blocks               = 0;
+	cow_file->free_blocks_search_block_number     = 0;
+	cow_file->free_blocks_read                    = 0;
+	cow_file->pending_free_blocks_size            = 0;
+	cow_file->number_of_pending_free_blocks       = 0;
+
+	return( result );
 }
 
-/* Sets the data size in the file header
+/* Retrieves the maximum allocation table cache size
  * Returns 1 if successful or -1 on error
  */
-int libbfoverlay_cow_file_set_data_size(
+int libbfoverlay_cow_file_get_maximum_cache_size(
      libbfoverlay_cow_file_t *cow_file,
-     libbfio_pool_t *file_io_pool,
-     int file_io_pool_entry,
-     size64_t data_size,
+     size_t *maximum_cache_size,
      libcerror_error_t **error )
 {
-	uint8_t cow_file_header_data[ 8 ];
-
-	static char *function = "libbfoverlay_cow_file_set_data_size";
-	ssize_t write_count   = 0;
-	off64_t file_offset   = 0;
+	static char *function = "libbfoverlay_cow_file_get_maximum_cache_size";
 
 	if( cow_file == NULL )
 	{
@@ -405,65 +579,35 @@ int libbfoverlay_cow_file_set_data_size(
 
 		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: data size\t\t\t: %" PRIu64 "\n",
-		 function,
-		 data_size );
-
-		libcnotify_printf(
-		 "\n" );
-	}
-#endif /* defined( HAVE_DEBUG_OUTPUT ) */
-
-	byte_stream_copy_from_uint64_big_endian(
-	 cow_file_header_data,
-	 data_size );
-
-	file_offset = 16;
-
-	write_count = libbfio_pool_write_buffer_at_offset(
-	               file_io_pool,
-	               file_io_pool_entry,
-	               cow_file_header_data,
-	               8,
-	               file_offset,
-	               error );
-
-	if( write_count != (ssize_t) 8 )
+	if( maximum_cache_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write data size at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 file_offset,
-		 file_offset );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum cache size.",
+		 function );
 
 		return( -1 );
 	}
-	cow_file->data_size = data_size;
+	*maximum_cache_size = cow_file->maximum_cache_size;
 
 	return( 1 );
 }
 
-/* Enlarges the allocation table
+/* Sets the maximum allocation table cache size
+ * The level 1 allocation table is always kept in memory, the cache size
+ * determines the number of level 2 and higher allocation table blocks that
+ * are kept in memory. At least one allocation table block is cached.
  * Returns 1 if successful or -1 on error
  */
-int libbfoverlay_cow_file_enlarge_allocation_table(
+int libbfoverlay_cow_file_set_maximum_cache_size(
      libbfoverlay_cow_file_t *cow_file,
-     libbfio_pool_t *file_io_pool,
-     int file_io_pool_entry,
+     size_t maximum_cache_size,
      libcerror_error_t **error )
 {
-	uint8_t *block_data   = NULL;
-	static char *function = "libbfoverlay_cow_file_enlarge_allocation_table";
-	ssize_t read_count    = 0;
-	ssize_t write_count   = 0;
-	off64_t file_offset   = 0;
+	static char *function          = "libbfoverlay_cow_file_set_maximum_cache_size";
+	size_t number_of_cache_entries = 0;
 
 	if( cow_file == NULL )
 	{
@@ -476,227 +620,227 @@ int libbfoverlay_cow_file_enlarge_allocation_table(
 
 		return( -1 );
 	}
-	if( cow_file->allocation_table_block == NULL )
+	if( maximum_cache_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid COW file - missing allocation table block.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum cache size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( cow_file->number_of_allocated_blocks == 0 )
-	 || ( cow_file->number_of_allocated_blocks > ( (uint32_t) UINT32_MAX / cow_file->allocation_table_block->number_of_entries ) ) )
+	if( cow_file->allocation_table_block_cache != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid number of allocated blocks value out of bounds.",
-		 function );
+		if( cow_file->number_of_dirty_blocks != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid COW file - allocation table contains changes that have not been written.",
+			 function );
 
-		return( -1 );
+			return( -1 );
+		}
+		number_of_cache_entries = maximum_cache_size / cow_file->block_size;
+
+		if( number_of_cache_entries == 0 )
+		{
+			number_of_cache_entries = 1;
+		}
+		else if( number_of_cache_entries > (size_t) INT_MAX )
+		{
+			number_of_cache_entries = (size_t) INT_MAX;
+		}
+		/* The cache entries are mapped by block number hence they need to be emptied
+		 * before the cache is resized
+		 */
+		if( libcdata_array_clear(
+		     cow_file->allocation_table_block_cache,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libbfoverlay_cow_allocation_table_block_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to clear allocation table block cache.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcdata_array_resize(
+		     cow_file->allocation_table_block_cache,
+		     (int) number_of_cache_entries,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libbfoverlay_cow_allocation_table_block_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize allocation table block cache.",
+			 function );
+
+			return( -1 );
+		}
 	}
-	block_data = (uint8_t *) memory_allocate(
-	                          cow_file->block_size );
+	cow_file->maximum_cache_size = maximum_cache_size;
+
+	return( 1 );
+}
+
+/* Retrieves the maximum size of allocation table blocks with changes that have not been written
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_get_maximum_dirty_size(
+     libbfoverlay_cow_file_t *cow_file,
+     size_t *maximum_dirty_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_cow_file_get_maximum_dirty_size";
 
-	if( block_data == NULL )
+	if( cow_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create block data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( memory_set(
-	     block_data,
-	     0,
-	     cow_file->block_size ) == NULL )
+	if( maximum_dirty_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear block data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum dirty size.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	/* Read COW file header block with level 1 allocation table
-	 */
-	read_count = libbfio_pool_read_buffer_at_offset(
-	             file_io_pool,
-	             file_io_pool_entry,
-	             block_data,
-	             (size_t) cow_file->block_size,
-	             file_offset,
-	             error );
+	*maximum_dirty_size = cow_file->maximum_dirty_size;
 
-	if( read_count != (ssize_t) cow_file->block_size )
+	return( 1 );
+}
+
+/* Sets the maximum size of allocation table blocks with changes that have not been written
+ * A maximum dirty size of 0 represents that changes are written immediately
+ * Changes that exceed the new maximum dirty size are written
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_set_maximum_dirty_size(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size_t maximum_dirty_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_cow_file_set_maximum_dirty_size";
+
+	if( cow_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 file_offset,
-		 file_offset );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	/* Copy the level 1 allocation to a COW level 2 allocation table block
-	 */
-	if( memory_copy(
-	     block_data,
-	     "# BFO-COW-AB",
-	     12 ) == NULL )
+	if( maximum_dirty_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy COW allocation table block signature.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum dirty size value exceeds maximum.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	byte_stream_copy_from_uint32_big_endian(
-	 &( block_data[ 12 ] ),
-	 LIBBFOVERLAY_COW_FILE_FORMAT_VERSION );
+	cow_file->maximum_dirty_size = maximum_dirty_size;
 
-	if( memory_set(
-	     &( block_data[ 16 ] ),
-	     0,
-	     sizeof( bfoverlay_cow_allocation_table_block_header_t ) - 16 ) == NULL )
+	/* Blocks released while changes were not written immediately are marked as free on flush
+	 */
+	if( ( ( cow_file->number_of_dirty_blocks > 0 )
+	  && ( ( (size_t) cow_file->number_of_dirty_blocks * cow_file->block_size ) > maximum_dirty_size ) )
+	 || ( ( maximum_dirty_size == 0 )
+	  && ( cow_file->number_of_pending_free_blocks > 0 ) ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear COW allocation table block header data.",
-		 function );
+		if( libbfoverlay_cow_file_flush(
+		     cow_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush COW file.",
+			 function );
 
-		goto on_error;
+			return( -1 );
+		}
 	}
-	cow_file->last_data_block_number += 1;
-
-	file_offset = (off64_t) cow_file->last_data_block_number * cow_file->block_size;
-
-	/* Write a COW level 2 allocation table block
-	 */
-	write_count = libbfio_pool_write_buffer_at_offset(
-	               file_io_pool,
-	               file_io_pool_entry,
-	               block_data,
-	               (size_t) cow_file->block_size,
-	               file_offset,
-	               error );
+	return( 1 );
+}
 
-	if( write_count != (ssize_t) cow_file->block_size )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write COW allocation table block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 file_offset,
-		 file_offset );
+/* Retrieves the block size
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_get_block_size(
+     libbfoverlay_cow_file_t *cow_file,
+     size32_t *block_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_cow_file_get_block_size";
 
-		goto on_error;
-	}
-	/* Update the number of allocated blocks and the level 1 allocation table
-	 */
-	if( memory_set(
-	     block_data,
-	     0,
-	     cow_file->block_size ) == NULL )
+	if( cow_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear block data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	cow_file->number_of_allocated_blocks *= cow_file->allocation_table_block->number_of_entries;
-
-	byte_stream_copy_to_uint32_big_endian(
-	 &( block_data[ 28 ] ),
-	 cow_file->number_of_allocated_blocks );
-
-	byte_stream_copy_to_uint32_big_endian(
-	 &( block_data[ 32 ] ),
-	 cow_file->last_data_block_number );
-
-	file_offset = 28;
-
-	write_count = libbfio_pool_write_buffer_at_offset(
-	               file_io_pool,
-	               file_io_pool_entry,
-	               &( block_data[ 28 ] ),
-	               cow_file->block_size - 28,
-	               file_offset,
-	               error );
-
-	if( write_count != (ssize_t) cow_file->block_size - 28 )
+	if( block_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 file_offset,
-		 file_offset );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block size.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	memory_free(
-	 block_data );
+	*block_size = cow_file->block_size;
 
 	return( 1 );
-
-on_error:
-	if( block_data != NULL )
-	{
-		memory_free(
-		 block_data );
-	}
-	return( -1 );
 }
 
-/* Allocates a new data block for a specific offset
+/* Sets the block size
+ * The block size is only used when a new COW file is created, an existing COW file
+ * is opened with the block size stored in its file header
  * Returns 1 if successful or -1 on error
  */
-int libbfoverlay_cow_file_allocate_block_for_offset(
+int libbfoverlay_cow_file_set_block_size(
      libbfoverlay_cow_file_t *cow_file,
-     libbfio_pool_t *file_io_pool,
-     int file_io_pool_entry,
-     off64_t offset,
-     off64_t *file_offset,
+     size32_t block_size,
      libcerror_error_t **error )
 {
-	uint8_t cow_allocation_table_entry_data[ sizeof( bfoverlay_cow_allocation_table_block_entry_t ) ];
-
-	static char *function     = "libbfoverlay_cow_file_allocate_block_for_offset";
-	ssize_t read_count        = 0;
-	ssize_t write_count       = 0;
-	off64_t safe_file_offset  = 0;
-	off64_t table_index       = 0;
-	uint32_t block_number     = 0;
-	uint32_t blocks_per_entry = 0;
-	uint8_t write_header      = 0;
-	int depth                 = 0;
-	int entry_index           = 0;
+	static char *function = "libbfoverlay_cow_file_set_block_size";
 
 	if( cow_file == NULL )
 	{
@@ -709,249 +853,172 @@ int libbfoverlay_cow_file_allocate_block_for_offset(
 
 		return( -1 );
 	}
-	if( cow_file->allocation_table_block == NULL )
+	if( cow_file->l1_allocation_table_block != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid COW file - missing allocation table block.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid COW file - level 1 allocation table block value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( cow_file->number_of_allocated_blocks == 0 )
+	if( ( block_size < LIBBFOVERLAY_COW_MINIMUM_BLOCK_SIZE )
+	 || ( block_size > LIBBFOVERLAY_COW_MAXIMUM_BLOCK_SIZE )
+	 || ( ( block_size & ( block_size - 1 ) ) != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid COW file - number of allocated blocks value out of bounds.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported block size: %" PRIu32 ".",
+		 function,
+		 block_size );
 
 		return( -1 );
 	}
-	if( cow_file->allocation_table_block->number_of_entries == 0 )
+	cow_file->block_size = block_size;
+
+	return( 1 );
+}
+
+/* Retrieves the allocation table block cache entry for a specific block number
+ * This function does not read the allocation table block
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_get_cache_entry(
+     libbfoverlay_cow_file_t *cow_file,
+     uint32_t block_number,
+     libbfoverlay_cow_allocation_table_block_t **allocation_table_block,
+     libcerror_error_t **error )
+{
+	libbfoverlay_cow_allocation_table_block_t *safe_allocation_table_block = NULL;
+	static char *function                                                 = "libbfoverlay_cow_file_get_cache_entry";
+	int cache_entry_index                                                 = 0;
+	int number_of_cache_entries                                           = 0;
+
+	if( cow_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid COW file - invalid allocation table block - number of entries value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
 		 function );
 
 		return( -1 );
 	}
-	if( offset < 0 )
+	if( allocation_table_block == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation table block.",
 		 function );
 
 		return( -1 );
 	}
-	if( file_offset == NULL )
+	if( libcdata_array_get_number_of_entries(
+	     cow_file->allocation_table_block_cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of allocation table block cache entries.",
 		 function );
 
 		return( -1 );
 	}
-	table_index = offset / cow_file->block_size;
-
-	if( table_index >= (off64_t) cow_file->number_of_allocated_blocks )
-	{
-		if( libbfoverlay_cow_file_enlarge_allocation_table(
-		     cow_file,
-		     file_io_pool,
-		     file_io_pool_entry,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to enlarge allocation table.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	blocks_per_entry = cow_file->number_of_allocated_blocks / cow_file->allocation_table_block->number_of_entries;
-
-	if( blocks_per_entry == 0 )
+	if( number_of_cache_entries <= 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: blocks per entry value out of bounds.",
+		 "%s: invalid number of allocation table block cache entries value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	entry_index      = table_index / blocks_per_entry;
-	safe_file_offset = cow_file->l1_allocation_table_offset + ( entry_index * sizeof( bfoverlay_cow_allocation_table_block_entry_t ) );
+	cache_entry_index = (int) ( block_number % (uint32_t) number_of_cache_entries );
 
-	read_count = libbfio_pool_read_buffer_at_offset(
-	             file_io_pool,
-	             file_io_pool_entry,
-	             cow_allocation_table_entry_data,
-	             sizeof( bfoverlay_cow_allocation_table_block_entry_t ),
-	             safe_file_offset,
-	             error );
-
-	if( read_count != (ssize_t) sizeof( bfoverlay_cow_allocation_table_block_entry_t ) )
+	if( libcdata_array_get_entry_by_index(
+	     cow_file->allocation_table_block_cache,
+	     cache_entry_index,
+	     (intptr_t **) &safe_allocation_table_block,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read level 1 COW allocation table entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve allocation table block cache entry: %d.",
 		 function,
-		 entry_index,
-		 safe_file_offset,
-		 safe_file_offset );
+		 cache_entry_index );
 
 		return( -1 );
 	}
-	byte_stream_copy_to_uint32_big_endian(
-	 cow_allocation_table_entry_data,
-	 block_number );
-
-	if( block_number == LIBBFOVERLAY_COW_BLOCK_NUMBER_NOT_SET )
+	if( safe_allocation_table_block == NULL )
 	{
-		cow_file->last_data_block_number += 1;
-
-		block_number = cow_file->last_data_block_number;
-
-		byte_stream_copy_from_uint32_big_endian(
-		 cow_allocation_table_entry_data,
-		 block_number );
-
-		write_count = libbfio_pool_write_buffer_at_offset(
-		               file_io_pool,
-		               file_io_pool_entry,
-		               cow_allocation_table_entry_data,
-		               sizeof( bfoverlay_cow_allocation_table_block_entry_t ),
-		               safe_file_offset,
-		               error );
-
-		if( write_count != (ssize_t) sizeof( bfoverlay_cow_allocation_table_block_entry_t ) )
+		if( libbfoverlay_cow_allocation_table_block_initialize(
+		     &safe_allocation_table_block,
+		     cow_file->block_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write COW level 1 allocation table entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 entry_index,
-			 safe_file_offset,
-			 safe_file_offset );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create COW allocation table block.",
+			 function );
 
 			return( -1 );
 		}
-	}
-	depth = 2;
-
-	while( blocks_per_entry > 1 )
-	{
-		safe_file_offset = (off64_t) block_number * cow_file->block_size;
-
-		table_index      -= entry_index * blocks_per_entry;
-		blocks_per_entry /= cow_file->allocation_table_block->number_of_entries;
-		entry_index       = table_index / blocks_per_entry;
-
-		if( libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
-		     cow_file->allocation_table_block,
-		     file_io_pool,
-		     file_io_pool_entry,
-		     safe_file_offset,
-		     entry_index,
-		     &block_number,
+		if( libcdata_array_set_entry_by_index(
+		     cow_file->allocation_table_block_cache,
+		     cache_entry_index,
+		     (intptr_t *) safe_allocation_table_block,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve level %d COW allocation table entry: %d at offset %" PRIi64 " (0x%08" PRIx64 ").",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set allocation table block cache entry: %d.",
 			 function,
-			 depth,
-			 entry_index,
-			 safe_file_offset,
-			 safe_file_offset );
-
-			return( -1 );
-		}
-		if( block_number == LIBBFOVERLAY_COW_BLOCK_NUMBER_NOT_SET )
-		{
-			cow_file->last_data_block_number += 1;
-
-			block_number = cow_file->last_data_block_number;
+			 cache_entry_index );
 
-			if( libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
-			     cow_file->allocation_table_block,
-			     file_io_pool,
-			     file_io_pool_entry,
-			     safe_file_offset,
-			     entry_index,
-			     block_number,
-			     write_header,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set level %d COW allocation table entry: %d at offset %" PRIi64 " (0x%08" PRIx64 ").",
-				 function,
-				 depth,
-				 entry_index,
-				 safe_file_offset,
-				 safe_file_offset );
+			libbfoverlay_cow_allocation_table_block_free(
+			 &safe_allocation_table_block,
+			 NULL );
 
-				return( -1 );
-			}
-			write_header = 1;
+			return( -1 );
 		}
-		depth++;
 	}
-	*file_offset = (off64_t) cow_file->last_data_block_number * cow_file->block_size;
+	*allocation_table_block = safe_allocation_table_block;
 
 	return( 1 );
 }
 
-/* Retrieve the data block for a specific offset
- * Returns 1 if successful, 0 if no data block exists or -1 on error
+/* Retrieves a specific allocation table block if it is cached
+ * This function does not modify the allocation table block cache
+ * Returns 1 if successful, 0 if the allocation table block is not cached or -1 on error
  */
-int libbfoverlay_cow_file_get_block_at_offset(
+int libbfoverlay_cow_file_get_cached_allocation_table_block(
      libbfoverlay_cow_file_t *cow_file,
-     libbfio_pool_t *file_io_pool,
-     int file_io_pool_entry,
-     off64_t offset,
-     off64_t *range_start_offset,
-     off64_t *range_end_offset,
-     off64_t *file_offset,
+     uint32_t block_number,
+     libbfoverlay_cow_allocation_table_block_t **allocation_table_block,
      libcerror_error_t **error )
 {
-	uint8_t cow_allocation_table_entry_data[ sizeof( bfoverlay_cow_allocation_table_block_entry_t ) ];
-
-	static char *function     = "libbfoverlay_cow_file_get_block_at_offset";
-	ssize_t read_count        = 0;
-	off64_t safe_file_offset  = 0;
-	off64_t table_index       = 0;
-	uint32_t block_number     = 0;
-	uint32_t blocks_per_entry = 0;
-	int depth                 = 0;
-	int entry_index           = 0;
+	libbfoverlay_cow_allocation_table_block_t *safe_allocation_table_block = NULL;
+	static char *function                                                 = "libbfoverlay_cow_file_get_cached_allocation_table_block";
+	int cache_entry_index                                                 = 0;
+	int number_of_cache_entries                                           = 0;
 
 	if( cow_file == NULL )
 	{
@@ -964,86 +1031,3645 @@ int libbfoverlay_cow_file_get_block_at_offset(
 
 		return( -1 );
 	}
-	if( cow_file->allocation_table_block == NULL )
+	if( cow_file->l1_allocation_table_block == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid COW file - missing allocation table block.",
+		 "%s: invalid COW file - missing level 1 allocation table block.",
 		 function );
 
 		return( -1 );
 	}
-	if( cow_file->number_of_allocated_blocks == 0 )
+	if( allocation_table_block == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid COW file - number of allocated blocks value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation table block.",
 		 function );
 
 		return( -1 );
 	}
-	if( cow_file->allocation_table_block->number_of_entries == 0 )
+	if( block_number == 0 )
+	{
+		*allocation_table_block = cow_file->l1_allocation_table_block;
+
+		return( 1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     cow_file->allocation_table_block_cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid COW file - invalid allocation table block - number of entries value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of allocation table block cache entries.",
 		 function );
 
 		return( -1 );
 	}
-	if( offset < 0 )
+	if( number_of_cache_entries <= 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 "%s: invalid number of allocation table block cache entries value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( range_start_offset == NULL )
+	cache_entry_index = (int) ( block_number % (uint32_t) number_of_cache_entries );
+
+	if( libcdata_array_get_entry_by_index(
+	     cow_file->allocation_table_block_cache,
+	     cache_entry_index,
+	     (intptr_t **) &safe_allocation_table_block,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid range start offset.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve allocation table block cache entry: %d.",
+		 function,
+		 cache_entry_index );
 
 		return( -1 );
 	}
-	if( range_end_offset == NULL )
+	if( ( safe_allocation_table_block == NULL )
+	 || ( safe_allocation_table_block->block_number != block_number ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		return( 0 );
+	}
+	*allocation_table_block = safe_allocation_table_block;
+
+	return( 1 );
+}
+
+/* Retrieves a specific allocation table block
+ * The allocation table block is read from the COW file if it is not cached
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_get_allocation_table_block(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint32_t block_number,
+     libbfoverlay_cow_allocation_table_block_t **allocation_table_block,
+     libcerror_error_t **error )
+{
+	libbfoverlay_cow_allocation_table_block_t *safe_allocation_table_block = NULL;
+	static char *function                                                 = "libbfoverlay_cow_file_get_allocation_table_block";
+	off64_t file_offset                                                   = 0;
+	uint64_t start_timestamp                                              = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_file->l1_allocation_table_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid COW file - missing level 1 allocation table block.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_number > cow_file->last_data_block_number )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_table_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation table block.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_number == 0 )
+	{
+		*allocation_table_block = cow_file->l1_allocation_table_block;
+
+		return( 1 );
+	}
+	if( libbfoverlay_cow_file_get_cache_entry(
+	     cow_file,
+	     block_number,
+	     &safe_allocation_table_block,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve allocation table block cache entry for block: %" PRIu32 ".",
+		 function,
+		 block_number );
+
+		return( -1 );
+	}
+	if( safe_allocation_table_block->block_number != block_number )
+	{
+		/* Changes in the cache entry must be written before it is reused
+		 */
+		if( safe_allocation_table_block->is_dirty != 0 )
+		{
+			if( libbfoverlay_cow_file_write_allocation_table_block(
+			     cow_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     safe_allocation_table_block,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write COW allocation table block: %" PRIu32 ".",
+				 function,
+				 safe_allocation_table_block->block_number );
+
+				return( -1 );
+			}
+		}
+		/* Block number 0 is used to indicate that the cache entry does not contain valid data
+		 */
+		safe_allocation_table_block->block_number = 0;
+
+		file_offset = (off64_t) block_number * cow_file->block_size;
+
+		if( cow_file->io_statistics != NULL )
+		{
+			if( libbfoverlay_io_statistics_get_timestamp(
+			     &start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve start timestamp.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( libbfoverlay_cow_allocation_table_block_read_file_io_pool(
+		     safe_allocation_table_block,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     file_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read COW allocation table block: %" PRIu32 " at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 block_number,
+			 file_offset,
+			 file_offset );
+
+			return( -1 );
+		}
+		if( cow_file->io_statistics != NULL )
+		{
+			if( libbfoverlay_io_statistics_add_io(
+			     cow_file->io_statistics,
+			     LIBBFOVERLAY_IO_TYPE_COW_METADATA_READ,
+			     0,
+			     (size_t) cow_file->block_size,
+			     start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update IO statistics.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		safe_allocation_table_block->block_number = block_number;
+	}
+	*allocation_table_block = safe_allocation_table_block;
+
+	return( 1 );
+}
+
+/* Creates a new (empty) allocation table block for a specific block number
+ * The allocation table block is only created in memory, it must be written
+ * by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_create_allocation_table_block(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint32_t block_number,
+     libbfoverlay_cow_allocation_table_block_t **allocation_table_block,
+     libcerror_error_t **error )
+{
+	libbfoverlay_cow_allocation_table_block_t *safe_allocation_table_block = NULL;
+	static char *function                                                 = "libbfoverlay_cow_file_create_allocation_table_block";
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_number == 0 )
+	 || ( block_number > cow_file->last_data_block_number ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_table_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation table block.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfoverlay_cow_file_get_cache_entry(
+	     cow_file,
+	     block_number,
+	     &safe_allocation_table_block,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve allocation table block cache entry for block: %" PRIu32 ".",
+		 function,
+		 block_number );
+
+		return( -1 );
+	}
+	/* Changes in the cache entry must be written before it is reused
+	 */
+	if( ( safe_allocation_table_block->block_number != block_number )
+	 && ( safe_allocation_table_block->is_dirty != 0 ) )
+	{
+		if( libbfoverlay_cow_file_write_allocation_table_block(
+		     cow_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     safe_allocation_table_block,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write COW allocation table block: %" PRIu32 ".",
+			 function,
+			 safe_allocation_table_block->block_number );
+
+			return( -1 );
+		}
+	}
+	if( libbfoverlay_cow_allocation_table_block_clear(
+	     safe_allocation_table_block,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to clear COW allocation table block.",
+		 function );
+
+		return( -1 );
+	}
+	safe_allocation_table_block->block_number = block_number;
+
+	if( cow_file->io_statistics != NULL )
+	{
+		if( libbfoverlay_io_statistics_add_count(
+		     cow_file->io_statistics,
+		     LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_ALLOCATED_TABLE_BLOCKS,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update IO statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*allocation_table_block = safe_allocation_table_block;
+
+	return( 1 );
+}
+
+/* Writes an allocation table block
+ * The level 1 allocation table block is written including the file header
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_write_allocation_table_block(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libbfoverlay_cow_allocation_table_block_t *allocation_table_block,
+     libcerror_error_t **error )
+{
+	static char *function    = "libbfoverlay_cow_file_write_allocation_table_block";
+	ssize_t write_count      = 0;
+	off64_t file_offset      = 0;
+	uint64_t start_timestamp = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_table_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation table block.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_file->io_statistics != NULL )
+	{
+		if( libbfoverlay_io_statistics_get_timestamp(
+		     &start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( allocation_table_block == cow_file->l1_allocation_table_block )
+	{
+		write_count = libbfio_pool_write_buffer_at_offset(
+		               file_io_pool,
+		               file_io_pool_entry,
+		               allocation_table_block->data,
+		               allocation_table_block->data_size,
+		               0,
+		               error );
+
+		if( write_count != (ssize_t) allocation_table_block->data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write level 1 COW allocation table block.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		if( allocation_table_block->block_number == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid allocation table block - block number value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		file_offset = (off64_t) allocation_table_block->block_number * cow_file->block_size;
+
+		if( libbfoverlay_cow_allocation_table_block_write_file_io_pool(
+		     allocation_table_block,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     file_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write COW allocation table block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 file_offset,
+			 file_offset );
+
+			return( -1 );
+		}
+	}
+	if( cow_file->io_statistics != NULL )
+	{
+		if( libbfoverlay_io_statistics_add_io(
+		     cow_file->io_statistics,
+		     LIBBFOVERLAY_IO_TYPE_COW_METADATA_WRITE,
+		     0,
+		     allocation_table_block->data_size,
+		     start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update IO statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( allocation_table_block->is_dirty != 0 )
+	{
+		allocation_table_block->is_dirty = 0;
+
+		cow_file->number_of_dirty_blocks -= 1;
+	}
+	return( 1 );
+}
+
+/* Marks an allocation table block as containing changes that have not been written
+ * All changes are written when the maximum dirty size is exceeded
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_set_allocation_table_block_dirty(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libbfoverlay_cow_allocation_table_block_t *allocation_table_block,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_cow_file_set_allocation_table_block_dirty";
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_table_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation table block.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_table_block->is_dirty == 0 )
+	{
+		allocation_table_block->is_dirty = 1;
+
+		cow_file->number_of_dirty_blocks += 1;
+	}
+	if( ( (size_t) cow_file->number_of_dirty_blocks * cow_file->block_size ) > cow_file->maximum_dirty_size )
+	{
+		if( libbfoverlay_cow_file_flush(
+		     cow_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush COW file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes consecutive entries of an allocation table block
+ * If a maximum dirty size is set the entries are written on flush
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_write_allocation_table_entries(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libbfoverlay_cow_allocation_table_block_t *allocation_table_block,
+     int entry_index,
+     int number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function    = "libbfoverlay_cow_file_write_allocation_table_entries";
+	off64_t file_offset      = 0;
+	uint64_t start_timestamp = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_table_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation table block.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_file->maximum_dirty_size != 0 )
+	{
+		if( libbfoverlay_cow_file_set_allocation_table_block_dirty(
+		     cow_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     allocation_table_block,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to mark COW allocation table block: %" PRIu32 " as dirty.",
+			 function,
+			 allocation_table_block->block_number );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	file_offset = (off64_t) allocation_table_block->block_number * cow_file->block_size;
+
+	if( cow_file->io_statistics != NULL )
+	{
+		if( libbfoverlay_io_statistics_get_timestamp(
+		     &start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libbfoverlay_cow_allocation_table_block_write_entries_file_io_pool(
+	     allocation_table_block,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     file_offset,
+	     entry_index,
+	     number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write COW allocation table entries: %d - %d at offset %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 entry_index,
+		 entry_index + number_of_entries - 1,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	if( cow_file->io_statistics != NULL )
+	{
+		if( libbfoverlay_io_statistics_add_io(
+		     cow_file->io_statistics,
+		     LIBBFOVERLAY_IO_TYPE_COW_METADATA_WRITE,
+		     0,
+		     (size_t) number_of_entries * 4,
+		     start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update IO statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes all allocation table blocks with changes that have not been written
+ * The level 1 allocation table block, which contains the file header, is written last
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_flush(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	libbfoverlay_cow_allocation_table_block_t *allocation_table_block = NULL;
+	static char *function                                            = "libbfoverlay_cow_file_flush";
+	uint32_t pending_free_block_index                                = 0;
+	int cache_entry_index                                            = 0;
+	int number_of_cache_entries                                      = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( cow_file->number_of_dirty_blocks == 0 )
+	 && ( cow_file->number_of_pending_free_blocks == 0 ) )
+	{
+		return( 1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     cow_file->allocation_table_block_cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of allocation table block cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	for( cache_entry_index = 0;
+	     cache_entry_index < number_of_cache_entries;
+	     cache_entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     cow_file->allocation_table_block_cache,
+		     cache_entry_index,
+		     (intptr_t **) &allocation_table_block,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve allocation table block cache entry: %d.",
+			 function,
+			 cache_entry_index );
+
+			return( -1 );
+		}
+		if( ( allocation_table_block != NULL )
+		 && ( allocation_table_block->is_dirty != 0 ) )
+		{
+			if( libbfoverlay_cow_file_write_allocation_table_block(
+			     cow_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     allocation_table_block,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write COW allocation table block: %" PRIu32 ".",
+				 function,
+				 allocation_table_block->block_number );
+
+				return( -1 );
+			}
+		}
+	}
+	if( ( cow_file->l1_allocation_table_block != NULL )
+	 && ( cow_file->l1_allocation_table_block->is_dirty != 0 ) )
+	{
+		if( libbfoverlay_cow_file_write_allocation_table_block(
+		     cow_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     cow_file->l1_allocation_table_block,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write level 1 COW allocation table block.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The blocks released by the allocation table blocks that were written can now be reused
+	 */
+	for( pending_free_block_index = 0;
+	     pending_free_block_index < cow_file->number_of_pending_free_blocks;
+	     pending_free_block_index++ )
+	{
+		if( libbfoverlay_cow_file_set_free_block(
+		     cow_file,
+		     cow_file->pending_free_blocks[ pending_free_block_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set free block: %" PRIu32 ".",
+			 function,
+			 cow_file->pending_free_blocks[ pending_free_block_index ] );
+
+			return( -1 );
+		}
+	}
+	cow_file->number_of_pending_free_blocks = 0;
+
+	return( 1 );
+}
+
+/* Sets the data size in the file header
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_set_data_size(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t cow_file_header_data[ 8 ];
+
+	static char *function    = "libbfoverlay_cow_file_set_data_size";
+	ssize_t write_count      = 0;
+	off64_t file_offset      = 0;
+	uint64_t start_timestamp = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: data size\t\t\t: %" PRIu64 "\n",
+		 function,
+		 data_size );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+	if( cow_file->maximum_dirty_size == 0 )
+	{
+		byte_stream_copy_from_uint64_big_endian(
+		 cow_file_header_data,
+		 data_size );
+
+		file_offset = 16;
+
+		if( cow_file->io_statistics != NULL )
+		{
+			if( libbfoverlay_io_statistics_get_timestamp(
+			     &start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve start timestamp.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		write_count = libbfio_pool_write_buffer_at_offset(
+		               file_io_pool,
+		               file_io_pool_entry,
+		               cow_file_header_data,
+		               8,
+		               file_offset,
+		               error );
+
+		if( write_count != (ssize_t) 8 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data size at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 file_offset,
+			 file_offset );
+
+			return( -1 );
+		}
+		if( cow_file->io_statistics != NULL )
+		{
+			if( libbfoverlay_io_statistics_add_io(
+			     cow_file->io_statistics,
+			     LIBBFOVERLAY_IO_TYPE_COW_METADATA_WRITE,
+			     0,
+			     8,
+			     start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update IO statistics.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	cow_file->data_size = data_size;
+
+	/* Keep the copy of the file header in the level 1 allocation table block up to date
+	 */
+	if( cow_file->l1_allocation_table_block != NULL )
+	{
+		byte_stream_copy_from_uint64_big_endian(
+		 ( (bfoverlay_cow_file_header_t *) cow_file->l1_allocation_table_block->data )->data_size,
+		 data_size );
+
+		/* If a maximum dirty size is set the file header is written on flush
+		 */
+		if( cow_file->maximum_dirty_size != 0 )
+		{
+			if( libbfoverlay_cow_file_set_allocation_table_block_dirty(
+			     cow_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     cow_file->l1_allocation_table_block,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to mark level 1 COW allocation table block as dirty.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Enlarges the allocation table
+ * The current level 1 allocation table is moved into a new level 2 allocation table block
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_enlarge_allocation_table(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	libbfoverlay_cow_allocation_table_block_t *allocation_table_block    = NULL;
+	libbfoverlay_cow_allocation_table_block_t *l1_allocation_table_block = NULL;
+	static char *function                                               = "libbfoverlay_cow_file_enlarge_allocation_table";
+	size_t entries_data_size                                            = 0;
+	ssize_t write_count                                                 = 0;
+	off64_t file_offset                                                 = 0;
+	uint64_t start_timestamp                                            = 0;
+	uint32_t block_number                                               = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_file->l1_allocation_table_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid COW file - missing level 1 allocation table block.",
+		 function );
+
+		return( -1 );
+	}
+	l1_allocation_table_block = cow_file->l1_allocation_table_block;
+
+	if( ( cow_file->number_of_allocated_blocks == 0 )
+	 || ( cow_file->number_of_allocated_blocks > ( (uint32_t) UINT32_MAX / l1_allocation_table_block->number_of_entries ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of allocated blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entries_data_size = l1_allocation_table_block->data_size - sizeof( bfoverlay_cow_allocation_table_block_header_t );
+
+	if( libbfoverlay_cow_file_allocate_block_number(
+	     cow_file,
+	     &block_number,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to allocate block number.",
+		 function );
+
+		return( -1 );
+	}
+	/* Copy the level 1 allocation table to a COW level 2 allocation table block
+	 */
+	if( libbfoverlay_cow_file_create_allocation_table_block(
+	     cow_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     block_number,
+	     &allocation_table_block,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create COW allocation table block: %" PRIu32 ".",
+		 function,
+		 block_number );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     &( allocation_table_block->data[ sizeof( bfoverlay_cow_allocation_table_block_header_t ) ] ),
+	     &( l1_allocation_table_block->data[ sizeof( bfoverlay_cow_allocation_table_block_header_t ) ] ),
+	     entries_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy level 1 COW allocation table entries.",
+		 function );
+
+		return( -1 );
+	}
+	/* Write a COW level 2 allocation table block
+	 */
+	if( libbfoverlay_cow_file_write_allocation_table_block(
+	     cow_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     allocation_table_block,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write COW allocation table block: %" PRIu32 ".",
+		 function,
+		 block_number );
+
+		return( -1 );
+	}
+	/* Update the number of allocated blocks and the level 1 allocation table
+	 */
+	if( memory_set(
+	     &( l1_allocation_table_block->data[ sizeof( bfoverlay_cow_allocation_table_block_header_t ) ] ),
+	     0,
+	     entries_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear level 1 COW allocation table entries.",
+		 function );
+
+		return( -1 );
+	}
+	cow_file->number_of_allocated_blocks *= l1_allocation_table_block->number_of_entries;
+
+	byte_stream_copy_from_uint32_big_endian(
+	 ( (bfoverlay_cow_file_header_t *) l1_allocation_table_block->data )->number_of_allocated_blocks,
+	 cow_file->number_of_allocated_blocks );
+
+	if( libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
+	     l1_allocation_table_block,
+	     0,
+	     block_number,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set level 1 COW allocation table entry: 0.",
+		 function );
+
+		return( -1 );
+	}
+	/* If a maximum dirty size is set the level 1 allocation table is written on flush
+	 */
+	if( cow_file->maximum_dirty_size != 0 )
+	{
+		if( libbfoverlay_cow_file_set_allocation_table_block_dirty(
+		     cow_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     l1_allocation_table_block,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to mark level 1 COW allocation table block as dirty.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	file_offset = 28;
+
+	if( cow_file->io_statistics != NULL )
+	{
+		if( libbfoverlay_io_statistics_get_timestamp(
+		     &start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	write_count = libbfio_pool_write_buffer_at_offset(
+	               file_io_pool,
+	               file_io_pool_entry,
+	               &( l1_allocation_table_block->data[ 28 ] ),
+	               l1_allocation_table_block->data_size - 28,
+	               file_offset,
+	               error );
+
+	if( write_count != (ssize_t) ( l1_allocation_table_block->data_size - 28 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	if( cow_file->io_statistics != NULL )
+	{
+		if( libbfoverlay_io_statistics_add_io(
+		     cow_file->io_statistics,
+		     LIBBFOVERLAY_IO_TYPE_COW_METADATA_WRITE,
+		     0,
+		     l1_allocation_table_block->data_size - 28,
+		     start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update IO statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the allocation table block and entry that contains the data block number for a specific offset
+ * The allocation table is enlarged and allocation table blocks are created when needed
+ * The table block offset is the offset of the allocation table block in the COW file
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_get_allocation_table_entry_for_offset(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     libbfoverlay_cow_allocation_table_block_t **allocation_table_block,
+     off64_t *table_block_offset,
+     int *entry_index,
+     libcerror_error_t **error )
+{
+	libbfoverlay_cow_allocation_table_block_t *safe_allocation_table_block = NULL;
+	static char *function                                                 = "libbfoverlay_cow_file_get_allocation_table_entry_for_offset";
+	off64_t safe_table_block_offset                                       = 0;
+	off64_t table_index                                                   = 0;
+	uint32_t block_number                                                 = 0;
+	uint32_t blocks_per_entry                                             = 0;
+	int depth                                                             = 0;
+	int safe_entry_index                                                  = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_file->l1_allocation_table_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid COW file - missing level 1 allocation table block.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_file->number_of_allocated_blocks == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid COW file - number of allocated blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_file->l1_allocation_table_block->number_of_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid COW file - invalid level 1 allocation table block - number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_table_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation table block.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_block_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table block offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	table_index = offset / cow_file->block_size;
+
+	while( table_index >= (off64_t) cow_file->number_of_allocated_blocks )
+	{
+		if( libbfoverlay_cow_file_enlarge_allocation_table(
+		     cow_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to enlarge allocation table.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	safe_allocation_table_block = cow_file->l1_allocation_table_block;
+	blocks_per_entry            = cow_file->number_of_allocated_blocks / safe_allocation_table_block->number_of_entries;
+
+	if( blocks_per_entry == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: blocks per entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	depth = 1;
+
+	while( blocks_per_entry > 1 )
+	{
+		safe_entry_index = (int) ( table_index / blocks_per_entry );
+
+		if( libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
+		     safe_allocation_table_block,
+		     safe_entry_index,
+		     &block_number,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve level %d COW allocation table entry: %d.",
+			 function,
+			 depth,
+			 safe_entry_index );
+
+			return( -1 );
+		}
+		if( block_number > cow_file->last_data_block_number )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid level %d COW allocation table entry: %d block number value: %" PRIu32 " out of bounds.",
+			 function,
+			 depth,
+			 safe_entry_index,
+			 block_number );
+
+			return( -1 );
+		}
+		if( block_number == LIBBFOVERLAY_COW_BLOCK_NUMBER_NOT_SET )
+		{
+			if( libbfoverlay_cow_file_allocate_block_number(
+			     cow_file,
+			     &block_number,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to allocate block number.",
+				 function );
+
+				return( -1 );
+			}
+
+			if( libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
+			     safe_allocation_table_block,
+			     safe_entry_index,
+			     block_number,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set level %d COW allocation table entry: %d.",
+				 function,
+				 depth,
+				 safe_entry_index );
+
+				return( -1 );
+			}
+			if( libbfoverlay_cow_file_write_allocation_table_entries(
+			     cow_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     safe_allocation_table_block,
+			     safe_entry_index,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write level %d COW allocation table entry: %d at offset %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 depth,
+				 safe_entry_index,
+				 safe_table_block_offset,
+				 safe_table_block_offset );
+
+				return( -1 );
+			}
+			safe_table_block_offset = (off64_t) block_number * cow_file->block_size;
+
+			if( libbfoverlay_cow_file_create_allocation_table_block(
+			     cow_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     block_number,
+			     &safe_allocation_table_block,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create level %d COW allocation table block: %" PRIu32 ".",
+				 function,
+				 depth + 1,
+				 block_number );
+
+				return( -1 );
+			}
+			if( libbfoverlay_cow_file_write_allocation_table_block(
+			     cow_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     safe_allocation_table_block,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write level %d COW allocation table block at offset %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 depth + 1,
+				 safe_table_block_offset,
+				 safe_table_block_offset );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			safe_table_block_offset = (off64_t) block_number * cow_file->block_size;
+
+			if( libbfoverlay_cow_file_get_allocation_table_block(
+			     cow_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     block_number,
+			     &safe_allocation_table_block,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve level %d COW allocation table block: %" PRIu32 ".",
+				 function,
+				 depth + 1,
+				 block_number );
+
+				return( -1 );
+			}
+		}
+		table_index      -= (off64_t) safe_entry_index * blocks_per_entry;
+		blocks_per_entry /= (uint32_t) cow_file->l1_allocation_table_block->number_of_entries;
+
+		depth++;
+	}
+	*allocation_table_block = safe_allocation_table_block;
+	*table_block_offset     = safe_table_block_offset;
+	*entry_index            = (int) table_index;
+
+	return( 1 );
+}
+
+/* Allocates a new data block for a specific offset
+ * If a data block was already allocated for the offset its file offset is returned
+ * A free block is reused if available, otherwise the data block is appended to the COW file
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_allocate_block_for_offset(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     off64_t *file_offset,
+     libcerror_error_t **error )
+{
+	libbfoverlay_cow_allocation_table_block_t *allocation_table_block = NULL;
+	static char *function                                            = "libbfoverlay_cow_file_allocate_block_for_offset";
+	off64_t table_block_offset                                       = 0;
+	uint32_t block_number                                            = 0;
+	int entry_index                                                  = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_file->free_blocks_read == 0 )
+	{
+		if( libbfoverlay_cow_file_read_free_blocks(
+		     cow_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read free blocks.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libbfoverlay_cow_file_get_allocation_table_entry_for_offset(
+	     cow_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     offset,
+	     &allocation_table_block,
+	     &table_block_offset,
+	     &entry_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve allocation table entry for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	if( libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
+	     allocation_table_block,
+	     entry_index,
+	     &block_number,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve COW allocation table entry: %d.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	if( ( block_number != LIBBFOVERLAY_COW_BLOCK_NUMBER_ZERO )
+	 && ( block_number > cow_file->last_data_block_number ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid COW allocation table entry: %d block number value: %" PRIu32 " out of bounds.",
+		 function,
+		 entry_index,
+		 block_number );
+
+		return( -1 );
+	}
+	/* A block that only contains zero bytes has no data block
+	 */
+	if( ( block_number == LIBBFOVERLAY_COW_BLOCK_NUMBER_NOT_SET )
+	 || ( block_number == LIBBFOVERLAY_COW_BLOCK_NUMBER_ZERO ) )
+	{
+		if( libbfoverlay_cow_file_allocate_block_number(
+		     cow_file,
+		     &block_number,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to allocate block number.",
+			 function );
+
+			return( -1 );
+		}
+		if( cow_file->io_statistics != NULL )
+		{
+			if( libbfoverlay_io_statistics_add_count(
+			     cow_file->io_statistics,
+			     LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_ALLOCATED_BLOCKS,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update IO statistics.",
+				 function );
+
+				return( -1 );
+			}
+		}
+
+		if( libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
+		     allocation_table_block,
+		     entry_index,
+		     block_number,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set COW allocation table entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( libbfoverlay_cow_file_write_allocation_table_entries(
+		     cow_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     allocation_table_block,
+		     entry_index,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write COW allocation table entry: %d at offset %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 entry_index,
+			 table_block_offset,
+			 table_block_offset );
+
+			return( -1 );
+		}
+	}
+	*file_offset = (off64_t) block_number * cow_file->block_size;
+
+	return( 1 );
+}
+
+/* Allocates new data blocks for a run of consecutive blocks starting at a specific offset
+ * The data blocks are allocated contiguously in the COW file, hence the run can be written with a single write
+ * The run stops at the first block that already has a data block or at the maximum number of blocks
+ * If a data block was already allocated for the offset its file offset is returned and the run consists of 1 block
+ * If free blocks are available these are reused and the run is limited to the first run of consecutive free blocks
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_allocate_blocks_for_offset(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     uint32_t maximum_number_of_blocks,
+     off64_t *file_offset,
+     uint32_t *number_of_blocks,
+     libcerror_error_t **error )
+{
+	libbfoverlay_cow_allocation_table_block_t *allocation_table_block = NULL;
+	static char *function                                            = "libbfoverlay_cow_file_allocate_blocks_for_offset";
+	off64_t range_end_offset                                         = 0;
+	off64_t range_start_offset                                       = 0;
+	off64_t run_offset                                               = 0;
+	off64_t safe_file_offset                                         = 0;
+	off64_t table_block_offset                                       = 0;
+	uint32_t block_number                                            = 0;
+	uint32_t first_block_number                                      = 0;
+	uint32_t last_data_block_number                                  = 0;
+	uint32_t number_of_range_blocks                                  = 0;
+	uint32_t remaining_number_of_blocks                              = 0;
+	uint32_t run_number_of_blocks                                    = 0;
+	uint8_t use_free_blocks                                          = 0;
+	int entry_index                                                  = 0;
+	int number_of_entries                                            = 0;
+	int result                                                       = 0;
+	int run_entry_index                                              = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_blocks == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of blocks value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of blocks.",
+		 function );
+
+		return( -1 );
+	}
+	offset -= offset % cow_file->block_size;
+
+	if( cow_file->free_blocks_read == 0 )
+	{
+		if( libbfoverlay_cow_file_read_free_blocks(
+		     cow_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read free blocks.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* Determine the number of consecutive blocks without a data block
+	 */
+	run_offset = offset;
+
+	while( run_number_of_blocks < maximum_number_of_blocks )
+	{
+		result = libbfoverlay_cow_file_get_block_at_offset(
+		          cow_file,
+		          file_io_pool,
+		          file_io_pool_entry,
+		          run_offset,
+		          &range_start_offset,
+		          &range_end_offset,
+		          &safe_file_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 run_offset,
+			 run_offset );
+
+			return( -1 );
+		}
+		else if( ( result != 0 )
+		      && ( safe_file_offset >= 0 ) )
+		{
+			break;
+		}
+		/* The range without data blocks can extend beyond the allocation table
+		 */
+		if( ( ( range_end_offset - run_offset ) / cow_file->block_size ) > (off64_t) ( maximum_number_of_blocks - run_number_of_blocks ) )
+		{
+			number_of_range_blocks = maximum_number_of_blocks - run_number_of_blocks;
+		}
+		else
+		{
+			number_of_range_blocks = (uint32_t) ( ( range_end_offset - run_offset ) / cow_file->block_size );
+		}
+		run_number_of_blocks += number_of_range_blocks;
+		run_offset           += (off64_t) number_of_range_blocks * cow_file->block_size;
+	}
+	if( run_number_of_blocks == 0 )
+	{
+		*file_offset      = safe_file_offset;
+		*number_of_blocks = 1;
+
+		return( 1 );
+	}
+	/* Create the allocation table blocks of the run before allocating
+	 * the data blocks, so that the data blocks are contiguous
+	 */
+	remaining_number_of_blocks = run_number_of_blocks;
+	run_offset                 = offset;
+
+	while( remaining_number_of_blocks > 0 )
+	{
+		if( libbfoverlay_cow_file_get_allocation_table_entry_for_offset(
+		     cow_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     run_offset,
+		     &allocation_table_block,
+		     &table_block_offset,
+		     &entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve allocation table entry for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 run_offset,
+			 run_offset );
+
+			return( -1 );
+		}
+		number_of_entries = allocation_table_block->number_of_entries - entry_index;
+
+		if( (uint32_t) number_of_entries > remaining_number_of_blocks )
+		{
+			number_of_entries = (int) remaining_number_of_blocks;
+		}
+		remaining_number_of_blocks -= (uint32_t) number_of_entries;
+		run_offset                 += (off64_t) number_of_entries * cow_file->block_size;
+	}
+	/* Allocate the data blocks, reusing free blocks before growing the COW file
+	 */
+	result = libbfoverlay_cow_file_get_free_blocks(
+	          cow_file,
+	          run_number_of_blocks,
+	          &first_block_number,
+	          &remaining_number_of_blocks,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve free blocks.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		remaining_number_of_blocks = run_number_of_blocks;
+	}
+	use_free_blocks      = (uint8_t) result;
+	run_number_of_blocks = 0;
+	run_offset           = offset;
+
+	while( remaining_number_of_blocks > 0 )
+	{
+		last_data_block_number = cow_file->last_data_block_number;
+
+		if( libbfoverlay_cow_file_get_allocation_table_entry_for_offset(
+		     cow_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     run_offset,
+		     &allocation_table_block,
+		     &table_block_offset,
+		     &entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve allocation table entry for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 run_offset,
+			 run_offset );
+
+			return( -1 );
+		}
+		if( use_free_blocks == 0 )
+		{
+			if( cow_file->last_data_block_number != last_data_block_number )
+			{
+				/* An allocation table block was created, hence the data blocks
+				 * allocated after it are no longer contiguous with the run
+				 */
+				if( run_number_of_blocks > 0 )
+				{
+					break;
+				}
+			}
+			if( run_number_of_blocks == 0 )
+			{
+				first_block_number = cow_file->last_data_block_number + 1;
+			}
+		}
+		number_of_entries = allocation_table_block->number_of_entries - entry_index;
+
+		if( (uint32_t) number_of_entries > remaining_number_of_blocks )
+		{
+			number_of_entries = (int) remaining_number_of_blocks;
+		}
+		if( ( use_free_blocks == 0 )
+		 && ( (uint32_t) number_of_entries > ( (uint32_t) UINT32_MAX - 1 - cow_file->last_data_block_number ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid last data block number value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		for( run_entry_index = 0;
+		     run_entry_index < number_of_entries;
+		     run_entry_index++ )
+		{
+			if( use_free_blocks != 0 )
+			{
+				block_number = first_block_number + run_number_of_blocks + (uint32_t) run_entry_index;
+			}
+			else
+			{
+				cow_file->last_data_block_number += 1;
+
+				block_number = cow_file->last_data_block_number;
+			}
+			if( libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
+			     allocation_table_block,
+			     entry_index + run_entry_index,
+			     block_number,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set COW allocation table entry: %d.",
+				 function,
+				 entry_index + run_entry_index );
+
+				return( -1 );
+			}
+		}
+		if( cow_file->io_statistics != NULL )
+		{
+			if( libbfoverlay_io_statistics_add_count(
+			     cow_file->io_statistics,
+			     LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_ALLOCATED_BLOCKS,
+			     (uint64_t) number_of_entries,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update IO statistics.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( libbfoverlay_cow_file_write_allocation_table_entries(
+		     cow_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     allocation_table_block,
+		     entry_index,
+		     number_of_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write COW allocation table entries: %d - %d at offset %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 entry_index,
+			 entry_index + number_of_entries - 1,
+			 table_block_offset,
+			 table_block_offset );
+
+			return( -1 );
+		}
+		remaining_number_of_blocks -= (uint32_t) number_of_entries;
+		run_number_of_blocks       += (uint32_t) number_of_entries;
+		run_offset                 += (off64_t) number_of_entries * cow_file->block_size;
+	}
+	*file_offset      = (off64_t) first_block_number * cow_file->block_size;
+	*number_of_blocks = run_number_of_blocks;
+
+	return( 1 );
+}
+
+/* Retrieve the data block for a specific offset
+ * If no data block exists the range is set to the range without data blocks
+ * If the block only contains zero bytes the file offset is set to -1, since no data block is stored
+ * Returns 1 if successful, 0 if no data block exists or -1 on error
+ */
+int libbfoverlay_cow_file_get_block_at_offset(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     off64_t *range_start_offset,
+     off64_t *range_end_offset,
+     off64_t *file_offset,
+     libcerror_error_t **error )
+{
+	libbfoverlay_cow_allocation_table_block_t *allocation_table_block = NULL;
+	static char *function                                            = "libbfoverlay_cow_file_get_block_at_offset";
+	off64_t block_index                                              = 0;
+	off64_t data_end_offset                                          = 0;
+	off64_t table_index                                              = 0;
+	uint32_t block_number                                            = 0;
+	uint32_t blocks_per_entry                                        = 0;
+	int depth                                                        = 0;
+	int entry_index                                                  = 0;
+	int grab_for_write                                               = 0;
+	int is_cached                                                    = 0;
+	int result                                                       = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_file->l1_allocation_table_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid COW file - missing level 1 allocation table block.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_file->number_of_allocated_blocks == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid COW file - number of allocated blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_file->l1_allocation_table_block->number_of_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid COW file - invalid level 1 allocation table block - number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_start_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range start offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_end_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range end offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file offset.",
+		 function );
+
+		return( -1 );
+	}
+	block_index = offset / cow_file->block_size;
+
+	*file_offset        = 0;
+	*range_start_offset = block_index * cow_file->block_size;
+	*range_end_offset   = *range_start_offset + cow_file->block_size;
+
+	if( block_index >= (off64_t) cow_file->number_of_allocated_blocks )
+	{
+		/* The allocation table does not cover the offset, hence the range without data blocks
+		 * spans from the end of the allocation table to the end of the data
+		 */
+		data_end_offset = (off64_t) ( ( cow_file->data_size + cow_file->block_size - 1 ) / cow_file->block_size ) * cow_file->block_size;
+
+		*range_start_offset = (off64_t) cow_file->number_of_allocated_blocks * cow_file->block_size;
+
+		if( data_end_offset > offset )
+		{
+			*range_end_offset = data_end_offset;
+		}
+		else
+		{
+			*range_end_offset = INT64_MAX;
+		}
+		return( 0 );
+	}
+	allocation_table_block = cow_file->l1_allocation_table_block;
+	blocks_per_entry       = cow_file->number_of_allocated_blocks / allocation_table_block->number_of_entries;
+
+	if( blocks_per_entry == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: blocks per entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The allocation table is first looked up under a read lock using only the cached
+	 * allocation table blocks, so that multiple readers can look up blocks concurrently.
+	 * Only if an allocation table block is not cached is the lookup repeated under
+	 * a write lock, since reading the block replaces an allocation table block cache entry.
+	 */
+	do
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+		if( grab_for_write == 0 )
+		{
+			if( libcthreads_read_write_lock_grab_for_read(
+			     cow_file->read_write_lock,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab read/write lock for reading.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			if( libcthreads_read_write_lock_grab_for_write(
+			     cow_file->read_write_lock,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab read/write lock for writing.",
+				 function );
+
+				return( -1 );
+			}
+		}
+#endif
+		allocation_table_block = cow_file->l1_allocation_table_block;
+		blocks_per_entry       = cow_file->number_of_allocated_blocks / allocation_table_block->number_of_entries;
+		table_index            = block_index;
+		depth                  = 1;
+		is_cached              = 1;
+		result                 = 1;
+
+		do
+		{
+			entry_index = (int) ( table_index / blocks_per_entry );
+
+			if( libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
+			     allocation_table_block,
+			     entry_index,
+			     &block_number,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve level %d COW allocation table entry: %d.",
+				 function,
+				 depth,
+				 entry_index );
+
+				result = -1;
+
+				break;
+			}
+			if( ( blocks_per_entry == 1 )
+			 && ( block_number == LIBBFOVERLAY_COW_BLOCK_NUMBER_ZERO ) )
+			{
+				break;
+			}
+			if( block_number > cow_file->last_data_block_number )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid level %d COW allocation table entry: %d block number value: %" PRIu32 " out of bounds.",
+				 function,
+				 depth,
+				 entry_index,
+				 block_number );
+
+				result = -1;
+
+				break;
+			}
+			table_index -= (off64_t) entry_index * blocks_per_entry;
+
+			if( block_number == LIBBFOVERLAY_COW_BLOCK_NUMBER_NOT_SET )
+			{
+				/* The entry covers blocks_per_entry blocks without data blocks
+				 */
+				*range_start_offset = ( block_index - table_index ) * cow_file->block_size;
+				*range_end_offset   = *range_start_offset + ( (off64_t) blocks_per_entry * cow_file->block_size );
+
+				result = 0;
+
+				break;
+			}
+			if( blocks_per_entry > 1 )
+			{
+				if( grab_for_write == 0 )
+				{
+					is_cached = libbfoverlay_cow_file_get_cached_allocation_table_block(
+					             cow_file,
+					             block_number,
+					             &allocation_table_block,
+					             error );
+
+					if( is_cached == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+						 "%s: unable to retrieve cached level %d COW allocation table block: %" PRIu32 ".",
+						 function,
+						 depth + 1,
+						 block_number );
+
+						result = -1;
+
+						break;
+					}
+					else if( is_cached == 0 )
+					{
+						break;
+					}
+				}
+				else
+				{
+					if( libbfoverlay_cow_file_get_allocation_table_block(
+					     cow_file,
+					     file_io_pool,
+					     file_io_pool_entry,
+					     block_number,
+					     &allocation_table_block,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+						 "%s: unable to retrieve level %d COW allocation table block: %" PRIu32 ".",
+						 function,
+						 depth + 1,
+						 block_number );
+
+						result = -1;
+
+						break;
+					}
+				}
+			}
+			blocks_per_entry /= (uint32_t) cow_file->l1_allocation_table_block->number_of_entries;
+
+			depth++;
+		}
+		while( blocks_per_entry > 0 );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+		if( grab_for_write == 0 )
+		{
+			if( libcthreads_read_write_lock_release_for_read(
+			     cow_file->read_write_lock,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release read/write lock for reading.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			if( libcthreads_read_write_lock_release_for_write(
+			     cow_file->read_write_lock,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release read/write lock for writing.",
+				 function );
+
+				return( -1 );
+			}
+		}
+#endif
+		grab_for_write = 1;
+	}
+	while( is_cached == 0 );
+
+	if( result == 1 )
+	{
+		if( block_number == LIBBFOVERLAY_COW_BLOCK_NUMBER_ZERO )
+		{
+			*file_offset = -1;
+		}
+		else
+		{
+			*file_offset = (off64_t) block_number * cow_file->block_size;
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the data blocks of consecutive blocks starting at a specific offset that are stored contiguously in the COW file
+ * A block that only contains zero bytes has no data block and ends the consecutive blocks
+ * Returns 1 if successful, 0 if no data block exists or -1 on error
+ */
+int libbfoverlay_cow_file_get_contiguous_blocks_at_offset(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     uint32_t maximum_number_of_blocks,
+     off64_t *file_offset,
+     uint32_t *number_of_blocks,
+     libcerror_error_t **error )
+{
+	static char *function          = "libbfoverlay_cow_file_get_contiguous_blocks_at_offset";
+	off64_t block_file_offset      = 0;
+	off64_t range_end_offset       = 0;
+	off64_t range_start_offset     = 0;
+	off64_t safe_file_offset       = 0;
+	uint32_t safe_number_of_blocks = 0;
+	int result                     = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_blocks == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of blocks value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of blocks.",
+		 function );
+
+		return( -1 );
+	}
+	*file_offset      = 0;
+	*number_of_blocks = 0;
+
+	while( safe_number_of_blocks < maximum_number_of_blocks )
+	{
+		result = libbfoverlay_cow_file_get_block_at_offset(
+		          cow_file,
+		          file_io_pool,
+		          file_io_pool_entry,
+		          offset,
+		          &range_start_offset,
+		          &range_end_offset,
+		          &block_file_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		else if( ( result == 0 )
+		      || ( block_file_offset < 0 ) )
+		{
+			break;
+		}
+		if( safe_number_of_blocks == 0 )
+		{
+			safe_file_offset = block_file_offset;
+		}
+		else if( block_file_offset != ( safe_file_offset + ( (off64_t) safe_number_of_blocks * cow_file->block_size ) ) )
+		{
+			break;
+		}
+		safe_number_of_blocks++;
+
+		offset = range_end_offset;
+	}
+	if( safe_number_of_blocks == 0 )
+	{
+		return( 0 );
+	}
+	*file_offset      = safe_file_offset;
+	*number_of_blocks = safe_number_of_blocks;
+
+	return( 1 );
+}
+
+/* Determines if the data of a block only contains zero bytes
+ * Returns 1 if the data only contains zero bytes, 0 if not or -1 on error
+ */
+int libbfoverlay_cow_file_check_for_zero_block(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	const uint64_t *aligned_data_index = NULL;
+	const uint8_t *data_end            = NULL;
+	const uint8_t *data_index          = NULL;
+	static char *function              = "libbfoverlay_cow_file_check_for_zero_block";
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	data_index = data;
+	data_end   = &( data[ data_size ] );
+
+	while( ( data_index < data_end )
+	    && ( ( (intptr_t) data_index % sizeof( uint64_t ) ) != 0 ) )
+	{
+		if( *data_index != 0 )
+		{
+			return( 0 );
+		}
+		data_index++;
+	}
+	aligned_data_index = (const uint64_t *) data_index;
+
+	/* Compare 4 aligned values at a time, which compilers can vectorize
+	 */
+	while( ( data_end - (const uint8_t *) aligned_data_index ) >= (ssize_t) ( 4 * sizeof( uint64_t ) ) )
+	{
+		if( ( aligned_data_index[ 0 ] | aligned_data_index[ 1 ] | aligned_data_index[ 2 ] | aligned_data_index[ 3 ] ) != 0 )
+		{
+			return( 0 );
+		}
+		aligned_data_index += 4;
+	}
+	data_index = (const uint8_t *) aligned_data_index;
+
+	while( data_index < data_end )
+	{
+		if( *data_index != 0 )
+		{
+			return( 0 );
+		}
+		data_index++;
+	}
+	return( 1 );
+}
+
+/* Marks the blocks of a range starting at a specific offset as blocks that only contain zero bytes
+ * If data blocks were allocated for the range these are freed to be reused by subsequent allocations
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_set_zero_blocks_for_offset(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     uint64_t number_of_blocks,
+     libcerror_error_t **error )
+{
+	libbfoverlay_cow_allocation_table_block_t *allocation_table_block = NULL;
+	static char *function                                            = "libbfoverlay_cow_file_set_zero_blocks_for_offset";
+	off64_t table_block_offset                                       = 0;
+	uint64_t number_of_zero_blocks                                   = 0;
+	uint32_t block_number                                            = 0;
+	int entry_index                                                  = 0;
+	int first_entry_index                                            = 0;
+	int last_entry_index                                             = 0;
+	int number_of_entries                                            = 0;
+	int run_entry_index                                              = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_file->block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid COW file - block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocks > (uint64_t) ( ( INT64_MAX - offset ) / cow_file->block_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of blocks value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	offset -= offset % cow_file->block_size;
+
+	if( ( number_of_blocks > 0 )
+	 && ( cow_file->free_blocks_read == 0 ) )
+	{
+		if( libbfoverlay_cow_file_read_free_blocks(
+		     cow_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read free blocks.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	while( number_of_blocks > 0 )
+	{
+		if( libbfoverlay_cow_file_get_allocation_table_entry_for_offset(
+		     cow_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     offset,
+		     &allocation_table_block,
+		     &table_block_offset,
+		     &entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve allocation table entry for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		number_of_entries = allocation_table_block->number_of_entries - entry_index;
+
+		if( (uint64_t) number_of_entries > number_of_blocks )
+		{
+			number_of_entries = (int) number_of_blocks;
+		}
+		first_entry_index = -1;
+		last_entry_index  = -1;
+
+		for( run_entry_index = entry_index;
+		     run_entry_index < ( entry_index + number_of_entries );
+		     run_entry_index++ )
+		{
+			if( libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
+			     allocation_table_block,
+			     run_entry_index,
+			     &block_number,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve COW allocation table entry: %d.",
+				 function,
+				 run_entry_index );
+
+				return( -1 );
+			}
+			if( block_number == LIBBFOVERLAY_COW_BLOCK_NUMBER_ZERO )
+			{
+				continue;
+			}
+			if( block_number > cow_file->last_data_block_number )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid COW allocation table entry: %d block number value: %" PRIu32 " out of bounds.",
+				 function,
+				 run_entry_index,
+				 block_number );
+
+				return( -1 );
+			}
+			if( libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
+			     allocation_table_block,
+			     run_entry_index,
+			     LIBBFOVERLAY_COW_BLOCK_NUMBER_ZERO,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set COW allocation table entry: %d.",
+				 function,
+				 run_entry_index );
+
+				return( -1 );
+			}
+			if( block_number != LIBBFOVERLAY_COW_BLOCK_NUMBER_NOT_SET )
+			{
+				if( libbfoverlay_cow_file_release_block(
+				     cow_file,
+				     block_number,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release block: %" PRIu32 ".",
+					 function,
+					 block_number );
+
+					return( -1 );
+				}
+			}
+			if( first_entry_index == -1 )
+			{
+				first_entry_index = run_entry_index;
+			}
+			last_entry_index = run_entry_index;
+
+			number_of_zero_blocks++;
+		}
+		if( first_entry_index != -1 )
+		{
+			if( libbfoverlay_cow_file_write_allocation_table_entries(
+			     cow_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     allocation_table_block,
+			     first_entry_index,
+			     last_entry_index - first_entry_index + 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write COW allocation table entries: %d - %d at offset %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 first_entry_index,
+				 last_entry_index,
+				 table_block_offset,
+				 table_block_offset );
+
+				return( -1 );
+			}
+		}
+		number_of_blocks -= (uint64_t) number_of_entries;
+		offset           += (off64_t) number_of_entries * cow_file->block_size;
+	}
+	if( ( cow_file->io_statistics != NULL )
+	 && ( number_of_zero_blocks > 0 ) )
+	{
+		if( libbfoverlay_io_statistics_add_count(
+		     cow_file->io_statistics,
+		     LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_ZERO_BLOCKS,
+		     number_of_zero_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update IO statistics.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Marks a block as free
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_set_free_block(
+     libbfoverlay_cow_file_t *cow_file,
+     uint32_t block_number,
+     libcerror_error_t **error )
+{
+	void *reallocation               = NULL;
+	static char *function            = "libbfoverlay_cow_file_set_free_block";
+	size_t bitmap_size               = 0;
+	size_t previous_bitmap_size      = 0;
+	uint32_t bitmap_number_of_blocks = 0;
+	uint8_t bit_mask                 = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_number == 0 )
+	 || ( block_number > cow_file->last_data_block_number ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_number >= cow_file->free_blocks_bitmap_number_of_blocks )
+	{
+		/* Grow the bitmap in steps of at least 4096 blocks to limit the number of reallocations
+		 */
+		bitmap_number_of_blocks = cow_file->free_blocks_bitmap_number_of_blocks;
+
+		if( bitmap_number_of_blocks < 4096 )
+		{
+			bitmap_number_of_blocks = 4096;
+		}
+		while( bitmap_number_of_blocks <= block_number )
+		{
+			if( bitmap_number_of_blocks > ( (uint32_t) UINT32_MAX / 2 ) )
+			{
+				bitmap_number_of_blocks = (uint32_t) UINT32_MAX;
+
+				break;
+			}
+			bitmap_number_of_blocks *= 2;
+		}
+		previous_bitmap_size = ( (size_t) cow_file->free_blocks_bitmap_number_of_blocks + 7 ) / 8;
+		bitmap_size          = ( (size_t) bitmap_number_of_blocks + 7 ) / 8;
+
+		if( bitmap_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid free blocks bitmap size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = memory_reallocate(
+		                cow_file->free_blocks_bitmap,
+		                sizeof( uint8_t ) * bitmap_size );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize free blocks bitmap.",
+			 function );
+
+			return( -1 );
+		}
+		cow_file->free_blocks_bitmap = (uint8_t *) reallocation;
+
+		if( memory_set(
+		     &( cow_file->free_blocks_bitmap[ previous_bitmap_size ] ),
+		     0,
+		     bitmap_size - previous_bitmap_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear free blocks bitmap.",
+			 function );
+
+			return( -1 );
+		}
+		cow_file->free_blocks_bitmap_number_of_blocks = bitmap_number_of_blocks;
+	}
+	bit_mask = (uint8_t) ( 1 << ( block_number % 8 ) );
+
+	if( ( cow_file->free_blocks_bitmap[ block_number / 8 ] & bit_mask ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block: %" PRIu32 " value already free.",
+		 function,
+		 block_number );
+
+		return( -1 );
+	}
+	cow_file->free_blocks_bitmap[ block_number / 8 ] |= bit_mask;
+
+	cow_file->number_of_free_blocks += 1;
+
+	if( block_number < cow_file->free_blocks_search_block_number )
+	{
+		cow_file->free_blocks_search_block_number = block_number;
+	}
+	return( 1 );
+}
+
+/* Releases a block that is no longer referenced by an allocation table entry
+ * The block must only be reused after the allocation table entry that released it was written,
+ * otherwise after a crash the on-disk allocation table can reference data of another offset.
+ * If changes are written immediately the block is marked as free, otherwise the block is
+ * marked as free after the allocation table blocks have been flushed
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_release_block(
+     libbfoverlay_cow_file_t *cow_file,
+     uint32_t block_number,
+     libcerror_error_t **error )
+{
+	void *reallocation                = NULL;
+	static char *function             = "libbfoverlay_cow_file_release_block";
+	size_t pending_free_blocks_size   = 0;
+	uint32_t number_of_pending_blocks = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_number == 0 )
+	 || ( block_number > cow_file->last_data_block_number ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_file->maximum_dirty_size == 0 )
+	{
+		if( libbfoverlay_cow_file_set_free_block(
+		     cow_file,
+		     block_number,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set free block: %" PRIu32 ".",
+			 function,
+			 block_number );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( cow_file->number_of_pending_free_blocks >= cow_file->pending_free_blocks_size )
+	{
+		/* Grow the array in steps of at least 1024 blocks to limit the number of reallocations
+		 */
+		number_of_pending_blocks = cow_file->pending_free_blocks_size;
+
+		if( number_of_pending_blocks < 1024 )
+		{
+			number_of_pending_blocks = 1024;
+		}
+		else if( number_of_pending_blocks > ( (uint32_t) UINT32_MAX / 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of pending free blocks value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		else
+		{
+			number_of_pending_blocks *= 2;
+		}
+		pending_free_blocks_size = sizeof( uint32_t ) * (size_t) number_of_pending_blocks;
+
+		if( pending_free_blocks_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid pending free blocks size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = memory_reallocate(
+		                cow_file->pending_free_blocks,
+		                pending_free_blocks_size );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize pending free blocks.",
+			 function );
+
+			return( -1 );
+		}
+		cow_file->pending_free_blocks      = (uint32_t *) reallocation;
+		cow_file->pending_free_blocks_size = number_of_pending_blocks;
+	}
+	cow_file->pending_free_blocks[ cow_file->number_of_pending_free_blocks ] = block_number;
+
+	cow_file->number_of_pending_free_blocks += 1;
+
+	return( 1 );
+}
+
+/* Retrieves a run of consecutive free blocks and marks them as in use
+ * The free block with the lowest block number is used, to keep the COW file compact
+ * Returns 1 if successful, 0 if no free blocks are available or -1 on error
+ */
+int libbfoverlay_cow_file_get_free_blocks(
+     libbfoverlay_cow_file_t *cow_file,
+     uint32_t maximum_number_of_blocks,
+     uint32_t *block_number,
+     uint32_t *number_of_blocks,
+     libcerror_error_t **error )
+{
+	static char *function           = "libbfoverlay_cow_file_get_free_blocks";
+	uint32_t first_block_number     = 0;
+	uint32_t safe_number_of_blocks  = 0;
+	uint32_t search_block_number    = 0;
+	uint8_t bit_mask                = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_blocks == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum number of blocks value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block number.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_blocks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_file->number_of_free_blocks == 0 )
+	{
+		return( 0 );
+	}
+	search_block_number = cow_file->free_blocks_search_block_number;
+
+	while( search_block_number < cow_file->free_blocks_bitmap_number_of_blocks )
+	{
+		/* Skip bytes of the bitmap without free blocks
+		 */
+		if( ( ( search_block_number % 8 ) == 0 )
+		 && ( cow_file->free_blocks_bitmap[ search_block_number / 8 ] == 0 ) )
+		{
+			search_block_number += 8;
+
+			continue;
+		}
+		bit_mask = (uint8_t) ( 1 << ( search_block_number % 8 ) );
+
+		if( ( cow_file->free_blocks_bitmap[ search_block_number / 8 ] & bit_mask ) != 0 )
+		{
+			break;
+		}
+		search_block_number++;
+	}
+	if( search_block_number >= cow_file->free_blocks_bitmap_number_of_blocks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of free blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	first_block_number = search_block_number;
+
+	while( ( safe_number_of_blocks < maximum_number_of_blocks )
+	    && ( search_block_number < cow_file->free_blocks_bitmap_number_of_blocks ) )
+	{
+		bit_mask = (uint8_t) ( 1 << ( search_block_number % 8 ) );
+
+		if( ( cow_file->free_blocks_bitmap[ search_block_number / 8 ] & bit_mask ) == 0 )
+		{
+			break;
+		}
+		cow_file->free_blocks_bitmap[ search_block_number / 8 ] &= (uint8_t) ~bit_mask;
+
+		safe_number_of_blocks++;
+		search_block_number++;
+	}
+	cow_file->number_of_free_blocks          -= safe_number_of_blocks;
+	cow_file->free_blocks_search_block_number = search_block_number;
+
+	*block_number     = first_block_number;
+	*number_of_blocks = safe_number_of_blocks;
+
+	return( 1 );
+}
+
+/* Allocates a block number for a new data or allocation table block
+ * A free block is reused if available, otherwise the block is appended to the COW file
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_allocate_block_number(
+     libbfoverlay_cow_file_t *cow_file,
+     uint32_t *block_number,
+     libcerror_error_t **error )
+{
+	static char *function     = "libbfoverlay_cow_file_allocate_block_number";
+	uint32_t number_of_blocks = 0;
+	int result                = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block number.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbfoverlay_cow_file_get_free_blocks(
+	          cow_file,
+	          1,
+	          block_number,
+	          &number_of_blocks,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve free block.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		if( cow_file->last_data_block_number >= ( (uint32_t) UINT32_MAX - 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid last data block number value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		cow_file->last_data_block_number += 1;
+
+		*block_number = cow_file->last_data_block_number;
+	}
+	return( 1 );
+}
+
+/* Marks the blocks referenced by an allocation table block, and the allocation table blocks
+ * it references, as in use
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_read_free_blocks_from_allocation_table_block(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libbfoverlay_cow_allocation_table_block_t *allocation_table_block,
+     uint32_t blocks_per_entry,
+     int depth,
+     libcerror_error_t **error )
+{
+	libbfoverlay_cow_allocation_table_block_t *sub_allocation_table_block = NULL;
+	uint32_t *block_numbers                                              = NULL;
+	static char *function                                                = "libbfoverlay_cow_file_read_free_blocks_from_allocation_table_block";
+	uint32_t block_number                                                = 0;
+	uint8_t bit_mask                                                     = 0;
+	int entry_index                                                      = 0;
+	int number_of_entries                                                = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_file->l1_allocation_table_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid COW file - missing level 1 allocation table block.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_table_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation table block.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( allocation_table_block->number_of_entries <= 0 )
+	 || ( (size_t) allocation_table_block->number_of_entries > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint32_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid allocation table block - number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( blocks_per_entry == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid blocks per entry value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_entries = allocation_table_block->number_of_entries;
+
+	/* The allocation table block can be evicted from the cache while reading
+	 * the allocation table blocks it references, hence its entries are copied
+	 */
+	block_numbers = (uint32_t *) memory_allocate(
+	                              sizeof( uint32_t ) * number_of_entries );
+
+	if( block_numbers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block numbers.",
+		 function );
+
+		goto on_error;
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
+		     allocation_table_block,
+		     entry_index,
+		     &( block_numbers[ entry_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve level %d COW allocation table entry: %d.",
+			 function,
+			 depth,
+			 entry_index );
+
+			goto on_error;
+		}
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		block_number = block_numbers[ entry_index ];
+
+		if( block_number == LIBBFOVERLAY_COW_BLOCK_NUMBER_NOT_SET )
+		{
+			continue;
+		}
+		/* A block that only contains zero bytes has no data block
+		 */
+		if( ( blocks_per_entry == 1 )
+		 && ( block_number == LIBBFOVERLAY_COW_BLOCK_NUMBER_ZERO ) )
+		{
+			continue;
+		}
+		if( ( block_number > cow_file->last_data_block_number )
+		 || ( block_number >= cow_file->free_blocks_bitmap_number_of_blocks ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid level %d COW allocation table entry: %d block number value: %" PRIu32 " out of bounds.",
+			 function,
+			 depth,
+			 entry_index,
+			 block_number );
+
+			goto on_error;
+		}
+		bit_mask = (uint8_t) ( 1 << ( block_number % 8 ) );
+
+		/* A block that is referenced more than once would be reused while still in use
+		 */
+		if( ( cow_file->free_blocks_bitmap[ block_number / 8 ] & bit_mask ) == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid level %d COW allocation table entry: %d block number: %" PRIu32 " value already in use.",
+			 function,
+			 depth,
+			 entry_index,
+			 block_number );
+
+			goto on_error;
+		}
+		cow_file->free_blocks_bitmap[ block_number / 8 ] &= (uint8_t) ~bit_mask;
+
+		cow_file->number_of_free_blocks -= 1;
+
+		if( blocks_per_entry > 1 )
+		{
+			if( libbfoverlay_cow_file_get_allocation_table_block(
+			     cow_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     block_number,
+			     &sub_allocation_table_block,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve level %d COW allocation table block: %" PRIu32 ".",
+				 function,
+				 depth + 1,
+				 block_number );
+
+				goto on_error;
+			}
+			if( libbfoverlay_cow_file_read_free_blocks_from_allocation_table_block(
+			     cow_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     sub_allocation_table_block,
+			     blocks_per_entry / (uint32_t) cow_file->l1_allocation_table_block->number_of_entries,
+			     depth + 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to read free blocks from level %d COW allocation table block: %" PRIu32 ".",
+				 function,
+				 depth + 1,
+				 block_number );
+
+				goto on_error;
+			}
+		}
+	}
+	memory_free(
+	 block_numbers );
+
+	return( 1 );
+
+on_error:
+	if( block_numbers != NULL )
+	{
+		memory_free(
+		 block_numbers );
+	}
+	return( -1 );
+}
+
+/* Reads the free blocks
+ * The free blocks are the blocks in the COW file that are not referenced by the allocation table,
+ * such as blocks that were discarded or allocated but not referenced when the COW file was not closed cleanly
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_read_free_blocks(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	static char *function            = "libbfoverlay_cow_file_read_free_blocks";
+	size_t bitmap_size               = 0;
+	uint32_t bitmap_number_of_blocks = 0;
+	uint32_t block_number            = 0;
+	uint32_t blocks_per_entry        = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid range end offset.",
+		 "%s: invalid COW file.",
 		 function );
 
 		return( -1 );
 	}
-	if( file_offset == NULL )
+	if( cow_file->l1_allocation_table_block == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid COW file - missing level 1 allocation table block.",
 		 function );
 
 		return( -1 );
 	}
-	table_index = offset / cow_file->block_size;
+	if( cow_file->l1_allocation_table_block->number_of_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid COW file - invalid level 1 allocation table block - number of entries value out of bounds.",
+		 function );
 
-	blocks_per_entry = cow_file->number_of_allocated_blocks / cow_file->allocation_table_block->number_of_entries;
+		return( -1 );
+	}
+	blocks_per_entry = cow_file->number_of_allocated_blocks / cow_file->l1_allocation_table_block->number_of_entries;
 
 	if( blocks_per_entry == 0 )
 	{
@@ -1056,113 +4682,386 @@ int libbfoverlay_cow_file_get_block_at_offset(
 
 		return( -1 );
 	}
-	entry_index      = table_index / blocks_per_entry;
-	safe_file_offset = cow_file->l1_allocation_table_offset + ( entry_index * sizeof( bfoverlay_cow_allocation_table_block_entry_t ) );
+	if( cow_file->free_blocks_bitmap != NULL )
+	{
+		memory_free(
+		 cow_file->free_blocks_bitmap );
+
+		cow_file->free_blocks_bitmap = NULL;
+	}
+	cow_file->free_blocks_bitmap_number_of_blocks = 0;
+	cow_file->free_blocks_search_block_number     = 0;
+	cow_file->number_of_free_blocks               = 0;
 
-	read_count = libbfio_pool_read_buffer_at_offset(
-	             file_io_pool,
-	             file_io_pool_entry,
-	             cow_allocation_table_entry_data,
-	             sizeof( bfoverlay_cow_allocation_table_block_entry_t ),
-	             safe_file_offset,
-	             error );
+	bitmap_number_of_blocks = cow_file->last_data_block_number + 1;
+	bitmap_size             = ( (size_t) bitmap_number_of_blocks + 7 ) / 8;
 
-	if( read_count == -1 )
+	if( bitmap_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read level 1 COW allocation table entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-		 function,
-		 entry_index,
-		 safe_file_offset,
-		 safe_file_offset );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid free blocks bitmap size value exceeds maximum.",
+		 function );
 
 		return( -1 );
 	}
-/* TODO improve method of determining if allocation table block exists */
-	else if( read_count != (ssize_t) sizeof( bfoverlay_cow_allocation_table_block_entry_t ) )
+	cow_file->free_blocks_bitmap = (uint8_t *) memory_allocate(
+	                                            sizeof( uint8_t ) * bitmap_size );
+
+	if( cow_file->free_blocks_bitmap == NULL )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create free blocks bitmap.",
+		 function );
+
+		return( -1 );
 	}
-	byte_stream_copy_to_uint32_big_endian(
-	 cow_allocation_table_entry_data,
-	 block_number );
+	if( memory_set(
+	     cow_file->free_blocks_bitmap,
+	     0,
+	     bitmap_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear free blocks bitmap.",
+		 function );
 
-	if( ( block_number != LIBBFOVERLAY_COW_BLOCK_NUMBER_NOT_SET )
-	 && ( block_number > cow_file->last_data_block_number ) )
+		goto on_error;
+	}
+	cow_file->free_blocks_bitmap_number_of_blocks = bitmap_number_of_blocks;
+
+	/* Block 0 contains the COW file header and level 1 allocation table and is always in use,
+	 * the other blocks are free unless referenced by the allocation table
+	 */
+	for( block_number = 1;
+	     block_number < bitmap_number_of_blocks;
+	     block_number++ )
+	{
+		cow_file->free_blocks_bitmap[ block_number / 8 ] |= (uint8_t) ( 1 << ( block_number % 8 ) );
+	}
+	cow_file->number_of_free_blocks           = bitmap_number_of_blocks - 1;
+	cow_file->free_blocks_search_block_number = 1;
+
+	if( libbfoverlay_cow_file_read_free_blocks_from_allocation_table_block(
+	     cow_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     cow_file->l1_allocation_table_block,
+	     blocks_per_entry,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to read free blocks from level 1 COW allocation table block.",
+		 function );
+
+		goto on_error;
+	}
+	cow_file->free_blocks_read = 1;
+
+	return( 1 );
+
+on_error:
+	if( cow_file->free_blocks_bitmap != NULL )
+	{
+		memory_free(
+		 cow_file->free_blocks_bitmap );
+
+		cow_file->free_blocks_bitmap = NULL;
+	}
+	cow_file->free_blocks_bitmap_number_of_blocks = 0;
+	cow_file->free_blocks_search_block_number     = 0;
+	cow_file->number_of_free_blocks               = 0;
+
+	return( -1 );
+}
+
+/* Discards the data blocks within a specific range
+ * Only blocks that are fully contained in the range are discarded, where the last block
+ * is considered fully contained if the range extends to the end of the data
+ * The allocation table entries of the discarded blocks are cleared and the data blocks
+ * are marked as free to be reused by subsequent allocations
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_cow_file_discard_blocks(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     size64_t size,
+     uint32_t *number_of_discarded_blocks,
+     libcerror_error_t **error )
+{
+	libbfoverlay_cow_allocation_table_block_t *allocation_table_block = NULL;
+	static char *function                                            = "libbfoverlay_cow_file_discard_blocks";
+	off64_t end_offset                                               = 0;
+	off64_t file_offset                                              = 0;
+	off64_t range_end_offset                                         = 0;
+	off64_t range_start_offset                                       = 0;
+	off64_t table_block_offset                                       = 0;
+	uint32_t block_number                                            = 0;
+	uint32_t expected_block_number                                   = 0;
+	uint32_t safe_number_of_discarded_blocks                         = 0;
+	int entry_index                                                  = 0;
+	int result                                                       = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( cow_file->block_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid level 1 COW allocation table entry: %d block number value: %" PRIu32 " out of bounds.",
-		 function,
-		 entry_index,
-		 block_number );
+		 "%s: invalid COW file - block size value out of bounds.",
+		 function );
 
 		return( -1 );
 	}
-	depth = 2;
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
 
-	while( blocks_per_entry > 1 )
+		return( -1 );
+	}
+	if( size > (size64_t) ( INT64_MAX - offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_discarded_blocks == NULL )
 	{
-		safe_file_offset = (off64_t) block_number * cow_file->block_size;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of discarded blocks.",
+		 function );
 
-		table_index      -= entry_index * blocks_per_entry;
-		blocks_per_entry /= cow_file->allocation_table_block->number_of_entries;
-		entry_index       = table_index / blocks_per_entry;
+		return( -1 );
+	}
+	end_offset = offset + (off64_t) size;
 
-		if( libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
-		     cow_file->allocation_table_block,
+	if( (size64_t) end_offset >= cow_file->data_size )
+	{
+		end_offset = (off64_t) cow_file->data_size;
+	}
+	else
+	{
+		end_offset -= end_offset % cow_file->block_size;
+	}
+	if( ( offset % cow_file->block_size ) != 0 )
+	{
+		offset += cow_file->block_size - ( offset % cow_file->block_size );
+	}
+	if( ( offset < end_offset )
+	 && ( cow_file->free_blocks_read == 0 ) )
+	{
+		if( libbfoverlay_cow_file_read_free_blocks(
+		     cow_file,
 		     file_io_pool,
 		     file_io_pool_entry,
-		     safe_file_offset,
-		     entry_index,
-		     &block_number,
 		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read free blocks.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	while( offset < end_offset )
+	{
+		result = libbfoverlay_cow_file_get_block_at_offset(
+		          cow_file,
+		          file_io_pool,
+		          file_io_pool_entry,
+		          offset,
+		          &range_start_offset,
+		          &range_end_offset,
+		          &file_offset,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve level %d COW allocation table entry: %d at offset %" PRIi64 " (0x%08" PRIx64 ").",
+			 "%s: unable to retrieve block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
 			 function,
-			 depth,
-			 entry_index,
-			 safe_file_offset,
-			 safe_file_offset );
+			 offset,
+			 offset );
 
 			return( -1 );
 		}
-		if( ( block_number != LIBBFOVERLAY_COW_BLOCK_NUMBER_NOT_SET )
-		 && ( block_number > cow_file->last_data_block_number ) )
+		if( range_end_offset <= offset )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid level %d COW allocation table entry: %d at offset %" PRIi64 " (0x%08" PRIx64 ") block number value: %" PRIu32 " out of bounds.",
-			 function,
-			 depth,
-			 entry_index,
-			 safe_file_offset,
-			 safe_file_offset,
-			 block_number );
+			 "%s: invalid range end offset value out of bounds.",
+			 function );
 
 			return( -1 );
 		}
-		depth++;
-	}
-	*file_offset        = (off64_t) block_number * cow_file->block_size;
-	*range_start_offset = (off64_t) table_index * cow_file->block_size;
-	*range_end_offset   = ( (off64_t) table_index * cow_file->block_size ) + cow_file->block_size;
+		if( result != 0 )
+		{
+			if( libbfoverlay_cow_file_get_allocation_table_entry_for_offset(
+			     cow_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     offset,
+			     &allocation_table_block,
+			     &table_block_offset,
+			     &entry_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve allocation table entry for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset,
+				 offset );
 
-	if( block_number == LIBBFOVERLAY_COW_BLOCK_NUMBER_NOT_SET )
-	{
-		return( 0 );
+				return( -1 );
+			}
+			if( libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
+			     allocation_table_block,
+			     entry_index,
+			     &block_number,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve COW allocation table entry: %d.",
+				 function,
+				 entry_index );
+
+				return( -1 );
+			}
+			if( file_offset < 0 )
+			{
+				expected_block_number = LIBBFOVERLAY_COW_BLOCK_NUMBER_ZERO;
+			}
+			else
+			{
+				expected_block_number = (uint32_t) ( file_offset / cow_file->block_size );
+			}
+			if( ( block_number == LIBBFOVERLAY_COW_BLOCK_NUMBER_NOT_SET )
+			 || ( block_number != expected_block_number ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid COW allocation table entry: %d block number value: %" PRIu32 " out of bounds.",
+				 function,
+				 entry_index,
+				 block_number );
+
+				return( -1 );
+			}
+			if( libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
+			     allocation_table_block,
+			     entry_index,
+			     LIBBFOVERLAY_COW_BLOCK_NUMBER_NOT_SET,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set COW allocation table entry: %d.",
+				 function,
+				 entry_index );
+
+				return( -1 );
+			}
+			if( libbfoverlay_cow_file_write_allocation_table_entries(
+			     cow_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     allocation_table_block,
+			     entry_index,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write COW allocation table entry: %d at offset %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 entry_index,
+				 table_block_offset,
+				 table_block_offset );
+
+				return( -1 );
+			}
+			/* A block that only contains zero bytes has no data block to reuse
+			 */
+			if( block_number != LIBBFOVERLAY_COW_BLOCK_NUMBER_ZERO )
+			{
+				if( libbfoverlay_cow_file_release_block(
+				     cow_file,
+				     block_number,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release block: %" PRIu32 ".",
+					 function,
+					 block_number );
+
+					return( -1 );
+				}
+			}
+			safe_number_of_discarded_blocks++;
+		}
+		offset = range_end_offset;
 	}
+	*number_of_discarded_blocks = safe_number_of_discarded_blocks;
+
 	return( 1 );
 }
-
@@ -26,8 +26,11 @@
 #include <types.h>
 
 #include "libbfoverlay_cow_allocation_table_block.h"
+#include "libbfoverlay_io_statistics.h"
 #include "libbfoverlay_libbfio.h"
+#include "libbfoverlay_libcdata.h"
 #include "libbfoverlay_libcerror.h"
+#include "libbfoverlay_libcthreads.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -53,13 +56,68 @@ struct libbfoverlay_cow_file
 	 */
 	uint32_t last_data_block_number;
 
-	/* Offset of the level 1 allocation table
+	/* The level 1 allocation table block
 	 */
-	off64_t l1_allocation_table_offset;
+	libbfoverlay_cow_allocation_table_block_t *l1_allocation_table_block;
 
-	/* Allocation table block
+	/* The allocation table block cache
 	 */
-	libbfoverlay_cow_allocation_table_block_t *allocation_table_block;
+	libcdata_array_t *allocation_table_block_cache;
+
+	/* The maximum allocation table cache size
+	 */
+	size_t maximum_cache_size;
+
+	/* The maximum size of allocation table blocks with changes that have not been written
+	 * 0 represents that changes are written immediately
+	 */
+	size_t maximum_dirty_size;
+
+	/* The number of allocation table blocks with changes that have not been written
+	 */
+	int number_of_dirty_blocks;
+
+	/* The free blocks bitmap, where a set bit indicates the corresponding block is not in use
+	 */
+	uint8_t *free_blocks_bitmap;
+
+	/* The number of blocks the free blocks bitmap can hold
+	 */
+	uint32_t free_blocks_bitmap_number_of_blocks;
+
+	/* The number of free blocks
+	 */
+	uint32_t number_of_free_blocks;
+
+	/* The block number to start searching for free blocks
+	 */
+	uint32_t free_blocks_search_block_number;
+
+	/* Value to indicate the free blocks were read from the allocation table
+	 */
+	uint8_t free_blocks_read;
+
+	/* The blocks that are marked as free when the allocation table blocks are flushed
+	 */
+	uint32_t *pending_free_blocks;
+
+	/* The number of blocks the pending free blocks array can hold
+	 */
+	uint32_t pending_free_blocks_size;
+
+	/* The number of pending free blocks
+	 */
+	uint32_t number_of_pending_free_blocks;
+
+	/* The IO statistics, which are not managed by the COW file
+	 */
+	libbfoverlay_io_statistics_t *io_statistics;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
 };
 
 int libbfoverlay_cow_file_initialize(
@@ -81,6 +139,95 @@ int libbfoverlay_cow_file_close(
      libbfoverlay_cow_file_t *cow_file,
      libcerror_error_t **error );
 
+int libbfoverlay_cow_file_get_maximum_cache_size(
+     libbfoverlay_cow_file_t *cow_file,
+     size_t *maximum_cache_size,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_set_maximum_cache_size(
+     libbfoverlay_cow_file_t *cow_file,
+     size_t maximum_cache_size,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_get_maximum_dirty_size(
+     libbfoverlay_cow_file_t *cow_file,
+     size_t *maximum_dirty_size,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_set_maximum_dirty_size(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size_t maximum_dirty_size,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_get_block_size(
+     libbfoverlay_cow_file_t *cow_file,
+     size32_t *block_size,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_set_block_size(
+     libbfoverlay_cow_file_t *cow_file,
+     size32_t block_size,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_get_cache_entry(
+     libbfoverlay_cow_file_t *cow_file,
+     uint32_t block_number,
+     libbfoverlay_cow_allocation_table_block_t **allocation_table_block,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_get_cached_allocation_table_block(
+     libbfoverlay_cow_file_t *cow_file,
+     uint32_t block_number,
+     libbfoverlay_cow_allocation_table_block_t **allocation_table_block,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_get_allocation_table_block(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint32_t block_number,
+     libbfoverlay_cow_allocation_table_block_t **allocation_table_block,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_create_allocation_table_block(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint32_t block_number,
+     libbfoverlay_cow_allocation_table_block_t **allocation_table_block,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_write_allocation_table_block(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libbfoverlay_cow_allocation_table_block_t *allocation_table_block,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_set_allocation_table_block_dirty(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libbfoverlay_cow_allocation_table_block_t *allocation_table_block,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_write_allocation_table_entries(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libbfoverlay_cow_allocation_table_block_t *allocation_table_block,
+     int entry_index,
+     int number_of_entries,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_flush(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
 int libbfoverlay_cow_file_set_data_size(
      libbfoverlay_cow_file_t *cow_file,
      libbfio_pool_t *file_io_pool,
@@ -94,6 +241,16 @@ int libbfoverlay_cow_file_enlarge_allocation_table(
      int file_io_pool_entry,
      libcerror_error_t **error );
 
+int libbfoverlay_cow_file_get_allocation_table_entry_for_offset(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     libbfoverlay_cow_allocation_table_block_t **allocation_table_block,
+     off64_t *table_block_offset,
+     int *entry_index,
+     libcerror_error_t **error );
+
 int libbfoverlay_cow_file_allocate_block_for_offset(
      libbfoverlay_cow_file_t *cow_file,
      libbfio_pool_t *file_io_pool,
@@ -102,6 +259,16 @@ int libbfoverlay_cow_file_allocate_block_for_offset(
      off64_t *file_offset,
      libcerror_error_t **error );
 
+int libbfoverlay_cow_file_allocate_blocks_for_offset(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     uint32_t maximum_number_of_blocks,
+     off64_t *file_offset,
+     uint32_t *number_of_blocks,
+     libcerror_error_t **error );
+
 int libbfoverlay_cow_file_get_block_at_offset(
      libbfoverlay_cow_file_t *cow_file,
      libbfio_pool_t *file_io_pool,
@@ -112,6 +279,75 @@ int libbfoverlay_cow_file_get_block_at_offset(
      off64_t *file_offset,
      libcerror_error_t **error );
 
+int libbfoverlay_cow_file_get_contiguous_blocks_at_offset(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     uint32_t maximum_number_of_blocks,
+     off64_t *file_offset,
+     uint32_t *number_of_blocks,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_check_for_zero_block(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_set_zero_blocks_for_offset(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     uint64_t number_of_blocks,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_set_free_block(
+     libbfoverlay_cow_file_t *cow_file,
+     uint32_t block_number,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_release_block(
+     libbfoverlay_cow_file_t *cow_file,
+     uint32_t block_number,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_get_free_blocks(
+     libbfoverlay_cow_file_t *cow_file,
+     uint32_t maximum_number_of_blocks,
+     uint32_t *block_number,
+     uint32_t *number_of_blocks,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_allocate_block_number(
+     libbfoverlay_cow_file_t *cow_file,
+     uint32_t *block_number,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_read_free_blocks_from_allocation_table_block(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libbfoverlay_cow_allocation_table_block_t *allocation_table_block,
+     uint32_t blocks_per_entry,
+     int depth,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_read_free_blocks(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
+int libbfoverlay_cow_file_discard_blocks(
+     libbfoverlay_cow_file_t *cow_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     size64_t size,
+     uint32_t *number_of_discarded_blocks,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
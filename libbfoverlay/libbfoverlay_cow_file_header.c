@@ -374,7 +374,18 @@ int libbfoverlay_cow_file_header_write_file_io_pool(
 
 		return( -1 );
 	}
-	cow_file_header->block_size                 = 4096;
+	if( ( (size_t) cow_file_header->block_size < sizeof( bfoverlay_cow_file_header_t ) )
+	 || ( cow_file_header->block_size > LIBBFOVERLAY_COW_MAXIMUM_BLOCK_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid COW file header - block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 	cow_file_header->number_of_allocated_blocks = (uint32_t) ( cow_file_header->block_size - sizeof( bfoverlay_cow_file_header_t ) ) / sizeof( bfoverlay_cow_allocation_table_block_entry_t );
 
 	if( memory_copy(
@@ -534,6 +534,46 @@ int libbfoverlay_descriptor_file_read_data(
 			{
 				layer->use_cow = 1;
 			}
+			else if( ( value_string_size > 11 )
+			      && ( memory_compare(
+			            value_string,
+			            "block_size=",
+			            11 ) == 0 ) )
+			{
+				if( libfvalue_utf8_string_copy_to_integer(
+				     &( value_string[ 11 ] ),
+				     value_string_size - 11,
+				     (uint64_t *) &value_64bit,
+				     64,
+				     LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to set layer: %d block size.",
+					 function,
+					 layer_index );
+
+					goto on_error;
+				}
+				if( ( value_64bit < LIBBFOVERLAY_COW_MINIMUM_BLOCK_SIZE )
+				 || ( value_64bit > LIBBFOVERLAY_COW_MAXIMUM_BLOCK_SIZE )
+				 || ( ( value_64bit & ( value_64bit - 1 ) ) != 0 ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid layer: %d block size value out of bounds.",
+					 function,
+					 layer_index );
+
+					goto on_error;
+				}
+				layer->cow_block_size = (size32_t) value_64bit;
+			}
 			else if( ( value_string_size > 12 )
 			      && ( memory_compare(
 			            value_string,
@@ -625,6 +665,18 @@ int libbfoverlay_descriptor_file_read_data(
 			}
 			cow_layer_index = layer_index;
 		}
+		else if( layer->cow_block_size != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid layer: %d block size specified without COW.",
+			 function,
+			 layer_index );
+
+			goto on_error;
+		}
 		else if( layer->data_file_path == NULL )
 		{
 			if( layer->size == -1 )
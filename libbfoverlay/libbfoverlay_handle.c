@@ -25,6 +25,10 @@
 #include <types.h>
 #include <wide_string.h>
 
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
 #include "libbfoverlay_definitions.h"
 #include "libbfoverlay_descriptor_file.h"
 #include "libbfoverlay_handle.h"
@@ -37,6 +41,7 @@
 #include "libbfoverlay_libcthreads.h"
 #include "libbfoverlay_libuna.h"
 #include "libbfoverlay_range.h"
+#include "libbfoverlay_range_map.h"
 #include "libbfoverlay_types.h"
 
 /* Creates a handle
@@ -120,6 +125,7 @@ int libbfoverlay_handle_initialize(
 #endif
 	internal_handle->cow_file_io_pool_entry         = -1;
 	internal_handle->maximum_number_of_open_handles = LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES;
+	internal_handle->maximum_cache_size             = LIBBFOVERLAY_DEFAULT_MAXIMUM_CACHE_SIZE;
 
 	*handle = (libbfoverlay_handle_t *) internal_handle;
 
@@ -720,6 +726,7 @@ int libbfoverlay_internal_handle_open_data_files(
 	libbfoverlay_layer_t *layer  = NULL;
 	static char *function        = "libbfoverlay_internal_handle_open_data_files";
 	size64_t file_size           = 0;
+	size32_t cow_block_size      = 0;
 	int bfio_access_flags        = 0;
 	int layer_index              = 0;
 	int number_of_layers         = 0;
@@ -763,6 +770,17 @@ int libbfoverlay_internal_handle_open_data_files(
 
 		return( -1 );
 	}
+	if( internal_handle->io_statistics != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - IO statistics already exists.",
+		 function );
+
+		return( -1 );
+	}
 	if( libbfoverlay_descriptor_get_number_of_layers(
 	     internal_handle->descriptor_file,
 	     &number_of_layers,
@@ -777,6 +795,20 @@ int libbfoverlay_internal_handle_open_data_files(
 
 		goto on_error;
 	}
+	if( libbfoverlay_io_statistics_initialize(
+	     &( internal_handle->io_statistics ),
+	     number_of_layers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create IO statistics.",
+		 function );
+
+		goto on_error;
+	}
 	if( libbfio_pool_initialize(
 	     &file_io_pool,
 	     number_of_layers,
@@ -946,6 +978,8 @@ int libbfoverlay_internal_handle_open_data_files(
 				bfio_access_flags |= LIBBFIO_OPEN_WRITE;
 
 				internal_handle->cow_file_io_pool_entry = number_of_layers - 1;
+
+				cow_block_size = layer->cow_block_size;
 			}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 			if( libbfio_file_pool_open_wide(
@@ -1158,6 +1192,58 @@ int libbfoverlay_internal_handle_open_data_files(
 
 			goto on_error;
 		}
+		if( internal_handle->record_statistics != 0 )
+		{
+			internal_handle->cow_file->io_statistics = internal_handle->io_statistics;
+		}
+
+		if( cow_block_size != 0 )
+		{
+			if( libbfoverlay_cow_file_set_block_size(
+			     internal_handle->cow_file,
+			     cow_block_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set COW file block size.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libbfoverlay_cow_file_set_maximum_cache_size(
+		     internal_handle->cow_file,
+		     internal_handle->maximum_cache_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set COW file maximum cache size.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfoverlay_cow_file_set_maximum_dirty_size(
+		     internal_handle->cow_file,
+		     file_io_pool,
+		     internal_handle->cow_file_io_pool_entry,
+		     internal_handle->maximum_dirty_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set COW file maximum dirty size.",
+			 function );
+
+			goto on_error;
+		}
 		if( libbfoverlay_cow_file_open(
 		     internal_handle->cow_file,
 		     file_io_pool,
@@ -1247,6 +1333,12 @@ on_error:
 		 &( internal_handle->cow_file ),
 		 NULL );
 	}
+	if( internal_handle->io_statistics != NULL )
+	{
+		libbfoverlay_io_statistics_free(
+		 &( internal_handle->io_statistics ),
+		 NULL );
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( wide_file_path != NULL )
 	{
@@ -1493,6 +1585,27 @@ int libbfoverlay_handle_close(
 		return( -1 );
 	}
 #endif
+	/* The COW file must be flushed before the data files are closed
+	 */
+	if( ( internal_handle->cow_file != NULL )
+	 && ( internal_handle->data_file_io_pool != NULL ) )
+	{
+		if( libbfoverlay_cow_file_flush(
+		     internal_handle->cow_file,
+		     internal_handle->data_file_io_pool,
+		     internal_handle->cow_file_io_pool_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush COW file.",
+			 function );
+
+			result = -1;
+		}
+	}
 	if( internal_handle->file_io_handle_opened_in_library != 0 )
 	{
 		if( libbfio_handle_close(
@@ -1595,6 +1708,22 @@ int libbfoverlay_handle_close(
 		}
 		internal_handle->cow_file_io_pool_entry = -1;
 	}
+	if( internal_handle->io_statistics != NULL )
+	{
+		if( libbfoverlay_io_statistics_free(
+		     &( internal_handle->io_statistics ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free IO statistics.",
+			 function );
+
+			result = -1;
+		}
+	}
 	if( internal_handle->cow_block_data != NULL )
 	{
 		memory_free(
@@ -1602,18 +1731,17 @@ int libbfoverlay_handle_close(
 
 		internal_handle->cow_block_data = NULL;
 	}
-	if( internal_handle->ranges_array != 0 )
+	if( internal_handle->range_map != NULL )
 	{
-		if( libcdata_array_free(
-		     &( internal_handle->ranges_array ),
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libbfoverlay_range_free,
+		if( libbfoverlay_range_map_free(
+		     &( internal_handle->range_map ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free ranges array.",
+			 "%s: unable to free range map.",
 			 function );
 
 			result = -1;
@@ -1725,12 +1853,15 @@ on_error:
 }
 
 /* Determine the ranges for reading
+ * The ranges are determined using a temporary ranges array and are stored
+ * in a range map that is sorted by offset
  * Returns 1 if successful or -1 on error
  */
 int libbfoverlay_internal_handle_open_determine_ranges(
      libbfoverlay_internal_handle_t *internal_handle,
      libcerror_error_t **error )
 {
+	libcdata_array_t *ranges_array   = NULL;
 	libbfoverlay_layer_t *layer      = NULL;
 	libbfoverlay_range_t *range      = NULL;
 	libbfoverlay_range_t *safe_range = NULL;
@@ -1757,19 +1888,19 @@ int libbfoverlay_internal_handle_open_determine_ranges(
 
 		return( -1 );
 	}
-	if( internal_handle->ranges_array != NULL )
+	if( internal_handle->range_map != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - ranges array value already set.",
+		 "%s: invalid handle - range map value already set.",
 		 function );
 
 		return( -1 );
 	}
 	if( libcdata_array_initialize(
-	     &( internal_handle->ranges_array ),
+	     &ranges_array,
 	     0,
 	     error ) != 1 )
 	{
@@ -1859,7 +1990,7 @@ int libbfoverlay_internal_handle_open_determine_ranges(
 		     range_index++ )
 		{
 			if( libcdata_array_get_entry_by_index(
-			     internal_handle->ranges_array,
+			     ranges_array,
 			     range_index,
 			     (intptr_t **) &range,
 			     error ) != 1 )
@@ -1933,7 +2064,7 @@ int libbfoverlay_internal_handle_open_determine_ranges(
 				}
 #endif
 				if( libcdata_array_insert_entry(
-				     internal_handle->ranges_array,
+				     ranges_array,
 				     &entry_index,
 				     (intptr_t *) safe_range,
 				     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libbfoverlay_range_compare,
@@ -2005,7 +2136,7 @@ int libbfoverlay_internal_handle_open_determine_ranges(
 			}
 #endif
 			if( libcdata_array_insert_entry(
-			     internal_handle->ranges_array,
+			     ranges_array,
 			     &entry_index,
 			     (intptr_t *) safe_range,
 			     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &libbfoverlay_range_compare,
@@ -2026,19 +2157,98 @@ int libbfoverlay_internal_handle_open_determine_ranges(
 			number_of_ranges++;
 		}
 	}
+	if( libbfoverlay_range_map_initialize(
+	     &( internal_handle->range_map ),
+	     number_of_ranges,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create range map.",
+		 function );
+
+		goto on_error;
+	}
+	for( range_index = 0;
+	     range_index < number_of_ranges;
+	     range_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     ranges_array,
+		     range_index,
+		     (intptr_t **) &range,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range: %d.",
+			 function,
+			 range_index );
+
+			goto on_error;
+		}
+		if( libbfoverlay_range_map_set_range_by_index(
+		     internal_handle->range_map,
+		     range_index,
+		     range,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set range: %d in range map.",
+			 function,
+			 range_index );
+
+			goto on_error;
+		}
+	}
+	if( libcdata_array_free(
+	     &ranges_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libbfoverlay_range_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free ranges array.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
+	if( internal_handle->range_map != NULL )
+	{
+		libbfoverlay_range_map_free(
+		 &( internal_handle->range_map ),
+		 NULL );
+	}
 	if( safe_range != NULL )
 	{
 		libbfoverlay_range_free(
 		 &safe_range,
 		 NULL );
 	}
+	if( ranges_array != NULL )
+	{
+		libcdata_array_free(
+		 &ranges_array,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libbfoverlay_range_free,
+		 NULL );
+	}
 	return( -1 );
 }
 
 /* Retrieve the range for a specific offset
+ * The range index is used as a hint to speed up sequential access and is set to the index of the range found
  * Returns 1 if successful, 0 if no range exists or -1 on error
  */
 int libbfoverlay_internal_handle_get_range_at_offset(
@@ -2048,10 +2258,8 @@ int libbfoverlay_internal_handle_get_range_at_offset(
      libbfoverlay_range_t **range,
      libcerror_error_t **error )
 {
-	libbfoverlay_range_t *safe_range = NULL;
-	static char *function            = "libbfoverlay_internal_handle_get_range_at_offset";
-	int number_of_ranges             = 0;
-	int safe_range_index             = 0;
+	static char *function = "libbfoverlay_internal_handle_get_range_at_offset";
+	int result            = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -2064,371 +2272,4868 @@ int libbfoverlay_internal_handle_get_range_at_offset(
 
 		return( -1 );
 	}
-	if( range_index == NULL )
+	result = libbfoverlay_range_map_get_range_at_offset(
+	          internal_handle->range_map,
+	          offset,
+	          range_index,
+	          range,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid range index.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve range at offset: %" PRIi64 " (0x%08" PRIx64 ") from range map.",
+		 function,
+		 offset,
+		 offset );
 
 		return( -1 );
 	}
-	if( range == NULL )
+	return( result );
+}
+
+/* Retrieves the data run at a specific offset
+ * A data run is the largest part of the data, up to the maximum size, that is stored
+ * contiguously in a single data file or is sparse
+ * The range index is used as a hint to speed up sequential access and is set to the index of the range found
+ * The file IO pool entry is set to -1 if the data run is sparse
+ * This function can be called by multiple threads concurrently, acquire at least a read lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_internal_handle_get_data_run_at_offset(
+     libbfoverlay_internal_handle_t *internal_handle,
+     off64_t offset,
+     size_t maximum_size,
+     int *range_index,
+     int *file_io_pool_entry,
+     off64_t *file_offset,
+     size_t *data_run_size,
+     int *latency_path,
+     libcerror_error_t **error )
+{
+	libbfoverlay_range_t *range     = NULL;
+	static char *function           = "libbfoverlay_internal_handle_get_data_run_at_offset";
+	size_t maximum_number_of_blocks = 0;
+	size_t read_size                = 0;
+	off64_t cow_block_end_offset    = 0;
+	off64_t cow_block_start_offset  = 0;
+	off64_t safe_file_offset        = 0;
+	uint32_t number_of_blocks       = 0;
+	int result                      = 0;
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid range.",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-/* TODO preserve current range and index */
-	if( libcdata_array_get_number_of_entries(
-	     internal_handle->ranges_array,
-	     &number_of_ranges,
-	     error ) != 1 )
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of ranges.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	for( safe_range_index = 0;
-	     safe_range_index < number_of_ranges;
-	     safe_range_index++ )
+	if( ( maximum_size == 0 )
+	 || ( maximum_size > (size_t) SSIZE_MAX ) )
 	{
-		if( libcdata_array_get_entry_by_index(
-		     internal_handle->ranges_array,
-		     safe_range_index,
-		     (intptr_t **) &safe_range,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve range: %d.",
-			 function,
-			 safe_range_index );
-
-			return( -1 );
-		}
-		if( range == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing range: %d.",
-			 function,
-			 safe_range_index );
-
-			return( -1 );
-		}
-		if( ( offset >= safe_range->start_offset )
-		 && ( offset < safe_range->end_offset ) )
-		{
-			*range_index = safe_range_index;
-			*range       = safe_range;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum size value out of bounds.",
+		 function );
 
-			return( 1 );
-		}
+		return( -1 );
 	}
-	return( 0 );
-}
-
-/* Reads data from the current offset into a buffer
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read or -1 on error
- */
-ssize_t libbfoverlay_internal_handle_read_buffer(
-         libbfoverlay_internal_handle_t *internal_handle,
-         uint8_t *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
-{
-	libbfoverlay_range_t *range    = NULL;
-	static char *function          = "libbfoverlay_internal_handle_read_buffer";
-	size_t buffer_offset           = 0;
-	size_t cow_block_offset        = 0;
-	size_t read_size               = 0;
-	ssize_t read_count             = 0;
-	off64_t cow_block_end_offset   = 0;
-	off64_t cow_block_start_offset = 0;
-	off64_t file_offset            = 0;
-	int range_index                = 0;
-	int result                     = 0;
-
-	if( internal_handle == NULL )
+	if( file_io_pool_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid file IO pool entry.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( file_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - current offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file offset.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( data_run_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 "%s: invalid data run size.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( latency_path == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid latency path.",
 		 function );
 
 		return( -1 );
 	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->size )
+	read_size = maximum_size;
+
+	if( internal_handle->cow_file != NULL )
 	{
-		return( 0 );
+		result = libbfoverlay_cow_file_get_block_at_offset(
+		          internal_handle->cow_file,
+		          internal_handle->data_file_io_pool,
+		          internal_handle->cow_file_io_pool_entry,
+		          offset,
+		          &cow_block_start_offset,
+		          &cow_block_end_offset,
+		          &safe_file_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve COW block at offset %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		/* Do not read beyond the COW block or the range without COW blocks
+		 */
+		if( (int64_t) read_size > ( cow_block_end_offset - offset ) )
+		{
+			read_size = (size_t) ( cow_block_end_offset - offset );
+		}
 	}
-	if( (size64_t) buffer_size > ( internal_handle->size - internal_handle->current_offset ) )
+	if( ( result != 0 )
+	 && ( safe_file_offset < 0 ) )
 	{
-		buffer_size = (size_t) ( internal_handle->size - internal_handle->current_offset );
+		/* The COW block only contains zero bytes and is read as sparse data
+		 */
+		*file_io_pool_entry = -1;
+		*file_offset        = 0;
+		*latency_path       = LIBBFOVERLAY_LATENCY_PATH_READ_SPARSE;
 	}
-	while( buffer_offset < buffer_size )
+	else if( result != 0 )
 	{
-		read_size = buffer_size - buffer_offset;
-
-		if( internal_handle->cow_file == NULL )
-		{
-			result = 0;
-		}
-		else
+		if( maximum_size > read_size )
 		{
-			result = libbfoverlay_cow_file_get_block_at_offset(
-			          internal_handle->cow_file,
-			          internal_handle->data_file_io_pool,
-			          internal_handle->cow_file_io_pool_entry,
-			          internal_handle->current_offset,
-			          &cow_block_start_offset,
-			          &cow_block_end_offset,
-			          &file_offset,
-			          error );
+			/* Consecutive blocks that are stored contiguously in the COW file are read at once
+			 */
+			maximum_number_of_blocks = 1 + ( ( maximum_size - read_size + internal_handle->cow_file->block_size - 1 ) / internal_handle->cow_file->block_size );
 
-			if( result == -1 )
+			if( maximum_number_of_blocks > (size_t) UINT32_MAX )
+			{
+				maximum_number_of_blocks = (size_t) UINT32_MAX;
+			}
+			if( libbfoverlay_cow_file_get_contiguous_blocks_at_offset(
+			     internal_handle->cow_file,
+			     internal_handle->data_file_io_pool,
+			     internal_handle->cow_file_io_pool_entry,
+			     cow_block_start_offset,
+			     (uint32_t) maximum_number_of_blocks,
+			     &safe_file_offset,
+			     &number_of_blocks,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve COW block at offset %" PRIi64 " (0x%08" PRIx64 ").",
+				 "%s: unable to retrieve contiguous COW blocks at offset %" PRIi64 " (0x%08" PRIx64 ").",
 				 function,
-				 internal_handle->current_offset,
-				 internal_handle->current_offset );
+				 cow_block_start_offset,
+				 cow_block_start_offset );
 
 				return( -1 );
 			}
-		}
-		if( result != 0 )
-		{
-			read_count = libbfio_pool_read_buffer_at_offset(
-			              internal_handle->data_file_io_pool,
-			              internal_handle->cow_file_io_pool_entry,
-			              internal_handle->cow_block_data,
-			              internal_handle->cow_file->block_size,
-			              file_offset,
-			              error );
-
-			if( read_count != (ssize_t) internal_handle->cow_file->block_size )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read COW block of size: %" PRIzd " from COW file at offset %" PRIi64 " (0x%08" PRIx64 ").",
-				 function,
-				 internal_handle->cow_file->block_size,
-				 cow_block_offset,
-				 cow_block_offset );
+			cow_block_end_offset = cow_block_start_offset + ( (off64_t) number_of_blocks * internal_handle->cow_file->block_size );
 
-				return( -1 );
-			}
-			cow_block_offset = (size_t) ( internal_handle->current_offset - cow_block_start_offset );
+			read_size = maximum_size;
 
-			if( (int64_t) read_size > ( cow_block_end_offset - internal_handle->current_offset ) )
+			if( (int64_t) read_size > ( cow_block_end_offset - offset ) )
 			{
-				read_size = (size_t) ( cow_block_end_offset - internal_handle->current_offset );
+				read_size = (size_t) ( cow_block_end_offset - offset );
 			}
-			if( memory_copy(
-			     &( buffer[ buffer_offset ] ),
-			     &( ( internal_handle->cow_block_data )[ cow_block_offset ] ),
-			     read_size ) == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-				 "%s: unable to copy buffer from COW block data.",
-				 function );
+		}
+		*file_io_pool_entry = internal_handle->cow_file_io_pool_entry;
+		*file_offset        = safe_file_offset + ( offset - cow_block_start_offset );
+		*latency_path       = LIBBFOVERLAY_LATENCY_PATH_READ_COW;
+	}
+	else
+	{
+		if( libbfoverlay_internal_handle_get_range_at_offset(
+		     internal_handle,
+		     offset,
+		     range_index,
+		     &range,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range at offset %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
 
-				return( -1 );
-			}
+			return( -1 );
+		}
+		if( range == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing range: %d.",
+			 function,
+			 *range_index );
+
+			return( -1 );
+		}
+		if( (int64_t) read_size > ( range->end_offset - offset ) )
+		{
+			read_size = (size_t) ( range->end_offset - offset );
+		}
+		if( ( range->flags & LIBBFOVERLAY_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			*file_io_pool_entry = -1;
+			*file_offset        = 0;
+			*latency_path       = LIBBFOVERLAY_LATENCY_PATH_READ_SPARSE;
 		}
 		else
 		{
-			if( range == NULL )
-			{
-				if( libbfoverlay_internal_handle_get_range_at_offset(
-			             internal_handle,
-			             internal_handle->current_offset,
-			             &range_index,
-			             &range,
-			             error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve range at offset %" PRIi64 " (0x%08" PRIx64 ").",
-					 function,
-					 internal_handle->current_offset,
-					 internal_handle->current_offset );
+			*file_io_pool_entry = range->data_file_index;
+			*file_offset        = range->data_file_offset + ( offset - range->start_offset );
 
-					return( -1 );
-				}
+			if( range->data_file_index == 0 )
+			{
+				*latency_path = LIBBFOVERLAY_LATENCY_PATH_READ_BASE_LAYER;
 			}
 			else
 			{
-/* TODO preserve current range and index ? */
-				range_index++;
+				*latency_path = LIBBFOVERLAY_LATENCY_PATH_READ_OVERLAY_LAYER;
+			}
+		}
+	}
+	*data_run_size = read_size;
 
-				if( libcdata_array_get_entry_by_index(
-				     internal_handle->ranges_array,
-				     range_index,
-				     (intptr_t **) &range,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve range: %d.",
-					 function,
-					 range_index );
+	return( 1 );
+}
 
-					return( -1 );
-				}
-			}
-			if( range == NULL )
+/* Reads the data of a data run into a buffer
+ * The latency path, as returned by libbfoverlay_internal_handle_get_data_run_at_offset,
+ * determines if the data is read from the COW file, a layer or is sparse
+ * This function can be called by multiple threads concurrently, acquire at least a read lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_internal_handle_read_data_run(
+     libbfoverlay_internal_handle_t *internal_handle,
+     int file_io_pool_entry,
+     off64_t file_offset,
+     int latency_path,
+     uint8_t *buffer,
+     size_t read_size,
+     libcerror_error_t **error )
+{
+	static char *function    = "libbfoverlay_internal_handle_read_data_run";
+	ssize_t read_count       = 0;
+	uint64_t start_timestamp = 0;
+	int io_type              = 0;
+	int layer_index          = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid read size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( latency_path == LIBBFOVERLAY_LATENCY_PATH_READ_SPARSE )
+	{
+		if( memory_set(
+		     buffer,
+		     0,
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( internal_handle->record_statistics != 0 )
+		{
+			if( libbfoverlay_io_statistics_add_io(
+			     internal_handle->io_statistics,
+			     LIBBFOVERLAY_IO_TYPE_SPARSE_READ,
+			     0,
+			     read_size,
+			     0,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing range: %d.",
-				 function,
-				 range_index );
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update IO statistics.",
+				 function );
 
 				return( -1 );
 			}
-			if( (int64_t) read_size > ( range->end_offset - internal_handle->current_offset ) )
-			{
-				read_size = (size_t) ( range->end_offset - internal_handle->current_offset );
-			}
-			if( ( range->flags & LIBBFOVERLAY_RANGE_FLAG_IS_SPARSE ) != 0 )
-			{
-				if( memory_set(
-				     &( buffer[ buffer_offset ] ),
-				     0,
-				     read_size ) == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to clear buffer.",
-					 function );
+		}
+		return( 1 );
+	}
+	if( latency_path == LIBBFOVERLAY_LATENCY_PATH_READ_COW )
+	{
+		io_type = LIBBFOVERLAY_IO_TYPE_COW_READ;
+	}
+	else
+	{
+		io_type     = LIBBFOVERLAY_IO_TYPE_LAYER_READ;
+		layer_index = file_io_pool_entry;
+	}
+	if( internal_handle->record_statistics != 0 )
+	{
+		if( libbfoverlay_io_statistics_get_timestamp(
+		     &start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve start timestamp.",
+			 function );
 
-					return( -1 );
-				}
-			}
-			else
-			{
-				file_offset = range->data_file_offset + ( internal_handle->current_offset - range->start_offset );
+			return( -1 );
+		}
+	}
+	read_count = libbfio_pool_read_buffer_at_offset(
+	              internal_handle->data_file_io_pool,
+	              file_io_pool_entry,
+	              buffer,
+	              read_size,
+	              file_offset,
+	              error );
+
+	if( read_count != (ssize_t) read_size )
+	{
+		if( io_type == LIBBFOVERLAY_IO_TYPE_COW_READ )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data of size: %" PRIzd " from COW file at offset %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_size,
+			 file_offset,
+			 file_offset );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data of size: %" PRIzd " from layer: %d at offset %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_size,
+			 file_io_pool_entry,
+			 file_offset,
+			 file_offset );
+		}
+		return( -1 );
+	}
+	if( internal_handle->record_statistics != 0 )
+	{
+		if( libbfoverlay_io_statistics_add_io(
+		     internal_handle->io_statistics,
+		     io_type,
+		     layer_index,
+		     read_size,
+		     start_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update IO statistics.",
+			 function );
 
-				read_count = libbfio_pool_read_buffer_at_offset(
-				              internal_handle->data_file_io_pool,
-				              range->data_file_index,
-				              &( buffer[ buffer_offset ] ),
-				              read_size,
-				              file_offset,
-				              error );
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
 
-				if( read_count != (ssize_t) read_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read data of size: %" PRIzd " from layer: %d at offset %" PRIi64 " (0x%08" PRIx64 ").",
-					 function,
-					 read_size,
-					 range->data_file_index,
-					 file_offset,
-					 file_offset );
+/* Reads data at a specific offset into a buffer
+ * This function does not change the current offset and can be called by multiple threads
+ * concurrently, acquire at least a read lock before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libbfoverlay_internal_handle_read_buffer_at_offset(
+         libbfoverlay_internal_handle_t *internal_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function            = "libbfoverlay_internal_handle_read_buffer_at_offset";
+	size_t buffer_offset             = 0;
+	size_t read_size                 = 0;
+	off64_t file_offset              = 0;
+	uint64_t latency_start_timestamp = 0;
+	int file_io_pool_entry           = 0;
+	int latency_path                 = 0;
+	int range_index                  = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_handle->size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) buffer_size > ( internal_handle->size - offset ) )
+	{
+		buffer_size = (size_t) ( internal_handle->size - offset );
+	}
+	while( buffer_offset < buffer_size )
+	{
+		if( internal_handle->record_latency_histograms != 0 )
+		{
+			if( libbfoverlay_io_statistics_get_timestamp(
+			     &latency_start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve latency start timestamp.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( libbfoverlay_internal_handle_get_data_run_at_offset(
+		     internal_handle,
+		     offset,
+		     buffer_size - buffer_offset,
+		     &range_index,
+		     &file_io_pool_entry,
+		     &file_offset,
+		     &read_size,
+		     &latency_path,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data run at offset %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		/* Read the data directly into the buffer, so no shared COW block buffer is needed
+		 */
+		if( libbfoverlay_internal_handle_read_data_run(
+		     internal_handle,
+		     file_io_pool_entry,
+		     file_offset,
+		     latency_path,
+		     &( buffer[ buffer_offset ] ),
+		     read_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data run at offset %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		if( ( internal_handle->record_latency_histograms != 0 )
+		 && ( internal_handle->io_statistics != NULL ) )
+		{
+			if( libbfoverlay_io_statistics_add_latency(
+			     internal_handle->io_statistics,
+			     latency_path,
+			     latency_start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update latency histogram.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		buffer_offset += read_size;
+		offset        += read_size;
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Reads data at a specific offset into multiple buffers
+ * The buffers are filled in order as if they were a single buffer
+ * Every data run is read at once, a data run that spans multiple buffers is read
+ * into an intermediate buffer, unless the remainder of the current buffer is large
+ * This function does not change the current offset and can be called by multiple threads
+ * concurrently, acquire at least a read lock before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libbfoverlay_internal_handle_read_vector_at_offset(
+         libbfoverlay_internal_handle_t *internal_handle,
+         uint8_t **buffers,
+         const size_t *buffer_sizes,
+         int number_of_buffers,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	uint8_t *intermediate_buffer     = NULL;
+	static char *function            = "libbfoverlay_internal_handle_read_vector_at_offset";
+	size_t buffer_offset             = 0;
+	size_t copy_offset               = 0;
+	size_t copy_size                 = 0;
+	size_t intermediate_buffer_size  = 0;
+	size_t read_size                 = 0;
+	size_t segment_size              = 0;
+	size_t vector_offset             = 0;
+	size_t vector_size               = 0;
+	off64_t file_offset              = 0;
+	uint64_t latency_start_timestamp = 0;
+	int buffer_index                 = 0;
+	int file_io_pool_entry           = 0;
+	int latency_path                 = 0;
+	int range_index                  = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buffers < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of buffers value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( buffer_sizes[ buffer_index ] == 0 )
+		{
+			continue;
+		}
+		if( buffers[ buffer_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid buffer: %d.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+		if( buffer_sizes[ buffer_index ] > ( (size_t) SSIZE_MAX - vector_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid buffer sizes value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		vector_size += buffer_sizes[ buffer_index ];
+	}
+	if( (size64_t) offset >= internal_handle->size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) vector_size > ( internal_handle->size - offset ) )
+	{
+		vector_size = (size_t) ( internal_handle->size - offset );
+	}
+	buffer_index = 0;
+
+	while( vector_offset < vector_size )
+	{
+		while( buffer_offset >= buffer_sizes[ buffer_index ] )
+		{
+			buffer_index++;
+
+			buffer_offset = 0;
+		}
+		if( internal_handle->record_latency_histograms != 0 )
+		{
+			if( libbfoverlay_io_statistics_get_timestamp(
+			     &latency_start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve latency start timestamp.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libbfoverlay_internal_handle_get_data_run_at_offset(
+		     internal_handle,
+		     offset,
+		     vector_size - vector_offset,
+		     &range_index,
+		     &file_io_pool_entry,
+		     &file_offset,
+		     &read_size,
+		     &latency_path,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data run at offset %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			goto on_error;
+		}
+		segment_size = buffer_sizes[ buffer_index ] - buffer_offset;
+
+		if( ( read_size > segment_size )
+		 && ( segment_size >= (size_t) LIBBFOVERLAY_MAXIMUM_INTERMEDIATE_READ_SIZE ) )
+		{
+			/* Copying a large remainder of a buffer costs more than an additional read
+			 */
+			read_size = segment_size;
+		}
+		if( read_size <= segment_size )
+		{
+			if( libbfoverlay_internal_handle_read_data_run(
+			     internal_handle,
+			     file_io_pool_entry,
+			     file_offset,
+			     latency_path,
+			     &( ( buffers[ buffer_index ] )[ buffer_offset ] ),
+			     read_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read data run at offset %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset,
+				 offset );
+
+				goto on_error;
+			}
+			buffer_offset += read_size;
+		}
+		else if( latency_path == LIBBFOVERLAY_LATENCY_PATH_READ_SPARSE )
+		{
+			/* A sparse data run is cleared in every buffer it spans
+			 */
+			for( copy_offset = 0;
+			     copy_offset < read_size;
+			     copy_offset += copy_size )
+			{
+				while( buffer_offset >= buffer_sizes[ buffer_index ] )
+				{
+					buffer_index++;
+
+					buffer_offset = 0;
+				}
+				copy_size = buffer_sizes[ buffer_index ] - buffer_offset;
+
+				if( copy_size > ( read_size - copy_offset ) )
+				{
+					copy_size = read_size - copy_offset;
+				}
+				if( memory_set(
+				     &( ( buffers[ buffer_index ] )[ buffer_offset ] ),
+				     0,
+				     copy_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear buffer: %d.",
+					 function,
+					 buffer_index );
+
+					goto on_error;
+				}
+				buffer_offset += copy_size;
+			}
+			if( internal_handle->record_statistics != 0 )
+			{
+				if( libbfoverlay_io_statistics_add_io(
+				     internal_handle->io_statistics,
+				     LIBBFOVERLAY_IO_TYPE_SPARSE_READ,
+				     0,
+				     read_size,
+				     0,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to update IO statistics.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+		else
+		{
+			if( intermediate_buffer == NULL )
+			{
+				intermediate_buffer_size = vector_size;
+
+				if( intermediate_buffer_size > (size_t) LIBBFOVERLAY_MAXIMUM_INTERMEDIATE_READ_SIZE )
+				{
+					intermediate_buffer_size = (size_t) LIBBFOVERLAY_MAXIMUM_INTERMEDIATE_READ_SIZE;
+				}
+				intermediate_buffer = (uint8_t *) memory_allocate(
+				                                   sizeof( uint8_t ) * intermediate_buffer_size );
+
+				if( intermediate_buffer == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create intermediate buffer.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( read_size > intermediate_buffer_size )
+			{
+				read_size = intermediate_buffer_size;
+			}
+			if( libbfoverlay_internal_handle_read_data_run(
+			     internal_handle,
+			     file_io_pool_entry,
+			     file_offset,
+			     latency_path,
+			     intermediate_buffer,
+			     read_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read data run at offset %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset,
+				 offset );
+
+				goto on_error;
+			}
+			for( copy_offset = 0;
+			     copy_offset < read_size;
+			     copy_offset += copy_size )
+			{
+				while( buffer_offset >= buffer_sizes[ buffer_index ] )
+				{
+					buffer_index++;
+
+					buffer_offset = 0;
+				}
+				copy_size = buffer_sizes[ buffer_index ] - buffer_offset;
+
+				if( copy_size > ( read_size - copy_offset ) )
+				{
+					copy_size = read_size - copy_offset;
+				}
+				if( memory_copy(
+				     &( ( buffers[ buffer_index ] )[ buffer_offset ] ),
+				     &( intermediate_buffer[ copy_offset ] ),
+				     copy_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy data to buffer: %d.",
+					 function,
+					 buffer_index );
+
+					goto on_error;
+				}
+				buffer_offset += copy_size;
+			}
+		}
+		if( ( internal_handle->record_latency_histograms != 0 )
+		 && ( internal_handle->io_statistics != NULL ) )
+		{
+			if( libbfoverlay_io_statistics_add_latency(
+			     internal_handle->io_statistics,
+			     latency_path,
+			     latency_start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update latency histogram.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		vector_offset += read_size;
+		offset        += read_size;
+	}
+	if( intermediate_buffer != NULL )
+	{
+		memory_free(
+		 intermediate_buffer );
+	}
+	return( (ssize_t) vector_offset );
+
+on_error:
+	if( intermediate_buffer != NULL )
+	{
+		memory_free(
+		 intermediate_buffer );
+	}
+	return( -1 );
+}
+
+/* Compares two batch read segments by file IO pool entry and file offset
+ * This function is used as a qsort compare function
+ * Returns -1 if the first segment is stored before, 1 if after or 0 if equal
+ */
+int libbfoverlay_internal_handle_compare_batch_read_segments(
+     const void *first_segment,
+     const void *second_segment )
+{
+	const libbfoverlay_batch_read_segment_t *first_batch_read_segment  = NULL;
+	const libbfoverlay_batch_read_segment_t *second_batch_read_segment = NULL;
+
+	first_batch_read_segment  = (const libbfoverlay_batch_read_segment_t *) first_segment;
+	second_batch_read_segment = (const libbfoverlay_batch_read_segment_t *) second_segment;
+
+	if( first_batch_read_segment->file_io_pool_entry < second_batch_read_segment->file_io_pool_entry )
+	{
+		return( -1 );
+	}
+	else if( first_batch_read_segment->file_io_pool_entry > second_batch_read_segment->file_io_pool_entry )
+	{
+		return( 1 );
+	}
+	if( first_batch_read_segment->latency_path < second_batch_read_segment->latency_path )
+	{
+		return( -1 );
+	}
+	else if( first_batch_read_segment->latency_path > second_batch_read_segment->latency_path )
+	{
+		return( 1 );
+	}
+	if( first_batch_read_segment->file_offset < second_batch_read_segment->file_offset )
+	{
+		return( -1 );
+	}
+	else if( first_batch_read_segment->file_offset > second_batch_read_segment->file_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Reads data of multiple requests at specific offsets
+ * The requests are resolved into data runs, which are sorted by data file and file offset.
+ * Data runs that are adjacent or overlap in the same data file are read at once into an
+ * intermediate buffer, up to LIBBFOVERLAY_MAXIMUM_INTERMEDIATE_READ_SIZE
+ * The number of bytes read of each request are stored in read counts
+ * This function does not change the current offset and can be called by multiple threads
+ * concurrently, acquire at least a read lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_internal_handle_read_batch(
+     libbfoverlay_internal_handle_t *internal_handle,
+     uint8_t **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     int number_of_requests,
+     ssize_t *read_counts,
+     libcerror_error_t **error )
+{
+	libbfoverlay_batch_read_segment_t *batch_read_segment = NULL;
+	libbfoverlay_batch_read_segment_t *segments           = NULL;
+	uint8_t *intermediate_buffer                          = NULL;
+	void *reallocation                                    = NULL;
+	static char *function                                 = "libbfoverlay_internal_handle_read_batch";
+	size_t buffer_offset                                  = 0;
+	size_t maximum_number_of_segments                     = 0;
+	size_t number_of_segments                             = 0;
+	size_t read_size                                      = 0;
+	size_t request_size                                   = 0;
+	size_t segment_index                                  = 0;
+	size_t segment_index_end                              = 0;
+	off64_t file_offset                                   = 0;
+	off64_t merged_end_offset                             = 0;
+	off64_t offset                                        = 0;
+	off64_t segment_end_offset                            = 0;
+	uint64_t latency_start_timestamp                      = 0;
+	int file_io_pool_entry                                = 0;
+	int latency_path                                      = 0;
+	int range_index                                       = 0;
+	int request_index                                     = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_requests < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of requests value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_counts == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read counts.",
+		 function );
+
+		return( -1 );
+	}
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		if( ( buffers[ request_index ] == NULL )
+		 && ( buffer_sizes[ request_index ] > 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid buffer: %d.",
+			 function,
+			 request_index );
+
+			return( -1 );
+		}
+		if( buffer_sizes[ request_index ] > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid buffer: %d size value exceeds maximum.",
+			 function,
+			 request_index );
+
+			return( -1 );
+		}
+		if( offsets[ request_index ] < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid offset: %d value out of bounds.",
+			 function,
+			 request_index );
+
+			return( -1 );
+		}
+	}
+	/* Resolve the requests against the range map and COW allocation table
+	 * Sparse data runs are handled directly since they require no backing read
+	 */
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		offset       = offsets[ request_index ];
+		request_size = buffer_sizes[ request_index ];
+
+		if( (size64_t) offset >= internal_handle->size )
+		{
+			request_size = 0;
+		}
+		else if( (size64_t) request_size > ( internal_handle->size - offset ) )
+		{
+			request_size = (size_t) ( internal_handle->size - offset );
+		}
+		buffer_offset = 0;
+
+		while( buffer_offset < request_size )
+		{
+			if( libbfoverlay_internal_handle_get_data_run_at_offset(
+			     internal_handle,
+			     offset,
+			     request_size - buffer_offset,
+			     &range_index,
+			     &file_io_pool_entry,
+			     &file_offset,
+			     &read_size,
+			     &latency_path,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve data run at offset %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset,
+				 offset );
+
+				goto on_error;
+			}
+			if( latency_path == LIBBFOVERLAY_LATENCY_PATH_READ_SPARSE )
+			{
+				if( internal_handle->record_latency_histograms != 0 )
+				{
+					if( libbfoverlay_io_statistics_get_timestamp(
+					     &latency_start_timestamp,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+						 "%s: unable to retrieve latency start timestamp.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				if( libbfoverlay_internal_handle_read_data_run(
+				     internal_handle,
+				     file_io_pool_entry,
+				     file_offset,
+				     latency_path,
+				     &( ( buffers[ request_index ] )[ buffer_offset ] ),
+				     read_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read data run at offset %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 offset,
+					 offset );
+
+					goto on_error;
+				}
+				if( ( internal_handle->record_latency_histograms != 0 )
+				 && ( internal_handle->io_statistics != NULL ) )
+				{
+					if( libbfoverlay_io_statistics_add_latency(
+					     internal_handle->io_statistics,
+					     latency_path,
+					     latency_start_timestamp,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to update latency histogram.",
+						 function );
+
+						goto on_error;
+					}
+				}
+			}
+			else
+			{
+				if( number_of_segments >= maximum_number_of_segments )
+				{
+					if( maximum_number_of_segments == 0 )
+					{
+						maximum_number_of_segments = (size_t) number_of_requests;
+					}
+					else
+					{
+						maximum_number_of_segments *= 2;
+					}
+					if( maximum_number_of_segments > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libbfoverlay_batch_read_segment_t ) ) )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+						 "%s: invalid maximum number of segments value out of bounds.",
+						 function );
+
+						goto on_error;
+					}
+					reallocation = memory_reallocate(
+					                segments,
+					                sizeof( libbfoverlay_batch_read_segment_t ) * maximum_number_of_segments );
+
+					if( reallocation == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+						 "%s: unable to resize segments.",
+						 function );
+
+						goto on_error;
+					}
+					segments = (libbfoverlay_batch_read_segment_t *) reallocation;
+				}
+				batch_read_segment = &( segments[ number_of_segments++ ] );
+
+				batch_read_segment->file_io_pool_entry = file_io_pool_entry;
+				batch_read_segment->file_offset        = file_offset;
+				batch_read_segment->latency_path       = latency_path;
+				batch_read_segment->buffer             = &( ( buffers[ request_index ] )[ buffer_offset ] );
+				batch_read_segment->size               = read_size;
+			}
+			buffer_offset += read_size;
+			offset        += read_size;
+		}
+		read_counts[ request_index ] = (ssize_t) request_size;
+	}
+	if( number_of_segments == 0 )
+	{
+		return( 1 );
+	}
+	/* Sort the data runs by data file and file offset and read the adjacent data runs at once
+	 */
+	qsort(
+	 segments,
+	 number_of_segments,
+	 sizeof( libbfoverlay_batch_read_segment_t ),
+	 &libbfoverlay_internal_handle_compare_batch_read_segments );
+
+	segment_index = 0;
+
+	while( segment_index < number_of_segments )
+	{
+		batch_read_segment = &( segments[ segment_index ] );
+
+		file_io_pool_entry = batch_read_segment->file_io_pool_entry;
+		file_offset        = batch_read_segment->file_offset;
+		latency_path       = batch_read_segment->latency_path;
+		merged_end_offset  = file_offset + batch_read_segment->size;
+
+		for( segment_index_end = segment_index + 1;
+		     segment_index_end < number_of_segments;
+		     segment_index_end++ )
+		{
+			batch_read_segment = &( segments[ segment_index_end ] );
+
+			if( ( batch_read_segment->file_io_pool_entry != file_io_pool_entry )
+			 || ( batch_read_segment->latency_path != latency_path )
+			 || ( batch_read_segment->file_offset > merged_end_offset ) )
+			{
+				break;
+			}
+			segment_end_offset = batch_read_segment->file_offset + (off64_t) batch_read_segment->size;
+
+			if( segment_end_offset < merged_end_offset )
+			{
+				segment_end_offset = merged_end_offset;
+			}
+			/* The merged data runs must fit in the intermediate buffer
+			 */
+			if( ( segment_end_offset - file_offset ) > (off64_t) LIBBFOVERLAY_MAXIMUM_INTERMEDIATE_READ_SIZE )
+			{
+				break;
+			}
+			merged_end_offset = segment_end_offset;
+		}
+		if( internal_handle->record_latency_histograms != 0 )
+		{
+			if( libbfoverlay_io_statistics_get_timestamp(
+			     &latency_start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve latency start timestamp.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( segment_index_end == ( segment_index + 1 ) )
+		{
+			/* A data run that is not merged is read directly into its buffer
+			 */
+			batch_read_segment = &( segments[ segment_index ] );
+
+			if( libbfoverlay_internal_handle_read_data_run(
+			     internal_handle,
+			     file_io_pool_entry,
+			     file_offset,
+			     latency_path,
+			     batch_read_segment->buffer,
+			     batch_read_segment->size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read data run from file IO pool entry: %d at offset %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 file_io_pool_entry,
+				 file_offset,
+				 file_offset );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			read_size = (size_t) ( merged_end_offset - file_offset );
+
+			if( intermediate_buffer == NULL )
+			{
+				intermediate_buffer = (uint8_t *) memory_allocate(
+				                                   sizeof( uint8_t ) * LIBBFOVERLAY_MAXIMUM_INTERMEDIATE_READ_SIZE );
+
+				if( intermediate_buffer == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create intermediate buffer.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( libbfoverlay_internal_handle_read_data_run(
+			     internal_handle,
+			     file_io_pool_entry,
+			     file_offset,
+			     latency_path,
+			     intermediate_buffer,
+			     read_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read data run from file IO pool entry: %d at offset %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 file_io_pool_entry,
+				 file_offset,
+				 file_offset );
+
+				goto on_error;
+			}
+			while( segment_index < segment_index_end )
+			{
+				batch_read_segment = &( segments[ segment_index ] );
+
+				if( memory_copy(
+				     batch_read_segment->buffer,
+				     &( intermediate_buffer[ batch_read_segment->file_offset - file_offset ] ),
+				     batch_read_segment->size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy data of segment: %" PRIzd ".",
+					 function,
+					 segment_index );
+
+					goto on_error;
+				}
+				segment_index++;
+			}
+		}
+		if( ( internal_handle->record_latency_histograms != 0 )
+		 && ( internal_handle->io_statistics != NULL ) )
+		{
+			if( libbfoverlay_io_statistics_add_latency(
+			     internal_handle->io_statistics,
+			     latency_path,
+			     latency_start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update latency histogram.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		segment_index = segment_index_end;
+	}
+	if( intermediate_buffer != NULL )
+	{
+		memory_free(
+		 intermediate_buffer );
+	}
+	memory_free(
+	 segments );
+
+	return( 1 );
+
+on_error:
+	if( intermediate_buffer != NULL )
+	{
+		memory_free(
+		 intermediate_buffer );
+	}
+	if( segments != NULL )
+	{
+		memory_free(
+		 segments );
+	}
+	return( -1 );
+}
+
+/* Reads data from the current offset into a buffer
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libbfoverlay_internal_handle_read_buffer(
+         libbfoverlay_internal_handle_t *internal_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_internal_handle_read_buffer";
+	ssize_t read_count    = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libbfoverlay_internal_handle_read_buffer_at_offset(
+	              internal_handle,
+	              buffer,
+	              buffer_size,
+	              internal_handle->current_offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 internal_handle->current_offset,
+		 internal_handle->current_offset );
+
+		return( -1 );
+	}
+	internal_handle->current_offset += read_count;
+
+	return( read_count );
+}
+
+/* Reads data from the current offset into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libbfoverlay_handle_read_buffer(
+         libbfoverlay_handle_t *handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "libbfoverlay_handle_read_buffer";
+	ssize_t read_count                              = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	if( internal_handle->data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libbfoverlay_internal_handle_read_buffer(
+		      internal_handle,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads data at a specific offset
+ * The current offset is not changed, which allows multiple threads to read concurrently
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libbfoverlay_handle_read_buffer_at_offset(
+         libbfoverlay_handle_t *handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "libbfoverlay_handle_read_buffer_at_offset";
+	ssize_t read_count                              = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	if( internal_handle->data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libbfoverlay_internal_handle_read_buffer_at_offset(
+	              internal_handle,
+	              buffer,
+	              buffer_size,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads data at a specific offset into multiple buffers
+ * The buffers are filled in order as if they were a single buffer and the read lock
+ * is only acquired once
+ * The current offset is not changed, which allows multiple threads to read concurrently
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libbfoverlay_handle_read_vector_at_offset(
+         libbfoverlay_handle_t *handle,
+         uint8_t **buffers,
+         const size_t *buffer_sizes,
+         int number_of_buffers,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "libbfoverlay_handle_read_vector_at_offset";
+	ssize_t read_count                              = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	if( internal_handle->data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libbfoverlay_internal_handle_read_vector_at_offset(
+	              internal_handle,
+	              buffers,
+	              buffer_sizes,
+	              number_of_buffers,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read vector.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads data of multiple requests at specific offsets
+ * The requests are read with a single acquisition of the read lock and data that is
+ * stored adjacently in a data file is read at once
+ * The number of bytes read of each request are stored in read counts
+ * The current offset is not changed, which allows multiple threads to read concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_handle_read_batch(
+     libbfoverlay_handle_t *handle,
+     uint8_t **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     int number_of_requests,
+     ssize_t *read_counts,
+     libcerror_error_t **error )
+{
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "libbfoverlay_handle_read_batch";
+	int result                                      = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	if( internal_handle->data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libbfoverlay_internal_handle_read_batch(
+	          internal_handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          number_of_requests,
+	          read_counts,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read batch.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Writes data from buffer at the current offset
+ * A COW block that only contains zero bytes is marked as a zero block in the allocation table instead of being written
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libbfoverlay_internal_handle_write_buffer(
+         libbfoverlay_internal_handle_t *internal_handle,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	const uint8_t *cow_block_data    = NULL;
+	static char *function            = "libbfoverlay_internal_handle_write_buffer";
+	size_t block_index               = 0;
+	size_t buffer_offset             = 0;
+	size_t cow_block_offset          = 0;
+	size_t cow_data_size             = 0;
+	size_t maximum_number_of_blocks  = 0;
+	size_t write_size                = 0;
+	ssize_t read_count               = 0;
+	ssize_t write_count              = 0;
+	off64_t cow_block_end_offset     = 0;
+	off64_t cow_block_start_offset   = 0;
+	off64_t file_offset              = 0;
+	uint64_t latency_start_timestamp = 0;
+	uint64_t start_timestamp         = 0;
+	uint32_t number_of_blocks        = 0;
+	int latency_path                 = 0;
+	int result                       = 0;
+	int zero_block_result            = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < buffer_size )
+	{
+		if( internal_handle->record_latency_histograms != 0 )
+		{
+			if( libbfoverlay_io_statistics_get_timestamp(
+			     &latency_start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve latency start timestamp.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		result = libbfoverlay_cow_file_get_block_at_offset(
+		          internal_handle->cow_file,
+		          internal_handle->data_file_io_pool,
+		          internal_handle->cow_file_io_pool_entry,
+		          internal_handle->current_offset,
+		          &cow_block_start_offset,
+		          &cow_block_end_offset,
+		          &file_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve COW block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 internal_handle->current_offset,
+			 internal_handle->current_offset );
+
+			return( -1 );
+		}
+		else if( ( result == 0 )
+		      || ( file_offset < 0 ) )
+		{
+			latency_path = LIBBFOVERLAY_LATENCY_PATH_WRITE_COW_ALLOCATE;
+
+			/* The range without COW blocks can span multiple blocks
+			 */
+			cow_block_start_offset = internal_handle->current_offset - ( internal_handle->current_offset % internal_handle->cow_file->block_size );
+			cow_block_end_offset   = cow_block_start_offset + internal_handle->cow_file->block_size;
+
+			/* A COW block that only contains zero bytes has no data block
+			 */
+			result = 0;
+		}
+		else
+		{
+			latency_path = LIBBFOVERLAY_LATENCY_PATH_WRITE_COW_HIT;
+		}
+		cow_block_offset = (size_t) ( internal_handle->current_offset - cow_block_start_offset );
+
+		write_size = buffer_size - buffer_offset;
+
+		if( (int64_t) write_size > ( cow_block_end_offset - internal_handle->current_offset ) )
+		{
+			write_size = (size_t) ( cow_block_end_offset - internal_handle->current_offset );
+		}
+		if( write_size == (size_t) internal_handle->cow_file->block_size )
+		{
+			zero_block_result = libbfoverlay_cow_file_check_for_zero_block(
+			                     &( buffer[ buffer_offset ] ),
+			                     internal_handle->cow_file->block_size,
+			                     error );
+
+			if( zero_block_result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if buffer contains zero block.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			if( internal_handle->record_statistics != 0 )
+			{
+				if( libbfoverlay_io_statistics_add_count(
+				     internal_handle->io_statistics,
+				     LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_READ_MODIFY_WRITE_READS,
+				     1,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to update IO statistics.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			read_count = libbfoverlay_internal_handle_read_buffer_at_offset(
+			              internal_handle,
+			              internal_handle->cow_block_data,
+			              internal_handle->cow_file->block_size,
+			              cow_block_start_offset,
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read COW block data.",
+				 function );
+
+				return( -1 );
+			}
+			if( read_count < (ssize_t) internal_handle->cow_file->block_size )
+			{
+				if( memory_set(
+				     &( ( internal_handle->cow_block_data )[ read_count ] ),
+				     0,
+				     internal_handle->cow_file->block_size - read_count ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear read COW block data.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			if( memory_copy(
+			     &( ( internal_handle->cow_block_data )[ cow_block_offset ] ),
+			     &( buffer[ buffer_offset ] ),
+			     write_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy buffer to COW block data.",
+				 function );
+
+				return( -1 );
+			}
+			zero_block_result = libbfoverlay_cow_file_check_for_zero_block(
+			                     internal_handle->cow_block_data,
+			                     internal_handle->cow_file->block_size,
+			                     error );
+
+			if( zero_block_result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if COW block data contains zero block.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( zero_block_result != 0 )
+		{
+			/* A COW block that only contains zero bytes is not stored in the COW file
+			 */
+			if( libbfoverlay_cow_file_set_zero_blocks_for_offset(
+			     internal_handle->cow_file,
+			     internal_handle->data_file_io_pool,
+			     internal_handle->cow_file_io_pool_entry,
+			     cow_block_start_offset,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set zero block in COW file for offset %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 cow_block_start_offset,
+				 cow_block_start_offset );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			if( write_size == (size_t) internal_handle->cow_file->block_size )
+			{
+				/* The buffer covers one or more entire COW blocks, hence the existing data
+				 * does not need to be read and the buffer can be written directly
+				 */
+				maximum_number_of_blocks = ( buffer_size - buffer_offset ) / internal_handle->cow_file->block_size;
+
+				if( maximum_number_of_blocks > (size_t) UINT32_MAX )
+				{
+					maximum_number_of_blocks = (size_t) UINT32_MAX;
+				}
+				/* Stop before the first COW block that only contains zero bytes
+				 */
+				for( block_index = 1;
+				     block_index < maximum_number_of_blocks;
+				     block_index++ )
+				{
+					zero_block_result = libbfoverlay_cow_file_check_for_zero_block(
+					                     &( buffer[ buffer_offset + ( block_index * internal_handle->cow_file->block_size ) ] ),
+					                     internal_handle->cow_file->block_size,
+					                     error );
+
+					if( zero_block_result == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+						 "%s: unable to determine if buffer contains zero block.",
+						 function );
+
+						return( -1 );
+					}
+					else if( zero_block_result != 0 )
+					{
+						break;
+					}
+				}
+				maximum_number_of_blocks = block_index;
+
+				if( result == 0 )
+				{
+					result = libbfoverlay_cow_file_allocate_blocks_for_offset(
+					          internal_handle->cow_file,
+					          internal_handle->data_file_io_pool,
+					          internal_handle->cow_file_io_pool_entry,
+					          internal_handle->current_offset,
+					          (uint32_t) maximum_number_of_blocks,
+					          &file_offset,
+					          &number_of_blocks,
+					          error );
+				}
+				else
+				{
+					result = libbfoverlay_cow_file_get_contiguous_blocks_at_offset(
+					          internal_handle->cow_file,
+					          internal_handle->data_file_io_pool,
+					          internal_handle->cow_file_io_pool_entry,
+					          internal_handle->current_offset,
+					          (uint32_t) maximum_number_of_blocks,
+					          &file_offset,
+					          &number_of_blocks,
+					          error );
+				}
+				if( result != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve blocks in COW file for offset %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 internal_handle->current_offset,
+					 internal_handle->current_offset );
+
+					return( -1 );
+				}
+				cow_block_data = &( buffer[ buffer_offset ] );
+				write_size     = (size_t) number_of_blocks * internal_handle->cow_file->block_size;
+				cow_data_size  = write_size;
+			}
+			else
+			{
+				if( result == 0 )
+				{
+					if( libbfoverlay_cow_file_allocate_block_for_offset(
+					     internal_handle->cow_file,
+					     internal_handle->data_file_io_pool,
+					     internal_handle->cow_file_io_pool_entry,
+					     internal_handle->current_offset,
+					     &file_offset,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to allocate block in COW file for offset %" PRIi64 " (0x%08" PRIx64 ").",
+						 function,
+						 internal_handle->current_offset,
+						 internal_handle->current_offset );
+
+						return( -1 );
+					}
+				}
+				cow_block_data = internal_handle->cow_block_data;
+				cow_data_size  = internal_handle->cow_file->block_size;
+			}
+			if( internal_handle->record_statistics != 0 )
+			{
+				if( libbfoverlay_io_statistics_get_timestamp(
+				     &start_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve start timestamp.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			write_count = libbfio_pool_write_buffer_at_offset(
+			               internal_handle->data_file_io_pool,
+			               internal_handle->cow_file_io_pool_entry,
+			               cow_block_data,
+			               cow_data_size,
+			               file_offset,
+			               error );
+
+			if( write_count != (ssize_t) cow_data_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write COW data of size: %" PRIzd " to COW file at offset %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 cow_data_size,
+				 file_offset,
+				 file_offset );
+
+				return( -1 );
+			}
+			if( internal_handle->record_statistics != 0 )
+			{
+				if( libbfoverlay_io_statistics_add_io(
+				     internal_handle->io_statistics,
+				     LIBBFOVERLAY_IO_TYPE_COW_WRITE,
+				     0,
+				     cow_data_size,
+				     start_timestamp,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to update IO statistics.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		if( ( internal_handle->record_latency_histograms != 0 )
+		 && ( internal_handle->io_statistics != NULL ) )
+		{
+			if( libbfoverlay_io_statistics_add_latency(
+			     internal_handle->io_statistics,
+			     latency_path,
+			     latency_start_timestamp,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update latency histogram.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		buffer_offset                   += write_size;
+		internal_handle->current_offset += write_size;
+	}
+	if( (size64_t) internal_handle->current_offset > internal_handle->size )
+	{
+		if( libbfoverlay_cow_file_set_data_size(
+		     internal_handle->cow_file,
+		     internal_handle->data_file_io_pool,
+		     internal_handle->cow_file_io_pool_entry,
+		     (size64_t) internal_handle->current_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set data size in COW file.",
+			 function );
+
+			return( -1 );
+		}
+		internal_handle->size = (size64_t) internal_handle->current_offset;
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes data from buffer at the current offset
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libbfoverlay_handle_write_buffer(
+         libbfoverlay_handle_t *handle,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "libbfoverlay_handle_write_buffer";
+	ssize_t write_count                             = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	if( internal_handle->data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	write_count = libbfoverlay_internal_handle_write_buffer(
+	               internal_handle,
+	               buffer,
+	               buffer_size,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		write_count = -1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Writes data at a specific offset
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libbfoverlay_handle_write_buffer_at_offset(
+         libbfoverlay_handle_t *handle,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "libbfoverlay_handle_write_buffer_at_offset";
+	ssize_t write_count                             = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	if( internal_handle->data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing COW file.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libbfoverlay_internal_handle_seek_offset(
+	     internal_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		write_count = -1;
+	}
+	else
+	{
+		write_count = libbfoverlay_internal_handle_write_buffer(
+			       internal_handle,
+			       buffer,
+			       buffer_size,
+			       error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to write buffer.",
+			 function );
+
+			write_count = -1;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Flushes the handle
+ * Changes to the COW allocation table that have not been written are written
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_handle_flush(
+     libbfoverlay_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "libbfoverlay_handle_flush";
+	int result                                      = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->cow_file != NULL )
+	{
+		if( libbfoverlay_cow_file_flush(
+		     internal_handle->cow_file,
+		     internal_handle->data_file_io_pool,
+		     internal_handle->cow_file_io_pool_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush COW file.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the offset of the next data or hole at or after a specific offset
+ * A hole is a part of the data that is sparse and not stored in the COW file,
+ * where the end of the data is considered an implicit hole
+ * This function can be called by multiple threads concurrently, acquire at least a read lock before call
+ * Returns 1 if successful, 0 if no such offset was found or -1 on error
+ */
+int libbfoverlay_internal_handle_get_data_or_hole_offset(
+     libbfoverlay_internal_handle_t *internal_handle,
+     off64_t offset,
+     uint8_t find_hole,
+     off64_t *data_or_hole_offset,
+     libcerror_error_t **error )
+{
+	static char *function  = "libbfoverlay_internal_handle_get_data_or_hole_offset";
+	size_t data_run_size   = 0;
+	size_t maximum_size    = 0;
+	off64_t file_offset    = 0;
+	int file_io_pool_entry = 0;
+	int latency_path       = 0;
+	int range_index        = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_or_hole_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data or hole offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_handle->size )
+	{
+		return( 0 );
+	}
+	while( (size64_t) offset < internal_handle->size )
+	{
+		maximum_size = (size_t) SSIZE_MAX;
+
+		if( (size64_t) maximum_size > ( internal_handle->size - offset ) )
+		{
+			maximum_size = (size_t) ( internal_handle->size - offset );
+		}
+		if( libbfoverlay_internal_handle_get_data_run_at_offset(
+		     internal_handle,
+		     offset,
+		     maximum_size,
+		     &range_index,
+		     &file_io_pool_entry,
+		     &file_offset,
+		     &data_run_size,
+		     &latency_path,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data run at offset %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		if( data_run_size == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid data run size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( latency_path == LIBBFOVERLAY_LATENCY_PATH_READ_SPARSE ) == ( find_hole != 0 ) )
+		{
+			*data_or_hole_offset = offset;
+
+			return( 1 );
+		}
+		offset += (off64_t) data_run_size;
+	}
+	if( find_hole == 0 )
+	{
+		return( 0 );
+	}
+	*data_or_hole_offset = (off64_t) internal_handle->size;
+
+	return( 1 );
+}
+
+/* Seeks a certain offset of the data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libbfoverlay_internal_handle_seek_offset(
+         libbfoverlay_internal_handle_t *internal_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_internal_handle_seek_offset";
+	int result            = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( SEEK_DATA )
+	if( whence == SEEK_DATA )
+	{
+		whence = LIBBFOVERLAY_SEEK_DATA;
+	}
+#endif
+#if defined( SEEK_HOLE )
+	if( whence == SEEK_HOLE )
+	{
+		whence = LIBBFOVERLAY_SEEK_HOLE;
+	}
+#endif
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET )
+	 && ( whence != LIBBFOVERLAY_SEEK_DATA )
+	 && ( whence != LIBBFOVERLAY_SEEK_HOLE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += internal_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) internal_handle->size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence == LIBBFOVERLAY_SEEK_DATA )
+	 || ( whence == LIBBFOVERLAY_SEEK_HOLE ) )
+	{
+		result = libbfoverlay_internal_handle_get_data_or_hole_offset(
+		          internal_handle,
+		          offset,
+		          (uint8_t) ( whence == LIBBFOVERLAY_SEEK_HOLE ),
+		          &offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data or hole offset.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: no data at or after offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+	}
+	internal_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset
+ * Whence is SEEK_SET, SEEK_CUR, SEEK_END, LIBBFOVERLAY_SEEK_DATA or LIBBFOVERLAY_SEEK_HOLE
+ * SEEK_DATA and SEEK_HOLE of the system are supported when available
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libbfoverlay_handle_seek_offset(
+         libbfoverlay_handle_t *handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "libbfoverlay_handle_seek_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	if( internal_handle->data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libbfoverlay_internal_handle_seek_offset(
+	          internal_handle,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		offset = -1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Resizes the data of the handle
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_handle_resize(
+     libbfoverlay_handle_t *handle,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "libbfoverlay_handle_resize";
+	int result                                      = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	if( internal_handle->data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing COW file.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libbfoverlay_cow_file_set_data_size(
+	     internal_handle->cow_file,
+	     internal_handle->data_file_io_pool,
+	     internal_handle->cow_file_io_pool_entry,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set data size in COW file.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_handle->size = size;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Discards the data within a specific range of the handle
+ * The COW data blocks that are fully contained in the range are released for reuse
+ * and the range reverts to the data of the underlying layers
+ * Data blocks that are only partially contained in the range are left unchanged
+ * Without a COW layer there is no data to discard
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_handle_discard(
+     libbfoverlay_handle_t *handle,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "libbfoverlay_handle_discard";
+	uint32_t number_of_discarded_blocks             = 0;
+	int result                                      = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	if( internal_handle->data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->cow_file != NULL )
+	{
+		if( libbfoverlay_cow_file_discard_blocks(
+		     internal_handle->cow_file,
+		     internal_handle->data_file_io_pool,
+		     internal_handle->cow_file_io_pool_entry,
+		     offset,
+		     size,
+		     &number_of_discarded_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to discard blocks in COW file.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Writes zero bytes within a specific range of the handle
+ * The COW blocks that are fully contained in the range are marked as zero blocks
+ * in the allocation table without writing data, the COW blocks that are only
+ * partially contained in the range are written with zero bytes
+ * The current offset is not changed
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_internal_handle_write_zeroes(
+     libbfoverlay_internal_handle_t *internal_handle,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	uint8_t *zero_block_data         = NULL;
+	static char *function            = "libbfoverlay_internal_handle_write_zeroes";
+	size_t write_size                = 0;
+	ssize_t write_count              = 0;
+	off64_t current_offset           = 0;
+	off64_t end_offset               = 0;
+	off64_t leading_end_offset       = 0;
+	off64_t trailing_start_offset    = 0;
+	off64_t zero_blocks_end_offset   = 0;
+	off64_t zero_blocks_start_offset = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->cow_file->block_size == 0 )
+	 || ( internal_handle->cow_file->block_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid COW file - block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size64_t) ( INT64_MAX - offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == 0 )
+	{
+		return( 1 );
+	}
+	end_offset = offset + (off64_t) size;
+
+	zero_blocks_start_offset = offset;
+
+	if( ( zero_blocks_start_offset % internal_handle->cow_file->block_size ) != 0 )
+	{
+		zero_blocks_start_offset += internal_handle->cow_file->block_size - ( zero_blocks_start_offset % internal_handle->cow_file->block_size );
+	}
+	zero_blocks_end_offset = end_offset - ( end_offset % internal_handle->cow_file->block_size );
+
+	leading_end_offset = zero_blocks_start_offset;
+
+	if( leading_end_offset > end_offset )
+	{
+		leading_end_offset = end_offset;
+	}
+	trailing_start_offset = zero_blocks_end_offset;
+
+	if( trailing_start_offset < leading_end_offset )
+	{
+		trailing_start_offset = leading_end_offset;
+	}
+	/* The partial COW blocks are at most 1 block size minus 1 byte in size
+	 */
+	zero_block_data = (uint8_t *) memory_allocate(
+	                               internal_handle->cow_file->block_size );
+
+	if( zero_block_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create zero block data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     zero_block_data,
+	     0,
+	     internal_handle->cow_file->block_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear zero block data.",
+		 function );
+
+		goto on_error;
+	}
+	current_offset = internal_handle->current_offset;
+
+	if( offset < leading_end_offset )
+	{
+		internal_handle->current_offset = offset;
+
+		write_size = (size_t) ( leading_end_offset - offset );
+
+		write_count = libbfoverlay_internal_handle_write_buffer(
+		               internal_handle,
+		               zero_block_data,
+		               write_size,
+		               error );
+
+		if( write_count != (ssize_t) write_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write zero bytes at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			goto on_error;
+		}
+	}
+	if( zero_blocks_start_offset < zero_blocks_end_offset )
+	{
+		if( libbfoverlay_cow_file_set_zero_blocks_for_offset(
+		     internal_handle->cow_file,
+		     internal_handle->data_file_io_pool,
+		     internal_handle->cow_file_io_pool_entry,
+		     zero_blocks_start_offset,
+		     (uint64_t) ( ( zero_blocks_end_offset - zero_blocks_start_offset ) / internal_handle->cow_file->block_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set zero blocks in COW file for offset %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 zero_blocks_start_offset,
+			 zero_blocks_start_offset );
+
+			goto on_error;
+		}
+	}
+	if( trailing_start_offset < end_offset )
+	{
+		internal_handle->current_offset = trailing_start_offset;
+
+		write_size = (size_t) ( end_offset - trailing_start_offset );
+
+		write_count = libbfoverlay_internal_handle_write_buffer(
+		               internal_handle,
+		               zero_block_data,
+		               write_size,
+		               error );
+
+		if( write_count != (ssize_t) write_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write zero bytes at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 trailing_start_offset,
+			 trailing_start_offset );
+
+			goto on_error;
+		}
+	}
+	if( (size64_t) end_offset > internal_handle->size )
+	{
+		if( libbfoverlay_cow_file_set_data_size(
+		     internal_handle->cow_file,
+		     internal_handle->data_file_io_pool,
+		     internal_handle->cow_file_io_pool_entry,
+		     (size64_t) end_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set data size in COW file.",
+			 function );
+
+			goto on_error;
+		}
+		internal_handle->size = (size64_t) end_offset;
+	}
+	internal_handle->current_offset = current_offset;
+
+	memory_free(
+	 zero_block_data );
+
+	return( 1 );
+
+on_error:
+	internal_handle->current_offset = current_offset;
+
+	memory_free(
+	 zero_block_data );
+
+	return( -1 );
+}
+
+/* Writes zero bytes within a specific range of the handle
+ * The COW blocks that are fully contained in the range are marked as zero blocks
+ * in the allocation table without writing data
+ * The current offset is not changed
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_handle_write_zeroes(
+     libbfoverlay_handle_t *handle,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "libbfoverlay_handle_write_zeroes";
+	int result                                      = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	if( internal_handle->data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libbfoverlay_internal_handle_write_zeroes(
+	     internal_handle,
+	     offset,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write zeroes.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Writes a compacted copy of the COW file
+ * The data blocks are written in logical order, blocks that are no longer referenced
+ * by the allocation table are not copied and only the allocation table blocks that
+ * are needed are created
+ * The compacted COW file must be empty, which prevents overwriting the COW file itself
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_internal_handle_write_compacted_cow_file(
+     libbfoverlay_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	libbfoverlay_cow_file_t *compacted_cow_file = NULL;
+	uint8_t *block_data                         = NULL;
+	static char *function                       = "libbfoverlay_internal_handle_write_compacted_cow_file";
+	size_t block_data_size                      = 0;
+	size_t read_size                            = 0;
+	size_t write_size                           = 0;
+	ssize_t read_count                          = 0;
+	ssize_t write_count                         = 0;
+	off64_t compacted_file_offset               = 0;
+	off64_t file_offset                         = 0;
+	off64_t offset                              = 0;
+	off64_t range_end_offset                    = 0;
+	off64_t range_start_offset                  = 0;
+	size64_t file_size                          = 0;
+	uint32_t block_index                        = 0;
+	uint32_t maximum_number_of_blocks           = 0;
+	uint32_t number_of_blocks                   = 0;
+	uint32_t number_of_compacted_blocks         = 0;
+	int result                                  = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->cow_file->block_size == 0 )
+	 || ( internal_handle->cow_file->block_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid COW file - block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_get_size(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve compacted COW file size.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_size != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid compacted COW file - file is not empty.",
+		 function );
+
+		return( -1 );
+	}
+	/* The data blocks are copied in runs of up to the maximum intermediate read size
+	 */
+	maximum_number_of_blocks = (uint32_t) ( LIBBFOVERLAY_MAXIMUM_INTERMEDIATE_READ_SIZE / internal_handle->cow_file->block_size );
+
+	if( maximum_number_of_blocks == 0 )
+	{
+		maximum_number_of_blocks = 1;
+	}
+	block_data_size = (size_t) maximum_number_of_blocks * internal_handle->cow_file->block_size;
+
+	block_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * block_data_size );
+
+	if( block_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_cow_file_initialize(
+	     &compacted_cow_file,
+	     internal_handle->cow_file->data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create compacted COW file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_cow_file_set_block_size(
+	     compacted_cow_file,
+	     internal_handle->cow_file->block_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set compacted COW file block size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_cow_file_set_maximum_dirty_size(
+	     compacted_cow_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     internal_handle->maximum_dirty_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set compacted COW file maximum dirty size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_cow_file_open(
+	     compacted_cow_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open compacted COW file.",
+		 function );
+
+		goto on_error;
+	}
+	while( (size64_t) offset < internal_handle->cow_file->data_size )
+	{
+		if( internal_handle->abort != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+			 "%s: abort requested.",
+			 function );
+
+			goto on_error;
+		}
+		result = libbfoverlay_cow_file_get_block_at_offset(
+		          internal_handle->cow_file,
+		          internal_handle->data_file_io_pool,
+		          internal_handle->cow_file_io_pool_entry,
+		          offset,
+		          &range_start_offset,
+		          &range_end_offset,
+		          &file_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve COW block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			goto on_error;
+		}
+		if( range_end_offset <= offset )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid range end offset value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		if( result == 0 )
+		{
+			/* The range without COW blocks can span multiple blocks
+			 */
+			offset = range_end_offset;
+
+			continue;
+		}
+		if( file_offset < 0 )
+		{
+			if( libbfoverlay_cow_file_set_zero_blocks_for_offset(
+			     compacted_cow_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     offset,
+			     1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set zero block in compacted COW file for offset %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset,
+				 offset );
+
+				goto on_error;
+			}
+			offset = range_end_offset;
+
+			continue;
+		}
+		if( libbfoverlay_cow_file_get_contiguous_blocks_at_offset(
+		     internal_handle->cow_file,
+		     internal_handle->data_file_io_pool,
+		     internal_handle->cow_file_io_pool_entry,
+		     offset,
+		     maximum_number_of_blocks,
+		     &file_offset,
+		     &number_of_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve contiguous COW blocks at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			goto on_error;
+		}
+		read_size = (size_t) number_of_blocks * internal_handle->cow_file->block_size;
+
+		read_count = libbfio_pool_read_buffer_at_offset(
+		              internal_handle->data_file_io_pool,
+		              internal_handle->cow_file_io_pool_entry,
+		              block_data,
+		              read_size,
+		              file_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read COW data of size: %" PRIzd " from COW file at offset %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_size,
+			 file_offset,
+			 file_offset );
+
+			goto on_error;
+		}
+		/* The compacted COW file has no data blocks yet, hence the allocated
+		 * data blocks are appended and only end at allocation table blocks
+		 */
+		block_index = 0;
+
+		while( block_index < number_of_blocks )
+		{
+			if( libbfoverlay_cow_file_allocate_blocks_for_offset(
+			     compacted_cow_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     offset,
+			     number_of_blocks - block_index,
+			     &compacted_file_offset,
+			     &number_of_compacted_blocks,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to allocate blocks in compacted COW file for offset %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset,
+				 offset );
+
+				goto on_error;
+			}
+			if( ( number_of_compacted_blocks == 0 )
+			 || ( number_of_compacted_blocks > ( number_of_blocks - block_index ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid number of compacted blocks value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			write_size = (size_t) number_of_compacted_blocks * internal_handle->cow_file->block_size;
+
+			write_count = libbfio_pool_write_buffer_at_offset(
+			               file_io_pool,
+			               file_io_pool_entry,
+			               &( block_data[ (size_t) block_index * internal_handle->cow_file->block_size ] ),
+			               write_size,
+			               compacted_file_offset,
+			               error );
+
+			if( write_count != (ssize_t) write_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write COW data of size: %" PRIzd " to compacted COW file at offset %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 write_size,
+				 compacted_file_offset,
+				 compacted_file_offset );
+
+				goto on_error;
+			}
+			block_index += number_of_compacted_blocks;
+			offset      += (off64_t) write_size;
+		}
+	}
+	if( libbfoverlay_cow_file_flush(
+	     compacted_cow_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush compacted COW file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_cow_file_close(
+	     compacted_cow_file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close compacted COW file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_cow_file_free(
+	     &compacted_cow_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free compacted COW file.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 block_data );
+
+	return( 1 );
+
+on_error:
+	if( compacted_cow_file != NULL )
+	{
+		libbfoverlay_cow_file_free(
+		 &compacted_cow_file,
+		 NULL );
+	}
+	if( block_data != NULL )
+	{
+		memory_free(
+		 block_data );
+	}
+	return( -1 );
+}
+
+/* Writes a compacted copy of the COW file to a file
+ * The file must not exist or be empty
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_handle_write_compacted_cow_file(
+     libbfoverlay_handle_t *handle,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libbfio_pool_t *file_io_pool                    = NULL;
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "libbfoverlay_handle_write_compacted_cow_file";
+	int result                                      = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	if( internal_handle->data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_initialize(
+	     &file_io_pool,
+	     1,
+	     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_pool_open(
+	     file_io_pool,
+	     0,
+	     filename,
+	     LIBBFIO_OPEN_READ_WRITE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open compacted COW file: %s.",
+		 function,
+		 filename );
+
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	if( libbfoverlay_internal_handle_write_compacted_cow_file(
+	     internal_handle,
+	     file_io_pool,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write compacted COW file.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	if( libbfio_pool_close_all(
+	     file_io_pool,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close compacted COW file.",
+		 function );
+
+		result = -1;
+	}
+	if( libbfio_pool_free(
+	     &file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO pool.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Writes a compacted copy of the COW file to a file
+ * The file must not exist or be empty
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_handle_write_compacted_cow_file_wide(
+     libbfoverlay_handle_t *handle,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	libbfio_pool_t *file_io_pool                    = NULL;
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "libbfoverlay_handle_write_compacted_cow_file_wide";
+	int result                                      = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	if( internal_handle->data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_initialize(
+	     &file_io_pool,
+	     1,
+	     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_pool_open_wide(
+	     file_io_pool,
+	     0,
+	     filename,
+	     LIBBFIO_OPEN_READ_WRITE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open compacted COW file: %ls.",
+		 function,
+		 filename );
+
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	if( libbfoverlay_internal_handle_write_compacted_cow_file(
+	     internal_handle,
+	     file_io_pool,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write compacted COW file.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	if( libbfio_pool_close_all(
+	     file_io_pool,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close compacted COW file.",
+		 function );
+
+		result = -1;
+	}
+	if( libbfio_pool_free(
+	     &file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO pool.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Retrieves the current offset
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_handle_get_offset(
+     libbfoverlay_handle_t *handle,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "libbfoverlay_handle_get_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	if( internal_handle->data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*offset = internal_handle->current_offset;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Returns the size of the data of the handle
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_handle_get_size(
+     libbfoverlay_handle_t *handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "libbfoverlay_handle_get_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	if( internal_handle->data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*size = internal_handle->size;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the extents of a range of the data of the handle
+ * An extent is a contiguous part of the range that is sparse, stored in a COW file
+ * block run or stored contiguously in the data file of a specific layer
+ * The extent flags contain LIBBFOVERLAY_EXTENT_FLAGS, the layer index is -1 for
+ * sparse and COW extents and the data offset is the offset of the extent in the
+ * data file of the layer or in the COW file
+ * This function can be called by multiple threads concurrently, acquire at least a read lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_internal_handle_get_extents(
+     libbfoverlay_internal_handle_t *internal_handle,
+     off64_t offset,
+     size64_t size,
+     off64_t *extent_offsets,
+     size64_t *extent_sizes,
+     uint32_t *extent_flags,
+     int *extent_layer_indexes,
+     off64_t *extent_data_offsets,
+     int maximum_number_of_extents,
+     int *number_of_extents,
+     libcerror_error_t **error )
+{
+	static char *function  = "libbfoverlay_internal_handle_get_extents";
+	size_t data_run_size   = 0;
+	size_t maximum_size    = 0;
+	off64_t data_offset    = 0;
+	off64_t end_offset     = 0;
+	uint32_t flags         = 0;
+	int extent_index       = -1;
+	int file_io_pool_entry = 0;
+	int latency_path       = 0;
+	int layer_index        = 0;
+	int range_index        = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent sizes.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_layer_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent layer indexes.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_data_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent data offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_extents < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of extents value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extents == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of extents.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_extents = 0;
+
+	if( (size64_t) offset >= internal_handle->size )
+	{
+		return( 1 );
+	}
+	if( size > ( internal_handle->size - offset ) )
+	{
+		size = internal_handle->size - offset;
+	}
+	end_offset = offset + (off64_t) size;
+
+	while( offset < end_offset )
+	{
+		maximum_size = (size_t) SSIZE_MAX;
+
+		if( (size64_t) maximum_size > (size64_t) ( end_offset - offset ) )
+		{
+			maximum_size = (size_t) ( end_offset - offset );
+		}
+		if( libbfoverlay_internal_handle_get_data_run_at_offset(
+		     internal_handle,
+		     offset,
+		     maximum_size,
+		     &range_index,
+		     &file_io_pool_entry,
+		     &data_offset,
+		     &data_run_size,
+		     &latency_path,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data run at offset %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
 
-					return( -1 );
-				}
-			}
+			return( -1 );
 		}
-		buffer_offset += read_size;
-
-		internal_handle->current_offset += read_size;
+		if( data_run_size == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid data run size value out of bounds.",
+			 function );
 
-		if( buffer_offset >= buffer_size )
+			return( -1 );
+		}
+		if( latency_path == LIBBFOVERLAY_LATENCY_PATH_READ_SPARSE )
+		{
+			flags       = LIBBFOVERLAY_EXTENT_FLAG_IS_SPARSE;
+			layer_index = -1;
+		}
+		else if( latency_path == LIBBFOVERLAY_LATENCY_PATH_READ_COW )
+		{
+			flags       = LIBBFOVERLAY_EXTENT_FLAG_IS_COW;
+			layer_index = -1;
+		}
+		else
+		{
+			flags       = 0;
+			layer_index = file_io_pool_entry;
+		}
+		/* Consecutive data runs are combined into a single extent if they are
+		 * sparse or stored contiguously in the same data file
+		 */
+		if( ( extent_index >= 0 )
+		 && ( extent_flags[ extent_index ] == flags )
+		 && ( extent_layer_indexes[ extent_index ] == layer_index )
+		 && ( ( flags == LIBBFOVERLAY_EXTENT_FLAG_IS_SPARSE )
+		  ||  ( ( extent_data_offsets[ extent_index ] + (off64_t) extent_sizes[ extent_index ] ) == data_offset ) ) )
+		{
+			extent_sizes[ extent_index ] += data_run_size;
+		}
+		else
 		{
-			break;
+			if( ( extent_index + 1 ) >= maximum_number_of_extents )
+			{
+				break;
+			}
+			extent_index++;
+
+			extent_offsets[ extent_index ]       = offset;
+			extent_sizes[ extent_index ]         = (size64_t) data_run_size;
+			extent_flags[ extent_index ]         = flags;
+			extent_layer_indexes[ extent_index ] = layer_index;
+			extent_data_offsets[ extent_index ]  = data_offset;
 		}
+		offset += (off64_t) data_run_size;
 	}
-	return( (ssize_t) buffer_offset );
+	*number_of_extents = extent_index + 1;
+
+	return( 1 );
 }
 
-/* Reads data from the current offset into a buffer
- * Returns the number of bytes read or -1 on error
+/* Retrieves the extents of a range of the data of the handle
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libbfoverlay_handle_read_buffer(
-         libbfoverlay_handle_t *handle,
-         uint8_t *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libbfoverlay_handle_get_extents(
+     libbfoverlay_handle_t *handle,
+     off64_t offset,
+     size64_t size,
+     off64_t *extent_offsets,
+     size64_t *extent_sizes,
+     uint32_t *extent_flags,
+     int *extent_layer_indexes,
+     off64_t *extent_data_offsets,
+     int maximum_number_of_extents,
+     int *number_of_extents,
+     libcerror_error_t **error )
 {
 	libbfoverlay_internal_handle_t *internal_handle = NULL;
-	static char *function                           = "libbfoverlay_handle_read_buffer";
-	ssize_t read_count                              = 0;
+	static char *function                           = "libbfoverlay_handle_get_extents";
+	int result                                      = 0;
 
 	if( handle == NULL )
 	{
@@ -2455,7 +7160,7 @@ ssize_t libbfoverlay_handle_read_buffer(
 		return( -1 );
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2463,31 +7168,38 @@ ssize_t libbfoverlay_handle_read_buffer(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	read_count = libbfoverlay_internal_handle_read_buffer(
-		      internal_handle,
-		      buffer,
-		      buffer_size,
-		      error );
+	result = libbfoverlay_internal_handle_get_extents(
+	          internal_handle,
+	          offset,
+	          size,
+	          extent_offsets,
+	          extent_sizes,
+	          extent_flags,
+	          extent_layer_indexes,
+	          extent_data_offsets,
+	          maximum_number_of_extents,
+	          number_of_extents,
+	          error );
 
-	if( read_count == -1 )
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extents.",
 		 function );
 
-		read_count = -1;
+		result = -1;
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2495,28 +7207,25 @@ ssize_t libbfoverlay_handle_read_buffer(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( result );
 }
 
-/* Reads data at a specific offset
- * Returns the number of bytes read or -1 on error
+/* Retrieves the maximum COW allocation table cache size
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libbfoverlay_handle_read_buffer_at_offset(
-         libbfoverlay_handle_t *handle,
-         uint8_t *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libbfoverlay_handle_get_maximum_cache_size(
+     libbfoverlay_handle_t *handle,
+     size_t *maximum_cache_size,
+     libcerror_error_t **error )
 {
 	libbfoverlay_internal_handle_t *internal_handle = NULL;
-	static char *function                           = "libbfoverlay_handle_read_buffer_at_offset";
-	ssize_t read_count                              = 0;
+	static char *function                           = "libbfoverlay_handle_get_maximum_cache_size";
 
 	if( handle == NULL )
 	{
@@ -2531,19 +7240,19 @@ ssize_t libbfoverlay_handle_read_buffer_at_offset(
 	}
 	internal_handle = (libbfoverlay_internal_handle_t *) handle;
 
-	if( internal_handle->data_file_io_pool == NULL )
+	if( maximum_cache_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing data file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum cache size.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2551,49 +7260,16 @@ ssize_t libbfoverlay_handle_read_buffer_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( libbfoverlay_internal_handle_seek_offset(
-	     internal_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
-
-		read_count = -1;
-	}
-	else
-	{
-		read_count = libbfoverlay_internal_handle_read_buffer(
-			      internal_handle,
-			      buffer,
-			      buffer_size,
-			      error );
-
-		if( read_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read buffer.",
-			 function );
+	*maximum_cache_size = internal_handle->maximum_cache_size;
 
-			read_count = -1;
-		}
-	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2601,265 +7277,134 @@ ssize_t libbfoverlay_handle_read_buffer_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( 1 );
 }
 
-/* Writes data from buffer at the current offset
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes written or -1 on error
+/* Sets the maximum COW allocation table cache size
+ * The level 1 allocation table is always kept in memory, the cache size
+ * limits the amount of memory used to cache other allocation table blocks
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libbfoverlay_internal_handle_write_buffer(
-         libbfoverlay_internal_handle_t *internal_handle,
-         const uint8_t *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libbfoverlay_handle_set_maximum_cache_size(
+     libbfoverlay_handle_t *handle,
+     size_t maximum_cache_size,
+     libcerror_error_t **error )
 {
-	static char *function          = "libbfoverlay_internal_handle_write_buffer";
-	size_t buffer_offset           = 0;
-	size_t cow_block_offset        = 0;
-	size_t write_size              = 0;
-	ssize_t read_count             = 0;
-	ssize_t write_count            = 0;
-	off64_t cow_block_end_offset   = 0;
-	off64_t cow_block_start_offset = 0;
-	off64_t file_offset            = 0;
-	off64_t safe_current_offset    = 0;
-	int result                     = 0;
-
-	if( internal_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->current_offset < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - current offset value out of bounds.",
-		 function );
-
-		return( -1 );
-	}
-	if( buffer == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
-		 function );
-
-		return( -1 );
-	}
-	if( buffer_size > (size_t) SSIZE_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
-		 function );
-
-		return( -1 );
-	}
-	while( buffer_offset < buffer_size )
-	{
-		result = libbfoverlay_cow_file_get_block_at_offset(
-		          internal_handle->cow_file,
-		          internal_handle->data_file_io_pool,
-		          internal_handle->cow_file_io_pool_entry,
-		          internal_handle->current_offset,
-		          &cow_block_start_offset,
-		          &cow_block_end_offset,
-		          &file_offset,
-		          error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve COW block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 internal_handle->current_offset,
-			 internal_handle->current_offset );
-
-			return( -1 );
-		}
-		safe_current_offset = internal_handle->current_offset;
-
-		if( libbfoverlay_internal_handle_seek_offset(
-		     internal_handle,
-		     cow_block_start_offset,
-		     SEEK_SET,
-		     error ) == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek COW block offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 cow_block_start_offset,
-			 cow_block_start_offset );
-
-			return( -1 );
-		}
-		read_count = libbfoverlay_internal_handle_read_buffer(
-			      internal_handle,
-		              internal_handle->cow_block_data,
-		              internal_handle->cow_file->block_size,
-			      error );
-
-		if( read_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read COW block data.",
-			 function );
-
-			return( -1 );
-		}
-		if( read_count < (ssize_t) internal_handle->cow_file->block_size )
-		{
-			if( memory_set(
-			     &( ( internal_handle->cow_block_data )[ read_count ] ),
-			     0,
-			     internal_handle->cow_file->block_size - read_count ) == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-				 "%s: unable to clear read COW block data.",
-				 function );
-
-				return( -1 );
-			}
-		}
-		internal_handle->current_offset = safe_current_offset;
-
-		cow_block_offset = (size_t) ( internal_handle->current_offset - cow_block_start_offset );
-
-		write_size = buffer_size - buffer_offset;
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "libbfoverlay_handle_set_maximum_cache_size";
+	int result                                      = 1;
 
-		if( (int64_t) write_size > ( cow_block_end_offset - internal_handle->current_offset ) )
-		{
-			write_size = (size_t) ( cow_block_end_offset - internal_handle->current_offset );
-		}
-		if( memory_copy(
-		     &( ( internal_handle->cow_block_data )[ cow_block_offset ] ),
-		     &( buffer[ buffer_offset ] ),
-		     write_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy buffer to COW block data.",
-			 function );
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-			return( -1 );
-		}
-		if( result == 0 )
-		{
-			if( libbfoverlay_cow_file_allocate_block_for_offset(
-			     internal_handle->cow_file,
-			     internal_handle->data_file_io_pool,
-			     internal_handle->cow_file_io_pool_entry,
-			     internal_handle->current_offset,
-			     &file_offset,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to allocate block in COW file for offset %" PRIi64 " (0x%08" PRIx64 ").",
-				 function,
-				 internal_handle->current_offset,
-				 internal_handle->current_offset );
+		return( -1 );
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
 
-				return( -1 );
-			}
-		}
-		write_count = libbfio_pool_write_buffer_at_offset(
-		               internal_handle->data_file_io_pool,
-		               internal_handle->cow_file_io_pool_entry,
-		               internal_handle->cow_block_data,
-		               internal_handle->cow_file->block_size,
-		               file_offset,
-		               error );
+	if( maximum_cache_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum cache size value exceeds maximum.",
+		 function );
 
-		if( write_count != (ssize_t) internal_handle->cow_file->block_size )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to write COW block of size: %" PRIzd " to COW file at offset %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 internal_handle->cow_file->block_size,
-			 cow_block_offset,
-			 cow_block_offset );
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-			return( -1 );
-		}
-		buffer_offset                   += write_size;
-		internal_handle->current_offset += write_size;
+		return( -1 );
 	}
-	if( (size64_t) internal_handle->current_offset > internal_handle->size )
+#endif
+	if( internal_handle->cow_file != NULL )
 	{
-		if( libbfoverlay_cow_file_set_data_size(
+		/* Resizing the cache discards the cached allocation table blocks
+		 */
+		if( libbfoverlay_cow_file_flush(
 		     internal_handle->cow_file,
 		     internal_handle->data_file_io_pool,
 		     internal_handle->cow_file_io_pool_entry,
-		     (size64_t) internal_handle->current_offset,
 		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush COW file.",
+			 function );
+
+			result = -1;
+		}
+		else if( libbfoverlay_cow_file_set_maximum_cache_size(
+		          internal_handle->cow_file,
+		          maximum_cache_size,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set data size in COW file.",
+			 "%s: unable to set COW file maximum cache size.",
 			 function );
 
-			return( -1 );
+			result = -1;
 		}
-		internal_handle->size = (size64_t) internal_handle->current_offset;
 	}
-	return( (ssize_t) buffer_offset );
+	if( result == 1 )
+	{
+		internal_handle->maximum_cache_size = maximum_cache_size;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
 }
 
-/* Writes data from buffer at the current offset
- * Returns the number of bytes written if successful, or -1 on error
+/* Retrieves the maximum size of COW allocation table changes that are kept in memory
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libbfoverlay_handle_write_buffer(
-         libbfoverlay_handle_t *handle,
-         const uint8_t *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libbfoverlay_handle_get_maximum_dirty_size(
+     libbfoverlay_handle_t *handle,
+     size_t *maximum_dirty_size,
+     libcerror_error_t **error )
 {
 	libbfoverlay_internal_handle_t *internal_handle = NULL;
-	static char *function                           = "libbfoverlay_handle_write_buffer";
-	ssize_t write_count                             = 0;
+	static char *function                           = "libbfoverlay_handle_get_maximum_dirty_size";
 
 	if( handle == NULL )
 	{
@@ -2874,46 +7419,87 @@ ssize_t libbfoverlay_handle_write_buffer(
 	}
 	internal_handle = (libbfoverlay_internal_handle_t *) handle;
 
-	if( internal_handle->data_file_io_pool == NULL )
+	if( maximum_dirty_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum dirty size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing data file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->cow_file == NULL )
+#endif
+	*maximum_dirty_size = internal_handle->maximum_dirty_size;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing COW file.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum size of COW allocation table changes that are kept in memory
+ * A maximum dirty size of 0, the default, represents that changes are written
+ * immediately. Otherwise changes are written when the maximum dirty size is exceeded,
+ * on flush and on close
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_handle_set_maximum_dirty_size(
+     libbfoverlay_handle_t *handle,
+     size_t maximum_dirty_size,
+     libcerror_error_t **error )
+{
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "libbfoverlay_handle_set_maximum_dirty_size";
+	int result                                      = 1;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	if( maximum_dirty_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid size value exceeds maximum.",
+		 "%s: invalid maximum dirty size value exceeds maximum.",
 		 function );
 
 		return( -1 );
@@ -2933,22 +7519,28 @@ ssize_t libbfoverlay_handle_write_buffer(
 		return( -1 );
 	}
 #endif
-	write_count = libbfoverlay_internal_handle_write_buffer(
-	               internal_handle,
-	               buffer,
-	               buffer_size,
-	               error );
-
-	if( write_count == -1 )
+	if( internal_handle->cow_file != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write buffer.",
-		 function );
+		if( libbfoverlay_cow_file_set_maximum_dirty_size(
+		     internal_handle->cow_file,
+		     internal_handle->data_file_io_pool,
+		     internal_handle->cow_file_io_pool_entry,
+		     maximum_dirty_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set COW file maximum dirty size.",
+			 function );
 
-		write_count = -1;
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->maximum_dirty_size = maximum_dirty_size;
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -2965,22 +7557,20 @@ ssize_t libbfoverlay_handle_write_buffer(
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( result );
 }
 
-/* Writes data at a specific offset
- * Returns the number of bytes written or -1 on error
+/* Retrieves the number of layers
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libbfoverlay_handle_write_buffer_at_offset(
-         libbfoverlay_handle_t *handle,
-         const uint8_t *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libbfoverlay_handle_get_number_of_layers(
+     libbfoverlay_handle_t *handle,
+     int *number_of_layers,
+     libcerror_error_t **error )
 {
 	libbfoverlay_internal_handle_t *internal_handle = NULL;
-	static char *function                           = "libbfoverlay_handle_write_buffer_at_offset";
-	ssize_t write_count                             = 0;
+	static char *function                           = "libbfoverlay_handle_get_number_of_layers";
+	int result                                      = 1;
 
 	if( handle == NULL )
 	{
@@ -2995,30 +7585,19 @@ ssize_t libbfoverlay_handle_write_buffer_at_offset(
 	}
 	internal_handle = (libbfoverlay_internal_handle_t *) handle;
 
-	if( internal_handle->data_file_io_pool == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing data file IO pool.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->cow_file == NULL )
+	if( internal_handle->descriptor_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing COW file.",
+		 "%s: invalid handle - missing descriptor file.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3026,49 +7605,28 @@ ssize_t libbfoverlay_handle_write_buffer_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( libbfoverlay_internal_handle_seek_offset(
-	     internal_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( libbfoverlay_descriptor_get_number_of_layers(
+	     internal_handle->descriptor_file,
+	     number_of_layers,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
-
-		write_count = -1;
-	}
-	else
-	{
-		write_count = libbfoverlay_internal_handle_write_buffer(
-			       internal_handle,
-			       buffer,
-			       buffer_size,
-			       error );
-
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to write buffer.",
-			 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of layers.",
+		 function );
 
-			write_count = -1;
-		}
+		result = -1;
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3076,28 +7634,29 @@ ssize_t libbfoverlay_handle_write_buffer_at_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( result );
 }
 
-/* Seeks a certain offset of the data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
+/* Retrieves an IO statistics value
+ * Returns 1 if successful or -1 on error
  */
-off64_t libbfoverlay_internal_handle_seek_offset(
-         libbfoverlay_internal_handle_t *internal_handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libbfoverlay_handle_get_statistics(
+     libbfoverlay_handle_t *handle,
+     int value_type,
+     uint64_t *value,
+     libcerror_error_t **error )
 {
-	static char *function = "libbfoverlay_internal_handle_seek_offset";
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "libbfoverlay_handle_get_statistics";
+	int result                                      = 1;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -3108,54 +7667,81 @@ off64_t libbfoverlay_internal_handle_seek_offset(
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	if( internal_handle->io_statistics == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO statistics.",
 		 function );
 
 		return( -1 );
 	}
-	if( whence == SEEK_CUR )
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		offset += internal_handle->current_offset;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
 	}
-	else if( whence == SEEK_END )
+#endif
+	if( libbfoverlay_io_statistics_get_value(
+	     internal_handle->io_statistics,
+	     value_type,
+	     value,
+	     error ) != 1 )
 	{
-		offset += (off64_t) internal_handle->size;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve IO statistics value: %d.",
+		 function,
+		 value_type );
+
+		result = -1;
 	}
-	if( offset < 0 )
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->current_offset = offset;
-
-	return( offset );
+#endif
+	return( result );
 }
 
-/* Seeks a certain offset
- * Returns the offset if the seek is successful or -1 on error
+/* Retrieves the IO statistics of a specific layer
+ * Returns 1 if successful or -1 on error
  */
-off64_t libbfoverlay_handle_seek_offset(
-         libbfoverlay_handle_t *handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libbfoverlay_handle_get_layer_statistics(
+     libbfoverlay_handle_t *handle,
+     int layer_index,
+     uint64_t *number_of_bytes_read,
+     uint64_t *number_of_read_requests,
+     libcerror_error_t **error )
 {
 	libbfoverlay_internal_handle_t *internal_handle = NULL;
-	static char *function                           = "libbfoverlay_handle_seek_offset";
+	static char *function                           = "libbfoverlay_handle_get_layer_statistics";
+	int result                                      = 1;
 
 	if( handle == NULL )
 	{
@@ -3170,19 +7756,19 @@ off64_t libbfoverlay_handle_seek_offset(
 	}
 	internal_handle = (libbfoverlay_internal_handle_t *) handle;
 
-	if( internal_handle->data_file_io_pool == NULL )
+	if( internal_handle->io_statistics == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing data file IO pool.",
+		 "%s: invalid handle - missing IO statistics.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3190,31 +7776,31 @@ off64_t libbfoverlay_handle_seek_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	offset = libbfoverlay_internal_handle_seek_offset(
-	          internal_handle,
-	          offset,
-	          whence,
-	          error );
-
-	if( offset == -1 )
+	if( libbfoverlay_io_statistics_get_layer_values(
+	     internal_handle->io_statistics,
+	     layer_index,
+	     number_of_bytes_read,
+	     number_of_read_requests,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve IO statistics of layer: %d.",
+		 function,
+		 layer_index );
 
-		offset = -1;
+		result = -1;
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3222,25 +7808,24 @@ off64_t libbfoverlay_handle_seek_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( offset );
+	return( result );
 }
 
-/* Resizes the data of the handle
+/* Resets the IO statistics
  * Returns 1 if successful or -1 on error
  */
-int libbfoverlay_handle_resize(
+int libbfoverlay_handle_reset_statistics(
      libbfoverlay_handle_t *handle,
-     size64_t size,
      libcerror_error_t **error )
 {
 	libbfoverlay_internal_handle_t *internal_handle = NULL;
-	static char *function                           = "libbfoverlay_handle_resize";
+	static char *function                           = "libbfoverlay_handle_reset_statistics";
 	int result                                      = 1;
 
 	if( handle == NULL )
@@ -3256,30 +7841,19 @@ int libbfoverlay_handle_resize(
 	}
 	internal_handle = (libbfoverlay_internal_handle_t *) handle;
 
-	if( internal_handle->data_file_io_pool == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing data file IO pool.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->cow_file == NULL )
+	if( internal_handle->io_statistics == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing COW file.",
+		 "%s: invalid handle - missing IO statistics.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3287,34 +7861,27 @@ int libbfoverlay_handle_resize(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( libbfoverlay_cow_file_set_data_size(
-	     internal_handle->cow_file,
-	     internal_handle->data_file_io_pool,
-	     internal_handle->cow_file_io_pool_entry,
-	     size,
+	if( libbfoverlay_io_statistics_reset(
+	     internal_handle->io_statistics,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set data size in COW file.",
+		 "%s: unable to reset IO statistics.",
 		 function );
 
 		result = -1;
 	}
-	else
-	{
-		internal_handle->size = size;
-	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3322,7 +7889,7 @@ int libbfoverlay_handle_resize(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
@@ -3331,16 +7898,17 @@ int libbfoverlay_handle_resize(
 	return( result );
 }
 
-/* Retrieves the current offset
+/* Sets if IO statistics are recorded
+ * IO statistics are not recorded by default
  * Returns 1 if successful or -1 on error
  */
-int libbfoverlay_handle_get_offset(
+int libbfoverlay_handle_set_record_statistics(
      libbfoverlay_handle_t *handle,
-     off64_t *offset,
+     uint8_t record_statistics,
      libcerror_error_t **error )
 {
 	libbfoverlay_internal_handle_t *internal_handle = NULL;
-	static char *function                           = "libbfoverlay_handle_get_offset";
+	static char *function                           = "libbfoverlay_handle_set_record_statistics";
 
 	if( handle == NULL )
 	{
@@ -3355,30 +7923,87 @@ int libbfoverlay_handle_get_offset(
 	}
 	internal_handle = (libbfoverlay_internal_handle_t *) handle;
 
-	if( internal_handle->data_file_io_pool == NULL )
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing data file IO pool.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( offset == NULL )
+#endif
+	if( record_statistics != 0 )
+	{
+		internal_handle->record_statistics = 1;
+	}
+	else
+	{
+		internal_handle->record_statistics = 0;
+	}
+	/* The COW file records IO statistics when it references them
+	 */
+	if( internal_handle->cow_file != NULL )
+	{
+		if( internal_handle->record_statistics != 0 )
+		{
+			internal_handle->cow_file->io_statistics = internal_handle->io_statistics;
+		}
+		else
+		{
+			internal_handle->cow_file->io_statistics = NULL;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets if latency histograms are recorded
+ * Latency histograms are not recorded by default
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_handle_set_record_latency_histograms(
+     libbfoverlay_handle_t *handle,
+     uint8_t record_latency_histograms,
+     libcerror_error_t **error )
+{
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "libbfoverlay_handle_set_record_latency_histograms";
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3386,16 +8011,22 @@ int libbfoverlay_handle_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	*offset = internal_handle->current_offset;
-
+	if( record_latency_histograms != 0 )
+	{
+		internal_handle->record_latency_histograms = 1;
+	}
+	else
+	{
+		internal_handle->record_latency_histograms = 0;
+	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3403,7 +8034,7 @@ int libbfoverlay_handle_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -3412,16 +8043,19 @@ int libbfoverlay_handle_get_offset(
 	return( 1 );
 }
 
-/* Returns the size of the data of the handle
+/* Retrieves the latency histogram of a specific latency path
  * Returns 1 if successful or -1 on error
  */
-int libbfoverlay_handle_get_size(
+int libbfoverlay_handle_get_latency_histogram(
      libbfoverlay_handle_t *handle,
-     size64_t *size,
+     int latency_path,
+     uint64_t *bucket_counts,
+     int number_of_buckets,
      libcerror_error_t **error )
 {
 	libbfoverlay_internal_handle_t *internal_handle = NULL;
-	static char *function                           = "libbfoverlay_handle_get_size";
+	static char *function                           = "libbfoverlay_handle_get_latency_histogram";
+	int result                                      = 1;
 
 	if( handle == NULL )
 	{
@@ -3436,24 +8070,13 @@ int libbfoverlay_handle_get_size(
 	}
 	internal_handle = (libbfoverlay_internal_handle_t *) handle;
 
-	if( internal_handle->data_file_io_pool == NULL )
+	if( internal_handle->io_statistics == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing data file IO pool.",
-		 function );
-
-		return( -1 );
-	}
-	if( size == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid size",
+		 "%s: invalid handle - missing IO statistics.",
 		 function );
 
 		return( -1 );
@@ -3473,8 +8096,23 @@ int libbfoverlay_handle_get_size(
 		return( -1 );
 	}
 #endif
-	*size = internal_handle->size;
+	if( libbfoverlay_io_statistics_get_latency_histogram(
+	     internal_handle->io_statistics,
+	     latency_path,
+	     bucket_counts,
+	     number_of_buckets,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve latency histogram of path: %d.",
+		 function,
+		 latency_path );
 
+		result = -1;
+	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -3490,6 +8128,6 @@ int libbfoverlay_handle_get_size(
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 }
 
@@ -28,17 +28,44 @@
 #include "libbfoverlay_cow_file.h"
 #include "libbfoverlay_descriptor_file.h"
 #include "libbfoverlay_extern.h"
+#include "libbfoverlay_io_statistics.h"
 #include "libbfoverlay_libbfio.h"
 #include "libbfoverlay_libcdata.h"
 #include "libbfoverlay_libcerror.h"
 #include "libbfoverlay_libcthreads.h"
 #include "libbfoverlay_range.h"
+#include "libbfoverlay_range_map.h"
 #include "libbfoverlay_types.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+typedef struct libbfoverlay_batch_read_segment libbfoverlay_batch_read_segment_t;
+
+struct libbfoverlay_batch_read_segment
+{
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The file offset
+	 */
+	off64_t file_offset;
+
+	/* The latency path
+	 */
+	int latency_path;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The size
+	 */
+	size_t size;
+};
+
 typedef struct libbfoverlay_internal_handle libbfoverlay_internal_handle_t;
 
 struct libbfoverlay_internal_handle
@@ -59,9 +86,21 @@ struct libbfoverlay_internal_handle
 	 */
 	uint8_t *cow_block_data;
 
-	/* The ranges array
+	/* The range map
+	 */
+	libbfoverlay_range_map_t *range_map;
+
+	/* The IO statistics
+	 */
+	libbfoverlay_io_statistics_t *io_statistics;
+
+	/* Value to indicate if IO statistics are recorded
+	 */
+	uint8_t record_statistics;
+
+	/* Value to indicate if latency histograms are recorded
 	 */
-	libcdata_array_t *ranges_array;
+	uint8_t record_latency_histograms;
 
 	/* The current offset
 	 */
@@ -91,6 +130,14 @@ struct libbfoverlay_internal_handle
 	 */
 	int maximum_number_of_open_handles;
 
+	/* The maximum COW allocation table cache size
+	 */
+	size_t maximum_cache_size;
+
+	/* The maximum size of COW allocation table changes that are kept in memory
+	 */
+	size_t maximum_dirty_size;
+
 	/* The size
 	 */
 	size64_t size;
@@ -175,6 +222,54 @@ int libbfoverlay_internal_handle_open_read(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+int libbfoverlay_internal_handle_get_data_run_at_offset(
+     libbfoverlay_internal_handle_t *internal_handle,
+     off64_t offset,
+     size_t maximum_size,
+     int *range_index,
+     int *file_io_pool_entry,
+     off64_t *file_offset,
+     size_t *data_run_size,
+     int *latency_path,
+     libcerror_error_t **error );
+
+int libbfoverlay_internal_handle_read_data_run(
+     libbfoverlay_internal_handle_t *internal_handle,
+     int file_io_pool_entry,
+     off64_t file_offset,
+     int latency_path,
+     uint8_t *buffer,
+     size_t read_size,
+     libcerror_error_t **error );
+
+ssize_t libbfoverlay_internal_handle_read_buffer_at_offset(
+         libbfoverlay_internal_handle_t *internal_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+ssize_t libbfoverlay_internal_handle_read_vector_at_offset(
+         libbfoverlay_internal_handle_t *internal_handle,
+         uint8_t **buffers,
+         const size_t *buffer_sizes,
+         int number_of_buffers,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int libbfoverlay_internal_handle_compare_batch_read_segments(
+     const void *first_segment,
+     const void *second_segment );
+
+int libbfoverlay_internal_handle_read_batch(
+     libbfoverlay_internal_handle_t *internal_handle,
+     uint8_t **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     int number_of_requests,
+     ssize_t *read_counts,
+     libcerror_error_t **error );
+
 ssize_t libbfoverlay_internal_handle_read_buffer(
          libbfoverlay_internal_handle_t *internal_handle,
          uint8_t *buffer,
@@ -207,6 +302,25 @@ ssize_t libbfoverlay_handle_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+LIBBFOVERLAY_EXTERN \
+ssize_t libbfoverlay_handle_read_vector_at_offset(
+         libbfoverlay_handle_t *handle,
+         uint8_t **buffers,
+         const size_t *buffer_sizes,
+         int number_of_buffers,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBBFOVERLAY_EXTERN \
+int libbfoverlay_handle_read_batch(
+     libbfoverlay_handle_t *handle,
+     uint8_t **buffers,
+     const size_t *buffer_sizes,
+     const off64_t *offsets,
+     int number_of_requests,
+     ssize_t *read_counts,
+     libcerror_error_t **error );
+
 ssize_t libbfoverlay_internal_handle_write_buffer(
          libbfoverlay_internal_handle_t *internal_handle,
          const uint8_t *buffer,
@@ -228,6 +342,18 @@ ssize_t libbfoverlay_handle_write_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+LIBBFOVERLAY_EXTERN \
+int libbfoverlay_handle_flush(
+     libbfoverlay_handle_t *handle,
+     libcerror_error_t **error );
+
+int libbfoverlay_internal_handle_get_data_or_hole_offset(
+     libbfoverlay_internal_handle_t *internal_handle,
+     off64_t offset,
+     uint8_t find_hole,
+     off64_t *data_or_hole_offset,
+     libcerror_error_t **error );
+
 off64_t libbfoverlay_internal_handle_seek_offset(
          libbfoverlay_internal_handle_t *internal_handle,
          off64_t offset,
@@ -247,6 +373,48 @@ int libbfoverlay_handle_resize(
      size64_t size,
      libcerror_error_t **error );
 
+LIBBFOVERLAY_EXTERN \
+int libbfoverlay_handle_discard(
+     libbfoverlay_handle_t *handle,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libbfoverlay_internal_handle_write_zeroes(
+     libbfoverlay_internal_handle_t *internal_handle,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+LIBBFOVERLAY_EXTERN \
+int libbfoverlay_handle_write_zeroes(
+     libbfoverlay_handle_t *handle,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libbfoverlay_internal_handle_write_compacted_cow_file(
+     libbfoverlay_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
+LIBBFOVERLAY_EXTERN \
+int libbfoverlay_handle_write_compacted_cow_file(
+     libbfoverlay_handle_t *handle,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBBFOVERLAY_EXTERN \
+int libbfoverlay_handle_write_compacted_cow_file_wide(
+     libbfoverlay_handle_t *handle,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
 LIBBFOVERLAY_EXTERN \
 int libbfoverlay_handle_get_offset(
      libbfoverlay_handle_t *handle,
@@ -259,6 +427,103 @@ int libbfoverlay_handle_get_size(
      size64_t *size,
      libcerror_error_t **error );
 
+int libbfoverlay_internal_handle_get_extents(
+     libbfoverlay_internal_handle_t *internal_handle,
+     off64_t offset,
+     size64_t size,
+     off64_t *extent_offsets,
+     size64_t *extent_sizes,
+     uint32_t *extent_flags,
+     int *extent_layer_indexes,
+     off64_t *extent_data_offsets,
+     int maximum_number_of_extents,
+     int *number_of_extents,
+     libcerror_error_t **error );
+
+LIBBFOVERLAY_EXTERN \
+int libbfoverlay_handle_get_extents(
+     libbfoverlay_handle_t *handle,
+     off64_t offset,
+     size64_t size,
+     off64_t *extent_offsets,
+     size64_t *extent_sizes,
+     uint32_t *extent_flags,
+     int *extent_layer_indexes,
+     off64_t *extent_data_offsets,
+     int maximum_number_of_extents,
+     int *number_of_extents,
+     libcerror_error_t **error );
+
+LIBBFOVERLAY_EXTERN \
+int libbfoverlay_handle_get_maximum_cache_size(
+     libbfoverlay_handle_t *handle,
+     size_t *maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBBFOVERLAY_EXTERN \
+int libbfoverlay_handle_set_maximum_cache_size(
+     libbfoverlay_handle_t *handle,
+     size_t maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBBFOVERLAY_EXTERN \
+int libbfoverlay_handle_get_maximum_dirty_size(
+     libbfoverlay_handle_t *handle,
+     size_t *maximum_dirty_size,
+     libcerror_error_t **error );
+
+LIBBFOVERLAY_EXTERN \
+int libbfoverlay_handle_set_maximum_dirty_size(
+     libbfoverlay_handle_t *handle,
+     size_t maximum_dirty_size,
+     libcerror_error_t **error );
+
+LIBBFOVERLAY_EXTERN \
+int libbfoverlay_handle_get_number_of_layers(
+     libbfoverlay_handle_t *handle,
+     int *number_of_layers,
+     libcerror_error_t **error );
+
+LIBBFOVERLAY_EXTERN \
+int libbfoverlay_handle_get_statistics(
+     libbfoverlay_handle_t *handle,
+     int value_type,
+     uint64_t *value,
+     libcerror_error_t **error );
+
+LIBBFOVERLAY_EXTERN \
+int libbfoverlay_handle_get_layer_statistics(
+     libbfoverlay_handle_t *handle,
+     int layer_index,
+     uint64_t *number_of_bytes_read,
+     uint64_t *number_of_read_requests,
+     libcerror_error_t **error );
+
+LIBBFOVERLAY_EXTERN \
+int libbfoverlay_handle_reset_statistics(
+     libbfoverlay_handle_t *handle,
+     libcerror_error_t **error );
+
+LIBBFOVERLAY_EXTERN \
+int libbfoverlay_handle_set_record_statistics(
+     libbfoverlay_handle_t *handle,
+     uint8_t record_statistics,
+     libcerror_error_t **error );
+
+LIBBFOVERLAY_EXTERN \
+int libbfoverlay_handle_set_record_latency_histograms(
+     libbfoverlay_handle_t *handle,
+     uint8_t record_latency_histograms,
+     libcerror_error_t **error );
+
+LIBBFOVERLAY_EXTERN \
+int libbfoverlay_handle_get_latency_histogram(
+     libbfoverlay_handle_t *handle,
+     int latency_path,
+     uint64_t *bucket_counts,
+     int number_of_buckets,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,1118 @@
+/*
+ * The IO statistics functions
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_CLOCK_GETTIME )
+#include <time.h>
+#endif
+
+#include "libbfoverlay_definitions.h"
+#include "libbfoverlay_io_statistics.h"
+#include "libbfoverlay_libcerror.h"
+#include "libbfoverlay_libcthreads.h"
+
+/* Creates IO statistics
+ * Make sure the value io_statistics is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_io_statistics_initialize(
+     libbfoverlay_io_statistics_t **io_statistics,
+     int number_of_layers,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_io_statistics_initialize";
+	size_t layers_size    = 0;
+
+	if( io_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_statistics != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO statistics value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_layers <= 0 )
+	 || ( (size_t) number_of_layers > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint64_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of layers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*io_statistics = memory_allocate_structure(
+	                  libbfoverlay_io_statistics_t );
+
+	if( *io_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create IO statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *io_statistics,
+	     0,
+	     sizeof( libbfoverlay_io_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear IO statistics.",
+		 function );
+
+		memory_free(
+		 *io_statistics );
+
+		*io_statistics = NULL;
+
+		return( -1 );
+	}
+	layers_size = sizeof( uint64_t ) * number_of_layers;
+
+	( *io_statistics )->layer_number_of_bytes_read = (uint64_t *) memory_allocate(
+	                                                               layers_size );
+
+	if( ( *io_statistics )->layer_number_of_bytes_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create layer number of bytes read.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *io_statistics )->layer_number_of_bytes_read,
+	     0,
+	     layers_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear layer number of bytes read.",
+		 function );
+
+		goto on_error;
+	}
+	( *io_statistics )->layer_number_of_read_requests = (uint64_t *) memory_allocate(
+	                                                                  layers_size );
+
+	if( ( *io_statistics )->layer_number_of_read_requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create layer number of read requests.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *io_statistics )->layer_number_of_read_requests,
+	     0,
+	     layers_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear layer number of read requests.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_initialize(
+	     &( ( *io_statistics )->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *io_statistics )->number_of_layers = number_of_layers;
+
+	return( 1 );
+
+on_error:
+	if( *io_statistics != NULL )
+	{
+		if( ( *io_statistics )->layer_number_of_read_requests != NULL )
+		{
+			memory_free(
+			 ( *io_statistics )->layer_number_of_read_requests );
+		}
+		if( ( *io_statistics )->layer_number_of_bytes_read != NULL )
+		{
+			memory_free(
+			 ( *io_statistics )->layer_number_of_bytes_read );
+		}
+		memory_free(
+		 *io_statistics );
+
+		*io_statistics = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees IO statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_io_statistics_free(
+     libbfoverlay_io_statistics_t **io_statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_io_statistics_free";
+	int result            = 1;
+
+	if( io_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_statistics != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+		if( libcthreads_read_write_lock_free(
+		     &( ( *io_statistics )->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 ( *io_statistics )->layer_number_of_read_requests );
+
+		memory_free(
+		 ( *io_statistics )->layer_number_of_bytes_read );
+
+		memory_free(
+		 *io_statistics );
+
+		*io_statistics = NULL;
+	}
+	return( result );
+}
+
+/* Resets the IO statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_io_statistics_reset(
+     libbfoverlay_io_statistics_t *io_statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_io_statistics_reset";
+	size_t layers_size    = 0;
+	int result            = 1;
+
+	if( io_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO statistics.",
+		 function );
+
+		return( -1 );
+	}
+	layers_size = sizeof( uint64_t ) * io_statistics->number_of_layers;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     io_statistics->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( memory_set(
+	     io_statistics->layer_number_of_bytes_read,
+	     0,
+	     layers_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear layer number of bytes read.",
+		 function );
+
+		result = -1;
+	}
+	else if( memory_set(
+	          io_statistics->layer_number_of_read_requests,
+	          0,
+	          layers_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear layer number of read requests.",
+		 function );
+
+		result = -1;
+	}
+	else if( memory_set(
+	          io_statistics->latency_histograms,
+	          0,
+	          sizeof( io_statistics->latency_histograms ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear latency histograms.",
+		 function );
+
+		result = -1;
+	}
+	io_statistics->sparse_number_of_bytes_read           = 0;
+	io_statistics->sparse_number_of_read_requests        = 0;
+	io_statistics->cow_number_of_bytes_read              = 0;
+	io_statistics->cow_number_of_read_requests           = 0;
+	io_statistics->cow_number_of_bytes_written           = 0;
+	io_statistics->cow_number_of_write_requests          = 0;
+	io_statistics->cow_number_of_allocated_blocks        = 0;
+	io_statistics->cow_number_of_allocated_table_blocks  = 0;
+	io_statistics->cow_number_of_read_modify_write_reads = 0;
+	io_statistics->cow_number_of_zero_blocks             = 0;
+	io_statistics->cow_number_of_metadata_reads          = 0;
+	io_statistics->cow_number_of_metadata_writes         = 0;
+	io_statistics->backing_io_time                       = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_write(
+	     io_statistics->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a monotonic timestamp used to measure the backing IO time
+ * The timestamp is in number of nanoseconds or 0 if not supported
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_io_statistics_get_timestamp(
+     uint64_t *timestamp,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	struct timespec time_structure;
+#endif
+
+	static char *function = "libbfoverlay_io_statistics_get_timestamp";
+
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve performance counter.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) ( counter.QuadPart / frequency.QuadPart ) * 1000000000 )
+	           + ( ( (uint64_t) ( counter.QuadPart % frequency.QuadPart ) * 1000000000 ) / (uint64_t) frequency.QuadPart );
+
+#elif defined( HAVE_CLOCK_GETTIME )
+#if defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+#else
+	if( clock_gettime(
+	     CLOCK_REALTIME,
+	     &time_structure ) != 0 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time structure.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) time_structure.tv_sec * 1000000000 ) + (uint64_t) time_structure.tv_nsec;
+
+#else
+	/* Without a high resolution clock the backing IO time is not tracked
+	 */
+	*timestamp = 0;
+
+#endif /* defined( WINAPI ) */
+
+	return( 1 );
+}
+
+/* Adds an IO operation to the IO statistics
+ * The layer index is only used for layer reads
+ * The time since the start timestamp is added to the backing IO time,
+ * a start timestamp of 0 represents that the time is not tracked
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_io_statistics_add_io(
+     libbfoverlay_io_statistics_t *io_statistics,
+     int io_type,
+     int layer_index,
+     size_t io_size,
+     uint64_t start_timestamp,
+     libcerror_error_t **error )
+{
+	static char *function  = "libbfoverlay_io_statistics_add_io";
+	uint64_t end_timestamp = 0;
+
+	if( io_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_type < LIBBFOVERLAY_IO_TYPE_LAYER_READ )
+	 || ( io_type > LIBBFOVERLAY_IO_TYPE_COW_METADATA_WRITE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported IO type.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_type == LIBBFOVERLAY_IO_TYPE_LAYER_READ )
+	 && ( ( layer_index < 0 )
+	  || ( layer_index >= io_statistics->number_of_layers ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid layer index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( start_timestamp != 0 )
+	{
+		if( libbfoverlay_io_statistics_get_timestamp(
+		     &end_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve end timestamp.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     io_statistics->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	switch( io_type )
+	{
+		case LIBBFOVERLAY_IO_TYPE_LAYER_READ:
+			io_statistics->layer_number_of_bytes_read[ layer_index ]    += io_size;
+			io_statistics->layer_number_of_read_requests[ layer_index ] += 1;
+			break;
+
+		case LIBBFOVERLAY_IO_TYPE_SPARSE_READ:
+			io_statistics->sparse_number_of_bytes_read    += io_size;
+			io_statistics->sparse_number_of_read_requests += 1;
+			break;
+
+		case LIBBFOVERLAY_IO_TYPE_COW_READ:
+			io_statistics->cow_number_of_bytes_read    += io_size;
+			io_statistics->cow_number_of_read_requests += 1;
+			break;
+
+		case LIBBFOVERLAY_IO_TYPE_COW_WRITE:
+			io_statistics->cow_number_of_bytes_written  += io_size;
+			io_statistics->cow_number_of_write_requests += 1;
+			break;
+
+		case LIBBFOVERLAY_IO_TYPE_COW_METADATA_READ:
+			io_statistics->cow_number_of_metadata_reads += 1;
+			break;
+
+		case LIBBFOVERLAY_IO_TYPE_COW_METADATA_WRITE:
+			io_statistics->cow_number_of_metadata_writes += 1;
+			break;
+	}
+	if( end_timestamp > start_timestamp )
+	{
+		io_statistics->backing_io_time += end_timestamp - start_timestamp;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_write(
+	     io_statistics->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Adds a count to a statistics value
+ * Only the COW allocated blocks, allocated table blocks and read-modify-write
+ * reads value types are supported
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_io_statistics_add_count(
+     libbfoverlay_io_statistics_t *io_statistics,
+     int value_type,
+     uint64_t count,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_io_statistics_add_count";
+
+	if( io_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_type != LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_ALLOCATED_BLOCKS )
+	 && ( value_type != LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_ALLOCATED_TABLE_BLOCKS )
+	 && ( value_type != LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_READ_MODIFY_WRITE_READS )
+	 && ( value_type != LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_ZERO_BLOCKS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported value type.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     io_statistics->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	switch( value_type )
+	{
+		case LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_ALLOCATED_BLOCKS:
+			io_statistics->cow_number_of_allocated_blocks += count;
+			break;
+
+		case LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_ALLOCATED_TABLE_BLOCKS:
+			io_statistics->cow_number_of_allocated_table_blocks += count;
+			break;
+
+		case LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_READ_MODIFY_WRITE_READS:
+			io_statistics->cow_number_of_read_modify_write_reads += count;
+			break;
+
+		case LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_ZERO_BLOCKS:
+			io_statistics->cow_number_of_zero_blocks += count;
+			break;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_write(
+	     io_statistics->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Adds a latency sample to the histogram of a specific latency path
+ * The latency is the time since the start timestamp, a start timestamp
+ * of 0 represents that the time is not tracked
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_io_statistics_add_latency(
+     libbfoverlay_io_statistics_t *io_statistics,
+     int latency_path,
+     uint64_t start_timestamp,
+     libcerror_error_t **error )
+{
+	static char *function  = "libbfoverlay_io_statistics_add_latency";
+	uint64_t end_timestamp = 0;
+	uint64_t latency       = 0;
+	int bucket_index       = 0;
+
+	if( io_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( latency_path < LIBBFOVERLAY_LATENCY_PATH_READ_SPARSE )
+	 || ( latency_path > LIBBFOVERLAY_LATENCY_PATH_WRITE_COW_ALLOCATE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported latency path.",
+		 function );
+
+		return( -1 );
+	}
+	if( start_timestamp == 0 )
+	{
+		return( 1 );
+	}
+	if( libbfoverlay_io_statistics_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	if( end_timestamp > start_timestamp )
+	{
+		latency = end_timestamp - start_timestamp;
+	}
+	/* The bucket index is the number of significant bits of the latency
+	 */
+	while( latency != 0 )
+	{
+		bucket_index++;
+
+		latency >>= 1;
+	}
+	if( bucket_index >= LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS )
+	{
+		bucket_index = LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS - 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     io_statistics->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	io_statistics->latency_histograms[ latency_path - 1 ][ bucket_index ] += 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_write(
+	     io_statistics->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves a statistics value
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_io_statistics_get_value(
+     libbfoverlay_io_statistics_t *io_statistics,
+     int value_type,
+     uint64_t *value,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_io_statistics_get_value";
+
+	if( io_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_type < LIBBFOVERLAY_STATISTICS_VALUE_TYPE_SPARSE_NUMBER_OF_BYTES_READ )
+	 || ( value_type > LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_ZERO_BLOCKS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported value type.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     io_statistics->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	switch( value_type )
+	{
+		case LIBBFOVERLAY_STATISTICS_VALUE_TYPE_SPARSE_NUMBER_OF_BYTES_READ:
+			*value = io_statistics->sparse_number_of_bytes_read;
+			break;
+
+		case LIBBFOVERLAY_STATISTICS_VALUE_TYPE_SPARSE_NUMBER_OF_READ_REQUESTS:
+			*value = io_statistics->sparse_number_of_read_requests;
+			break;
+
+		case LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_BYTES_READ:
+			*value = io_statistics->cow_number_of_bytes_read;
+			break;
+
+		case LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_READ_REQUESTS:
+			*value = io_statistics->cow_number_of_read_requests;
+			break;
+
+		case LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_BYTES_WRITTEN:
+			*value = io_statistics->cow_number_of_bytes_written;
+			break;
+
+		case LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_WRITE_REQUESTS:
+			*value = io_statistics->cow_number_of_write_requests;
+			break;
+
+		case LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_ALLOCATED_BLOCKS:
+			*value = io_statistics->cow_number_of_allocated_blocks;
+			break;
+
+		case LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_ALLOCATED_TABLE_BLOCKS:
+			*value = io_statistics->cow_number_of_allocated_table_blocks;
+			break;
+
+		case LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_READ_MODIFY_WRITE_READS:
+			*value = io_statistics->cow_number_of_read_modify_write_reads;
+			break;
+
+		case LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_METADATA_READS:
+			*value = io_statistics->cow_number_of_metadata_reads;
+			break;
+
+		case LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_METADATA_WRITES:
+			*value = io_statistics->cow_number_of_metadata_writes;
+			break;
+
+		case LIBBFOVERLAY_STATISTICS_VALUE_TYPE_BACKING_IO_TIME:
+			*value = io_statistics->backing_io_time;
+			break;
+
+		case LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_ZERO_BLOCKS:
+			*value = io_statistics->cow_number_of_zero_blocks;
+			break;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_read(
+	     io_statistics->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the statistics values of a specific layer
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_io_statistics_get_layer_values(
+     libbfoverlay_io_statistics_t *io_statistics,
+     int layer_index,
+     uint64_t *number_of_bytes_read,
+     uint64_t *number_of_read_requests,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_io_statistics_get_layer_values";
+
+	if( io_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( layer_index < 0 )
+	 || ( layer_index >= io_statistics->number_of_layers ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid layer index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_bytes_read == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of bytes read.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_read_requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of read requests.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     io_statistics->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_bytes_read    = io_statistics->layer_number_of_bytes_read[ layer_index ];
+	*number_of_read_requests = io_statistics->layer_number_of_read_requests[ layer_index ];
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_read(
+	     io_statistics->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the latency histogram of a specific latency path
+ * The bucket counts must have room for LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS values
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_io_statistics_get_latency_histogram(
+     libbfoverlay_io_statistics_t *io_statistics,
+     int latency_path,
+     uint64_t *bucket_counts,
+     int number_of_buckets,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_io_statistics_get_latency_histogram";
+	int result            = 1;
+
+	if( io_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( latency_path < LIBBFOVERLAY_LATENCY_PATH_READ_SPARSE )
+	 || ( latency_path > LIBBFOVERLAY_LATENCY_PATH_WRITE_COW_ALLOCATE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported latency path.",
+		 function );
+
+		return( -1 );
+	}
+	if( bucket_counts == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bucket counts.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buckets < LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid number of buckets value too small.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     io_statistics->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( memory_copy(
+	     bucket_counts,
+	     io_statistics->latency_histograms[ latency_path - 1 ],
+	     sizeof( uint64_t ) * LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy latency histogram.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	if( libcthreads_read_write_lock_release_for_read(
+	     io_statistics->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
@@ -0,0 +1,177 @@
+/*
+ * The IO statistics functions
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBFOVERLAY_IO_STATISTICS_H )
+#define _LIBBFOVERLAY_IO_STATISTICS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbfoverlay_definitions.h"
+#include "libbfoverlay_libcerror.h"
+#include "libbfoverlay_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libbfoverlay_io_statistics libbfoverlay_io_statistics_t;
+
+struct libbfoverlay_io_statistics
+{
+	/* The number of layers
+	 */
+	int number_of_layers;
+
+	/* The number of bytes read per layer
+	 */
+	uint64_t *layer_number_of_bytes_read;
+
+	/* The number of read requests per layer
+	 */
+	uint64_t *layer_number_of_read_requests;
+
+	/* The number of bytes read from sparse ranges
+	 */
+	uint64_t sparse_number_of_bytes_read;
+
+	/* The number of read requests of sparse ranges
+	 */
+	uint64_t sparse_number_of_read_requests;
+
+	/* The number of bytes read from COW blocks
+	 */
+	uint64_t cow_number_of_bytes_read;
+
+	/* The number of read requests of COW blocks
+	 */
+	uint64_t cow_number_of_read_requests;
+
+	/* The number of bytes written to COW blocks
+	 */
+	uint64_t cow_number_of_bytes_written;
+
+	/* The number of write requests of COW blocks
+	 */
+	uint64_t cow_number_of_write_requests;
+
+	/* The number of allocated COW blocks
+	 */
+	uint64_t cow_number_of_allocated_blocks;
+
+	/* The number of allocated COW allocation table blocks
+	 */
+	uint64_t cow_number_of_allocated_table_blocks;
+
+	/* The number of reads needed to write partial COW blocks
+	 */
+	uint64_t cow_number_of_read_modify_write_reads;
+
+	/* The number of COW blocks marked as only containing zero bytes
+	 */
+	uint64_t cow_number_of_zero_blocks;
+
+	/* The number of COW metadata reads
+	 */
+	uint64_t cow_number_of_metadata_reads;
+
+	/* The number of COW metadata writes
+	 */
+	uint64_t cow_number_of_metadata_writes;
+
+	/* The cumulative time spent in backing IO in nanoseconds
+	 */
+	uint64_t backing_io_time;
+
+	/* The latency histograms per latency path
+	 */
+	uint64_t latency_histograms[ LIBBFOVERLAY_LATENCY_PATH_WRITE_COW_ALLOCATE ][ LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS ];
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+int libbfoverlay_io_statistics_initialize(
+     libbfoverlay_io_statistics_t **io_statistics,
+     int number_of_layers,
+     libcerror_error_t **error );
+
+int libbfoverlay_io_statistics_free(
+     libbfoverlay_io_statistics_t **io_statistics,
+     libcerror_error_t **error );
+
+int libbfoverlay_io_statistics_reset(
+     libbfoverlay_io_statistics_t *io_statistics,
+     libcerror_error_t **error );
+
+int libbfoverlay_io_statistics_get_timestamp(
+     uint64_t *timestamp,
+     libcerror_error_t **error );
+
+int libbfoverlay_io_statistics_add_io(
+     libbfoverlay_io_statistics_t *io_statistics,
+     int io_type,
+     int layer_index,
+     size_t io_size,
+     uint64_t start_timestamp,
+     libcerror_error_t **error );
+
+int libbfoverlay_io_statistics_add_count(
+     libbfoverlay_io_statistics_t *io_statistics,
+     int value_type,
+     uint64_t count,
+     libcerror_error_t **error );
+
+int libbfoverlay_io_statistics_add_latency(
+     libbfoverlay_io_statistics_t *io_statistics,
+     int latency_path,
+     uint64_t start_timestamp,
+     libcerror_error_t **error );
+
+int libbfoverlay_io_statistics_get_value(
+     libbfoverlay_io_statistics_t *io_statistics,
+     int value_type,
+     uint64_t *value,
+     libcerror_error_t **error );
+
+int libbfoverlay_io_statistics_get_layer_values(
+     libbfoverlay_io_statistics_t *io_statistics,
+     int layer_index,
+     uint64_t *number_of_bytes_read,
+     uint64_t *number_of_read_requests,
+     libcerror_error_t **error );
+
+int libbfoverlay_io_statistics_get_latency_histogram(
+     libbfoverlay_io_statistics_t *io_statistics,
+     int latency_path,
+     uint64_t *bucket_counts,
+     int number_of_buckets,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBFOVERLAY_IO_STATISTICS_H ) */
+
@@ -58,6 +58,10 @@ struct libbfoverlay_layer
 	/* Use copy-on-write (COW)
 	 */
 	int8_t use_cow;
+
+	/* The copy-on-write (COW) block size
+	 */
+	size32_t cow_block_size;
 };
 
 int libbfoverlay_layer_initialize(
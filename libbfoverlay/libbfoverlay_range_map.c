@@ -0,0 +1,482 @@
+/*
+ * The range map functions
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbfoverlay_libcerror.h"
+#include "libbfoverlay_range.h"
+#include "libbfoverlay_range_map.h"
+
+/* Creates a range map
+ * Make sure the value range_map is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_range_map_initialize(
+     libbfoverlay_range_map_t **range_map,
+     int number_of_ranges,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_range_map_initialize";
+	size_t ranges_size    = 0;
+
+	if( range_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *range_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid range map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_ranges < 0 )
+	 || ( (size_t) number_of_ranges > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libbfoverlay_range_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of ranges value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*range_map = memory_allocate_structure(
+	              libbfoverlay_range_map_t );
+
+	if( *range_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create range map.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *range_map,
+	     0,
+	     sizeof( libbfoverlay_range_map_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear range map.",
+		 function );
+
+		memory_free(
+		 *range_map );
+
+		*range_map = NULL;
+
+		return( -1 );
+	}
+	if( number_of_ranges > 0 )
+	{
+		ranges_size = sizeof( libbfoverlay_range_t ) * number_of_ranges;
+
+		( *range_map )->ranges = (libbfoverlay_range_t *) memory_allocate(
+		                                                   ranges_size );
+
+		if( ( *range_map )->ranges == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create ranges.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     ( *range_map )->ranges,
+		     0,
+		     ranges_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear ranges.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	( *range_map )->number_of_ranges = number_of_ranges;
+
+	return( 1 );
+
+on_error:
+	if( *range_map != NULL )
+	{
+		if( ( *range_map )->ranges != NULL )
+		{
+			memory_free(
+			 ( *range_map )->ranges );
+		}
+		memory_free(
+		 *range_map );
+
+		*range_map = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a range map
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_range_map_free(
+     libbfoverlay_range_map_t **range_map,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_range_map_free";
+
+	if( range_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *range_map != NULL )
+	{
+		if( ( *range_map )->ranges != NULL )
+		{
+			memory_free(
+			 ( *range_map )->ranges );
+		}
+		memory_free(
+		 *range_map );
+
+		*range_map = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of ranges
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_range_map_get_number_of_ranges(
+     libbfoverlay_range_map_t *range_map,
+     int *number_of_ranges,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_range_map_get_number_of_ranges";
+
+	if( range_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range map.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of ranges.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_ranges = range_map->number_of_ranges;
+
+	return( 1 );
+}
+
+/* Retrieves a specific range
+ * The range is owned by the range map and should not be freed
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_range_map_get_range_by_index(
+     libbfoverlay_range_map_t *range_map,
+     int range_index,
+     libbfoverlay_range_t **range,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_range_map_get_range_by_index";
+
+	if( range_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range map.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_index < 0 )
+	 || ( range_index >= range_map->number_of_ranges ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range.",
+		 function );
+
+		return( -1 );
+	}
+	*range = &( range_map->ranges[ range_index ] );
+
+	return( 1 );
+}
+
+/* Sets a specific range
+ * The range values are copied, ranges must be set in order of their start offset
+ * and must not overlap
+ * Returns 1 if successful or -1 on error
+ */
+int libbfoverlay_range_map_set_range_by_index(
+     libbfoverlay_range_map_t *range_map,
+     int range_index,
+     const libbfoverlay_range_t *range,
+     libcerror_error_t **error )
+{
+	static char *function = "libbfoverlay_range_map_set_range_by_index";
+
+	if( range_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range map.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_index < 0 )
+	 || ( range_index >= range_map->number_of_ranges ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range->start_offset < 0 )
+	 || ( range->end_offset <= range->start_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range - offsets value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_index > 0 )
+	 && ( range->start_offset < range_map->ranges[ range_index - 1 ].end_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range - start offset overlaps with previous range.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     &( range_map->ranges[ range_index ] ),
+	     range,
+	     sizeof( libbfoverlay_range_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy range.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the range for a specific offset
+ * The value range_index is used as a hint, if it refers to the range that contains
+ * the offset or the range directly before it no search is needed. Otherwise the
+ * range is determined using a binary search. On return range_index contains
+ * the index of the range.
+ * Returns 1 if successful, 0 if no range exists or -1 on error
+ */
+int libbfoverlay_range_map_get_range_at_offset(
+     libbfoverlay_range_map_t *range_map,
+     off64_t offset,
+     int *range_index,
+     libbfoverlay_range_t **range,
+     libcerror_error_t **error )
+{
+	libbfoverlay_range_t *safe_range = NULL;
+	static char *function            = "libbfoverlay_range_map_get_range_at_offset";
+	int first_range_index            = 0;
+	int last_range_index             = 0;
+	int middle_range_index           = 0;
+
+	if( range_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range map.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range index.",
+		 function );
+
+		return( -1 );
+	}
+	if( range == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range.",
+		 function );
+
+		return( -1 );
+	}
+	/* Fast path for sequential access
+	 */
+	if( ( *range_index >= 0 )
+	 && ( *range_index < range_map->number_of_ranges ) )
+	{
+		safe_range = &( range_map->ranges[ *range_index ] );
+
+		if( ( offset >= safe_range->start_offset )
+		 && ( offset < safe_range->end_offset ) )
+		{
+			*range = safe_range;
+
+			return( 1 );
+		}
+		if( ( offset >= safe_range->end_offset )
+		 && ( ( *range_index + 1 ) < range_map->number_of_ranges ) )
+		{
+			safe_range = &( range_map->ranges[ *range_index + 1 ] );
+
+			if( ( offset >= safe_range->start_offset )
+			 && ( offset < safe_range->end_offset ) )
+			{
+				*range_index += 1;
+				*range        = safe_range;
+
+				return( 1 );
+			}
+		}
+	}
+	first_range_index = 0;
+	last_range_index  = range_map->number_of_ranges - 1;
+
+	while( first_range_index <= last_range_index )
+	{
+		middle_range_index = first_range_index + ( ( last_range_index - first_range_index ) / 2 );
+
+		safe_range = &( range_map->ranges[ middle_range_index ] );
+
+		if( offset < safe_range->start_offset )
+		{
+			last_range_index = middle_range_index - 1;
+		}
+		else if( offset >= safe_range->end_offset )
+		{
+			first_range_index = middle_range_index + 1;
+		}
+		else
+		{
+			*range_index = middle_range_index;
+			*range       = safe_range;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
@@ -0,0 +1,86 @@
+/*
+ * The range map functions
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBFOVERLAY_RANGE_MAP_H )
+#define _LIBBFOVERLAY_RANGE_MAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbfoverlay_libcerror.h"
+#include "libbfoverlay_range.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libbfoverlay_range_map libbfoverlay_range_map_t;
+
+struct libbfoverlay_range_map
+{
+	/* The ranges, sorted by start offset
+	 */
+	libbfoverlay_range_t *ranges;
+
+	/* The number of ranges
+	 */
+	int number_of_ranges;
+};
+
+int libbfoverlay_range_map_initialize(
+     libbfoverlay_range_map_t **range_map,
+     int number_of_ranges,
+     libcerror_error_t **error );
+
+int libbfoverlay_range_map_free(
+     libbfoverlay_range_map_t **range_map,
+     libcerror_error_t **error );
+
+int libbfoverlay_range_map_get_number_of_ranges(
+     libbfoverlay_range_map_t *range_map,
+     int *number_of_ranges,
+     libcerror_error_t **error );
+
+int libbfoverlay_range_map_get_range_by_index(
+     libbfoverlay_range_map_t *range_map,
+     int range_index,
+     libbfoverlay_range_t **range,
+     libcerror_error_t **error );
+
+int libbfoverlay_range_map_set_range_by_index(
+     libbfoverlay_range_map_t *range_map,
+     int range_index,
+     const libbfoverlay_range_t *range,
+     libcerror_error_t **error );
+
+int libbfoverlay_range_map_get_range_at_offset(
+     libbfoverlay_range_map_t *range_map,
+     off64_t offset,
+     int *range_index,
+     libbfoverlay_range_t **range,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBFOVERLAY_RANGE_MAP_H ) */
+
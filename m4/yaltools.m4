@@ -93,6 +93,12 @@ AC_DEFUN([AX_BFOVERLAYTOOLS_CHECK_LOCAL],
     [AC_CHECK_FUNCS([clock_gettime getegid geteuid time])
   ])
 
+  dnl Functions included in bfoverlaytools/replay_handle.c
+  AS_IF(
+    [test "x$ac_cv_enable_winapi" = xno],
+    [AC_CHECK_FUNCS([nanosleep])
+  ])
+
   AX_TOOLS_CHECK_ENABLE_MINGW_BINMODE
 ])
 
@@ -0,0 +1,1490 @@
+/*
+ * Benchmarks of the range and COW lookup functions
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#endif
+
+#include <time.h>
+
+#include "bfoverlay_test_getopt.h"
+#include "bfoverlay_test_libbfoverlay.h"
+#include "bfoverlay_test_libcerror.h"
+#include "bfoverlay_test_workload.h"
+
+#include "../libbfoverlay/libbfoverlay_cow_file.h"
+#include "../libbfoverlay/libbfoverlay_descriptor_file.h"
+#include "../libbfoverlay/libbfoverlay_handle.h"
+#include "../libbfoverlay/libbfoverlay_layer.h"
+#include "../libbfoverlay/libbfoverlay_libcdata.h"
+#include "../libbfoverlay/libbfoverlay_range.h"
+#include "../libbfoverlay/libbfoverlay_range_map.h"
+
+#define BFOVERLAY_TEST_BENCHMARK_ACCESS_PATTERN_SEQUENTIAL	's'
+#define BFOVERLAY_TEST_BENCHMARK_ACCESS_PATTERN_RANDOM		'r'
+
+#define BFOVERLAY_TEST_BENCHMARK_MEDIA_SIZE			( (size64_t) 1024 * 1024 * 1024 )
+
+#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+
+/* Retrieves a monotonic timestamp
+ * The timestamp is in number of nanoseconds
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_benchmark_get_timestamp(
+     uint64_t *timestamp,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	struct timespec time_structure;
+#endif
+
+	static char *function = "bfoverlay_test_benchmark_get_timestamp";
+
+#if !defined( WINAPI ) && !defined( HAVE_CLOCK_GETTIME )
+	time_t time_value     = 0;
+#endif
+
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve performance counter.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) ( counter.QuadPart / frequency.QuadPart ) * 1000000000 )
+	           + ( ( (uint64_t) ( counter.QuadPart % frequency.QuadPart ) * 1000000000 ) / (uint64_t) frequency.QuadPart );
+
+#elif defined( HAVE_CLOCK_GETTIME )
+#if defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+#else
+	if( clock_gettime(
+	     CLOCK_REALTIME,
+	     &time_structure ) != 0 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time structure.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) time_structure.tv_sec * 1000000000 ) + (uint64_t) time_structure.tv_nsec;
+
+#else
+	time_value = time(
+	              NULL );
+
+	if( time_value == (time_t) -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = (uint64_t) time_value * 1000000000;
+
+#endif /* defined( WINAPI ) */
+
+	return( 1 );
+}
+
+/* Retrieves the number of read and write system calls made by the process
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int bfoverlay_test_benchmark_get_number_of_system_calls(
+     uint64_t *number_of_system_calls,
+     libcerror_error_t **error )
+{
+#if defined( __linux__ )
+	char line[ 128 ];
+
+	FILE *file_stream    = NULL;
+	uint64_t value_64bit = 0;
+	size_t line_index    = 0;
+#endif
+
+	static char *function = "bfoverlay_test_benchmark_get_number_of_system_calls";
+
+	if( number_of_system_calls == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of system calls.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_system_calls = 0;
+
+#if defined( __linux__ )
+	/* The syscr and syscw values in /proc/self/io contain the number of
+	 * read and write system calls
+	 */
+	file_stream = file_stream_open(
+	               "/proc/self/io",
+	               FILE_STREAM_OPEN_READ );
+
+	if( file_stream == NULL )
+	{
+		return( 0 );
+	}
+	while( file_stream_get_string(
+	        file_stream,
+	        line,
+	        128 ) != NULL )
+	{
+		if( ( narrow_string_compare(
+		       line,
+		       "syscr: ",
+		       7 ) != 0 )
+		 && ( narrow_string_compare(
+		       line,
+		       "syscw: ",
+		       7 ) != 0 ) )
+		{
+			continue;
+		}
+		value_64bit = 0;
+
+		for( line_index = 7;
+		     line_index < 128;
+		     line_index++ )
+		{
+			if( ( line[ line_index ] < '0' )
+			 || ( line[ line_index ] > '9' ) )
+			{
+				break;
+			}
+			value_64bit *= 10;
+			value_64bit += (uint64_t) ( line[ line_index ] - '0' );
+		}
+		*number_of_system_calls += value_64bit;
+	}
+	file_stream_close(
+	 file_stream );
+
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Retrieves the next pseudo random value
+ * Returns the pseudo random value
+ */
+uint64_t bfoverlay_test_benchmark_get_random_value(
+          uint64_t *random_state )
+{
+	*random_state ^= *random_state >> 12;
+	*random_state ^= *random_state << 25;
+	*random_state ^= *random_state >> 27;
+
+	return( *random_state * 0x2545f4914f6cdd1dULL );
+}
+
+/* Creates the offsets accessed by a benchmark
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_benchmark_initialize_offsets(
+     off64_t **offsets,
+     int number_of_operations,
+     size64_t media_size,
+     size_t step_size,
+     int access_pattern,
+     libcerror_error_t **error )
+{
+	static char *function  = "bfoverlay_test_benchmark_initialize_offsets";
+	uint64_t random_state  = 0x9e3779b97f4a7c15ULL;
+	off64_t current_offset = 0;
+	int operation_index    = 0;
+
+	if( offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_operations <= 0 )
+	 || ( (size_t) number_of_operations > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( off64_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of operations value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( media_size == 0 )
+	 || ( step_size == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media or step size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*offsets = (off64_t *) memory_allocate(
+	                        sizeof( off64_t ) * number_of_operations );
+
+	if( *offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create offsets.",
+		 function );
+
+		return( -1 );
+	}
+	for( operation_index = 0;
+	     operation_index < number_of_operations;
+	     operation_index++ )
+	{
+		if( access_pattern == BFOVERLAY_TEST_BENCHMARK_ACCESS_PATTERN_RANDOM )
+		{
+			current_offset = (off64_t) ( bfoverlay_test_benchmark_get_random_value(
+			                              &random_state ) % media_size );
+		}
+		( *offsets )[ operation_index ] = current_offset;
+
+		current_offset += step_size;
+
+		if( current_offset >= (off64_t) media_size )
+		{
+			current_offset = 0;
+		}
+	}
+	return( 1 );
+}
+
+/* Prints the result of a benchmark
+ */
+void bfoverlay_test_benchmark_result_fprint(
+      FILE *stream,
+      const char *function_name,
+      const char *parameters,
+      int number_of_operations,
+      uint64_t elapsed_time,
+      uint64_t number_of_system_calls,
+      int has_system_calls )
+{
+	if( ( stream == NULL )
+	 || ( number_of_operations <= 0 ) )
+	{
+		return;
+	}
+	fprintf(
+	 stream,
+	 "%s: %s: %.1f ns/op",
+	 function_name,
+	 parameters,
+	 (double) elapsed_time / (double) number_of_operations );
+
+	if( has_system_calls != 0 )
+	{
+		fprintf(
+		 stream,
+		 ", %.3f syscalls/op",
+		 (double) number_of_system_calls / (double) number_of_operations );
+	}
+	fprintf(
+	 stream,
+	 "\n" );
+}
+
+/* Frees a handle created by bfoverlay_test_benchmark_initialize_ranges_handle
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_benchmark_free_ranges_handle(
+     libbfoverlay_handle_t **handle,
+     libcerror_error_t **error )
+{
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "bfoverlay_test_benchmark_free_ranges_handle";
+	int result                                      = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *handle == NULL )
+	{
+		return( 1 );
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) *handle;
+
+	/* The handle was not opened hence the range map and descriptor file
+	 * are not freed by libbfoverlay_handle_free
+	 */
+	if( internal_handle->range_map != NULL )
+	{
+		if( libbfoverlay_range_map_free(
+		     &( internal_handle->range_map ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free range map.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->descriptor_file != NULL )
+	{
+		if( libbfoverlay_descriptor_file_free(
+		     &( internal_handle->descriptor_file ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free descriptor file.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libbfoverlay_handle_free(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Creates a handle with a descriptor file that contains layers spread over the media
+ * The base layer is followed by number_of_layers non-overlapping layers, which
+ * results in ( 2 * number_of_layers ) + 1 ranges
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_benchmark_initialize_ranges_handle(
+     libbfoverlay_handle_t **handle,
+     size64_t media_size,
+     int number_of_layers,
+     libcerror_error_t **error )
+{
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	libbfoverlay_layer_t *layer                     = NULL;
+	static char *function                           = "bfoverlay_test_benchmark_initialize_ranges_handle";
+	size64_t stride_size                            = 0;
+	int entry_index                                 = 0;
+	int layer_index                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_layers <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of layers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	stride_size = ( media_size / number_of_layers ) & ~( (size64_t) 511 );
+
+	if( stride_size < 1024 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfoverlay_handle_initialize(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize handle.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) *handle;
+
+	if( libbfoverlay_descriptor_file_initialize(
+	     &( internal_handle->descriptor_file ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize descriptor file.",
+		 function );
+
+		goto on_error;
+	}
+	/* The layers are added directly since the descriptor file format
+	 * supports a limited number of layers
+	 */
+	for( layer_index = 0;
+	     layer_index <= number_of_layers;
+	     layer_index++ )
+	{
+		if( libbfoverlay_layer_initialize(
+		     &layer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create layer: %d.",
+			 function,
+			 layer_index );
+
+			goto on_error;
+		}
+		if( layer_index == 0 )
+		{
+			layer->offset = 0;
+			layer->size   = (int64_t) media_size;
+		}
+		else
+		{
+			layer->offset = (off64_t) ( stride_size * ( layer_index - 1 ) ) + (off64_t) ( stride_size / 4 );
+			layer->size   = (int64_t) ( stride_size / 2 );
+		}
+		if( libcdata_array_append_entry(
+		     internal_handle->descriptor_file->layers_array,
+		     &entry_index,
+		     (intptr_t *) layer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append layer: %d.",
+			 function,
+			 layer_index );
+
+			goto on_error;
+		}
+		layer = NULL;
+	}
+	internal_handle->size = media_size;
+
+	return( 1 );
+
+on_error:
+	if( layer != NULL )
+	{
+		libbfoverlay_layer_free(
+		 &layer,
+		 NULL );
+	}
+	bfoverlay_test_benchmark_free_ranges_handle(
+	 handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Benchmarks the libbfoverlay_internal_handle_open_determine_ranges function
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_benchmark_determine_ranges(
+     int number_of_layers,
+     libcerror_error_t **error )
+{
+	char parameters[ 128 ];
+
+	libbfoverlay_handle_t *handle                   = NULL;
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "bfoverlay_test_benchmark_determine_ranges";
+	uint64_t end_number_of_system_calls             = 0;
+	uint64_t end_timestamp                          = 0;
+	uint64_t start_number_of_system_calls           = 0;
+	uint64_t start_timestamp                        = 0;
+	int has_system_calls                            = 0;
+	int iteration                                   = 0;
+	int number_of_iterations                        = 0;
+	int number_of_ranges                            = 0;
+
+	if( bfoverlay_test_benchmark_initialize_ranges_handle(
+	     &handle,
+	     BFOVERLAY_TEST_BENCHMARK_MEDIA_SIZE,
+	     number_of_layers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize handle.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	/* Determining the ranges scales quadratically with the number of layers
+	 */
+	number_of_iterations = 1 + ( 1048576 / ( number_of_layers * number_of_layers ) );
+
+	if( number_of_iterations > 1000 )
+	{
+		number_of_iterations = 1000;
+	}
+	has_system_calls = bfoverlay_test_benchmark_get_number_of_system_calls(
+	                    &start_number_of_system_calls,
+	                    error );
+
+	if( has_system_calls == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of system calls.",
+		 function );
+
+		goto on_error;
+	}
+	if( bfoverlay_test_benchmark_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	for( iteration = 0;
+	     iteration < number_of_iterations;
+	     iteration++ )
+	{
+		if( internal_handle->range_map != NULL )
+		{
+			if( libbfoverlay_range_map_free(
+			     &( internal_handle->range_map ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free range map.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libbfoverlay_internal_handle_open_determine_ranges(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine ranges.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( bfoverlay_test_benchmark_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	if( has_system_calls == 1 )
+	{
+		if( bfoverlay_test_benchmark_get_number_of_system_calls(
+		     &end_number_of_system_calls,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of system calls.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libbfoverlay_range_map_get_number_of_ranges(
+	     internal_handle->range_map,
+	     &number_of_ranges,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of ranges.",
+		 function );
+
+		goto on_error;
+	}
+	narrow_string_snprintf(
+	 parameters,
+	 128,
+	 "layers: %d, ranges: %d",
+	 number_of_layers + 1,
+	 number_of_ranges );
+
+	bfoverlay_test_benchmark_result_fprint(
+	 stdout,
+	 "libbfoverlay_internal_handle_open_determine_ranges",
+	 parameters,
+	 number_of_iterations,
+	 end_timestamp - start_timestamp,
+	 end_number_of_system_calls - start_number_of_system_calls,
+	 has_system_calls );
+
+	if( bfoverlay_test_benchmark_free_ranges_handle(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	bfoverlay_test_benchmark_free_ranges_handle(
+	 &handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Benchmarks the libbfoverlay_internal_handle_get_range_at_offset function
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_benchmark_get_range_at_offset(
+     int number_of_layers,
+     int access_pattern,
+     int number_of_operations,
+     libcerror_error_t **error )
+{
+	char parameters[ 128 ];
+
+	libbfoverlay_handle_t *handle                   = NULL;
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	libbfoverlay_range_t *range                     = NULL;
+	off64_t *offsets                                = NULL;
+	static char *function                           = "bfoverlay_test_benchmark_get_range_at_offset";
+	uint64_t end_number_of_system_calls             = 0;
+	uint64_t end_timestamp                          = 0;
+	uint64_t start_number_of_system_calls           = 0;
+	uint64_t start_timestamp                        = 0;
+	int has_system_calls                            = 0;
+	int number_of_ranges                            = 0;
+	int number_of_ranges_found                      = 0;
+	int operation_index                             = 0;
+	int range_index                                 = 0;
+	int result                                      = 0;
+
+	if( bfoverlay_test_benchmark_initialize_ranges_handle(
+	     &handle,
+	     BFOVERLAY_TEST_BENCHMARK_MEDIA_SIZE,
+	     number_of_layers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize handle.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	if( libbfoverlay_internal_handle_open_determine_ranges(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine ranges.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_range_map_get_number_of_ranges(
+	     internal_handle->range_map,
+	     &number_of_ranges,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of ranges.",
+		 function );
+
+		goto on_error;
+	}
+	if( bfoverlay_test_benchmark_initialize_offsets(
+	     &offsets,
+	     number_of_operations,
+	     BFOVERLAY_TEST_BENCHMARK_MEDIA_SIZE,
+	     4096,
+	     access_pattern,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize offsets.",
+		 function );
+
+		goto on_error;
+	}
+	has_system_calls = bfoverlay_test_benchmark_get_number_of_system_calls(
+	                    &start_number_of_system_calls,
+	                    error );
+
+	if( has_system_calls == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of system calls.",
+		 function );
+
+		goto on_error;
+	}
+	if( bfoverlay_test_benchmark_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	for( operation_index = 0;
+	     operation_index < number_of_operations;
+	     operation_index++ )
+	{
+		result = libbfoverlay_internal_handle_get_range_at_offset(
+		          internal_handle,
+		          offsets[ operation_index ],
+		          &range_index,
+		          &range,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range at offset: %" PRIi64 ".",
+			 function,
+			 offsets[ operation_index ] );
+
+			goto on_error;
+		}
+		number_of_ranges_found += result;
+	}
+	if( bfoverlay_test_benchmark_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	if( has_system_calls == 1 )
+	{
+		if( bfoverlay_test_benchmark_get_number_of_system_calls(
+		     &end_number_of_system_calls,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of system calls.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( number_of_ranges_found != number_of_operations )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of ranges found value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	narrow_string_snprintf(
+	 parameters,
+	 128,
+	 "ranges: %d, access pattern: %s",
+	 number_of_ranges,
+	 ( access_pattern == BFOVERLAY_TEST_BENCHMARK_ACCESS_PATTERN_RANDOM ) ? "random" : "sequential" );
+
+	bfoverlay_test_benchmark_result_fprint(
+	 stdout,
+	 "libbfoverlay_internal_handle_get_range_at_offset",
+	 parameters,
+	 number_of_operations,
+	 end_timestamp - start_timestamp,
+	 end_number_of_system_calls - start_number_of_system_calls,
+	 has_system_calls );
+
+	memory_free(
+	 offsets );
+
+	offsets = NULL;
+
+	if( bfoverlay_test_benchmark_free_ranges_handle(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( offsets != NULL )
+	{
+		memory_free(
+		 offsets );
+	}
+	bfoverlay_test_benchmark_free_ranges_handle(
+	 &handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Benchmarks the libbfoverlay_cow_file_get_block_at_offset function
+ * A COW file is generated of which half of the blocks are pre-populated in random order
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_benchmark_cow_file_get_block_at_offset(
+     size64_t media_size,
+     size32_t block_size,
+     int access_pattern,
+     int number_of_operations,
+     libcerror_error_t **error )
+{
+	char parameters[ 128 ];
+
+	bfoverlay_test_workload_t *workload             = NULL;
+	libbfoverlay_handle_t *handle                   = NULL;
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	off64_t *offsets                                = NULL;
+	static char *function                           = "bfoverlay_test_benchmark_cow_file_get_block_at_offset";
+	uint64_t end_number_of_system_calls             = 0;
+	uint64_t end_timestamp                          = 0;
+	uint64_t start_number_of_system_calls           = 0;
+	uint64_t start_timestamp                        = 0;
+	uint32_t blocks_per_entry                       = 0;
+	off64_t file_offset                             = 0;
+	off64_t range_end_offset                        = 0;
+	off64_t range_start_offset                      = 0;
+	int depth                                       = 0;
+	int has_system_calls                            = 0;
+	int number_of_blocks_found                      = 0;
+	int operation_index                             = 0;
+	int result                                      = 0;
+
+	if( bfoverlay_test_workload_initialize(
+	     &workload,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize workload.",
+		 function );
+
+		goto on_error;
+	}
+	workload->media_size              = media_size;
+	workload->number_of_sparse_layers = 1;
+	workload->use_cow                 = 1;
+	workload->cow_block_size          = block_size;
+	workload->cow_fill_percentage     = 50;
+	workload->cow_fragmented          = 1;
+
+	if( bfoverlay_test_workload_generate(
+	     workload,
+	     "bfoverlay_test_benchmark",
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to generate workload.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_handle_open(
+	     handle,
+	     "bfoverlay_test_benchmark.bfoverlay",
+	     LIBBFOVERLAY_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_handle_open_data_files(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open data files.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	if( internal_handle->cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing COW file.",
+		 function );
+
+		goto on_error;
+	}
+	/* Determine the depth of the allocation table in the same way as the lookup
+	 */
+	blocks_per_entry = internal_handle->cow_file->number_of_allocated_blocks / internal_handle->cow_file->l1_allocation_table_block->number_of_entries;
+
+	do
+	{
+		blocks_per_entry /= (uint32_t) internal_handle->cow_file->l1_allocation_table_block->number_of_entries;
+		depth++;
+	}
+	while( blocks_per_entry > 0 );
+
+	if( bfoverlay_test_benchmark_initialize_offsets(
+	     &offsets,
+	     number_of_operations,
+	     media_size,
+	     block_size,
+	     access_pattern,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize offsets.",
+		 function );
+
+		goto on_error;
+	}
+	has_system_calls = bfoverlay_test_benchmark_get_number_of_system_calls(
+	                    &start_number_of_system_calls,
+	                    error );
+
+	if( has_system_calls == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of system calls.",
+		 function );
+
+		goto on_error;
+	}
+	if( bfoverlay_test_benchmark_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	for( operation_index = 0;
+	     operation_index < number_of_operations;
+	     operation_index++ )
+	{
+		result = libbfoverlay_cow_file_get_block_at_offset(
+		          internal_handle->cow_file,
+		          internal_handle->data_file_io_pool,
+		          internal_handle->cow_file_io_pool_entry,
+		          offsets[ operation_index ],
+		          &range_start_offset,
+		          &range_end_offset,
+		          &file_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block at offset: %" PRIi64 ".",
+			 function,
+			 offsets[ operation_index ] );
+
+			goto on_error;
+		}
+		number_of_blocks_found += result;
+	}
+	if( bfoverlay_test_benchmark_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	if( has_system_calls == 1 )
+	{
+		if( bfoverlay_test_benchmark_get_number_of_system_calls(
+		     &end_number_of_system_calls,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of system calls.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	narrow_string_snprintf(
+	 parameters,
+	 128,
+	 "block size: %" PRIu32 ", table depth: %d, blocks found: %d%%, access pattern: %s",
+	 block_size,
+	 depth,
+	 (int) ( ( (int64_t) number_of_blocks_found * 100 ) / number_of_operations ),
+	 ( access_pattern == BFOVERLAY_TEST_BENCHMARK_ACCESS_PATTERN_RANDOM ) ? "random" : "sequential" );
+
+	bfoverlay_test_benchmark_result_fprint(
+	 stdout,
+	 "libbfoverlay_cow_file_get_block_at_offset",
+	 parameters,
+	 number_of_operations,
+	 end_timestamp - start_timestamp,
+	 end_number_of_system_calls - start_number_of_system_calls,
+	 has_system_calls );
+
+	memory_free(
+	 offsets );
+
+	offsets = NULL;
+
+	if( libbfoverlay_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( bfoverlay_test_workload_free(
+	     &workload,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free workload.",
+		 function );
+
+		goto on_error;
+	}
+	remove(
+	 "bfoverlay_test_benchmark.bfoverlay" );
+	remove(
+	 "bfoverlay_test_benchmark.cow" );
+
+	return( 1 );
+
+on_error:
+	if( offsets != NULL )
+	{
+		memory_free(
+		 offsets );
+	}
+	if( handle != NULL )
+	{
+		libbfoverlay_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( workload != NULL )
+	{
+		bfoverlay_test_workload_free(
+		 &workload,
+		 NULL );
+	}
+	remove(
+	 "bfoverlay_test_benchmark.bfoverlay" );
+	remove(
+	 "bfoverlay_test_benchmark.cow" );
+
+	return( -1 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+	int access_patterns[ 2 ]      = {
+		BFOVERLAY_TEST_BENCHMARK_ACCESS_PATTERN_SEQUENTIAL,
+		BFOVERLAY_TEST_BENCHMARK_ACCESS_PATTERN_RANDOM };
+
+	int numbers_of_layers[ 5 ]    = { 1, 16, 256, 1024, 4096 };
+	size32_t cow_block_sizes[ 3 ] = { 65536, 4096, 512 };
+	size64_t cow_media_sizes[ 3 ] = { 64 * 1024 * 1024, 64 * 1024 * 1024, 16 * 1024 * 1024 };
+
+	libcerror_error_t *error      = NULL;
+	int access_pattern_index      = 0;
+#endif
+
+	system_integer_t option       = 0;
+	int index                     = 0;
+	int number_of_operations      = 1000000;
+
+	while( ( option = bfoverlay_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "n:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'n':
+				number_of_operations = 0;
+
+				for( index = 0;
+				     optarg[ index ] != 0;
+				     index++ )
+				{
+					if( ( optarg[ index ] < (system_character_t) '0' )
+					 || ( optarg[ index ] > (system_character_t) '9' )
+					 || ( number_of_operations > ( ( INT_MAX - 9 ) / 10 ) ) )
+					{
+						fprintf(
+						 stderr,
+						 "Unsupported number of operations.\n" );
+
+						return( EXIT_FAILURE );
+					}
+					number_of_operations *= 10;
+					number_of_operations += (int) ( optarg[ index ] - (system_character_t) '0' );
+				}
+				if( number_of_operations == 0 )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported number of operations.\n" );
+
+					return( EXIT_FAILURE );
+				}
+				break;
+		}
+	}
+#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+	for( index = 0;
+	     index < 5;
+	     index++ )
+	{
+		if( bfoverlay_test_benchmark_determine_ranges(
+		     numbers_of_layers[ index ],
+		     &error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	for( index = 0;
+	     index < 5;
+	     index++ )
+	{
+		for( access_pattern_index = 0;
+		     access_pattern_index < 2;
+		     access_pattern_index++ )
+		{
+			if( bfoverlay_test_benchmark_get_range_at_offset(
+			     numbers_of_layers[ index ],
+			     access_patterns[ access_pattern_index ],
+			     number_of_operations,
+			     &error ) != 1 )
+			{
+				goto on_error;
+			}
+		}
+	}
+	for( index = 0;
+	     index < 3;
+	     index++ )
+	{
+		for( access_pattern_index = 0;
+		     access_pattern_index < 2;
+		     access_pattern_index++ )
+		{
+			if( bfoverlay_test_benchmark_cow_file_get_block_at_offset(
+			     cow_media_sizes[ index ],
+			     cow_block_sizes[ index ],
+			     access_patterns[ access_pattern_index ],
+			     number_of_operations,
+			     &error ) != 1 )
+			{
+				goto on_error;
+			}
+		}
+	}
+#endif /* defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( EXIT_FAILURE );
+#endif
+}
+
@@ -39,9 +39,9 @@
 #include "../libbfoverlay/libbfoverlay_cow_allocation_table_block.h"
 
 uint8_t bfoverlay_test_cow_allocation_table_block_data1[ 64 ] = {
+	0x23, 0x20, 0x42, 0x46, 0x4f, 0x2d, 0x43, 0x4f, 0x57, 0x2d, 0x41, 0x42, 0x01, 0x34, 0x64, 0x1c,
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
 
 #if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
@@ -57,8 +57,8 @@ int bfoverlay_test_cow_allocation_table_block_initialize(
 	int result                                                            = 0;
 
 #if defined( HAVE_BFOVERLAY_TEST_MEMORY )
-	int number_of_malloc_fail_tests                                       = 1;
-	int number_of_memset_fail_tests                                       = 1;
+	int number_of_malloc_fail_tests                                       = 2;
+	int number_of_memset_fail_tests                                       = 2;
 	int test_number                                                       = 0;
 #endif
 
@@ -284,36 +284,706 @@ on_error:
 	return( 0 );
 }
 
-#endif /* defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT ) */
+/* Tests the libbfoverlay_cow_allocation_table_block_read_data function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_cow_allocation_table_block_read_data(
+     void )
+{
+	libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block = NULL;
+	libcerror_error_t *error                                              = NULL;
+	int result                                                            = 0;
 
-/* The main program
+	/* Initialize test
+	 */
+	result = libbfoverlay_cow_allocation_table_block_initialize(
+	          &cow_allocation_table_block,
+	          64,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "cow_allocation_table_block",
+	 cow_allocation_table_block );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_cow_allocation_table_block_read_data(
+	          cow_allocation_table_block,
+	          bfoverlay_test_cow_allocation_table_block_data1,
+	          64,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_cow_allocation_table_block_read_data(
+	          NULL,
+	          bfoverlay_test_cow_allocation_table_block_data1,
+	          64,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_allocation_table_block_read_data(
+	          cow_allocation_table_block,
+	          NULL,
+	          64,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_allocation_table_block_read_data(
+	          cow_allocation_table_block,
+	          bfoverlay_test_cow_allocation_table_block_data1,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_allocation_table_block_read_data(
+	          cow_allocation_table_block,
+	          bfoverlay_test_cow_allocation_table_block_data1,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where signature is invalid
+	 */
+	bfoverlay_test_cow_allocation_table_block_data1[ 0 ] = '!';
+
+	result = libbfoverlay_cow_allocation_table_block_read_data(
+	          cow_allocation_table_block,
+	          bfoverlay_test_cow_allocation_table_block_data1,
+	          64,
+	          &error );
+
+	bfoverlay_test_cow_allocation_table_block_data1[ 0 ] = '#';
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_cow_allocation_table_block_free(
+	          &cow_allocation_table_block,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "cow_allocation_table_block",
+	 cow_allocation_table_block );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cow_allocation_table_block != NULL )
+	{
+		libbfoverlay_cow_allocation_table_block_free(
+		 &cow_allocation_table_block,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_cow_allocation_table_block_clear function
+ * Returns 1 if successful or 0 if not
  */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-int wmain(
-     int argc BFOVERLAY_TEST_ATTRIBUTE_UNUSED,
-     wchar_t * const argv[] BFOVERLAY_TEST_ATTRIBUTE_UNUSED )
-#else
-int main(
-     int argc BFOVERLAY_TEST_ATTRIBUTE_UNUSED,
-     char * const argv[] BFOVERLAY_TEST_ATTRIBUTE_UNUSED )
-#endif
+int bfoverlay_test_cow_allocation_table_block_clear(
+     void )
 {
-	BFOVERLAY_TEST_UNREFERENCED_PARAMETER( argc )
-	BFOVERLAY_TEST_UNREFERENCED_PARAMETER( argv )
+	libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block = NULL;
+	libcerror_error_t *error                                              = NULL;
+	uint32_t block_number                                                 = 0;
+	int result                                                            = 0;
 
-#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+	/* Initialize test
+	 */
+	result = libbfoverlay_cow_allocation_table_block_initialize(
+	          &cow_allocation_table_block,
+	          64,
+	          &error );
 
-	BFOVERLAY_TEST_RUN(
-	 "libbfoverlay_cow_allocation_table_block_initialize",
-	 bfoverlay_test_cow_allocation_table_block_initialize );
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	BFOVERLAY_TEST_RUN(
-	 "libbfoverlay_cow_allocation_table_block_free",
-	 bfoverlay_test_cow_allocation_table_block_free );
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "cow_allocation_table_block",
+	 cow_allocation_table_block );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* TODO add tests for libbfoverlay_cow_allocation_table_block_get_block_number_by_index */
+	result = libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
+	          cow_allocation_table_block,
+	          0,
+	          2,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_cow_allocation_table_block_clear(
+	          cow_allocation_table_block,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
+	          cow_allocation_table_block,
+	          0,
+	          &block_number,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "block_number",
+	 block_number,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_cow_allocation_table_block_clear(
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_cow_allocation_table_block_free(
+	          &cow_allocation_table_block,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	/* TODO add tests for libbfoverlay_cow_allocation_table_block_set_block_number_by_index */
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "cow_allocation_table_block",
+	 cow_allocation_table_block );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cow_allocation_table_block != NULL )
+	{
+		libbfoverlay_cow_allocation_table_block_free(
+		 &cow_allocation_table_block,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_cow_allocation_table_block_get_block_number_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_cow_allocation_table_block_get_block_number_by_index(
+     void )
+{
+	libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block = NULL;
+	libcerror_error_t *error                                              = NULL;
+	uint32_t block_number                                                 = 0;
+	int result                                                            = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_cow_allocation_table_block_initialize(
+	          &cow_allocation_table_block,
+	          64,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "cow_allocation_table_block",
+	 cow_allocation_table_block );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_cow_allocation_table_block_read_data(
+	          cow_allocation_table_block,
+	          bfoverlay_test_cow_allocation_table_block_data1,
+	          64,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
+	          cow_allocation_table_block,
+	          0,
+	          &block_number,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "block_number",
+	 block_number,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
+	          NULL,
+	          0,
+	          &block_number,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
+	          cow_allocation_table_block,
+	          -1,
+	          &block_number,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
+	          cow_allocation_table_block,
+	          8,
+	          &block_number,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
+	          cow_allocation_table_block,
+	          0,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_cow_allocation_table_block_free(
+	          &cow_allocation_table_block,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "cow_allocation_table_block",
+	 cow_allocation_table_block );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cow_allocation_table_block != NULL )
+	{
+		libbfoverlay_cow_allocation_table_block_free(
+		 &cow_allocation_table_block,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_cow_allocation_table_block_set_block_number_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_cow_allocation_table_block_set_block_number_by_index(
+     void )
+{
+	libbfoverlay_cow_allocation_table_block_t *cow_allocation_table_block = NULL;
+	libcerror_error_t *error                                              = NULL;
+	uint32_t block_number                                                 = 0;
+	int result                                                            = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_cow_allocation_table_block_initialize(
+	          &cow_allocation_table_block,
+	          64,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "cow_allocation_table_block",
+	 cow_allocation_table_block );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
+	          cow_allocation_table_block,
+	          7,
+	          0x12345678,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_cow_allocation_table_block_get_block_number_by_index(
+	          cow_allocation_table_block,
+	          7,
+	          &block_number,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "block_number",
+	 block_number,
+	 0x12345678 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
+	          NULL,
+	          0,
+	          1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
+	          cow_allocation_table_block,
+	          -1,
+	          1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
+	          cow_allocation_table_block,
+	          8,
+	          1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_cow_allocation_table_block_free(
+	          &cow_allocation_table_block,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "cow_allocation_table_block",
+	 cow_allocation_table_block );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cow_allocation_table_block != NULL )
+	{
+		libbfoverlay_cow_allocation_table_block_free(
+		 &cow_allocation_table_block,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BFOVERLAY_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BFOVERLAY_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BFOVERLAY_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BFOVERLAY_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BFOVERLAY_TEST_UNREFERENCED_PARAMETER( argc )
+	BFOVERLAY_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_allocation_table_block_initialize",
+	 bfoverlay_test_cow_allocation_table_block_initialize );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_allocation_table_block_free",
+	 bfoverlay_test_cow_allocation_table_block_free );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_allocation_table_block_read_data",
+	 bfoverlay_test_cow_allocation_table_block_read_data );
+
+	/* TODO add tests for libbfoverlay_cow_allocation_table_block_read_file_io_pool */
+
+	/* TODO add tests for libbfoverlay_cow_allocation_table_block_write_file_io_pool */
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_allocation_table_block_clear",
+	 bfoverlay_test_cow_allocation_table_block_clear );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_allocation_table_block_get_block_number_by_index",
+	 bfoverlay_test_cow_allocation_table_block_get_block_number_by_index );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_allocation_table_block_set_block_number_by_index",
+	 bfoverlay_test_cow_allocation_table_block_set_block_number_by_index );
 
 #endif /* defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT ) */
 
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -35,10 +36,173 @@
 #include "bfoverlay_test_memory.h"
 #include "bfoverlay_test_unused.h"
 
+#include "../libbfoverlay/libbfoverlay_cow_allocation_table_block.h"
 #include "../libbfoverlay/libbfoverlay_cow_file.h"
+#include "../libbfoverlay/libbfoverlay_definitions.h"
+#include "../libbfoverlay/libbfoverlay_libcdata.h"
+#include "../libbfoverlay/libbfoverlay_libcthreads.h"
 
 #if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
 
+#define BFOVERLAY_TEST_COW_FILE_NUMBER_OF_THREADS	4
+#define BFOVERLAY_TEST_COW_FILE_NUMBER_OF_LOOKUPS	64
+
+typedef struct bfoverlay_test_cow_file_lookup_worker bfoverlay_test_cow_file_lookup_worker_t;
+
+struct bfoverlay_test_cow_file_lookup_worker
+{
+	/* The COW file
+	 */
+	libbfoverlay_cow_file_t *cow_file;
+
+	/* The result of the lookups
+	 */
+	int result;
+};
+
+/* Sets up a COW file with a 2 level allocation table where the level 2 allocation table block is cached
+ * The level 1 entry 0 refers to level 2 allocation table block 1, in which the even entries refer to
+ * data block: entry + 2 and the odd entries to zero blocks. The other level 1 entries are not set.
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_cow_file_set_up_allocation_table(
+     libbfoverlay_cow_file_t *cow_file,
+     libcerror_error_t **error )
+{
+	libbfoverlay_cow_allocation_table_block_t *allocation_table_block = NULL;
+	static char *function                                            = "bfoverlay_test_cow_file_set_up_allocation_table";
+	uint32_t block_number                                            = 0;
+	int entry_index                                                  = 0;
+
+	if( cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid COW file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfoverlay_cow_allocation_table_block_initialize(
+	     &( cow_file->l1_allocation_table_block ),
+	     cow_file->block_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create level 1 COW allocation table block.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
+	     cow_file->l1_allocation_table_block,
+	     0,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set level 1 COW allocation table entry: 0.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_cow_allocation_table_block_initialize(
+	     &allocation_table_block,
+	     cow_file->block_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create level 2 COW allocation table block.",
+		 function );
+
+		goto on_error;
+	}
+	allocation_table_block->block_number = 1;
+
+	for( entry_index = 0;
+	     entry_index < allocation_table_block->number_of_entries;
+	     entry_index++ )
+	{
+		if( ( entry_index % 2 ) == 0 )
+		{
+			block_number = (uint32_t) entry_index + 2;
+		}
+		else
+		{
+			block_number = LIBBFOVERLAY_COW_BLOCK_NUMBER_ZERO;
+		}
+		if( libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
+		     allocation_table_block,
+		     entry_index,
+		     block_number,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set level 2 COW allocation table entry: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+	}
+	if( libcdata_array_initialize(
+	     &( cow_file->allocation_table_block_cache ),
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create allocation table block cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_set_entry_by_index(
+	     cow_file->allocation_table_block_cache,
+	     0,
+	     (intptr_t *) allocation_table_block,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set allocation table block cache entry: 0.",
+		 function );
+
+		goto on_error;
+	}
+	cow_file->number_of_allocated_blocks = (uint32_t) allocation_table_block->number_of_entries * (uint32_t) allocation_table_block->number_of_entries;
+	cow_file->last_data_block_number     = (uint32_t) allocation_table_block->number_of_entries + 1;
+
+	return( 1 );
+
+on_error:
+	if( allocation_table_block != NULL )
+	{
+		libbfoverlay_cow_allocation_table_block_free(
+		 &allocation_table_block,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Tests the libbfoverlay_cow_file_initialize function
  * Returns 1 if successful or 0 if not
  */
@@ -277,36 +441,2623 @@ on_error:
 	return( 0 );
 }
 
-#endif /* defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT ) */
+/* Tests the libbfoverlay_cow_file_get_maximum_cache_size function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_cow_file_get_maximum_cache_size(
+     void )
+{
+	libbfoverlay_cow_file_t *cow_file = NULL;
+	libcerror_error_t *error          = NULL;
+	size_t maximum_cache_size         = 0;
+	int result                        = 0;
 
-/* The main program
+	/* Initialize test
+	 */
+	result = libbfoverlay_cow_file_initialize(
+	          &cow_file,
+	          1024,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_cow_file_get_maximum_cache_size(
+	          cow_file,
+	          &maximum_cache_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SIZE(
+	 "maximum_cache_size",
+	 maximum_cache_size,
+	 (size_t) LIBBFOVERLAY_DEFAULT_MAXIMUM_CACHE_SIZE );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_cow_file_get_maximum_cache_size(
+	          NULL,
+	          &maximum_cache_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_file_get_maximum_cache_size(
+	          cow_file,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_cow_file_free(
+	          &cow_file,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cow_file != NULL )
+	{
+		libbfoverlay_cow_file_free(
+		 &cow_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_cow_file_set_maximum_cache_size function
+ * Returns 1 if successful or 0 if not
  */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-int wmain(
-     int argc BFOVERLAY_TEST_ATTRIBUTE_UNUSED,
-     wchar_t * const argv[] BFOVERLAY_TEST_ATTRIBUTE_UNUSED )
-#else
-int main(
-     int argc BFOVERLAY_TEST_ATTRIBUTE_UNUSED,
-     char * const argv[] BFOVERLAY_TEST_ATTRIBUTE_UNUSED )
-#endif
+int bfoverlay_test_cow_file_set_maximum_cache_size(
+     void )
 {
-	BFOVERLAY_TEST_UNREFERENCED_PARAMETER( argc )
-	BFOVERLAY_TEST_UNREFERENCED_PARAMETER( argv )
+	libbfoverlay_cow_file_t *cow_file = NULL;
+	libcerror_error_t *error          = NULL;
+	size_t maximum_cache_size         = 0;
+	int result                        = 0;
 
-#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+	/* Initialize test
+	 */
+	result = libbfoverlay_cow_file_initialize(
+	          &cow_file,
+	          1024,
+	          &error );
 
-	BFOVERLAY_TEST_RUN(
-	 "libbfoverlay_cow_file_initialize",
-	 bfoverlay_test_cow_file_initialize );
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	BFOVERLAY_TEST_RUN(
-	 "libbfoverlay_cow_file_free",
-	 bfoverlay_test_cow_file_free );
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "cow_file",
+	 cow_file );
 
-	/* TODO add tests for libbfoverlay_cow_file_open_file_io_handle */
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* TODO add tests for libbfoverlay_cow_file_close */
+	/* Test regular cases
+	 */
+	result = libbfoverlay_cow_file_set_maximum_cache_size(
+	          cow_file,
+	          65536,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_cow_file_get_maximum_cache_size(
+	          cow_file,
+	          &maximum_cache_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SIZE(
+	 "maximum_cache_size",
+	 maximum_cache_size,
+	 (size_t) 65536 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_cow_file_set_maximum_cache_size(
+	          NULL,
+	          65536,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_file_set_maximum_cache_size(
+	          cow_file,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_cow_file_free(
+	          &cow_file,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cow_file != NULL )
+	{
+		libbfoverlay_cow_file_free(
+		 &cow_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_cow_file_get_maximum_dirty_size function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_cow_file_get_maximum_dirty_size(
+     void )
+{
+	libbfoverlay_cow_file_t *cow_file = NULL;
+	libcerror_error_t *error          = NULL;
+	size_t maximum_dirty_size         = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_cow_file_initialize(
+	          &cow_file,
+	          1024,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_cow_file_get_maximum_dirty_size(
+	          cow_file,
+	          &maximum_dirty_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SIZE(
+	 "maximum_dirty_size",
+	 maximum_dirty_size,
+	 (size_t) 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_cow_file_get_maximum_dirty_size(
+	          NULL,
+	          &maximum_dirty_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_file_get_maximum_dirty_size(
+	          cow_file,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_cow_file_free(
+	          &cow_file,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cow_file != NULL )
+	{
+		libbfoverlay_cow_file_free(
+		 &cow_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_cow_file_set_maximum_dirty_size function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_cow_file_set_maximum_dirty_size(
+     void )
+{
+	libbfoverlay_cow_file_t *cow_file = NULL;
+	libcerror_error_t *error          = NULL;
+	size_t maximum_dirty_size         = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_cow_file_initialize(
+	          &cow_file,
+	          1024,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_cow_file_set_maximum_dirty_size(
+	          cow_file,
+	          NULL,
+	          0,
+	          65536,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_cow_file_get_maximum_dirty_size(
+	          cow_file,
+	          &maximum_dirty_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SIZE(
+	 "maximum_dirty_size",
+	 maximum_dirty_size,
+	 (size_t) 65536 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_cow_file_set_maximum_dirty_size(
+	          NULL,
+	          NULL,
+	          0,
+	          65536,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_file_set_maximum_dirty_size(
+	          cow_file,
+	          NULL,
+	          0,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_cow_file_free(
+	          &cow_file,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cow_file != NULL )
+	{
+		libbfoverlay_cow_file_free(
+		 &cow_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_cow_file_get_block_size function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_cow_file_get_block_size(
+     void )
+{
+	libbfoverlay_cow_file_t *cow_file = NULL;
+	libcerror_error_t *error          = NULL;
+	size32_t block_size               = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_cow_file_initialize(
+	          &cow_file,
+	          1024,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_cow_file_get_block_size(
+	          cow_file,
+	          &block_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "block_size",
+	 (uint32_t) block_size,
+	 (uint32_t) LIBBFOVERLAY_COW_DEFAULT_BLOCK_SIZE );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_cow_file_get_block_size(
+	          NULL,
+	          &block_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_file_get_block_size(
+	          cow_file,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_cow_file_free(
+	          &cow_file,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cow_file != NULL )
+	{
+		libbfoverlay_cow_file_free(
+		 &cow_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_cow_file_set_block_size function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_cow_file_set_block_size(
+     void )
+{
+	libbfoverlay_cow_file_t *cow_file = NULL;
+	libcerror_error_t *error          = NULL;
+	size32_t block_size               = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_cow_file_initialize(
+	          &cow_file,
+	          1024,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_cow_file_set_block_size(
+	          cow_file,
+	          65536,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_cow_file_get_block_size(
+	          cow_file,
+	          &block_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "block_size",
+	 (uint32_t) block_size,
+	 (uint32_t) 65536 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_cow_file_set_block_size(
+	          NULL,
+	          65536,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_file_set_block_size(
+	          cow_file,
+	          256,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_file_set_block_size(
+	          cow_file,
+	          65535,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_file_set_block_size(
+	          cow_file,
+	          32 * 1024 * 1024,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_cow_file_free(
+	          &cow_file,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cow_file != NULL )
+	{
+		libbfoverlay_cow_file_free(
+		 &cow_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_cow_file_check_for_zero_block function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_cow_file_check_for_zero_block(
+     void )
+{
+	uint8_t data[ 256 ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	if( memory_set(
+	     data,
+	     0,
+	     256 ) == NULL )
+	{
+		goto on_error;
+	}
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_cow_file_check_for_zero_block(
+	          data,
+	          256,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_cow_file_check_for_zero_block(
+	          &( data[ 3 ] ),
+	          250,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data[ 255 ] = 0x01;
+
+	result = libbfoverlay_cow_file_check_for_zero_block(
+	          data,
+	          256,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with a non-zero byte outside the data
+	 */
+	result = libbfoverlay_cow_file_check_for_zero_block(
+	          data,
+	          255,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data[ 255 ] = 0x00;
+	data[ 100 ] = 0x80;
+
+	result = libbfoverlay_cow_file_check_for_zero_block(
+	          &( data[ 3 ] ),
+	          250,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_cow_file_check_for_zero_block(
+	          NULL,
+	          256,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_file_check_for_zero_block(
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_cow_file_release_block function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_cow_file_release_block(
+     void )
+{
+	libbfoverlay_cow_file_t *cow_file = NULL;
+	libcerror_error_t *error          = NULL;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_cow_file_initialize(
+	          &cow_file,
+	          1024,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	cow_file->last_data_block_number = 8;
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_cow_file_release_block(
+	          cow_file,
+	          3,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "cow_file->number_of_free_blocks",
+	 cow_file->number_of_free_blocks,
+	 (uint32_t) 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "cow_file->number_of_pending_free_blocks",
+	 cow_file->number_of_pending_free_blocks,
+	 (uint32_t) 0 );
+
+	/* If changes are not written immediately the block is not marked as free
+	 */
+	result = libbfoverlay_cow_file_set_maximum_dirty_size(
+	          cow_file,
+	          NULL,
+	          0,
+	          65536,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_cow_file_release_block(
+	          cow_file,
+	          5,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "cow_file->number_of_free_blocks",
+	 cow_file->number_of_free_blocks,
+	 (uint32_t) 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "cow_file->number_of_pending_free_blocks",
+	 cow_file->number_of_pending_free_blocks,
+	 (uint32_t) 1 );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_cow_file_release_block(
+	          NULL,
+	          5,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_file_release_block(
+	          cow_file,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_file_release_block(
+	          cow_file,
+	          9,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_cow_file_free(
+	          &cow_file,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cow_file != NULL )
+	{
+		libbfoverlay_cow_file_free(
+		 &cow_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_cow_file_allocate_block_number function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_cow_file_allocate_block_number(
+     void )
+{
+	libbfoverlay_cow_file_t *cow_file = NULL;
+	libcerror_error_t *error          = NULL;
+	uint32_t block_number             = 0;
+	uint32_t last_data_block_number   = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_cow_file_initialize(
+	          &cow_file,
+	          1024,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_cow_file_set_up_allocation_table(
+	          cow_file,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	last_data_block_number = cow_file->last_data_block_number;
+
+	/* Test regular cases
+	 * without free blocks the block is appended
+	 */
+	result = libbfoverlay_cow_file_allocate_block_number(
+	          cow_file,
+	          &block_number,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "block_number",
+	 block_number,
+	 last_data_block_number + 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "cow_file->last_data_block_number",
+	 cow_file->last_data_block_number,
+	 last_data_block_number + 1 );
+
+	/* If changes are written immediately a released block is reused
+	 */
+	result = libbfoverlay_cow_file_release_block(
+	          cow_file,
+	          3,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_cow_file_allocate_block_number(
+	          cow_file,
+	          &block_number,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "block_number",
+	 block_number,
+	 (uint32_t) 3 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "cow_file->number_of_free_blocks",
+	 cow_file->number_of_free_blocks,
+	 (uint32_t) 0 );
+
+	/* If changes are not written immediately a released block is not reused before a flush
+	 */
+	result = libbfoverlay_cow_file_set_maximum_dirty_size(
+	          cow_file,
+	          NULL,
+	          0,
+	          65536,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_cow_file_release_block(
+	          cow_file,
+	          5,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_cow_file_allocate_block_number(
+	          cow_file,
+	          &block_number,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "block_number",
+	 block_number,
+	 last_data_block_number + 2 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "cow_file->number_of_pending_free_blocks",
+	 cow_file->number_of_pending_free_blocks,
+	 (uint32_t) 1 );
+
+	result = libbfoverlay_cow_file_flush(
+	          cow_file,
+	          NULL,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "cow_file->number_of_pending_free_blocks",
+	 cow_file->number_of_pending_free_blocks,
+	 (uint32_t) 0 );
+
+	result = libbfoverlay_cow_file_allocate_block_number(
+	          cow_file,
+	          &block_number,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "block_number",
+	 block_number,
+	 (uint32_t) 5 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_cow_file_allocate_block_number(
+	          NULL,
+	          &block_number,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_file_allocate_block_number(
+	          cow_file,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_cow_file_free(
+	          &cow_file,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cow_file != NULL )
+	{
+		libbfoverlay_cow_file_free(
+		 &cow_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_cow_file_read_free_blocks function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_cow_file_read_free_blocks(
+     void )
+{
+	libbfoverlay_cow_allocation_table_block_t *l1_allocation_table_block = NULL;
+	libbfoverlay_cow_allocation_table_block_t *allocation_table_block    = NULL;
+	libbfoverlay_cow_file_t *cow_file                                    = NULL;
+	libcerror_error_t *error                                             = NULL;
+	uint32_t block_number                                                = 0;
+	uint32_t last_data_block_number                                      = 0;
+	uint8_t bit_mask                                                     = 0;
+	int block_is_free                                                    = 0;
+	int expected_block_is_free                                           = 0;
+	int number_of_entries                                                = 0;
+	int result                                                           = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_cow_file_initialize(
+	          &cow_file,
+	          1024,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_cow_file_set_up_allocation_table(
+	          cow_file,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	number_of_entries = cow_file->l1_allocation_table_block->number_of_entries;
+
+	/* Clear the level 2 entry that refers to block 4
+	 */
+	result = libcdata_array_get_entry_by_index(
+	          cow_file->allocation_table_block_cache,
+	          0,
+	          (intptr_t **) &allocation_table_block,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_table_block",
+	 allocation_table_block );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_cow_allocation_table_block_set_block_number_by_index(
+	          allocation_table_block,
+	          2,
+	          LIBBFOVERLAY_COW_BLOCK_NUMBER_NOT_SET,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The 2 blocks at the end of the COW file are not referenced
+	 */
+	cow_file->last_data_block_number += 2;
+
+	last_data_block_number = cow_file->last_data_block_number;
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_cow_file_read_free_blocks(
+	          cow_file,
+	          NULL,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT8(
+	 "cow_file->free_blocks_read",
+	 cow_file->free_blocks_read,
+	 (uint8_t) 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "cow_file->free_blocks_bitmap_number_of_blocks",
+	 cow_file->free_blocks_bitmap_number_of_blocks,
+	 last_data_block_number + 1 );
+
+	/* The blocks referenced by the odd level 2 entries, that refer to zero blocks,
+	 * the cleared level 2 entry and the unreferenced blocks at the end are free
+	 */
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "cow_file->number_of_free_blocks",
+	 cow_file->number_of_free_blocks,
+	 (uint32_t) ( number_of_entries / 2 ) + 3 );
+
+	for( block_number = 0;
+	     block_number <= last_data_block_number;
+	     block_number++ )
+	{
+		bit_mask = (uint8_t) ( 1 << ( block_number % 8 ) );
+
+		/* Block 0 contains the file header and block 1 the level 2 allocation table
+		 */
+		if( ( block_number <= 1 )
+		 || ( ( block_number != 4 )
+		  &&  ( ( block_number % 2 ) == 0 )
+		  &&  ( block_number < ( last_data_block_number - 1 ) ) ) )
+		{
+			expected_block_is_free = 0;
+		}
+		else
+		{
+			expected_block_is_free = 1;
+		}
+		block_is_free = (int) ( ( cow_file->free_blocks_bitmap[ block_number / 8 ] & bit_mask ) != 0 );
+
+		BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+		 "block_is_free",
+		 block_is_free,
+		 expected_block_is_free );
+	}
+	/* The lowest free block is allocated first
+	 */
+	result = libbfoverlay_cow_file_allocate_block_number(
+	          cow_file,
+	          &block_number,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "block_number",
+	 block_number,
+	 (uint32_t) 3 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_cow_file_allocate_block_number(
+	          cow_file,
+	          &block_number,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "block_number",
+	 block_number,
+	 (uint32_t) 4 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "cow_file->last_data_block_number",
+	 cow_file->last_data_block_number,
+	 last_data_block_number );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_cow_file_read_free_blocks(
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	l1_allocation_table_block = cow_file->l1_allocation_table_block;
+
+	cow_file->l1_allocation_table_block = NULL;
+
+	result = libbfoverlay_cow_file_read_free_blocks(
+	          cow_file,
+	          NULL,
+	          0,
+	          &error );
+
+	cow_file->l1_allocation_table_block = l1_allocation_table_block;
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_cow_file_free(
+	          &cow_file,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( ( cow_file != NULL )
+	 && ( l1_allocation_table_block != NULL ) )
+	{
+		cow_file->l1_allocation_table_block = l1_allocation_table_block;
+	}
+	if( cow_file != NULL )
+	{
+		libbfoverlay_cow_file_free(
+		 &cow_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_cow_file_get_cached_allocation_table_block function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_cow_file_get_cached_allocation_table_block(
+     void )
+{
+	libbfoverlay_cow_allocation_table_block_t *allocation_table_block = NULL;
+	libbfoverlay_cow_file_t *cow_file                                 = NULL;
+	libcerror_error_t *error                                          = NULL;
+	int result                                                        = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_cow_file_initialize(
+	          &cow_file,
+	          1024,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_cow_file_set_up_allocation_table(
+	          cow_file,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_cow_file_get_cached_allocation_table_block(
+	          cow_file,
+	          0,
+	          &allocation_table_block,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Block 0 is the level 1 allocation table block
+	 */
+	result = ( allocation_table_block == cow_file->l1_allocation_table_block );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	allocation_table_block = NULL;
+
+	result = libbfoverlay_cow_file_get_cached_allocation_table_block(
+	          cow_file,
+	          1,
+	          &allocation_table_block,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_table_block",
+	 allocation_table_block );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT32(
+	 "allocation_table_block->block_number",
+	 allocation_table_block->block_number,
+	 (uint32_t) 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Block 2 maps onto the same cache entry as block 1 and is not cached
+	 */
+	allocation_table_block = NULL;
+
+	result = libbfoverlay_cow_file_get_cached_allocation_table_block(
+	          cow_file,
+	          2,
+	          &allocation_table_block,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "allocation_table_block",
+	 allocation_table_block );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_cow_file_get_cached_allocation_table_block(
+	          NULL,
+	          1,
+	          &allocation_table_block,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_file_get_cached_allocation_table_block(
+	          cow_file,
+	          1,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_cow_file_free(
+	          &cow_file,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cow_file != NULL )
+	{
+		libbfoverlay_cow_file_free(
+		 &cow_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_cow_file_get_block_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_cow_file_get_block_at_offset(
+     void )
+{
+	libbfoverlay_cow_file_t *cow_file = NULL;
+	libcerror_error_t *error          = NULL;
+	off64_t file_offset               = 0;
+	off64_t range_end_offset          = 0;
+	off64_t range_start_offset        = 0;
+	off64_t table_end_offset          = 0;
+	int number_of_entries             = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_cow_file_initialize(
+	          &cow_file,
+	          1024,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_cow_file_set_up_allocation_table(
+	          cow_file,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	number_of_entries = cow_file->l1_allocation_table_block->number_of_entries;
+	table_end_offset  = (off64_t) cow_file->number_of_allocated_blocks * cow_file->block_size;
+
+	/* The data extends 10 blocks and 1 byte beyond the allocation table
+	 */
+	cow_file->data_size = (size64_t) table_end_offset + ( 10 * cow_file->block_size ) + 1;
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_cow_file_get_block_at_offset(
+	          cow_file,
+	          NULL,
+	          0,
+	          (off64_t) cow_file->block_size + 1,
+	          &range_start_offset,
+	          &range_end_offset,
+	          &file_offset,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "range_start_offset",
+	 (int64_t) range_start_offset,
+	 (int64_t) cow_file->block_size );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "range_end_offset",
+	 (int64_t) range_end_offset,
+	 (int64_t) 2 * cow_file->block_size );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "file_offset",
+	 (int64_t) file_offset,
+	 (int64_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_cow_file_get_block_at_offset(
+	          cow_file,
+	          NULL,
+	          0,
+	          (off64_t) 2 * cow_file->block_size,
+	          &range_start_offset,
+	          &range_end_offset,
+	          &file_offset,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "file_offset",
+	 (int64_t) file_offset,
+	 (int64_t) 4 * cow_file->block_size );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The range of a level 1 entry that is not set spans all the blocks of the entry
+	 */
+	result = libbfoverlay_cow_file_get_block_at_offset(
+	          cow_file,
+	          NULL,
+	          0,
+	          ( (off64_t) number_of_entries + 1 ) * cow_file->block_size,
+	          &range_start_offset,
+	          &range_end_offset,
+	          &file_offset,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "range_start_offset",
+	 (int64_t) range_start_offset,
+	 (int64_t) number_of_entries * cow_file->block_size );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "range_end_offset",
+	 (int64_t) range_end_offset,
+	 (int64_t) 2 * number_of_entries * cow_file->block_size );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The range of an offset beyond the allocation table spans up to the end of the data
+	 */
+	result = libbfoverlay_cow_file_get_block_at_offset(
+	          cow_file,
+	          NULL,
+	          0,
+	          table_end_offset + ( 3 * cow_file->block_size ) + 5,
+	          &range_start_offset,
+	          &range_end_offset,
+	          &file_offset,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "range_start_offset",
+	 (int64_t) range_start_offset,
+	 (int64_t) table_end_offset );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "range_end_offset",
+	 (int64_t) range_end_offset,
+	 (int64_t) table_end_offset + ( 11 * cow_file->block_size ) );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The range of an offset beyond the end of the data has no end
+	 */
+	result = libbfoverlay_cow_file_get_block_at_offset(
+	          cow_file,
+	          NULL,
+	          0,
+	          table_end_offset + ( 11 * cow_file->block_size ),
+	          &range_start_offset,
+	          &range_end_offset,
+	          &file_offset,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "range_end_offset",
+	 (int64_t) range_end_offset,
+	 (int64_t) INT64_MAX );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_cow_file_get_block_at_offset(
+	          NULL,
+	          NULL,
+	          0,
+	          0,
+	          &range_start_offset,
+	          &range_end_offset,
+	          &file_offset,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_file_get_block_at_offset(
+	          cow_file,
+	          NULL,
+	          0,
+	          -1,
+	          &range_start_offset,
+	          &range_end_offset,
+	          &file_offset,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_file_get_block_at_offset(
+	          cow_file,
+	          NULL,
+	          0,
+	          0,
+	          NULL,
+	          &range_end_offset,
+	          &file_offset,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_file_get_block_at_offset(
+	          cow_file,
+	          NULL,
+	          0,
+	          0,
+	          &range_start_offset,
+	          NULL,
+	          &file_offset,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_cow_file_get_block_at_offset(
+	          cow_file,
+	          NULL,
+	          0,
+	          0,
+	          &range_start_offset,
+	          &range_end_offset,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_cow_file_free(
+	          &cow_file,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cow_file != NULL )
+	{
+		libbfoverlay_cow_file_free(
+		 &cow_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+
+/* Looks up the blocks of the allocation table set up by bfoverlay_test_cow_file_set_up_allocation_table
+ * The result of the worker is set to 1 if all lookups returned the expected values or 0 if not
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_cow_file_run_lookup_worker(
+     void *arguments )
+{
+	bfoverlay_test_cow_file_lookup_worker_t *lookup_worker = NULL;
+	libbfoverlay_cow_file_t *cow_file                      = NULL;
+	off64_t expected_file_offset                           = 0;
+	off64_t file_offset                                    = 0;
+	off64_t range_end_offset                               = 0;
+	off64_t range_start_offset                             = 0;
+	int entry_index                                        = 0;
+	int lookup_index                                       = 0;
+	int number_of_entries                                  = 0;
+	int result                                             = 0;
+
+	if( arguments == NULL )
+	{
+		return( -1 );
+	}
+	lookup_worker = (bfoverlay_test_cow_file_lookup_worker_t *) arguments;
+	cow_file      = lookup_worker->cow_file;
+
+	lookup_worker->result = 0;
+
+	number_of_entries = cow_file->l1_allocation_table_block->number_of_entries;
+
+	for( lookup_index = 0;
+	     lookup_index < BFOVERLAY_TEST_COW_FILE_NUMBER_OF_LOOKUPS;
+	     lookup_index++ )
+	{
+		for( entry_index = 0;
+		     entry_index < number_of_entries;
+		     entry_index++ )
+		{
+			result = libbfoverlay_cow_file_get_block_at_offset(
+			          cow_file,
+			          NULL,
+			          0,
+			          (off64_t) entry_index * cow_file->block_size,
+			          &range_start_offset,
+			          &range_end_offset,
+			          &file_offset,
+			          NULL );
+
+			if( ( entry_index % 2 ) == 0 )
+			{
+				expected_file_offset = (off64_t) ( entry_index + 2 ) * cow_file->block_size;
+			}
+			else
+			{
+				expected_file_offset = -1;
+			}
+			if( ( result != 1 )
+			 || ( file_offset != expected_file_offset ) )
+			{
+				return( 1 );
+			}
+		}
+		/* The level 1 entry 1 is not set
+		 */
+		result = libbfoverlay_cow_file_get_block_at_offset(
+		          cow_file,
+		          NULL,
+		          0,
+		          (off64_t) number_of_entries * cow_file->block_size,
+		          &range_start_offset,
+		          &range_end_offset,
+		          &file_offset,
+		          NULL );
+
+		if( ( result != 0 )
+		 || ( range_start_offset != ( (off64_t) number_of_entries * cow_file->block_size ) )
+		 || ( range_end_offset != ( (off64_t) 2 * number_of_entries * cow_file->block_size ) ) )
+		{
+			return( 1 );
+		}
+	}
+	lookup_worker->result = 1;
+
+	return( 1 );
+}
+
+/* Tests the libbfoverlay_cow_file_get_block_at_offset function with multiple threads
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_cow_file_get_block_at_offset_multi_threaded(
+     void )
+{
+	bfoverlay_test_cow_file_lookup_worker_t lookup_workers[ BFOVERLAY_TEST_COW_FILE_NUMBER_OF_THREADS ];
+
+	libcthreads_thread_t *threads[ BFOVERLAY_TEST_COW_FILE_NUMBER_OF_THREADS ];
+
+	libbfoverlay_cow_file_t *cow_file = NULL;
+	libcerror_error_t *error          = NULL;
+	int number_of_threads_created     = 0;
+	int result                        = 0;
+	int thread_index                  = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_cow_file_initialize(
+	          &cow_file,
+	          1024,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_cow_file_set_up_allocation_table(
+	          cow_file,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+
+	/* The lock is held for reading while the threads look up blocks, as another reader would.
+	 * A lookup of a cached allocation table block must not grab the lock for writing,
+	 * otherwise the threads block and the test does not complete.
+	 */
+	result = libcthreads_read_write_lock_grab_for_read(
+	          cow_file->read_write_lock,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( thread_index = 0;
+	     thread_index < BFOVERLAY_TEST_COW_FILE_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		lookup_workers[ thread_index ].cow_file = cow_file;
+		lookup_workers[ thread_index ].result   = 0;
+
+		threads[ thread_index ] = NULL;
+
+		result = libcthreads_thread_create(
+		          &( threads[ thread_index ] ),
+		          NULL,
+		          &bfoverlay_test_cow_file_run_lookup_worker,
+		          (void *) &( lookup_workers[ thread_index ] ),
+		          &error );
+
+		if( result != 1 )
+		{
+			break;
+		}
+		number_of_threads_created++;
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_threads_created;
+	     thread_index++ )
+	{
+		if( libcthreads_thread_join(
+		     &( threads[ thread_index ] ),
+		     NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_read_write_lock_release_for_read(
+	          cow_file->read_write_lock,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( thread_index = 0;
+	     thread_index < BFOVERLAY_TEST_COW_FILE_NUMBER_OF_THREADS;
+	     thread_index++ )
+	{
+		BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+		 "lookup_workers[ thread_index ].result",
+		 lookup_workers[ thread_index ].result,
+		 1 );
+	}
+	/* Clean up
+	 */
+	result = libbfoverlay_cow_file_free(
+	          &cow_file,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "cow_file",
+	 cow_file );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cow_file != NULL )
+	{
+		libbfoverlay_cow_file_free(
+		 &cow_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BFOVERLAY_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BFOVERLAY_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BFOVERLAY_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BFOVERLAY_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BFOVERLAY_TEST_UNREFERENCED_PARAMETER( argc )
+	BFOVERLAY_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_file_initialize",
+	 bfoverlay_test_cow_file_initialize );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_file_free",
+	 bfoverlay_test_cow_file_free );
+
+	/* TODO add tests for libbfoverlay_cow_file_open_file_io_handle */
+
+	/* TODO add tests for libbfoverlay_cow_file_close */
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_file_get_maximum_cache_size",
+	 bfoverlay_test_cow_file_get_maximum_cache_size );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_file_set_maximum_cache_size",
+	 bfoverlay_test_cow_file_set_maximum_cache_size );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_file_get_maximum_dirty_size",
+	 bfoverlay_test_cow_file_get_maximum_dirty_size );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_file_set_maximum_dirty_size",
+	 bfoverlay_test_cow_file_set_maximum_dirty_size );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_file_get_block_size",
+	 bfoverlay_test_cow_file_get_block_size );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_file_set_block_size",
+	 bfoverlay_test_cow_file_set_block_size );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_file_check_for_zero_block",
+	 bfoverlay_test_cow_file_check_for_zero_block );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_file_release_block",
+	 bfoverlay_test_cow_file_release_block );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_file_allocate_block_number",
+	 bfoverlay_test_cow_file_allocate_block_number );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_file_read_free_blocks",
+	 bfoverlay_test_cow_file_read_free_blocks );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_file_get_cached_allocation_table_block",
+	 bfoverlay_test_cow_file_get_cached_allocation_table_block );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_file_get_block_at_offset",
+	 bfoverlay_test_cow_file_get_block_at_offset );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY )
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_cow_file_get_block_at_offset_multi_threaded",
+	 bfoverlay_test_cow_file_get_block_at_offset_multi_threaded );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( HAVE_LOCAL_LIBBFOVERLAY ) */
 
 #endif /* defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT ) */
 
@@ -48,6 +48,16 @@ uint8_t bfoverlay_test_descriptor_file_data1[ 138 ] = {
 	0x3d, 0x22, 0x6e, 0x74, 0x66, 0x73, 0x2e, 0x72, 0x61, 0x77, 0x22, 0x20, 0x66, 0x69, 0x6c, 0x65,
 	0x5f, 0x6f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x3d, 0x30, 0x0a };
 
+uint8_t bfoverlay_test_descriptor_file_data2[ 122 ] = {
+	0x23, 0x20, 0x62, 0x61, 0x73, 0x69, 0x63, 0x20, 0x66, 0x69, 0x6c, 0x65, 0x20, 0x6f, 0x76, 0x65,
+	0x72, 0x6c, 0x61, 0x79, 0x20, 0x64, 0x65, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74, 0x6f, 0x72, 0x20,
+	0x66, 0x69, 0x6c, 0x65, 0x0a, 0x6c, 0x61, 0x79, 0x65, 0x72, 0x3a, 0x20, 0x6f, 0x66, 0x66, 0x73,
+	0x65, 0x74, 0x3d, 0x30, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x3d, 0x32, 0x31, 0x34, 0x37, 0x34, 0x38,
+	0x33, 0x36, 0x34, 0x38, 0x0a, 0x6c, 0x61, 0x79, 0x65, 0x72, 0x3a, 0x20, 0x66, 0x69, 0x6c, 0x65,
+	0x3d, 0x22, 0x63, 0x6f, 0x77, 0x2e, 0x72, 0x61, 0x77, 0x22, 0x20, 0x63, 0x6f, 0x70, 0x79, 0x2d,
+	0x6f, 0x6e, 0x2d, 0x77, 0x72, 0x69, 0x74, 0x65, 0x20, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x5f, 0x73,
+	0x69, 0x7a, 0x65, 0x3d, 0x36, 0x35, 0x35, 0x33, 0x36, 0x0a };
+
 #if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
 
 /* Tests the libbfoverlay_descriptor_file_initialize function
@@ -329,6 +339,21 @@ int bfoverlay_test_descriptor_file_read_data(
 	 "error",
 	 error );
 
+	result = libbfoverlay_descriptor_file_read_data(
+	          descriptor_file,
+	          bfoverlay_test_descriptor_file_data2,
+	          122,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	/* Test error cases
 	 */
 	result = libbfoverlay_descriptor_file_read_data(
@@ -435,6 +460,30 @@ int bfoverlay_test_descriptor_file_read_data(
 	          37,
 	          &error );
 
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the COW block size is not supported
+	 */
+	bfoverlay_test_descriptor_file_data2[ 116 ] = '7';
+
+	result = libbfoverlay_descriptor_file_read_data(
+	          descriptor_file,
+	          bfoverlay_test_descriptor_file_data2,
+	          122,
+	          &error );
+
+	bfoverlay_test_descriptor_file_data2[ 116 ] = '6';
+
 	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
@@ -0,0 +1,465 @@
+/*
+ * Generates synthetic workloads for benchmarking
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bfoverlay_test_functions.h"
+#include "bfoverlay_test_getopt.h"
+#include "bfoverlay_test_libbfoverlay.h"
+#include "bfoverlay_test_libcerror.h"
+#include "bfoverlay_test_workload.h"
+
+/* Prints usage information
+ */
+void bfoverlay_test_generate_workload_usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use bfoverlay_test_generate_workload to generate a synthetic basic file\n"
+	                 "overlay with its data files for benchmarking.\n\n" );
+
+	fprintf( stream, "Usage: bfoverlay_test_generate_workload [ -b block_size ] [ -c percentage ]\n"
+	                 "                                        [ -f fragments ] [ -l layers ]\n"
+	                 "                                        [ -r seed ] [ -s size ]\n"
+	                 "                                        [ -S layers ] [ -Fh ] [ name ]\n\n" );
+
+	fprintf( stream, "\tname: the name of the generated files, default is workload\n\n" );
+	fprintf( stream, "\t-b:   COW block size, default is 4096\n" );
+	fprintf( stream, "\t-c:   add a COW layer of which the percentage of blocks is\n"
+	                 "\t      pre-populated\n" );
+	fprintf( stream, "\t-f:   number of fragments of every layer on top of the base\n"
+	                 "\t      layer, default is 1 (contiguous)\n" );
+	fprintf( stream, "\t-F:   pre-populate the COW blocks in random order (fragmented)\n" );
+	fprintf( stream, "\t-h:   shows this help\n" );
+	fprintf( stream, "\t-l:   number of layers including the base layer, default is 1\n" );
+	fprintf( stream, "\t-r:   pseudo random seed, default is 1\n" );
+	fprintf( stream, "\t-s:   media size, default is 67108864\n" );
+	fprintf( stream, "\t-S:   number of top-most layers without a data file (sparse),\n"
+	                 "\t      default is 0\n" );
+}
+
+/* Copies a decimal string to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_generate_workload_copy_from_string(
+     const system_character_t *string,
+     uint64_t maximum_value,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function = "bfoverlay_test_generate_workload_copy_from_string";
+	size_t string_index   = 0;
+	uint64_t safe_value   = 0;
+	uint8_t digit         = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid string value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( string_index = 0;
+	     string[ string_index ] != 0;
+	     string_index++ )
+	{
+		if( ( string[ string_index ] < (system_character_t) '0' )
+		 || ( string[ string_index ] > (system_character_t) '9' ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character in string.",
+			 function );
+
+			return( -1 );
+		}
+		digit = (uint8_t) ( string[ string_index ] - (system_character_t) '0' );
+
+		if( safe_value > ( ( maximum_value - digit ) / 10 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		safe_value = ( safe_value * 10 ) + digit;
+	}
+	*value_64bit = safe_value;
+
+	return( 1 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+	char name[ BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE ];
+
+	bfoverlay_test_workload_t *workload = NULL;
+	libcerror_error_t *error            = NULL;
+	system_integer_t option             = 0;
+	uint64_t value_64bit                = 0;
+
+	if( bfoverlay_test_workload_initialize(
+	     &workload,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize workload.\n" );
+
+		goto on_error;
+	}
+	while( ( option = bfoverlay_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:c:f:Fhl:r:s:S:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				bfoverlay_test_generate_workload_usage_fprint(
+				 stdout );
+
+				goto on_error;
+
+			case (system_integer_t) 'b':
+				if( bfoverlay_test_generate_workload_copy_from_string(
+				     optarg,
+				     (uint64_t) UINT32_MAX,
+				     &value_64bit,
+				     &error ) != 1 )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported COW block size.\n" );
+
+					goto on_error;
+				}
+				workload->cow_block_size = (size32_t) value_64bit;
+
+				break;
+
+			case (system_integer_t) 'c':
+				if( bfoverlay_test_generate_workload_copy_from_string(
+				     optarg,
+				     100,
+				     &value_64bit,
+				     &error ) != 1 )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported COW fill percentage.\n" );
+
+					goto on_error;
+				}
+				workload->use_cow             = 1;
+				workload->cow_fill_percentage = (uint8_t) value_64bit;
+
+				break;
+
+			case (system_integer_t) 'f':
+				if( bfoverlay_test_generate_workload_copy_from_string(
+				     optarg,
+				     BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NUMBER_OF_FRAGMENTS,
+				     &value_64bit,
+				     &error ) != 1 )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported number of fragments.\n" );
+
+					goto on_error;
+				}
+				workload->number_of_fragments = (int) value_64bit;
+
+				break;
+
+			case (system_integer_t) 'F':
+				workload->cow_fragmented = 1;
+
+				break;
+
+			case (system_integer_t) 'h':
+				bfoverlay_test_generate_workload_usage_fprint(
+				 stdout );
+
+				bfoverlay_test_workload_free(
+				 &workload,
+				 NULL );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'l':
+				if( bfoverlay_test_generate_workload_copy_from_string(
+				     optarg,
+				     BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NUMBER_OF_LAYERS,
+				     &value_64bit,
+				     &error ) != 1 )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported number of layers.\n" );
+
+					goto on_error;
+				}
+				workload->number_of_layers = (int) value_64bit;
+
+				break;
+
+			case (system_integer_t) 'r':
+				if( bfoverlay_test_generate_workload_copy_from_string(
+				     optarg,
+				     UINT64_MAX,
+				     &value_64bit,
+				     &error ) != 1 )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported random seed.\n" );
+
+					goto on_error;
+				}
+				workload->random_state = value_64bit;
+
+				break;
+
+			case (system_integer_t) 's':
+				if( bfoverlay_test_generate_workload_copy_from_string(
+				     optarg,
+				     (uint64_t) INT64_MAX,
+				     &value_64bit,
+				     &error ) != 1 )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported media size.\n" );
+
+					goto on_error;
+				}
+				workload->media_size = (size64_t) value_64bit;
+
+				break;
+
+			case (system_integer_t) 'S':
+				if( bfoverlay_test_generate_workload_copy_from_string(
+				     optarg,
+				     BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NUMBER_OF_LAYERS,
+				     &value_64bit,
+				     &error ) != 1 )
+				{
+					fprintf(
+					 stderr,
+					 "Unsupported number of sparse layers.\n" );
+
+					goto on_error;
+				}
+				workload->number_of_sparse_layers = (int) value_64bit;
+
+				break;
+		}
+	}
+	if( optind < argc )
+	{
+		if( bfoverlay_test_get_narrow_source(
+		     argv[ optind ],
+		     name,
+		     BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported name.\n" );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		if( narrow_string_copy(
+		     name,
+		     "workload",
+		     9 ) == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set name.\n" );
+
+			goto on_error;
+		}
+	}
+	if( bfoverlay_test_workload_generate(
+	     workload,
+	     name,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to generate workload.\n" );
+
+		goto on_error;
+	}
+	/* Print the workload in a form that can be consumed by a benchmark harness
+	 */
+	fprintf(
+	 stdout,
+	 "descriptor_file: %s.bfoverlay\n",
+	 name );
+
+	fprintf(
+	 stdout,
+	 "media_size: %" PRIu64 "\n",
+	 workload->media_size );
+
+	fprintf(
+	 stdout,
+	 "number_of_layers: %d\n",
+	 workload->number_of_layers );
+
+	fprintf(
+	 stdout,
+	 "number_of_sparse_layers: %d\n",
+	 workload->number_of_sparse_layers );
+
+	fprintf(
+	 stdout,
+	 "number_of_fragments: %d\n",
+	 workload->number_of_fragments );
+
+	fprintf(
+	 stdout,
+	 "number_of_descriptor_layers: %d\n",
+	 workload->number_of_descriptor_layers );
+
+	if( workload->use_cow != 0 )
+	{
+		fprintf(
+		 stdout,
+		 "cow_file: %s.cow\n",
+		 name );
+
+		fprintf(
+		 stdout,
+		 "cow_block_size: %" PRIu32 "\n",
+		 workload->cow_block_size );
+
+		fprintf(
+		 stdout,
+		 "cow_fill_percentage: %" PRIu8 "\n",
+		 workload->cow_fill_percentage );
+
+		fprintf(
+		 stdout,
+		 "cow_fragmented: %" PRIu8 "\n",
+		 workload->cow_fragmented );
+
+		fprintf(
+		 stdout,
+		 "number_of_cow_blocks: %" PRIu64 "\n",
+		 workload->number_of_cow_blocks );
+	}
+	if( bfoverlay_test_workload_free(
+	     &workload,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free workload.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( workload != NULL )
+	{
+		bfoverlay_test_workload_free(
+		 &workload,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
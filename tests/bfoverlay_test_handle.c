@@ -43,6 +43,7 @@
 #include "bfoverlay_test_libcerror.h"
 #include "bfoverlay_test_macros.h"
 #include "bfoverlay_test_memory.h"
+#include "bfoverlay_test_workload.h"
 
 #include "../libbfoverlay/libbfoverlay_handle.h"
 
@@ -54,7 +55,19 @@
 #define BFOVERLAY_TEST_HANDLE_VERBOSE
  */
 
-#define BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE	4096
+#define BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE		4096
+#define BFOVERLAY_TEST_HANDLE_MAXIMUM_NUMBER_OF_EXTENTS	256
+
+/* The generated overlays consist of a base layer with a data file and a COW layer
+ */
+#define BFOVERLAY_TEST_HANDLE_OVERLAY_MEDIA_SIZE	( 1024 * 1024 )
+#define BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE	4096
+
+/* The layer index used to fill the data written to a generated overlay,
+ * the data of the base layer is filled with layer index 0 and the data of
+ * the pre-populated COW blocks with layer index 1
+ */
+#define BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER	2
 
 /* Creates and opens a source handle
  * Returns 1 if successful or -1 on error
@@ -181,257 +194,631 @@ int bfoverlay_test_handle_close_source(
 	return( result );
 }
 
-/* Tests the libbfoverlay_handle_initialize function
- * Returns 1 if successful or 0 if not
+/* Generates an overlay with a base layer data file and a COW layer
+ * Returns 1 if successful or -1 on error
  */
-int bfoverlay_test_handle_initialize(
-     void )
+int bfoverlay_test_handle_generate_overlay(
+     const char *name,
+     uint8_t cow_fill_percentage,
+     uint8_t cow_fragmented,
+     libcerror_error_t **error )
 {
-	libbfoverlay_handle_t *handle   = NULL;
-	libcerror_error_t *error        = NULL;
-	int result                      = 0;
+	bfoverlay_test_workload_t *workload = NULL;
+	static char *function               = "bfoverlay_test_handle_generate_overlay";
 
-#if defined( HAVE_BFOVERLAY_TEST_MEMORY )
-	int number_of_malloc_fail_tests = 1;
-	int number_of_memset_fail_tests = 1;
-	int test_number                 = 0;
-#endif
+	if( bfoverlay_test_workload_initialize(
+	     &workload,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize workload.",
+		 function );
 
-	/* Test regular cases
-	 */
-	result = libbfoverlay_handle_initialize(
-	          &handle,
-	          &error );
+		goto on_error;
+	}
+	workload->media_size          = BFOVERLAY_TEST_HANDLE_OVERLAY_MEDIA_SIZE;
+	workload->use_cow             = 1;
+	workload->cow_block_size      = BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE;
+	workload->cow_fill_percentage = cow_fill_percentage;
+	workload->cow_fragmented      = cow_fragmented;
+
+	if( bfoverlay_test_workload_generate(
+	     workload,
+	     name,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to generate workload.",
+		 function );
 
-	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
+		goto on_error;
+	}
+	if( bfoverlay_test_workload_free(
+	     &workload,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free workload.",
+		 function );
 
-	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
-	 "handle",
-	 handle );
+		goto on_error;
+	}
+	return( 1 );
 
-	BFOVERLAY_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+on_error:
+	if( workload != NULL )
+	{
+		bfoverlay_test_workload_free(
+		 &workload,
+		 NULL );
+	}
+	return( -1 );
+}
 
-	result = libbfoverlay_handle_free(
-	          &handle,
-	          &error );
+/* Removes the files of a generated overlay
+ */
+void bfoverlay_test_handle_remove_overlay(
+      const char *name )
+{
+	char filename[ BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE + 32 ];
+
+	narrow_string_snprintf(
+	 filename,
+	 BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE + 32,
+	 "%s.bfoverlay",
+	 name );
+
+	remove(
+	 filename );
+
+	narrow_string_snprintf(
+	 filename,
+	 BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE + 32,
+	 "%s.cow",
+	 name );
+
+	remove(
+	 filename );
+
+	narrow_string_snprintf(
+	 filename,
+	 BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE + 32,
+	 "%s_layer0.raw",
+	 name );
+
+	remove(
+	 filename );
+}
 
-	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
+/* Creates and opens a generated overlay
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_handle_open_overlay(
+     libbfoverlay_handle_t **handle,
+     const char *name,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	char filename[ BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE + 32 ];
 
-	BFOVERLAY_TEST_ASSERT_IS_NULL(
-	 "handle",
-	 handle );
+	static char *function = "bfoverlay_test_handle_open_overlay";
+	int print_count       = 0;
 
-	BFOVERLAY_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-	/* Test error cases
-	 */
-	result = libbfoverlay_handle_initialize(
-	          NULL,
-	          &error );
+		return( -1 );
+	}
+	print_count = narrow_string_snprintf(
+	               filename,
+	               BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE + 32,
+	               "%s.bfoverlay",
+	               name );
+
+	if( ( print_count < 0 )
+	 || ( print_count >= ( BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE + 32 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set descriptor filename.",
+		 function );
 
-	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+		return( -1 );
+	}
+	if( libbfoverlay_handle_initialize(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize handle.",
+		 function );
 
-	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+		goto on_error;
+	}
+	if( libbfoverlay_handle_open(
+	     *handle,
+	     filename,
+	     access_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
 
-	libcerror_error_free(
-	 &error );
+		goto on_error;
+	}
+	if( libbfoverlay_handle_open_data_files(
+	     *handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open data files.",
+		 function );
 
-	handle = (libbfoverlay_handle_t *) 0x12345678UL;
+		goto on_error;
+	}
+	return( 1 );
 
-	result = libbfoverlay_handle_initialize(
-	          &handle,
-	          &error );
+on_error:
+	if( *handle != NULL )
+	{
+		libbfoverlay_handle_free(
+		 handle,
+		 NULL );
+	}
+	return( -1 );
+}
 
-	handle = NULL;
+/* Determines if the data of a generated overlay matches the data of a specific layer
+ * Returns 1 if the data matches, 0 if not or -1 on error
+ */
+int bfoverlay_test_handle_compare_overlay_data(
+     libbfoverlay_handle_t *handle,
+     off64_t offset,
+     size_t size,
+     int layer_index,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer          = NULL;
+	uint8_t *expected_buffer = NULL;
+	static char *function    = "bfoverlay_test_handle_compare_overlay_data";
+	ssize_t read_count       = 0;
+	int result               = 0;
 
-	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+	if( ( size == 0 )
+	 || ( size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
 
-	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+		return( -1 );
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * size );
 
-	libcerror_error_free(
-	 &error );
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
 
-#if defined( HAVE_BFOVERLAY_TEST_MEMORY )
+		goto on_error;
+	}
+	expected_buffer = (uint8_t *) memory_allocate(
+	                               sizeof( uint8_t ) * size );
 
-	for( test_number = 0;
-	     test_number < number_of_malloc_fail_tests;
-	     test_number++ )
+	if( expected_buffer == NULL )
 	{
-		/* Test libbfoverlay_handle_initialize with malloc failing
-		 */
-		bfoverlay_test_malloc_attempts_before_fail = test_number;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create expected buffer.",
+		 function );
 
-		result = libbfoverlay_handle_initialize(
-		          &handle,
-		          &error );
+		goto on_error;
+	}
+	if( bfoverlay_test_workload_fill_buffer(
+	     expected_buffer,
+	     size,
+	     layer_index,
+	     offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to fill expected buffer.",
+		 function );
 
-		if( bfoverlay_test_malloc_attempts_before_fail != -1 )
-		{
-			bfoverlay_test_malloc_attempts_before_fail = -1;
+		goto on_error;
+	}
+	read_count = libbfoverlay_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
 
-			if( handle != NULL )
-			{
-				libbfoverlay_handle_free(
-				 &handle,
-				 NULL );
-			}
-		}
-		else
-		{
-			BFOVERLAY_TEST_ASSERT_EQUAL_INT(
-			 "result",
-			 result,
-			 -1 );
+	if( read_count != (ssize_t) size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 ".",
+		 function,
+		 offset );
 
-			BFOVERLAY_TEST_ASSERT_IS_NULL(
-			 "handle",
-			 handle );
+		goto on_error;
+	}
+	result = memory_compare(
+	          buffer,
+	          expected_buffer,
+	          size );
 
-			BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
-			 "error",
-			 error );
+	memory_free(
+	 expected_buffer );
 
-			libcerror_error_free(
-			 &error );
-		}
+	memory_free(
+	 buffer );
+
+	return( (int) ( result == 0 ) );
+
+on_error:
+	if( expected_buffer != NULL )
+	{
+		memory_free(
+		 expected_buffer );
 	}
-	for( test_number = 0;
-	     test_number < number_of_memset_fail_tests;
-	     test_number++ )
+	if( buffer != NULL )
 	{
-		/* Test libbfoverlay_handle_initialize with memset failing
-		 */
-		bfoverlay_test_memset_attempts_before_fail = test_number;
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
 
-		result = libbfoverlay_handle_initialize(
-		          &handle,
-		          &error );
+/* Writes data of a specific layer to a generated overlay
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_handle_write_overlay_data(
+     libbfoverlay_handle_t *handle,
+     off64_t offset,
+     size_t size,
+     int layer_index,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer       = NULL;
+	static char *function = "bfoverlay_test_handle_write_overlay_data";
+	ssize_t write_count   = 0;
 
-		if( bfoverlay_test_memset_attempts_before_fail != -1 )
-		{
-			bfoverlay_test_memset_attempts_before_fail = -1;
+	if( ( size == 0 )
+	 || ( size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
 
-			if( handle != NULL )
-			{
-				libbfoverlay_handle_free(
-				 &handle,
-				 NULL );
-			}
-		}
-		else
-		{
-			BFOVERLAY_TEST_ASSERT_EQUAL_INT(
-			 "result",
-			 result,
-			 -1 );
+		return( -1 );
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * size );
 
-			BFOVERLAY_TEST_ASSERT_IS_NULL(
-			 "handle",
-			 handle );
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
 
-			BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
-			 "error",
-			 error );
+		goto on_error;
+	}
+	if( bfoverlay_test_workload_fill_buffer(
+	     buffer,
+	     size,
+	     layer_index,
+	     offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to fill buffer.",
+		 function );
 
-			libcerror_error_free(
-			 &error );
-		}
+		goto on_error;
 	}
-#endif /* defined( HAVE_BFOVERLAY_TEST_MEMORY ) */
+	write_count = libbfoverlay_handle_write_buffer_at_offset(
+	               handle,
+	               buffer,
+	               size,
+	               offset,
+	               error );
+
+	if( write_count != (ssize_t) size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		goto on_error;
+	}
+	memory_free(
+	 buffer );
 
 	return( 1 );
 
 on_error:
-	if( error != NULL )
+	if( buffer != NULL )
 	{
-		libcerror_error_free(
-		 &error );
+		memory_free(
+		 buffer );
 	}
-	if( handle != NULL )
+	return( -1 );
+}
+
+/* Determines if the data of a generated overlay only contains zero bytes
+ * Returns 1 if the data only contains zero bytes, 0 if not or -1 on error
+ */
+int bfoverlay_test_handle_check_overlay_zeroes(
+     libbfoverlay_handle_t *handle,
+     off64_t offset,
+     size_t size,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer       = NULL;
+	static char *function = "bfoverlay_test_handle_check_overlay_zeroes";
+	size_t buffer_offset  = 0;
+	ssize_t read_count    = 0;
+	int result            = 1;
+
+	if( ( size == 0 )
+	 || ( size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
 	{
-		libbfoverlay_handle_free(
-		 &handle,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
 	}
-	return( 0 );
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libbfoverlay_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count != (ssize_t) size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		memory_free(
+		 buffer );
+
+		return( -1 );
+	}
+	for( buffer_offset = 0;
+	     buffer_offset < size;
+	     buffer_offset++ )
+	{
+		if( buffer[ buffer_offset ] != 0 )
+		{
+			result = 0;
+
+			break;
+		}
+	}
+	memory_free(
+	 buffer );
+
+	return( result );
 }
 
-/* Tests the libbfoverlay_handle_free function
- * Returns 1 if successful or 0 if not
+/* Retrieves the size of a file
+ * Returns 1 if successful or -1 on error
  */
-int bfoverlay_test_handle_free(
-     void )
+int bfoverlay_test_handle_get_file_size(
+     const char *filename,
+     size64_t *file_size,
+     libcerror_error_t **error )
 {
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "bfoverlay_test_handle_get_file_size";
 
-	/* Test error cases
-	 */
-	result = libbfoverlay_handle_free(
-	          NULL,
-	          &error );
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
 
-	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file IO handle.",
+		 function );
 
-	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     narrow_string_length(
+	      filename ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
 
-	libcerror_error_free(
-	 &error );
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
 
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
-	if( error != NULL )
+	if( file_io_handle != NULL )
 	{
-		libcerror_error_free(
-		 &error );
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
 	}
-	return( 0 );
+	return( -1 );
 }
 
-/* Tests the libbfoverlay_handle_open function
+/* Tests the libbfoverlay_handle_initialize function
  * Returns 1 if successful or 0 if not
  */
-int bfoverlay_test_handle_open(
-     const system_character_t *source )
+int bfoverlay_test_handle_initialize(
+     void )
 {
-	char narrow_source[ 256 ];
+	libbfoverlay_handle_t *handle   = NULL;
+	libcerror_error_t *error        = NULL;
+	int result                      = 0;
 
-	libbfoverlay_handle_t *handle = NULL;
-	libcerror_error_t *error      = NULL;
-	int result                    = 0;
+#if defined( HAVE_BFOVERLAY_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
 
-	/* Initialize test
+	/* Test regular cases
 	 */
-	result = bfoverlay_test_get_narrow_source(
-	          source,
-	          narrow_source,
-	          256,
+	result = libbfoverlay_handle_initialize(
+	          &handle,
 	          &error );
 
 	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
@@ -439,11 +826,15 @@ int bfoverlay_test_handle_open(
 	 result,
 	 1 );
 
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
 	BFOVERLAY_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libbfoverlay_handle_initialize(
+	result = libbfoverlay_handle_free(
 	          &handle,
 	          &error );
 
@@ -452,7 +843,7 @@ int bfoverlay_test_handle_open(
 	 result,
 	 1 );
 
-	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
 	 "handle",
 	 handle );
 
@@ -460,20 +851,247 @@ int bfoverlay_test_handle_open(
 	 "error",
 	 error );
 
-	/* Test open
+	/* Test error cases
 	 */
-	result = libbfoverlay_handle_open(
-	          handle,
-	          narrow_source,
-	          LIBBFOVERLAY_OPEN_READ,
+	result = libbfoverlay_handle_initialize(
+	          NULL,
 	          &error );
 
 	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	handle = (libbfoverlay_handle_t *) 0x12345678UL;
+
+	result = libbfoverlay_handle_initialize(
+	          &handle,
+	          &error );
+
+	handle = NULL;
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_BFOVERLAY_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libbfoverlay_handle_initialize with malloc failing
+		 */
+		bfoverlay_test_malloc_attempts_before_fail = test_number;
+
+		result = libbfoverlay_handle_initialize(
+		          &handle,
+		          &error );
+
+		if( bfoverlay_test_malloc_attempts_before_fail != -1 )
+		{
+			bfoverlay_test_malloc_attempts_before_fail = -1;
+
+			if( handle != NULL )
+			{
+				libbfoverlay_handle_free(
+				 &handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			BFOVERLAY_TEST_ASSERT_IS_NULL(
+			 "handle",
+			 handle );
+
+			BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libbfoverlay_handle_initialize with memset failing
+		 */
+		bfoverlay_test_memset_attempts_before_fail = test_number;
+
+		result = libbfoverlay_handle_initialize(
+		          &handle,
+		          &error );
+
+		if( bfoverlay_test_memset_attempts_before_fail != -1 )
+		{
+			bfoverlay_test_memset_attempts_before_fail = -1;
+
+			if( handle != NULL )
+			{
+				libbfoverlay_handle_free(
+				 &handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			BFOVERLAY_TEST_ASSERT_IS_NULL(
+			 "handle",
+			 handle );
+
+			BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_BFOVERLAY_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libbfoverlay_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_free function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_handle_free(
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_open function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_open(
+     const system_character_t *source )
+{
+	char narrow_source[ 256 ];
+
+	libbfoverlay_handle_t *handle = NULL;
+	libcerror_error_t *error      = NULL;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = bfoverlay_test_get_narrow_source(
+	          source,
+	          narrow_source,
+	          256,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_handle_initialize(
+	          &handle,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open
+	 */
+	result = libbfoverlay_handle_open(
+	          handle,
+	          narrow_source,
+	          LIBBFOVERLAY_OPEN_READ,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
@@ -1623,6 +2241,7 @@ int bfoverlay_test_handle_read_buffer_at_offset(
 	size64_t size            = 0;
 	size_t read_size         = 0;
 	ssize_t read_count       = 0;
+	off64_t current_offset   = 0;
 	off64_t offset           = 0;
 	off64_t read_offset      = 0;
 	int number_of_tests      = 1024;
@@ -1710,6 +2329,20 @@ int bfoverlay_test_handle_read_buffer_at_offset(
 	}
 	/* Stress test read buffer
 	 */
+	result = libbfoverlay_handle_get_offset(
+	          handle,
+	          &current_offset,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	timestamp = time(
 	             NULL );
 
@@ -1763,8 +2396,8 @@ int bfoverlay_test_handle_read_buffer_at_offset(
 		 "error",
 		 error );
 
-		read_offset += read_count;
-
+		/* Reading at a specific offset does not change the current offset
+		 */
 		result = libbfoverlay_handle_get_offset(
 		          handle,
 		          &offset,
@@ -1778,7 +2411,7 @@ int bfoverlay_test_handle_read_buffer_at_offset(
 		BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
 		 "offset",
 		 offset,
-		 read_offset );
+		 current_offset );
 
 		BFOVERLAY_TEST_ASSERT_IS_NULL(
 		 "error",
@@ -1798,24 +2431,4752 @@ int bfoverlay_test_handle_read_buffer_at_offset(
 	 read_count,
 	 (ssize_t) -1 );
 
-	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libbfoverlay_handle_read_buffer_at_offset(
+	              handle,
+	              NULL,
+	              BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libbfoverlay_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libbfoverlay_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE,
+	              -1,
+	              &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_BFOVERLAY_TEST_RWLOCK )
+
+	/* Test libbfoverlay_handle_read_buffer_at_offset with pthread_rwlock_rdlock failing in libcthreads_read_write_lock_grab_for_read
+	 */
+	bfoverlay_test_pthread_rwlock_rdlock_attempts_before_fail = 0;
+
+	read_count = libbfoverlay_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	if( bfoverlay_test_pthread_rwlock_rdlock_attempts_before_fail != -1 )
+	{
+		bfoverlay_test_pthread_rwlock_rdlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Test libbfoverlay_handle_read_buffer_at_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_read
+	 */
+	bfoverlay_test_pthread_rwlock_unlock_attempts_before_fail = 0;
+
+	read_count = libbfoverlay_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	if( bfoverlay_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
+	{
+		bfoverlay_test_pthread_rwlock_unlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+#endif /* defined( HAVE_BFOVERLAY_TEST_RWLOCK ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_read_vector_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_read_vector_at_offset(
+     libbfoverlay_handle_t *handle )
+{
+	uint8_t buffer[ BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE ];
+	uint8_t vector_data[ BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE ];
+	uint8_t *buffers[ 4 ];
+	size_t buffer_sizes[ 4 ];
+
+	libcerror_error_t *error = NULL;
+	time_t timestamp         = 0;
+	size64_t size            = 0;
+	size_t read_size         = 0;
+	size_t vector_offset     = 0;
+	ssize_t read_count       = 0;
+	off64_t read_offset      = 0;
+	int buffer_index         = 0;
+	int number_of_tests      = 1024;
+	int random_number        = 0;
+	int result               = 0;
+	int test_number          = 0;
+
+	/* Determine size
+	 */
+	result = libbfoverlay_handle_get_size(
+	          handle,
+	          &size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	read_size = BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE;
+
+	if( size < BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE )
+	{
+		read_size = (size_t) size;
+	}
+	buffers[ 0 ]      = vector_data;
+	buffer_sizes[ 0 ] = 1024;
+	buffers[ 1 ]      = &( vector_data[ 1024 ] );
+	buffer_sizes[ 1 ] = 0;
+	buffers[ 2 ]      = &( vector_data[ 1024 ] );
+	buffer_sizes[ 2 ] = 1;
+	buffers[ 3 ]      = &( vector_data[ 1025 ] );
+	buffer_sizes[ 3 ] = BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE - 1025;
+
+	read_count = libbfoverlay_handle_read_vector_at_offset(
+	              handle,
+	              buffers,
+	              buffer_sizes,
+	              4,
+	              0,
+	              &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libbfoverlay_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE,
+	              0,
+	              &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) read_size );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          vector_data,
+	          buffer,
+	          read_size );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Read vector without buffers
+	 */
+	read_count = libbfoverlay_handle_read_vector_at_offset(
+	              handle,
+	              buffers,
+	              buffer_sizes,
+	              0,
+	              0,
+	              &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( size > 8 )
+	{
+		/* Read vector on size boundary
+		 */
+		read_count = libbfoverlay_handle_read_vector_at_offset(
+		              handle,
+		              buffers,
+		              buffer_sizes,
+		              4,
+		              size - 8,
+		              &error );
+
+		BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 8 );
+
+		BFOVERLAY_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read vector beyond size boundary
+		 */
+		read_count = libbfoverlay_handle_read_vector_at_offset(
+		              handle,
+		              buffers,
+		              buffer_sizes,
+		              4,
+		              size + 8,
+		              &error );
+
+		BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 0 );
+
+		BFOVERLAY_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Stress test read vector
+	 * The data read into the buffers should match the data read into a single buffer
+	 */
+	timestamp = time(
+	             NULL );
+
+	srand(
+	 (unsigned int) timestamp );
+
+	for( test_number = 0;
+	     test_number < number_of_tests;
+	     test_number++ )
+	{
+		random_number = rand();
+
+		BFOVERLAY_TEST_ASSERT_GREATER_THAN_INT(
+		 "random_number",
+		 random_number,
+		 -1 );
+
+		if( size > 0 )
+		{
+			read_offset = (off64_t) random_number % size;
+		}
+		read_size = (size_t) random_number % BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE;
+
+		vector_offset = 0;
+
+		for( buffer_index = 0;
+		     buffer_index < 4;
+		     buffer_index++ )
+		{
+			buffers[ buffer_index ] = &( vector_data[ vector_offset ] );
+
+			if( buffer_index == 3 )
+			{
+				buffer_sizes[ buffer_index ] = read_size - vector_offset;
+			}
+			else
+			{
+				buffer_sizes[ buffer_index ] = (size_t) rand() % ( read_size - vector_offset + 1 );
+			}
+			vector_offset += buffer_sizes[ buffer_index ];
+		}
+#if defined( BFOVERLAY_TEST_HANDLE_VERBOSE )
+		fprintf(
+		 stdout,
+		 "libbfoverlay_handle_read_vector_at_offset: at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIzd "\n",
+		 read_offset,
+		 read_offset,
+		 read_size );
+#endif
+		read_count = libbfoverlay_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              read_size,
+		              read_offset,
+		              &error );
+
+		BFOVERLAY_TEST_ASSERT_NOT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		BFOVERLAY_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_size = (size_t) read_count;
+
+		read_count = libbfoverlay_handle_read_vector_at_offset(
+		              handle,
+		              buffers,
+		              buffer_sizes,
+		              4,
+		              read_offset,
+		              &error );
+
+		BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) read_size );
+
+		BFOVERLAY_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          vector_data,
+		          buffer,
+		          read_size );
+
+		BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	buffers[ 0 ]      = vector_data;
+	buffer_sizes[ 0 ] = BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE;
+
+	read_count = libbfoverlay_handle_read_vector_at_offset(
+	              NULL,
+	              buffers,
+	              buffer_sizes,
+	              1,
+	              0,
+	              &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libbfoverlay_handle_read_vector_at_offset(
+	              handle,
+	              NULL,
+	              buffer_sizes,
+	              1,
+	              0,
+	              &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libbfoverlay_handle_read_vector_at_offset(
+	              handle,
+	              buffers,
+	              NULL,
+	              1,
+	              0,
+	              &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libbfoverlay_handle_read_vector_at_offset(
+	              handle,
+	              buffers,
+	              buffer_sizes,
+	              -1,
+	              0,
+	              &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libbfoverlay_handle_read_vector_at_offset(
+	              handle,
+	              buffers,
+	              buffer_sizes,
+	              1,
+	              -1,
+	              &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	buffers[ 0 ] = NULL;
+
+	read_count = libbfoverlay_handle_read_vector_at_offset(
+	              handle,
+	              buffers,
+	              buffer_sizes,
+	              1,
+	              0,
+	              &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	buffers[ 0 ]      = vector_data;
+	buffers[ 1 ]      = vector_data;
+	buffer_sizes[ 1 ] = (size_t) SSIZE_MAX;
+
+	read_count = libbfoverlay_handle_read_vector_at_offset(
+	              handle,
+	              buffers,
+	              buffer_sizes,
+	              2,
+	              0,
+	              &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_read_batch function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_read_batch(
+     libbfoverlay_handle_t *handle )
+{
+	uint8_t batch_data[ BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE ];
+	uint8_t buffer[ BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE ];
+	uint8_t *buffers[ 8 ];
+	size_t buffer_sizes[ 8 ];
+	off64_t offsets[ 8 ];
+	ssize_t read_counts[ 8 ];
+
+	libcerror_error_t *error = NULL;
+	time_t timestamp         = 0;
+	size64_t size            = 0;
+	size_t batch_offset      = 0;
+	ssize_t read_count       = 0;
+	int number_of_tests      = 256;
+	int random_number        = 0;
+	int request_index        = 0;
+	int result               = 0;
+	int test_number          = 0;
+
+	/* Determine size
+	 */
+	result = libbfoverlay_handle_get_size(
+	          handle,
+	          &size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_handle_read_batch(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          0,
+	          read_counts,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Read batch on and beyond size boundary
+	 */
+	buffers[ 0 ]      = batch_data;
+	buffer_sizes[ 0 ] = 16;
+	offsets[ 0 ]      = (off64_t) size - 8;
+	buffers[ 1 ]      = &( batch_data[ 16 ] );
+	buffer_sizes[ 1 ] = 16;
+	offsets[ 1 ]      = (off64_t) size + 8;
+
+	result = libbfoverlay_handle_read_batch(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          2,
+	          read_counts,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( size >= 8 )
+	{
+		BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_counts[ 0 ]",
+		 read_counts[ 0 ],
+		 (ssize_t) 8 );
+	}
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_counts[ 1 ]",
+	 read_counts[ 1 ],
+	 (ssize_t) 0 );
+
+	/* Stress test read batch
+	 * The data read by every request should match the data read with libbfoverlay_handle_read_buffer_at_offset
+	 */
+	timestamp = time(
+	             NULL );
+
+	srand(
+	 (unsigned int) timestamp );
+
+	for( test_number = 0;
+	     test_number < number_of_tests;
+	     test_number++ )
+	{
+		batch_offset = 0;
+
+		for( request_index = 0;
+		     request_index < 8;
+		     request_index++ )
+		{
+			random_number = rand();
+
+			BFOVERLAY_TEST_ASSERT_GREATER_THAN_INT(
+			 "random_number",
+			 random_number,
+			 -1 );
+
+			buffers[ request_index ]      = &( batch_data[ batch_offset ] );
+			buffer_sizes[ request_index ] = (size_t) random_number % ( ( BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE / 8 ) + 1 );
+			offsets[ request_index ]      = 0;
+
+			/* Requests are random, adjacent to or overlapping with the previous request
+			 */
+			if( ( request_index > 0 )
+			 && ( ( random_number % 3 ) == 1 ) )
+			{
+				offsets[ request_index ] = offsets[ request_index - 1 ] + buffer_sizes[ request_index - 1 ];
+			}
+			else if( ( request_index > 0 )
+			      && ( ( random_number % 3 ) == 2 ) )
+			{
+				offsets[ request_index ] = offsets[ request_index - 1 ] + ( buffer_sizes[ request_index - 1 ] / 2 );
+			}
+			else if( size > 0 )
+			{
+				offsets[ request_index ] = (off64_t) rand() % size;
+			}
+			batch_offset += buffer_sizes[ request_index ];
+		}
+		result = libbfoverlay_handle_read_batch(
+		          handle,
+		          buffers,
+		          buffer_sizes,
+		          offsets,
+		          8,
+		          read_counts,
+		          &error );
+
+		BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BFOVERLAY_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( request_index = 0;
+		     request_index < 8;
+		     request_index++ )
+		{
+#if defined( BFOVERLAY_TEST_HANDLE_VERBOSE )
+			fprintf(
+			 stdout,
+			 "libbfoverlay_handle_read_batch: at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIzd "\n",
+			 offsets[ request_index ],
+			 offsets[ request_index ],
+			 buffer_sizes[ request_index ] );
+#endif
+			read_count = libbfoverlay_handle_read_buffer_at_offset(
+			              handle,
+			              buffer,
+			              buffer_sizes[ request_index ],
+			              offsets[ request_index ],
+			              &error );
+
+			BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 read_counts[ request_index ] );
+
+			BFOVERLAY_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = memory_compare(
+			          buffers[ request_index ],
+			          buffer,
+			          (size_t) read_count );
+
+			BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+	}
+	/* Test error cases
+	 */
+	buffers[ 0 ]      = batch_data;
+	buffer_sizes[ 0 ] = BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE;
+	offsets[ 0 ]      = 0;
+
+	result = libbfoverlay_handle_read_batch(
+	          NULL,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          1,
+	          read_counts,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_read_batch(
+	          handle,
+	          NULL,
+	          buffer_sizes,
+	          offsets,
+	          1,
+	          read_counts,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_read_batch(
+	          handle,
+	          buffers,
+	          NULL,
+	          offsets,
+	          1,
+	          read_counts,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_read_batch(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          NULL,
+	          1,
+	          read_counts,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_read_batch(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          -1,
+	          read_counts,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_read_batch(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          1,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offsets[ 0 ] = -1;
+
+	result = libbfoverlay_handle_read_batch(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          1,
+	          read_counts,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offsets[ 0 ] = 0;
+	buffers[ 0 ] = NULL;
+
+	result = libbfoverlay_handle_read_batch(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          1,
+	          read_counts,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	buffers[ 0 ]      = batch_data;
+	buffer_sizes[ 0 ] = (size_t) SSIZE_MAX + 1;
+
+	result = libbfoverlay_handle_read_batch(
+	          handle,
+	          buffers,
+	          buffer_sizes,
+	          offsets,
+	          1,
+	          read_counts,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+
+/* Tests the libbfoverlay_internal_handle_write_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_internal_handle_write_buffer(
+     void )
+{
+	uint8_t buffer[ 1024 ];
+
+	libbfoverlay_handle_t *handle = NULL;
+	libcerror_error_t *error      = NULL;
+	ssize_t write_count           = 0;
+	off64_t offset                = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = bfoverlay_test_handle_generate_overlay(
+	          "bfoverlay_test_internal_write",
+	          0,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_open_overlay(
+	          &handle,
+	          "bfoverlay_test_internal_write",
+	          LIBBFOVERLAY_OPEN_READ_WRITE,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	offset = BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE - 512;
+
+	result = bfoverlay_test_workload_fill_buffer(
+	          buffer,
+	          1024,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
+	          offset,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	( (libbfoverlay_internal_handle_t *) handle )->current_offset = offset;
+
+	write_count = libbfoverlay_internal_handle_write_buffer(
+	               (libbfoverlay_internal_handle_t *) handle,
+	               buffer,
+	               1024,
+	               &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 1024 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "current_offset",
+	 (int64_t) ( (libbfoverlay_internal_handle_t *) handle )->current_offset,
+	 (int64_t) offset + 1024 );
+
+	result = bfoverlay_test_handle_compare_overlay_data(
+	          handle,
+	          offset,
+	          1024,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test the data surrounding the written data is unchanged
+	 */
+	result = bfoverlay_test_handle_compare_overlay_data(
+	          handle,
+	          0,
+	          (size_t) offset,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_compare_overlay_data(
+	          handle,
+	          offset + 1024,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE - 512,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	write_count = libbfoverlay_internal_handle_write_buffer(
+	               NULL,
+	               buffer,
+	               1024,
+	               &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libbfoverlay_internal_handle_write_buffer(
+	               (libbfoverlay_internal_handle_t *) handle,
+	               NULL,
+	               1024,
+	               &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = bfoverlay_test_handle_close_source(
+	          &handle,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	bfoverlay_test_handle_remove_overlay(
+	 "bfoverlay_test_internal_write" );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libbfoverlay_handle_free(
+		 &handle,
+		 NULL );
+	}
+	bfoverlay_test_handle_remove_overlay(
+	 "bfoverlay_test_internal_write" );
+
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT ) */
+
+/* Tests the libbfoverlay_handle_write_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_write_buffer(
+     void )
+{
+	uint8_t buffer[ ( 2 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE ) + 200 ];
+
+	libbfoverlay_handle_t *handle = NULL;
+	libcerror_error_t *error      = NULL;
+	size_t write_size             = 0;
+	ssize_t write_count           = 0;
+	off64_t offset                = 0;
+	off64_t seek_offset           = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = bfoverlay_test_handle_generate_overlay(
+	          "bfoverlay_test_write_buffer",
+	          0,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_open_overlay(
+	          &handle,
+	          "bfoverlay_test_write_buffer",
+	          LIBBFOVERLAY_OPEN_READ_WRITE,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test write of a run that starts and ends within a block
+	 * and spans a whole block in between
+	 */
+	offset     = ( 3 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE ) + 100;
+	write_size = ( 2 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE ) + 200;
+
+	result = bfoverlay_test_workload_fill_buffer(
+	          buffer,
+	          write_size,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
+	          offset,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	seek_offset = libbfoverlay_handle_seek_offset(
+	               handle,
+	               offset,
+	               SEEK_SET,
+	               &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "seek_offset",
+	 (int64_t) seek_offset,
+	 (int64_t) offset );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	write_count = libbfoverlay_handle_write_buffer(
+	               handle,
+	               buffer,
+	               write_size,
+	               &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) write_size );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_handle_get_offset(
+	          handle,
+	          &seek_offset,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "seek_offset",
+	 (int64_t) seek_offset,
+	 (int64_t) offset + write_size );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_compare_overlay_data(
+	          handle,
+	          offset,
+	          write_size,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test the data surrounding the written data in the first and last block is unchanged
+	 */
+	result = bfoverlay_test_handle_compare_overlay_data(
+	          handle,
+	          3 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          100,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_compare_overlay_data(
+	          handle,
+	          offset + write_size,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE - 300,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	write_count = libbfoverlay_handle_write_buffer(
+	               NULL,
+	               buffer,
+	               write_size,
+	               &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libbfoverlay_handle_write_buffer(
+	               handle,
+	               NULL,
+	               write_size,
+	               &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libbfoverlay_handle_write_buffer(
+	               handle,
+	               buffer,
+	               (size_t) SSIZE_MAX + 1,
+	               &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = bfoverlay_test_handle_close_source(
+	          &handle,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	bfoverlay_test_handle_remove_overlay(
+	 "bfoverlay_test_write_buffer" );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libbfoverlay_handle_free(
+		 &handle,
+		 NULL );
+	}
+	bfoverlay_test_handle_remove_overlay(
+	 "bfoverlay_test_write_buffer" );
+
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_write_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_write_buffer_at_offset(
+     void )
+{
+	uint8_t expected_prefix[ BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE ];
+	uint8_t expected_suffix[ BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE ];
+	uint8_t prefix[ BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE ];
+	uint8_t suffix[ BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE ];
+	uint8_t zero_buffer[ BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE ];
+
+	libbfoverlay_handle_t *handle = NULL;
+	libcerror_error_t *error      = NULL;
+	size_t prefix_size            = 0;
+	size_t suffix_size            = 0;
+	size_t write_size             = 0;
+	ssize_t read_count            = 0;
+	ssize_t write_count           = 0;
+	off64_t dirty_offset          = 0;
+	off64_t offset                = 0;
+	off64_t zero_offset           = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 * half of the COW blocks are pre-populated, hence the written blocks
+	 * can be either pre-populated or newly allocated
+	 */
+	result = bfoverlay_test_handle_generate_overlay(
+	          "bfoverlay_test_write_buffer_at_offset",
+	          50,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_open_overlay(
+	          &handle,
+	          "bfoverlay_test_write_buffer_at_offset",
+	          LIBBFOVERLAY_OPEN_READ_WRITE,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test write of a multi-block run with partial blocks at the start and end
+	 */
+	offset      = ( 5 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE ) - 700;
+	write_size  = ( 3 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE ) + 1400;
+	prefix_size = BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE - 700;
+	suffix_size = BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE - 700;
+
+	read_count = libbfoverlay_handle_read_buffer_at_offset(
+	              handle,
+	              expected_prefix,
+	              prefix_size,
+	              offset - prefix_size,
+	              &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) prefix_size );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libbfoverlay_handle_read_buffer_at_offset(
+	              handle,
+	              expected_suffix,
+	              suffix_size,
+	              offset + write_size,
+	              &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) suffix_size );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_write_overlay_data(
+	          handle,
+	          offset,
+	          write_size,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_compare_overlay_data(
+	          handle,
+	          offset,
+	          write_size,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test the data surrounding the written data in the first and last block is unchanged
+	 */
+	read_count = libbfoverlay_handle_read_buffer_at_offset(
+	              handle,
+	              prefix,
+	              prefix_size,
+	              offset - prefix_size,
+	              &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) prefix_size );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          prefix,
+	          expected_prefix,
+	          prefix_size );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	read_count = libbfoverlay_handle_read_buffer_at_offset(
+	              handle,
+	              suffix,
+	              suffix_size,
+	              offset + write_size,
+	              &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) suffix_size );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          suffix,
+	          expected_suffix,
+	          suffix_size );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test write of an all-zero block
+	 */
+	zero_offset = 32 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE;
+
+	if( memory_set(
+	     zero_buffer,
+	     0,
+	     BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE ) == NULL )
+	{
+		goto on_error;
+	}
+
+	write_count = libbfoverlay_handle_write_buffer_at_offset(
+	               handle,
+	               zero_buffer,
+	               BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	               zero_offset,
+	               &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_check_overlay_zeroes(
+	          handle,
+	          zero_offset,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test write with a maximum dirty size where the run exceeds the maximum dirty size
+	 */
+	result = libbfoverlay_handle_set_maximum_dirty_size(
+	          handle,
+	          4 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	dirty_offset = ( 64 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE ) - 100;
+
+	result = bfoverlay_test_handle_write_overlay_data(
+	          handle,
+	          dirty_offset,
+	          6 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test the written data is retained after close and reopen
+	 */
+	result = bfoverlay_test_handle_close_source(
+	          &handle,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_open_overlay(
+	          &handle,
+	          "bfoverlay_test_write_buffer_at_offset",
+	          LIBBFOVERLAY_OPEN_READ,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_compare_overlay_data(
+	          handle,
+	          dirty_offset,
+	          6 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_compare_overlay_data(
+	          handle,
+	          offset,
+	          write_size,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_check_overlay_zeroes(
+	          handle,
+	          zero_offset,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	write_count = libbfoverlay_handle_write_buffer_at_offset(
+	               NULL,
+	               zero_buffer,
+	               BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	               0,
+	               &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_count = libbfoverlay_handle_write_buffer_at_offset(
+	               handle,
+	               zero_buffer,
+	               BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	               -1,
+	               &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = bfoverlay_test_handle_close_source(
+	          &handle,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	bfoverlay_test_handle_remove_overlay(
+	 "bfoverlay_test_write_buffer_at_offset" );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libbfoverlay_handle_free(
+		 &handle,
+		 NULL );
+	}
+	bfoverlay_test_handle_remove_overlay(
+	 "bfoverlay_test_write_buffer_at_offset" );
+
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_seek_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_seek_offset(
+     libbfoverlay_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	off64_t offset           = 0;
+
+	/* Test regular cases
+	 */
+	offset = libbfoverlay_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	size = (size64_t) offset;
+
+	offset = libbfoverlay_handle_seek_offset(
+	          handle,
+	          1024,
+	          SEEK_SET,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 1024 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libbfoverlay_handle_seek_offset(
+	          handle,
+	          -512,
+	          SEEK_CUR,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 512 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libbfoverlay_handle_seek_offset(
+	          handle,
+	          (off64_t) ( size + 512 ),
+	          SEEK_SET,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) ( size + 512 ) );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Seek the next hole, where the end of the data is considered a hole
+	 */
+	offset = libbfoverlay_handle_seek_offset(
+	          handle,
+	          0,
+	          LIBBFOVERLAY_SEEK_HOLE,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_LESS_THAN_UINT64(
+	 "offset",
+	 (uint64_t) offset,
+	 (uint64_t) ( size + 1 ) );
+
+	/* Seek the next data or hole at the end of the data
+	 */
+	offset = libbfoverlay_handle_seek_offset(
+	          handle,
+	          (off64_t) size,
+	          LIBBFOVERLAY_SEEK_DATA,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libbfoverlay_handle_seek_offset(
+	          handle,
+	          (off64_t) size,
+	          LIBBFOVERLAY_SEEK_HOLE,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Reset offset to 0
+	 */
+	offset = libbfoverlay_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	offset = libbfoverlay_handle_seek_offset(
+	          NULL,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libbfoverlay_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_SET,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libbfoverlay_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_CUR,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	offset = libbfoverlay_handle_seek_offset(
+	          handle,
+	          (off64_t) ( -1 * ( size + 1 ) ),
+	          SEEK_END,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_BFOVERLAY_TEST_RWLOCK )
+
+	/* Test libbfoverlay_handle_seek_offset with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
+	 */
+	bfoverlay_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
+
+	offset = libbfoverlay_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	if( bfoverlay_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
+	{
+		bfoverlay_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) -1 );
+
+		BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Test libbfoverlay_handle_seek_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
+	 */
+	bfoverlay_test_pthread_rwlock_unlock_attempts_before_fail = 0;
+
+	offset = libbfoverlay_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	if( bfoverlay_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
+	{
+		bfoverlay_test_pthread_rwlock_unlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) -1 );
+
+		BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+#endif /* defined( HAVE_BFOVERLAY_TEST_RWLOCK ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_discard function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_discard(
+     void )
+{
+	libbfoverlay_handle_t *handle = NULL;
+	libcerror_error_t *error      = NULL;
+	size64_t cow_file_size        = 0;
+	size64_t discarded_file_size  = 0;
+	off64_t offset                = 0;
+	off64_t reused_offset         = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = bfoverlay_test_handle_generate_overlay(
+	          "bfoverlay_test_discard",
+	          0,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_open_overlay(
+	          &handle,
+	          "bfoverlay_test_discard",
+	          LIBBFOVERLAY_OPEN_READ_WRITE,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = 16 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE;
+
+	result = bfoverlay_test_handle_write_overlay_data(
+	          handle,
+	          offset,
+	          4 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_handle_flush(
+	          handle,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_get_file_size(
+	          "bfoverlay_test_discard.cow",
+	          &cow_file_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_handle_discard(
+	          handle,
+	          0,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test discard of a range that does not contain a whole block, which leaves the data unchanged
+	 */
+	result = libbfoverlay_handle_discard(
+	          handle,
+	          offset + 1,
+	          1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_compare_overlay_data(
+	          handle,
+	          offset,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test discard of whole COW blocks, which exposes the data of the lower layers
+	 */
+	result = libbfoverlay_handle_discard(
+	          handle,
+	          offset,
+	          4 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_compare_overlay_data(
+	          handle,
+	          offset,
+	          4 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test the discarded COW blocks are reused by subsequent writes
+	 */
+	reused_offset = 32 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE;
+
+	result = bfoverlay_test_handle_write_overlay_data(
+	          handle,
+	          reused_offset,
+	          4 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_handle_flush(
+	          handle,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_get_file_size(
+	          "bfoverlay_test_discard.cow",
+	          &discarded_file_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT64(
+	 "discarded_file_size",
+	 (uint64_t) discarded_file_size,
+	 (uint64_t) cow_file_size );
+
+	result = bfoverlay_test_handle_compare_overlay_data(
+	          handle,
+	          reused_offset,
+	          4 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_compare_overlay_data(
+	          handle,
+	          offset,
+	          4 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_handle_discard(
+	          NULL,
+	          0,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_discard(
+	          handle,
+	          -1,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = bfoverlay_test_handle_close_source(
+	          &handle,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	bfoverlay_test_handle_remove_overlay(
+	 "bfoverlay_test_discard" );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libbfoverlay_handle_free(
+		 &handle,
+		 NULL );
+	}
+	bfoverlay_test_handle_remove_overlay(
+	 "bfoverlay_test_discard" );
+
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_write_zeroes function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_write_zeroes(
+     void )
+{
+	libbfoverlay_handle_t *handle = NULL;
+	libcerror_error_t *error      = NULL;
+	size_t zeroes_size            = 0;
+	off64_t offset                = 0;
+	off64_t zeroes_offset         = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = bfoverlay_test_handle_generate_overlay(
+	          "bfoverlay_test_write_zeroes",
+	          50,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_open_overlay(
+	          &handle,
+	          "bfoverlay_test_write_zeroes",
+	          LIBBFOVERLAY_OPEN_READ_WRITE,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = 8 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE;
+
+	result = bfoverlay_test_handle_write_overlay_data(
+	          handle,
+	          offset,
+	          4 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_handle_write_zeroes(
+	          handle,
+	          offset,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test write zeroes of a range with partial blocks at the start and end
+	 */
+	zeroes_offset = offset + 300;
+	zeroes_size   = ( 2 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE ) + 600;
+
+	result = libbfoverlay_handle_write_zeroes(
+	          handle,
+	          zeroes_offset,
+	          zeroes_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_check_overlay_zeroes(
+	          handle,
+	          zeroes_offset,
+	          zeroes_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test the data surrounding the zeroes is unchanged
+	 */
+	result = bfoverlay_test_handle_compare_overlay_data(
+	          handle,
+	          offset,
+	          300,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_compare_overlay_data(
+	          handle,
+	          zeroes_offset + zeroes_size,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE + 3196,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test the zeroes are retained after close and reopen
+	 */
+	result = bfoverlay_test_handle_close_source(
+	          &handle,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_open_overlay(
+	          &handle,
+	          "bfoverlay_test_write_zeroes",
+	          LIBBFOVERLAY_OPEN_READ_WRITE,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_check_overlay_zeroes(
+	          handle,
+	          zeroes_offset,
+	          zeroes_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_compare_overlay_data(
+	          handle,
+	          offset,
+	          300,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_compare_overlay_data(
+	          handle,
+	          zeroes_offset + zeroes_size,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE + 3196,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_handle_write_zeroes(
+	          NULL,
+	          0,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_write_zeroes(
+	          handle,
+	          -1,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = bfoverlay_test_handle_close_source(
+	          &handle,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	bfoverlay_test_handle_remove_overlay(
+	 "bfoverlay_test_write_zeroes" );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libbfoverlay_handle_free(
+		 &handle,
+		 NULL );
+	}
+	bfoverlay_test_handle_remove_overlay(
+	 "bfoverlay_test_write_zeroes" );
+
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+
+/* Retrieves the layout of the COW blocks of a generated overlay
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_handle_get_cow_block_layout(
+     libbfoverlay_handle_t *handle,
+     int *number_of_data_blocks,
+     int *number_of_zero_blocks,
+     int *number_of_unordered_blocks,
+     libcerror_error_t **error )
+{
+	libbfoverlay_internal_handle_t *internal_handle = NULL;
+	static char *function                           = "bfoverlay_test_handle_get_cow_block_layout";
+	off64_t file_offset                             = 0;
+	off64_t last_file_offset                        = -1;
+	off64_t offset                                  = 0;
+	off64_t range_end_offset                        = 0;
+	off64_t range_start_offset                      = 0;
+	int result                                      = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libbfoverlay_internal_handle_t *) handle;
+
+	if( internal_handle->cow_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing COW file.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_data_blocks      = 0;
+	*number_of_zero_blocks      = 0;
+	*number_of_unordered_blocks = 0;
+
+	while( (size64_t) offset < internal_handle->cow_file->data_size )
+	{
+		result = libbfoverlay_cow_file_get_block_at_offset(
+		          internal_handle->cow_file,
+		          internal_handle->data_file_io_pool,
+		          internal_handle->cow_file_io_pool_entry,
+		          offset,
+		          &range_start_offset,
+		          &range_end_offset,
+		          &file_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve COW block at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		if( range_end_offset <= offset )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid range end offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( result != 0 )
+		{
+			if( file_offset < 0 )
+			{
+				*number_of_zero_blocks += 1;
+			}
+			else
+			{
+				if( file_offset <= last_file_offset )
+				{
+					*number_of_unordered_blocks += 1;
+				}
+				last_file_offset = file_offset;
+
+				*number_of_data_blocks += 1;
+			}
+		}
+		offset = range_end_offset;
+	}
+	return( 1 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT ) */
+
+/* Tests the libbfoverlay_handle_write_compacted_cow_file function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_write_compacted_cow_file(
+     void )
+{
+	uint8_t *compacted_data       = NULL;
+	uint8_t *data                 = NULL;
+	libbfoverlay_handle_t *handle = NULL;
+	libcerror_error_t *error      = NULL;
+	ssize_t read_count            = 0;
+	int result                    = 0;
+
+#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+	int compacted_number_of_data_blocks      = 0;
+	int compacted_number_of_unordered_blocks = 0;
+	int compacted_number_of_zero_blocks      = 0;
+	int number_of_data_blocks                = 0;
+	int number_of_unordered_blocks           = 0;
+	int number_of_zero_blocks                = 0;
+#endif
+
+	/* Initialize test
+	 * the pre-populated COW blocks are stored in random order
+	 */
+	result = bfoverlay_test_handle_generate_overlay(
+	          "bfoverlay_test_write_compacted_cow_file",
+	          50,
+	          1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_open_overlay(
+	          &handle,
+	          "bfoverlay_test_write_compacted_cow_file",
+	          LIBBFOVERLAY_OPEN_READ_WRITE,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Add zero block markers
+	 */
+	result = libbfoverlay_handle_write_zeroes(
+	          handle,
+	          40 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          2 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * BFOVERLAY_TEST_HANDLE_OVERLAY_MEDIA_SIZE );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	read_count = libbfoverlay_handle_read_buffer_at_offset(
+	              handle,
+	              data,
+	              BFOVERLAY_TEST_HANDLE_OVERLAY_MEDIA_SIZE,
+	              0,
+	              &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) BFOVERLAY_TEST_HANDLE_OVERLAY_MEDIA_SIZE );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+	result = bfoverlay_test_handle_get_cow_block_layout(
+	          handle,
+	          &number_of_data_blocks,
+	          &number_of_zero_blocks,
+	          &number_of_unordered_blocks,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_unordered_blocks",
+	 number_of_unordered_blocks,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "number_of_zero_blocks",
+	 number_of_zero_blocks,
+	 2 );
+#endif
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_handle_write_compacted_cow_file(
+	          handle,
+	          "bfoverlay_test_write_compacted_cow_file_compacted.cow",
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_handle_write_compacted_cow_file(
+	          NULL,
+	          "bfoverlay_test_write_compacted_cow_file_compacted.cow",
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_write_compacted_cow_file(
+	          handle,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test the overlay with the compacted COW file contains the same data
+	 */
+	result = bfoverlay_test_handle_close_source(
+	          &handle,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = remove(
+	          "bfoverlay_test_write_compacted_cow_file.cow" );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = rename(
+	          "bfoverlay_test_write_compacted_cow_file_compacted.cow",
+	          "bfoverlay_test_write_compacted_cow_file.cow" );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = bfoverlay_test_handle_open_overlay(
+	          &handle,
+	          "bfoverlay_test_write_compacted_cow_file",
+	          LIBBFOVERLAY_OPEN_READ,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	compacted_data = (uint8_t *) memory_allocate(
+	                              sizeof( uint8_t ) * BFOVERLAY_TEST_HANDLE_OVERLAY_MEDIA_SIZE );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "compacted_data",
+	 compacted_data );
+
+	read_count = libbfoverlay_handle_read_buffer_at_offset(
+	              handle,
+	              compacted_data,
+	              BFOVERLAY_TEST_HANDLE_OVERLAY_MEDIA_SIZE,
+	              0,
+	              &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) BFOVERLAY_TEST_HANDLE_OVERLAY_MEDIA_SIZE );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          compacted_data,
+	          data,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_MEDIA_SIZE );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test the data blocks of the compacted COW file are stored in logical order
+	 * and the zero block markers are preserved
+	 */
+#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+	result = bfoverlay_test_handle_get_cow_block_layout(
+	          handle,
+	          &compacted_number_of_data_blocks,
+	          &compacted_number_of_zero_blocks,
+	          &compacted_number_of_unordered_blocks,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "compacted_number_of_data_blocks",
+	 compacted_number_of_data_blocks,
+	 number_of_data_blocks );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "compacted_number_of_zero_blocks",
+	 compacted_number_of_zero_blocks,
+	 number_of_zero_blocks );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "compacted_number_of_unordered_blocks",
+	 compacted_number_of_unordered_blocks,
+	 0 );
+#endif
+
+	/* Clean up
+	 */
+	memory_free(
+	 compacted_data );
+
+	compacted_data = NULL;
+
+	memory_free(
+	 data );
+
+	data = NULL;
+
+	result = bfoverlay_test_handle_close_source(
+	          &handle,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	bfoverlay_test_handle_remove_overlay(
+	 "bfoverlay_test_write_compacted_cow_file" );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( compacted_data != NULL )
+	{
+		memory_free(
+		 compacted_data );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( handle != NULL )
+	{
+		libbfoverlay_handle_free(
+		 &handle,
+		 NULL );
+	}
+	remove(
+	 "bfoverlay_test_write_compacted_cow_file_compacted.cow" );
+
+	bfoverlay_test_handle_remove_overlay(
+	 "bfoverlay_test_write_compacted_cow_file" );
+
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_get_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_get_offset(
+     libbfoverlay_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	off64_t offset           = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_handle_get_offset(
+	          handle,
+	          &offset,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_handle_get_offset(
+	          NULL,
+	          &offset,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_get_offset(
+	          handle,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_get_size function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_get_size(
+     libbfoverlay_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_handle_get_size(
+	          handle,
+	          &size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_handle_get_size(
+	          NULL,
+	          &size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_get_size(
+	          handle,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_get_extents function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_get_extents(
+     libbfoverlay_handle_t *handle )
+{
+	uint8_t buffer[ BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE ];
+	uint8_t zero_buffer[ BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE ];
+	off64_t extent_data_offsets[ BFOVERLAY_TEST_HANDLE_MAXIMUM_NUMBER_OF_EXTENTS ];
+	off64_t extent_offsets[ BFOVERLAY_TEST_HANDLE_MAXIMUM_NUMBER_OF_EXTENTS ];
+	size64_t extent_sizes[ BFOVERLAY_TEST_HANDLE_MAXIMUM_NUMBER_OF_EXTENTS ];
+	uint32_t extent_flags[ BFOVERLAY_TEST_HANDLE_MAXIMUM_NUMBER_OF_EXTENTS ];
+	int extent_layer_indexes[ BFOVERLAY_TEST_HANDLE_MAXIMUM_NUMBER_OF_EXTENTS ];
+
+	libcerror_error_t *error   = NULL;
+	size64_t first_extent_size = 0;
+	size64_t size              = 0;
+	size64_t total_size        = 0;
+	size_t read_size           = 0;
+	ssize_t read_count         = 0;
+	int extent_index           = 0;
+	int number_of_extents      = 0;
+	int number_of_layers       = 0;
+	int result                 = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_handle_get_size(
+	          handle,
+	          &size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_handle_get_number_of_layers(
+	          handle,
+	          &number_of_layers,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_set(
+	          zero_buffer,
+	          0,
+	          BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE ) != NULL;
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_handle_get_extents(
+	          handle,
+	          0,
+	          size,
+	          extent_offsets,
+	          extent_sizes,
+	          extent_flags,
+	          extent_layer_indexes,
+	          extent_data_offsets,
+	          BFOVERLAY_TEST_HANDLE_MAXIMUM_NUMBER_OF_EXTENTS,
+	          &number_of_extents,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( size > 0 )
+	{
+		BFOVERLAY_TEST_ASSERT_GREATER_THAN_INT(
+		 "number_of_extents",
+		 number_of_extents,
+		 0 );
+	}
+	/* The extents should be consecutive and sparse extents should read as zero bytes
+	 */
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+		 "extent_offsets[ extent_index ]",
+		 (int64_t) extent_offsets[ extent_index ],
+		 (int64_t) total_size );
+
+		BFOVERLAY_TEST_ASSERT_NOT_EQUAL_INT64(
+		 "extent_sizes[ extent_index ]",
+		 (int64_t) extent_sizes[ extent_index ],
+		 (int64_t) 0 );
+
+		total_size += extent_sizes[ extent_index ];
+
+		if( ( extent_flags[ extent_index ] & ( LIBBFOVERLAY_EXTENT_FLAG_IS_SPARSE | LIBBFOVERLAY_EXTENT_FLAG_IS_COW ) ) != 0 )
+		{
+			BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+			 "extent_layer_indexes[ extent_index ]",
+			 extent_layer_indexes[ extent_index ],
+			 -1 );
+		}
+		else
+		{
+			BFOVERLAY_TEST_ASSERT_GREATER_THAN_INT(
+			 "extent_layer_indexes[ extent_index ]",
+			 extent_layer_indexes[ extent_index ],
+			 -1 );
+
+			BFOVERLAY_TEST_ASSERT_LESS_THAN_INT(
+			 "extent_layer_indexes[ extent_index ]",
+			 extent_layer_indexes[ extent_index ],
+			 number_of_layers );
+		}
+		if( ( extent_flags[ extent_index ] & LIBBFOVERLAY_EXTENT_FLAG_IS_SPARSE ) != 0 )
+		{
+			read_size = BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE;
+
+			if( (size64_t) read_size > extent_sizes[ extent_index ] )
+			{
+				read_size = (size_t) extent_sizes[ extent_index ];
+			}
+			read_count = libbfoverlay_handle_read_buffer_at_offset(
+			              handle,
+			              buffer,
+			              read_size,
+			              extent_offsets[ extent_index ],
+			              &error );
+
+			BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) read_size );
+
+			BFOVERLAY_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = memory_compare(
+			          buffer,
+			          zero_buffer,
+			          read_size );
+
+			BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+	}
+	if( number_of_extents < BFOVERLAY_TEST_HANDLE_MAXIMUM_NUMBER_OF_EXTENTS )
+	{
+		BFOVERLAY_TEST_ASSERT_EQUAL_UINT64(
+		 "total_size",
+		 (uint64_t) total_size,
+		 (uint64_t) size );
+	}
+	/* Retrieve a single extent
+	 */
+	if( number_of_extents > 0 )
+	{
+		first_extent_size = extent_sizes[ 0 ];
+
+		result = libbfoverlay_handle_get_extents(
+		          handle,
+		          0,
+		          size,
+		          extent_offsets,
+		          extent_sizes,
+		          extent_flags,
+		          extent_layer_indexes,
+		          extent_data_offsets,
+		          1,
+		          &number_of_extents,
+		          &error );
+
+		BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BFOVERLAY_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+		 "number_of_extents",
+		 number_of_extents,
+		 1 );
+
+		BFOVERLAY_TEST_ASSERT_EQUAL_UINT64(
+		 "extent_sizes[ 0 ]",
+		 (uint64_t) extent_sizes[ 0 ],
+		 (uint64_t) first_extent_size );
+	}
+	/* Retrieve extents beyond the size
+	 */
+	result = libbfoverlay_handle_get_extents(
+	          handle,
+	          (off64_t) size,
+	          size,
+	          extent_offsets,
+	          extent_sizes,
+	          extent_flags,
+	          extent_layer_indexes,
+	          extent_data_offsets,
+	          BFOVERLAY_TEST_HANDLE_MAXIMUM_NUMBER_OF_EXTENTS,
+	          &number_of_extents,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "number_of_extents",
+	 number_of_extents,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_handle_get_extents(
+	          NULL,
+	          0,
+	          size,
+	          extent_offsets,
+	          extent_sizes,
+	          extent_flags,
+	          extent_layer_indexes,
+	          extent_data_offsets,
+	          BFOVERLAY_TEST_HANDLE_MAXIMUM_NUMBER_OF_EXTENTS,
+	          &number_of_extents,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_get_extents(
+	          handle,
+	          -1,
+	          size,
+	          extent_offsets,
+	          extent_sizes,
+	          extent_flags,
+	          extent_layer_indexes,
+	          extent_data_offsets,
+	          BFOVERLAY_TEST_HANDLE_MAXIMUM_NUMBER_OF_EXTENTS,
+	          &number_of_extents,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_get_extents(
+	          handle,
+	          0,
+	          size,
+	          NULL,
+	          extent_sizes,
+	          extent_flags,
+	          extent_layer_indexes,
+	          extent_data_offsets,
+	          BFOVERLAY_TEST_HANDLE_MAXIMUM_NUMBER_OF_EXTENTS,
+	          &number_of_extents,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_get_extents(
+	          handle,
+	          0,
+	          size,
+	          extent_offsets,
+	          NULL,
+	          extent_flags,
+	          extent_layer_indexes,
+	          extent_data_offsets,
+	          BFOVERLAY_TEST_HANDLE_MAXIMUM_NUMBER_OF_EXTENTS,
+	          &number_of_extents,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_get_extents(
+	          handle,
+	          0,
+	          size,
+	          extent_offsets,
+	          extent_sizes,
+	          NULL,
+	          extent_layer_indexes,
+	          extent_data_offsets,
+	          BFOVERLAY_TEST_HANDLE_MAXIMUM_NUMBER_OF_EXTENTS,
+	          &number_of_extents,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_get_extents(
+	          handle,
+	          0,
+	          size,
+	          extent_offsets,
+	          extent_sizes,
+	          extent_flags,
+	          NULL,
+	          extent_data_offsets,
+	          BFOVERLAY_TEST_HANDLE_MAXIMUM_NUMBER_OF_EXTENTS,
+	          &number_of_extents,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_get_extents(
+	          handle,
+	          0,
+	          size,
+	          extent_offsets,
+	          extent_sizes,
+	          extent_flags,
+	          extent_layer_indexes,
+	          NULL,
+	          BFOVERLAY_TEST_HANDLE_MAXIMUM_NUMBER_OF_EXTENTS,
+	          &number_of_extents,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_get_extents(
+	          handle,
+	          0,
+	          size,
+	          extent_offsets,
+	          extent_sizes,
+	          extent_flags,
+	          extent_layer_indexes,
+	          extent_data_offsets,
+	          -1,
+	          &number_of_extents,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_get_extents(
+	          handle,
+	          0,
+	          size,
+	          extent_offsets,
+	          extent_sizes,
+	          extent_flags,
+	          extent_layer_indexes,
+	          extent_data_offsets,
+	          BFOVERLAY_TEST_HANDLE_MAXIMUM_NUMBER_OF_EXTENTS,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_get_maximum_cache_size function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_get_maximum_cache_size(
+     libbfoverlay_handle_t *handle )
+{
+	libcerror_error_t *error  = NULL;
+	size_t maximum_cache_size = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_handle_get_maximum_cache_size(
+	          handle,
+	          &maximum_cache_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_handle_get_maximum_cache_size(
+	          NULL,
+	          &maximum_cache_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_get_maximum_cache_size(
+	          handle,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_set_maximum_cache_size function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_set_maximum_cache_size(
+     libbfoverlay_handle_t *handle )
+{
+	libcerror_error_t *error  = NULL;
+	size_t maximum_cache_size = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_handle_get_maximum_cache_size(
+	          handle,
+	          &maximum_cache_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_handle_set_maximum_cache_size(
+	          handle,
+	          maximum_cache_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_handle_set_maximum_cache_size(
+	          NULL,
+	          maximum_cache_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_set_maximum_cache_size(
+	          handle,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_get_maximum_dirty_size function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_get_maximum_dirty_size(
+     libbfoverlay_handle_t *handle )
+{
+	libcerror_error_t *error  = NULL;
+	size_t maximum_dirty_size = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_handle_get_maximum_dirty_size(
+	          handle,
+	          &maximum_dirty_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_handle_get_maximum_dirty_size(
+	          NULL,
+	          &maximum_dirty_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_get_maximum_dirty_size(
+	          handle,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_set_maximum_dirty_size function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_set_maximum_dirty_size(
+     libbfoverlay_handle_t *handle )
+{
+	libcerror_error_t *error  = NULL;
+	size_t maximum_dirty_size = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_handle_get_maximum_dirty_size(
+	          handle,
+	          &maximum_dirty_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_handle_set_maximum_dirty_size(
+	          handle,
+	          maximum_dirty_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_handle_set_maximum_dirty_size(
+	          NULL,
+	          maximum_dirty_size,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_set_maximum_dirty_size(
+	          handle,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_get_number_of_layers function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_get_number_of_layers(
+     libbfoverlay_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int number_of_layers     = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_handle_get_number_of_layers(
+	          handle,
+	          &number_of_layers,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_layers",
+	 number_of_layers,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_handle_get_number_of_layers(
+	          NULL,
+	          &number_of_layers,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_get_number_of_layers(
+	          handle,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_get_statistics function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_get_statistics(
+     libbfoverlay_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	uint64_t value           = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_handle_get_statistics(
+	          handle,
+	          LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_BYTES_READ,
+	          &value,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_handle_get_statistics(
+	          NULL,
+	          LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_BYTES_READ,
+	          &value,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_get_statistics(
+	          handle,
+	          -1,
+	          &value,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_get_statistics(
+	          handle,
+	          LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_BYTES_READ,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_get_layer_statistics function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_get_layer_statistics(
+     libbfoverlay_handle_t *handle )
+{
+	libcerror_error_t *error         = NULL;
+	uint64_t number_of_bytes_read    = 0;
+	uint64_t number_of_read_requests = 0;
+	int result                       = 0;
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_handle_get_layer_statistics(
+	          handle,
+	          0,
+	          &number_of_bytes_read,
+	          &number_of_read_requests,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_handle_get_layer_statistics(
+	          NULL,
+	          0,
+	          &number_of_bytes_read,
+	          &number_of_read_requests,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_handle_get_layer_statistics(
+	          handle,
+	          -1,
+	          &number_of_bytes_read,
+	          &number_of_read_requests,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_reset_statistics function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_reset_statistics(
+     libbfoverlay_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	uint64_t value           = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_handle_reset_statistics(
+	          handle,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_handle_get_statistics(
+	          handle,
+	          LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_READ_REQUESTS,
+	          &value,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_handle_reset_statistics(
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_set_record_statistics function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_set_record_statistics(
+     libbfoverlay_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_handle_set_record_statistics(
+	          handle,
+	          1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_handle_set_record_statistics(
+	          handle,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_handle_set_record_statistics(
+	          NULL,
+	          1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_set_record_latency_histograms function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_set_record_latency_histograms(
+     libbfoverlay_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_handle_set_record_latency_histograms(
+	          handle,
+	          1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_handle_set_record_latency_histograms(
+	          handle,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_handle_set_record_latency_histograms(
+	          NULL,
+	          1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_handle_get_latency_histogram function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_handle_get_latency_histogram(
+     libbfoverlay_handle_t *handle )
+{
+	uint64_t bucket_counts[ LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_handle_get_latency_histogram(
+	          handle,
+	          LIBBFOVERLAY_LATENCY_PATH_READ_BASE_LAYER,
+	          bucket_counts,
+	          LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	read_count = libbfoverlay_handle_read_buffer_at_offset(
-	              handle,
-	              NULL,
-	              BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE,
-	              0,
-	              &error );
+	/* Test error cases
+	 */
+	result = libbfoverlay_handle_get_latency_histogram(
+	          NULL,
+	          LIBBFOVERLAY_LATENCY_PATH_READ_BASE_LAYER,
+	          bucket_counts,
+	          LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS,
+	          &error );
 
-	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1824,17 +7185,17 @@ int bfoverlay_test_handle_read_buffer_at_offset(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libbfoverlay_handle_read_buffer_at_offset(
-	              handle,
-	              buffer,
-	              (size_t) SSIZE_MAX + 1,
-	              0,
-	              &error );
+	result = libbfoverlay_handle_get_latency_histogram(
+	          handle,
+	          -1,
+	          bucket_counts,
+	          LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS,
+	          &error );
 
-	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1843,17 +7204,17 @@ int bfoverlay_test_handle_read_buffer_at_offset(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libbfoverlay_handle_read_buffer_at_offset(
-	              handle,
-	              buffer,
-	              BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE,
-	              -1,
-	              &error );
+	result = libbfoverlay_handle_get_latency_histogram(
+	          handle,
+	          LIBBFOVERLAY_LATENCY_PATH_READ_BASE_LAYER,
+	          NULL,
+	          LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS,
+	          &error );
 
-	BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1862,68 +7223,6 @@ int bfoverlay_test_handle_read_buffer_at_offset(
 	libcerror_error_free(
 	 &error );
 
-#if defined( HAVE_BFOVERLAY_TEST_RWLOCK )
-
-	/* Test libbfoverlay_handle_read_buffer_at_offset with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
-	 */
-	bfoverlay_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
-
-	read_count = libbfoverlay_handle_read_buffer_at_offset(
-	              handle,
-	              buffer,
-	              BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE,
-	              0,
-	              &error );
-
-	if( bfoverlay_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
-	{
-		bfoverlay_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
-	}
-	else
-	{
-		BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) -1 );
-
-		BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
-	/* Test libbfoverlay_handle_read_buffer_at_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
-	 */
-	bfoverlay_test_pthread_rwlock_unlock_attempts_before_fail = 0;
-
-	read_count = libbfoverlay_handle_read_buffer_at_offset(
-	              handle,
-	              buffer,
-	              BFOVERLAY_TEST_HANDLE_READ_BUFFER_SIZE,
-	              0,
-	              &error );
-
-	if( bfoverlay_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
-	{
-		bfoverlay_test_pthread_rwlock_unlock_attempts_before_fail = -1;
-	}
-	else
-	{
-		BFOVERLAY_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) -1 );
-
-		BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
-#endif /* defined( HAVE_BFOVERLAY_TEST_RWLOCK ) */
-
 	return( 1 );
 
 on_error:
@@ -1935,254 +7234,244 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libbfoverlay_handle_seek_offset function
+/* Tests the libbfoverlay_handle_flush function
  * Returns 1 if successful or 0 if not
  */
-int bfoverlay_test_handle_seek_offset(
-     libbfoverlay_handle_t *handle )
+int bfoverlay_test_handle_flush(
+     void )
 {
-	libcerror_error_t *error = NULL;
-	size64_t size            = 0;
-	off64_t offset           = 0;
+	libbfoverlay_handle_t *handle = NULL;
+	libcerror_error_t *error      = NULL;
+	size64_t cow_file_size        = 0;
+	size64_t reused_file_size     = 0;
+	off64_t offset                = 0;
+	off64_t reused_offset         = 0;
+	int result                    = 0;
 
-	/* Test regular cases
+	/* Initialize test
 	 */
-	offset = libbfoverlay_handle_seek_offset(
-	          handle,
+	result = bfoverlay_test_handle_generate_overlay(
+	          "bfoverlay_test_flush",
+	          0,
 	          0,
-	          SEEK_END,
 	          &error );
 
-	BFOVERLAY_TEST_ASSERT_NOT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	BFOVERLAY_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	size = (size64_t) offset;
+	result = bfoverlay_test_handle_open_overlay(
+	          &handle,
+	          "bfoverlay_test_flush",
+	          LIBBFOVERLAY_OPEN_READ_WRITE,
+	          &error );
 
-	offset = libbfoverlay_handle_seek_offset(
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_handle_flush(
 	          handle,
-	          1024,
-	          SEEK_SET,
 	          &error );
 
-	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 1024 );
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	BFOVERLAY_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	offset = libbfoverlay_handle_seek_offset(
+	/* Test flush with a maximum dirty size of blocks that were written and discarded
+	 */
+	result = libbfoverlay_handle_set_maximum_dirty_size(
 	          handle,
-	          -512,
-	          SEEK_CUR,
+	          16 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
 	          &error );
 
-	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 512 );
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	BFOVERLAY_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	offset = libbfoverlay_handle_seek_offset(
+	offset = 16 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE;
+
+	result = bfoverlay_test_handle_write_overlay_data(
 	          handle,
-	          (off64_t) ( size + 512 ),
-	          SEEK_SET,
+	          offset,
+	          4 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
 	          &error );
 
-	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) ( size + 512 ) );
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	BFOVERLAY_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Reset offset to 0
-	 */
-	offset = libbfoverlay_handle_seek_offset(
+	result = libbfoverlay_handle_flush(
 	          handle,
-	          0,
-	          SEEK_SET,
 	          &error );
 
-	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	BFOVERLAY_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	offset = libbfoverlay_handle_seek_offset(
-	          NULL,
-	          0,
-	          SEEK_SET,
+	result = bfoverlay_test_handle_get_file_size(
+	          "bfoverlay_test_flush.cow",
+	          &cow_file_size,
 	          &error );
 
-	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	offset = libbfoverlay_handle_seek_offset(
+	result = libbfoverlay_handle_discard(
 	          handle,
-	          -1,
-	          SEEK_SET,
+	          offset,
+	          4 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
 	          &error );
 
-	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	offset = libbfoverlay_handle_seek_offset(
+	result = libbfoverlay_handle_flush(
 	          handle,
-	          -1,
-	          SEEK_CUR,
 	          &error );
 
-	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	offset = libbfoverlay_handle_seek_offset(
-	          handle,
-	          (off64_t) ( -1 * ( size + 1 ) ),
-	          SEEK_END,
+	/* Test the discarded blocks are reused after close and reopen
+	 */
+	result = bfoverlay_test_handle_close_source(
+	          &handle,
 	          &error );
 
-	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
-	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	result = bfoverlay_test_handle_open_overlay(
+	          &handle,
+	          "bfoverlay_test_flush",
+	          LIBBFOVERLAY_OPEN_READ_WRITE,
+	          &error );
 
-#if defined( HAVE_BFOVERLAY_TEST_RWLOCK )
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	/* Test libbfoverlay_handle_seek_offset with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
-	 */
-	bfoverlay_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
 
-	offset = libbfoverlay_handle_seek_offset(
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bfoverlay_test_handle_compare_overlay_data(
 	          handle,
+	          offset,
+	          4 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
 	          0,
-	          SEEK_SET,
 	          &error );
 
-	if( bfoverlay_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
-	{
-		bfoverlay_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
-	}
-	else
-	{
-		BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 (int64_t) offset,
-		 (int64_t) -1 );
-
-		BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		libcerror_error_free(
-		 &error );
-	}
-	/* Test libbfoverlay_handle_seek_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
-	 */
-	bfoverlay_test_pthread_rwlock_unlock_attempts_before_fail = 0;
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	offset = libbfoverlay_handle_seek_offset(
+	result = libbfoverlay_handle_set_maximum_dirty_size(
 	          handle,
-	          0,
-	          SEEK_SET,
+	          16 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
 	          &error );
 
-	if( bfoverlay_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
-	{
-		bfoverlay_test_pthread_rwlock_unlock_attempts_before_fail = -1;
-	}
-	else
-	{
-		BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 (int64_t) offset,
-		 (int64_t) -1 );
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		libcerror_error_free(
-		 &error );
-	}
-#endif /* defined( HAVE_BFOVERLAY_TEST_RWLOCK ) */
+	reused_offset = 32 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE;
 
-	return( 1 );
+	result = bfoverlay_test_handle_write_overlay_data(
+	          handle,
+	          reused_offset,
+	          4 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
+	          &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-/* Tests the libbfoverlay_handle_get_offset function
- * Returns 1 if successful or 0 if not
- */
-int bfoverlay_test_handle_get_offset(
-     libbfoverlay_handle_t *handle )
-{
-	libcerror_error_t *error = NULL;
-	off64_t offset           = 0;
-	int result               = 0;
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* Test regular cases
-	 */
-	result = libbfoverlay_handle_get_offset(
+	result = libbfoverlay_handle_flush(
 	          handle,
-	          &offset,
 	          &error );
 
 	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
@@ -2194,68 +7483,46 @@ int bfoverlay_test_handle_get_offset(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libbfoverlay_handle_get_offset(
-	          NULL,
-	          &offset,
+	result = bfoverlay_test_handle_get_file_size(
+	          "bfoverlay_test_flush.cow",
+	          &reused_file_size,
 	          &error );
 
 	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT64(
+	 "reused_file_size",
+	 (uint64_t) reused_file_size,
+	 (uint64_t) cow_file_size );
 
-	result = libbfoverlay_handle_get_offset(
+	result = bfoverlay_test_handle_compare_overlay_data(
 	          handle,
-	          NULL,
+	          reused_offset,
+	          4 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          BFOVERLAY_TEST_HANDLE_OVERLAY_WRITE_LAYER,
 	          &error );
 
 	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
-
-/* Tests the libbfoverlay_handle_get_size function
- * Returns 1 if successful or 0 if not
- */
-int bfoverlay_test_handle_get_size(
-     libbfoverlay_handle_t *handle )
-{
-	libcerror_error_t *error = NULL;
-	size64_t size            = 0;
-	int result               = 0;
-
-	/* Test regular cases
-	 */
-	result = libbfoverlay_handle_get_size(
+	result = bfoverlay_test_handle_compare_overlay_data(
 	          handle,
-	          &size,
+	          offset,
+	          4 * BFOVERLAY_TEST_HANDLE_OVERLAY_BLOCK_SIZE,
+	          0,
 	          &error );
 
 	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
@@ -2269,9 +7536,8 @@ int bfoverlay_test_handle_get_size(
 
 	/* Test error cases
 	 */
-	result = libbfoverlay_handle_get_size(
+	result = libbfoverlay_handle_flush(
 	          NULL,
-	          &size,
 	          &error );
 
 	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
@@ -2286,22 +7552,23 @@ int bfoverlay_test_handle_get_size(
 	libcerror_error_free(
 	 &error );
 
-	result = libbfoverlay_handle_get_size(
-	          handle,
-	          NULL,
+	/* Clean up
+	 */
+	result = bfoverlay_test_handle_close_source(
+	          &handle,
 	          &error );
 
 	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 0 );
 
-	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	bfoverlay_test_handle_remove_overlay(
+	 "bfoverlay_test_flush" );
 
 	return( 1 );
 
@@ -2311,6 +7578,15 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( handle != NULL )
+	{
+		libbfoverlay_handle_free(
+		 &handle,
+		 NULL );
+	}
+	bfoverlay_test_handle_remove_overlay(
+	 "bfoverlay_test_flush" );
+
 	return( 0 );
 }
 
@@ -2371,6 +7647,38 @@ int main(
 	 "libbfoverlay_handle_free",
 	 bfoverlay_test_handle_free );
 
+#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_internal_handle_write_buffer",
+	 bfoverlay_test_internal_handle_write_buffer );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT ) */
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_handle_write_buffer",
+	 bfoverlay_test_handle_write_buffer );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_handle_write_buffer_at_offset",
+	 bfoverlay_test_handle_write_buffer_at_offset );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_handle_discard",
+	 bfoverlay_test_handle_discard );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_handle_write_zeroes",
+	 bfoverlay_test_handle_write_zeroes );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_handle_write_compacted_cow_file",
+	 bfoverlay_test_handle_write_compacted_cow_file );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_handle_flush",
+	 bfoverlay_test_handle_flush );
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	if( source != NULL )
 	{
@@ -2489,15 +7797,15 @@ int main(
 		 bfoverlay_test_handle_read_buffer_at_offset,
 		 handle );
 
-#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
-
-		/* TODO: add tests for libbfoverlay_internal_handle_write_buffer */
-
-#endif /* defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT ) */
-
-		/* TODO: add tests for libbfoverlay_handle_write_buffer */
+		BFOVERLAY_TEST_RUN_WITH_ARGS(
+		 "libbfoverlay_handle_read_vector_at_offset",
+		 bfoverlay_test_handle_read_vector_at_offset,
+		 handle );
 
-		/* TODO: add tests for libbfoverlay_handle_write_buffer_at_offset */
+		BFOVERLAY_TEST_RUN_WITH_ARGS(
+		 "libbfoverlay_handle_read_batch",
+		 bfoverlay_test_handle_read_batch,
+		 handle );
 
 #if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
 
@@ -2510,6 +7818,8 @@ int main(
 		 bfoverlay_test_handle_seek_offset,
 		 handle );
 
+		/* TODO: add tests for libbfoverlay_handle_resize */
+
 		BFOVERLAY_TEST_RUN_WITH_ARGS(
 		 "libbfoverlay_handle_get_offset",
 		 bfoverlay_test_handle_get_offset,
@@ -2520,6 +7830,66 @@ int main(
 		 bfoverlay_test_handle_get_size,
 		 handle );
 
+		BFOVERLAY_TEST_RUN_WITH_ARGS(
+		 "libbfoverlay_handle_get_extents",
+		 bfoverlay_test_handle_get_extents,
+		 handle );
+
+		BFOVERLAY_TEST_RUN_WITH_ARGS(
+		 "libbfoverlay_handle_get_maximum_cache_size",
+		 bfoverlay_test_handle_get_maximum_cache_size,
+		 handle );
+
+		BFOVERLAY_TEST_RUN_WITH_ARGS(
+		 "libbfoverlay_handle_set_maximum_cache_size",
+		 bfoverlay_test_handle_set_maximum_cache_size,
+		 handle );
+
+		BFOVERLAY_TEST_RUN_WITH_ARGS(
+		 "libbfoverlay_handle_get_maximum_dirty_size",
+		 bfoverlay_test_handle_get_maximum_dirty_size,
+		 handle );
+
+		BFOVERLAY_TEST_RUN_WITH_ARGS(
+		 "libbfoverlay_handle_set_maximum_dirty_size",
+		 bfoverlay_test_handle_set_maximum_dirty_size,
+		 handle );
+
+		BFOVERLAY_TEST_RUN_WITH_ARGS(
+		 "libbfoverlay_handle_get_number_of_layers",
+		 bfoverlay_test_handle_get_number_of_layers,
+		 handle );
+
+		BFOVERLAY_TEST_RUN_WITH_ARGS(
+		 "libbfoverlay_handle_get_statistics",
+		 bfoverlay_test_handle_get_statistics,
+		 handle );
+
+		BFOVERLAY_TEST_RUN_WITH_ARGS(
+		 "libbfoverlay_handle_get_layer_statistics",
+		 bfoverlay_test_handle_get_layer_statistics,
+		 handle );
+
+		BFOVERLAY_TEST_RUN_WITH_ARGS(
+		 "libbfoverlay_handle_reset_statistics",
+		 bfoverlay_test_handle_reset_statistics,
+		 handle );
+
+		BFOVERLAY_TEST_RUN_WITH_ARGS(
+		 "libbfoverlay_handle_set_record_statistics",
+		 bfoverlay_test_handle_set_record_statistics,
+		 handle );
+
+		BFOVERLAY_TEST_RUN_WITH_ARGS(
+		 "libbfoverlay_handle_set_record_latency_histograms",
+		 bfoverlay_test_handle_set_record_latency_histograms,
+		 handle );
+
+		BFOVERLAY_TEST_RUN_WITH_ARGS(
+		 "libbfoverlay_handle_get_latency_histogram",
+		 bfoverlay_test_handle_get_latency_histogram,
+		 handle );
+
 		/* Clean up
 		 */
 		result = bfoverlay_test_handle_close_source(
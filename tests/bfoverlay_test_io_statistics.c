@@ -0,0 +1,1421 @@
+/*
+ * Library io_statistics type test program
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bfoverlay_test_libcerror.h"
+#include "bfoverlay_test_libbfoverlay.h"
+#include "bfoverlay_test_macros.h"
+#include "bfoverlay_test_memory.h"
+#include "bfoverlay_test_unused.h"
+
+#include "../libbfoverlay/libbfoverlay_definitions.h"
+#include "../libbfoverlay/libbfoverlay_io_statistics.h"
+
+#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+
+/* Tests the libbfoverlay_io_statistics_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_io_statistics_initialize(
+     void )
+{
+	libbfoverlay_io_statistics_t *io_statistics = NULL;
+	libcerror_error_t *error                    = NULL;
+	int result                                  = 0;
+
+#if defined( HAVE_BFOVERLAY_TEST_MEMORY )
+	int number_of_malloc_fail_tests             = 3;
+	int number_of_memset_fail_tests             = 3;
+	int test_number                             = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_io_statistics_initialize(
+	          &io_statistics,
+	          2,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "io_statistics",
+	 io_statistics );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_io_statistics_free(
+	          &io_statistics,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "io_statistics",
+	 io_statistics );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_io_statistics_initialize(
+	          NULL,
+	          2,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	io_statistics = (libbfoverlay_io_statistics_t *) 0x12345678UL;
+
+	result = libbfoverlay_io_statistics_initialize(
+	          &io_statistics,
+	          2,
+	          &error );
+
+	io_statistics = NULL;
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_io_statistics_initialize(
+	          &io_statistics,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_BFOVERLAY_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libbfoverlay_io_statistics_initialize with malloc failing
+		 */
+		bfoverlay_test_malloc_attempts_before_fail = test_number;
+
+		result = libbfoverlay_io_statistics_initialize(
+		          &io_statistics,
+		          2,
+		          &error );
+
+		if( bfoverlay_test_malloc_attempts_before_fail != -1 )
+		{
+			bfoverlay_test_malloc_attempts_before_fail = -1;
+
+			if( io_statistics != NULL )
+			{
+				libbfoverlay_io_statistics_free(
+				 &io_statistics,
+				 NULL );
+			}
+		}
+		else
+		{
+			BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			BFOVERLAY_TEST_ASSERT_IS_NULL(
+			 "io_statistics",
+			 io_statistics );
+
+			BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libbfoverlay_io_statistics_initialize with memset failing
+		 */
+		bfoverlay_test_memset_attempts_before_fail = test_number;
+
+		result = libbfoverlay_io_statistics_initialize(
+		          &io_statistics,
+		          2,
+		          &error );
+
+		if( bfoverlay_test_memset_attempts_before_fail != -1 )
+		{
+			bfoverlay_test_memset_attempts_before_fail = -1;
+
+			if( io_statistics != NULL )
+			{
+				libbfoverlay_io_statistics_free(
+				 &io_statistics,
+				 NULL );
+			}
+		}
+		else
+		{
+			BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			BFOVERLAY_TEST_ASSERT_IS_NULL(
+			 "io_statistics",
+			 io_statistics );
+
+			BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_BFOVERLAY_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_statistics != NULL )
+	{
+		libbfoverlay_io_statistics_free(
+		 &io_statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_io_statistics_free function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_io_statistics_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_io_statistics_free(
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_io_statistics_add_io function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_io_statistics_add_io(
+     void )
+{
+	libbfoverlay_io_statistics_t *io_statistics = NULL;
+	libcerror_error_t *error                    = NULL;
+	uint64_t number_of_bytes_read               = 0;
+	uint64_t number_of_read_requests            = 0;
+	uint64_t value                              = 0;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_io_statistics_initialize(
+	          &io_statistics,
+	          2,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "io_statistics",
+	 io_statistics );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_io_statistics_add_io(
+	          io_statistics,
+	          LIBBFOVERLAY_IO_TYPE_LAYER_READ,
+	          1,
+	          512,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_io_statistics_add_io(
+	          io_statistics,
+	          LIBBFOVERLAY_IO_TYPE_LAYER_READ,
+	          1,
+	          1024,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_io_statistics_get_layer_values(
+	          io_statistics,
+	          1,
+	          &number_of_bytes_read,
+	          &number_of_read_requests,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_bytes_read",
+	 number_of_bytes_read,
+	 (uint64_t) 1536 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_read_requests",
+	 number_of_read_requests,
+	 (uint64_t) 2 );
+
+	result = libbfoverlay_io_statistics_add_io(
+	          io_statistics,
+	          LIBBFOVERLAY_IO_TYPE_COW_WRITE,
+	          0,
+	          4096,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_io_statistics_get_value(
+	          io_statistics,
+	          LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_BYTES_WRITTEN,
+	          &value,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 4096 );
+
+	result = libbfoverlay_io_statistics_get_value(
+	          io_statistics,
+	          LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_WRITE_REQUESTS,
+	          &value,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 1 );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_io_statistics_add_io(
+	          NULL,
+	          LIBBFOVERLAY_IO_TYPE_LAYER_READ,
+	          0,
+	          512,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_io_statistics_add_io(
+	          io_statistics,
+	          -1,
+	          0,
+	          512,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_io_statistics_add_io(
+	          io_statistics,
+	          LIBBFOVERLAY_IO_TYPE_LAYER_READ,
+	          2,
+	          512,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_io_statistics_free(
+	          &io_statistics,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "io_statistics",
+	 io_statistics );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_statistics != NULL )
+	{
+		libbfoverlay_io_statistics_free(
+		 &io_statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_io_statistics_add_count function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_io_statistics_add_count(
+     void )
+{
+	libbfoverlay_io_statistics_t *io_statistics = NULL;
+	libcerror_error_t *error                    = NULL;
+	uint64_t value                              = 0;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_io_statistics_initialize(
+	          &io_statistics,
+	          1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "io_statistics",
+	 io_statistics );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_io_statistics_add_count(
+	          io_statistics,
+	          LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_ALLOCATED_BLOCKS,
+	          16,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_io_statistics_get_value(
+	          io_statistics,
+	          LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_ALLOCATED_BLOCKS,
+	          &value,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 16 );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_io_statistics_add_count(
+	          NULL,
+	          LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_ALLOCATED_BLOCKS,
+	          1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_io_statistics_add_count(
+	          io_statistics,
+	          LIBBFOVERLAY_STATISTICS_VALUE_TYPE_COW_NUMBER_OF_BYTES_WRITTEN,
+	          1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_io_statistics_free(
+	          &io_statistics,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "io_statistics",
+	 io_statistics );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_statistics != NULL )
+	{
+		libbfoverlay_io_statistics_free(
+		 &io_statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_io_statistics_get_value function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_io_statistics_get_value(
+     void )
+{
+	libbfoverlay_io_statistics_t *io_statistics = NULL;
+	libcerror_error_t *error                    = NULL;
+	uint64_t value                              = 0;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_io_statistics_initialize(
+	          &io_statistics,
+	          1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "io_statistics",
+	 io_statistics );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_io_statistics_get_value(
+	          io_statistics,
+	          LIBBFOVERLAY_STATISTICS_VALUE_TYPE_SPARSE_NUMBER_OF_BYTES_READ,
+	          &value,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_io_statistics_get_value(
+	          NULL,
+	          LIBBFOVERLAY_STATISTICS_VALUE_TYPE_SPARSE_NUMBER_OF_BYTES_READ,
+	          &value,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_io_statistics_get_value(
+	          io_statistics,
+	          0,
+	          &value,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_io_statistics_get_value(
+	          io_statistics,
+	          LIBBFOVERLAY_STATISTICS_VALUE_TYPE_SPARSE_NUMBER_OF_BYTES_READ,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_io_statistics_free(
+	          &io_statistics,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "io_statistics",
+	 io_statistics );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_statistics != NULL )
+	{
+		libbfoverlay_io_statistics_free(
+		 &io_statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_io_statistics_reset function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_io_statistics_reset(
+     void )
+{
+	libbfoverlay_io_statistics_t *io_statistics = NULL;
+	libcerror_error_t *error                    = NULL;
+	uint64_t number_of_bytes_read               = 0;
+	uint64_t number_of_read_requests            = 0;
+	uint64_t value                              = 0;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_io_statistics_initialize(
+	          &io_statistics,
+	          1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "io_statistics",
+	 io_statistics );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_io_statistics_add_io(
+	          io_statistics,
+	          LIBBFOVERLAY_IO_TYPE_LAYER_READ,
+	          0,
+	          512,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_io_statistics_add_io(
+	          io_statistics,
+	          LIBBFOVERLAY_IO_TYPE_SPARSE_READ,
+	          0,
+	          512,
+	          0,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_io_statistics_reset(
+	          io_statistics,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_io_statistics_get_layer_values(
+	          io_statistics,
+	          0,
+	          &number_of_bytes_read,
+	          &number_of_read_requests,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_bytes_read",
+	 number_of_bytes_read,
+	 (uint64_t) 0 );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_read_requests",
+	 number_of_read_requests,
+	 (uint64_t) 0 );
+
+	result = libbfoverlay_io_statistics_get_value(
+	          io_statistics,
+	          LIBBFOVERLAY_STATISTICS_VALUE_TYPE_SPARSE_NUMBER_OF_BYTES_READ,
+	          &value,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_io_statistics_reset(
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_io_statistics_free(
+	          &io_statistics,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "io_statistics",
+	 io_statistics );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_statistics != NULL )
+	{
+		libbfoverlay_io_statistics_free(
+		 &io_statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_io_statistics_add_latency function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_io_statistics_add_latency(
+     void )
+{
+	uint64_t bucket_counts[ LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS ];
+
+	libbfoverlay_io_statistics_t *io_statistics = NULL;
+	libcerror_error_t *error                    = NULL;
+	uint64_t number_of_samples                  = 0;
+	uint64_t start_timestamp                    = 0;
+	int bucket_index                            = 0;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_io_statistics_initialize(
+	          &io_statistics,
+	          1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "io_statistics",
+	 io_statistics );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_io_statistics_get_timestamp(
+	          &start_timestamp,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_io_statistics_add_latency(
+	          io_statistics,
+	          LIBBFOVERLAY_LATENCY_PATH_WRITE_COW_ALLOCATE,
+	          start_timestamp,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_io_statistics_get_latency_histogram(
+	          io_statistics,
+	          LIBBFOVERLAY_LATENCY_PATH_WRITE_COW_ALLOCATE,
+	          bucket_counts,
+	          LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( bucket_index = 0;
+	     bucket_index < LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS;
+	     bucket_index++ )
+	{
+		number_of_samples += bucket_counts[ bucket_index ];
+	}
+	if( start_timestamp != 0 )
+	{
+		BFOVERLAY_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_samples",
+		 number_of_samples,
+		 (uint64_t) 1 );
+	}
+	else
+	{
+		BFOVERLAY_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_samples",
+		 number_of_samples,
+		 (uint64_t) 0 );
+	}
+	/* Test error cases
+	 */
+	result = libbfoverlay_io_statistics_add_latency(
+	          NULL,
+	          LIBBFOVERLAY_LATENCY_PATH_WRITE_COW_ALLOCATE,
+	          start_timestamp,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_io_statistics_add_latency(
+	          io_statistics,
+	          0,
+	          start_timestamp,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_io_statistics_free(
+	          &io_statistics,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "io_statistics",
+	 io_statistics );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_statistics != NULL )
+	{
+		libbfoverlay_io_statistics_free(
+		 &io_statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_io_statistics_get_latency_histogram function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_io_statistics_get_latency_histogram(
+     void )
+{
+	uint64_t bucket_counts[ LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS ];
+
+	libbfoverlay_io_statistics_t *io_statistics = NULL;
+	libcerror_error_t *error                    = NULL;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_io_statistics_initialize(
+	          &io_statistics,
+	          1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "io_statistics",
+	 io_statistics );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_io_statistics_get_latency_histogram(
+	          io_statistics,
+	          LIBBFOVERLAY_LATENCY_PATH_READ_SPARSE,
+	          bucket_counts,
+	          LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_UINT64(
+	 "bucket_counts[ 0 ]",
+	 bucket_counts[ 0 ],
+	 (uint64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_io_statistics_get_latency_histogram(
+	          NULL,
+	          LIBBFOVERLAY_LATENCY_PATH_READ_SPARSE,
+	          bucket_counts,
+	          LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_io_statistics_get_latency_histogram(
+	          io_statistics,
+	          LIBBFOVERLAY_LATENCY_PATH_WRITE_COW_ALLOCATE + 1,
+	          bucket_counts,
+	          LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_io_statistics_get_latency_histogram(
+	          io_statistics,
+	          LIBBFOVERLAY_LATENCY_PATH_READ_SPARSE,
+	          NULL,
+	          LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_io_statistics_get_latency_histogram(
+	          io_statistics,
+	          LIBBFOVERLAY_LATENCY_PATH_READ_SPARSE,
+	          bucket_counts,
+	          LIBBFOVERLAY_LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS - 1,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_io_statistics_free(
+	          &io_statistics,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "io_statistics",
+	 io_statistics );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_statistics != NULL )
+	{
+		libbfoverlay_io_statistics_free(
+		 &io_statistics,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BFOVERLAY_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BFOVERLAY_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BFOVERLAY_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BFOVERLAY_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BFOVERLAY_TEST_UNREFERENCED_PARAMETER( argc )
+	BFOVERLAY_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_io_statistics_initialize",
+	 bfoverlay_test_io_statistics_initialize );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_io_statistics_free",
+	 bfoverlay_test_io_statistics_free );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_io_statistics_add_io",
+	 bfoverlay_test_io_statistics_add_io );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_io_statistics_add_count",
+	 bfoverlay_test_io_statistics_add_count );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_io_statistics_get_value",
+	 bfoverlay_test_io_statistics_get_value );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_io_statistics_reset",
+	 bfoverlay_test_io_statistics_reset );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_io_statistics_add_latency",
+	 bfoverlay_test_io_statistics_add_latency );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_io_statistics_get_latency_histogram",
+	 bfoverlay_test_io_statistics_get_latency_histogram );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,1249 @@
+/*
+ * Library range_map type test program
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bfoverlay_test_libcerror.h"
+#include "bfoverlay_test_libbfoverlay.h"
+#include "bfoverlay_test_macros.h"
+#include "bfoverlay_test_memory.h"
+#include "bfoverlay_test_unused.h"
+
+#include "../libbfoverlay/libbfoverlay_range.h"
+#include "../libbfoverlay/libbfoverlay_range_map.h"
+
+#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+
+/* Sets a test range in the range map
+ * The test ranges are: 0 - 100, 100 - 200 and 300 - 400
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_range_map_set_test_range(
+     libbfoverlay_range_map_t *range_map,
+     int range_index,
+     libcerror_error_t **error )
+{
+	libbfoverlay_range_t range;
+
+	static off64_t bfoverlay_test_range_map_offsets[ 3 ][ 2 ] = {
+		{ 0, 100 }, { 100, 200 }, { 300, 400 } };
+
+	if( memory_set(
+	     &range,
+	     0,
+	     sizeof( libbfoverlay_range_t ) ) == NULL )
+	{
+		return( -1 );
+	}
+	range.start_offset    = bfoverlay_test_range_map_offsets[ range_index ][ 0 ];
+	range.end_offset      = bfoverlay_test_range_map_offsets[ range_index ][ 1 ];
+	range.data_file_index = range_index;
+
+	return( libbfoverlay_range_map_set_range_by_index(
+	         range_map,
+	         range_index,
+	         &range,
+	         error ) );
+}
+
+/* Tests the libbfoverlay_range_map_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_range_map_initialize(
+     void )
+{
+	libbfoverlay_range_map_t *range_map = NULL;
+	libcerror_error_t *error            = NULL;
+	int result                          = 0;
+
+#if defined( HAVE_BFOVERLAY_TEST_MEMORY )
+	int number_of_malloc_fail_tests     = 2;
+	int number_of_memset_fail_tests     = 2;
+	int test_number                     = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_range_map_initialize(
+	          &range_map,
+	          4,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "range_map",
+	 range_map );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_range_map_free(
+	          &range_map,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "range_map",
+	 range_map );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_range_map_initialize(
+	          NULL,
+	          4,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	range_map = (libbfoverlay_range_map_t *) 0x12345678UL;
+
+	result = libbfoverlay_range_map_initialize(
+	          &range_map,
+	          4,
+	          &error );
+
+	range_map = NULL;
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_BFOVERLAY_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libbfoverlay_range_map_initialize with malloc failing
+		 */
+		bfoverlay_test_malloc_attempts_before_fail = test_number;
+
+		result = libbfoverlay_range_map_initialize(
+		          &range_map,
+		          4,
+		          &error );
+
+		if( bfoverlay_test_malloc_attempts_before_fail != -1 )
+		{
+			bfoverlay_test_malloc_attempts_before_fail = -1;
+
+			if( range_map != NULL )
+			{
+				libbfoverlay_range_map_free(
+				 &range_map,
+				 NULL );
+			}
+		}
+		else
+		{
+			BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			BFOVERLAY_TEST_ASSERT_IS_NULL(
+			 "range_map",
+			 range_map );
+
+			BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libbfoverlay_range_map_initialize with memset failing
+		 */
+		bfoverlay_test_memset_attempts_before_fail = test_number;
+
+		result = libbfoverlay_range_map_initialize(
+		          &range_map,
+		          4,
+		          &error );
+
+		if( bfoverlay_test_memset_attempts_before_fail != -1 )
+		{
+			bfoverlay_test_memset_attempts_before_fail = -1;
+
+			if( range_map != NULL )
+			{
+				libbfoverlay_range_map_free(
+				 &range_map,
+				 NULL );
+			}
+		}
+		else
+		{
+			BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			BFOVERLAY_TEST_ASSERT_IS_NULL(
+			 "range_map",
+			 range_map );
+
+			BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_BFOVERLAY_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( range_map != NULL )
+	{
+		libbfoverlay_range_map_free(
+		 &range_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_range_map_free function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_range_map_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_range_map_free(
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_range_map_get_number_of_ranges function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_range_map_get_number_of_ranges(
+     void )
+{
+	libbfoverlay_range_map_t *range_map = NULL;
+	libcerror_error_t *error            = NULL;
+	int number_of_ranges                = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_range_map_initialize(
+	          &range_map,
+	          3,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "range_map",
+	 range_map );
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_range_map_get_number_of_ranges(
+	          range_map,
+	          &number_of_ranges,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "number_of_ranges",
+	 number_of_ranges,
+	 3 );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_range_map_get_number_of_ranges(
+	          NULL,
+	          &number_of_ranges,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_range_map_get_number_of_ranges(
+	          range_map,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_range_map_free(
+	          &range_map,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "range_map",
+	 range_map );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( range_map != NULL )
+	{
+		libbfoverlay_range_map_free(
+		 &range_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_range_map_set_range_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_range_map_set_range_by_index(
+     void )
+{
+	libbfoverlay_range_t range;
+
+	libbfoverlay_range_map_t *range_map = NULL;
+	libcerror_error_t *error            = NULL;
+	int range_index                     = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_range_map_initialize(
+	          &range_map,
+	          3,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "range_map",
+	 range_map );
+
+	/* Test regular cases
+	 */
+	for( range_index = 0;
+	     range_index < 3;
+	     range_index++ )
+	{
+		result = bfoverlay_test_range_map_set_test_range(
+		          range_map,
+		          range_index,
+		          &error );
+
+		BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BFOVERLAY_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+
+	/* Test error cases
+	 */
+	range.start_offset = 150;
+	range.end_offset   = 250;
+
+	result = libbfoverlay_range_map_set_range_by_index(
+	          NULL,
+	          2,
+	          &range,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_range_map_set_range_by_index(
+	          range_map,
+	          -1,
+	          &range,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_range_map_set_range_by_index(
+	          range_map,
+	          3,
+	          &range,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_range_map_set_range_by_index(
+	          range_map,
+	          2,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the range overlaps with the previous range
+	 */
+	result = libbfoverlay_range_map_set_range_by_index(
+	          range_map,
+	          2,
+	          &range,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the range is empty
+	 */
+	range.start_offset = 300;
+	range.end_offset   = 300;
+
+	result = libbfoverlay_range_map_set_range_by_index(
+	          range_map,
+	          2,
+	          &range,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_range_map_free(
+	          &range_map,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "range_map",
+	 range_map );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( range_map != NULL )
+	{
+		libbfoverlay_range_map_free(
+		 &range_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_range_map_get_range_by_index function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_range_map_get_range_by_index(
+     void )
+{
+	libbfoverlay_range_map_t *range_map = NULL;
+	libbfoverlay_range_t *range         = NULL;
+	libcerror_error_t *error            = NULL;
+	int range_index                     = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_range_map_initialize(
+	          &range_map,
+	          3,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "range_map",
+	 range_map );
+
+	for( range_index = 0;
+	     range_index < 3;
+	     range_index++ )
+	{
+		result = bfoverlay_test_range_map_set_test_range(
+		          range_map,
+		          range_index,
+		          &error );
+
+		BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BFOVERLAY_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+
+	/* Test regular cases
+	 */
+	result = libbfoverlay_range_map_get_range_by_index(
+	          range_map,
+	          2,
+	          &range,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "range",
+	 range );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT64(
+	 "range->start_offset",
+	 (int64_t) range->start_offset,
+	 (int64_t) 300 );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_range_map_get_range_by_index(
+	          NULL,
+	          0,
+	          &range,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_range_map_get_range_by_index(
+	          range_map,
+	          -1,
+	          &range,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_range_map_get_range_by_index(
+	          range_map,
+	          3,
+	          &range,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_range_map_get_range_by_index(
+	          range_map,
+	          0,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_range_map_free(
+	          &range_map,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "range_map",
+	 range_map );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( range_map != NULL )
+	{
+		libbfoverlay_range_map_free(
+		 &range_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbfoverlay_range_map_get_range_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int bfoverlay_test_range_map_get_range_at_offset(
+     void )
+{
+	libbfoverlay_range_map_t *range_map = NULL;
+	libbfoverlay_range_t *range         = NULL;
+	libcerror_error_t *error            = NULL;
+	int range_index                     = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libbfoverlay_range_map_initialize(
+	          &range_map,
+	          3,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "range_map",
+	 range_map );
+
+	for( range_index = 0;
+	     range_index < 3;
+	     range_index++ )
+	{
+		result = bfoverlay_test_range_map_set_test_range(
+		          range_map,
+		          range_index,
+		          &error );
+
+		BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BFOVERLAY_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+
+	/* Test regular cases with a range index hint of the current range
+	 */
+	range_index = 0;
+
+	result = libbfoverlay_range_map_get_range_at_offset(
+	          range_map,
+	          50,
+	          &range_index,
+	          &range,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "range_index",
+	 range_index,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "range",
+	 range );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "range->data_file_index",
+	 range->data_file_index,
+	 0 );
+
+	/* Test regular cases with a range index hint of the previous range
+	 */
+	result = libbfoverlay_range_map_get_range_at_offset(
+	          range_map,
+	          150,
+	          &range_index,
+	          &range,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "range_index",
+	 range_index,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "range",
+	 range );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "range->data_file_index",
+	 range->data_file_index,
+	 1 );
+
+	/* Test regular cases with a range index hint that does not match
+	 */
+	range_index = 0;
+
+	result = libbfoverlay_range_map_get_range_at_offset(
+	          range_map,
+	          350,
+	          &range_index,
+	          &range,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "range_index",
+	 range_index,
+	 2 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "range",
+	 range );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "range->data_file_index",
+	 range->data_file_index,
+	 2 );
+
+	range_index = 2;
+
+	result = libbfoverlay_range_map_get_range_at_offset(
+	          range_map,
+	          0,
+	          &range_index,
+	          &range,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "range_index",
+	 range_index,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "range",
+	 range );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "range->data_file_index",
+	 range->data_file_index,
+	 0 );
+
+	range_index = -1;
+
+	result = libbfoverlay_range_map_get_range_at_offset(
+	          range_map,
+	          99,
+	          &range_index,
+	          &range,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "range_index",
+	 range_index,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "range",
+	 range );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "range->data_file_index",
+	 range->data_file_index,
+	 0 );
+
+	/* Test offsets that are not covered by a range
+	 */
+	range_index = 0;
+
+	result = libbfoverlay_range_map_get_range_at_offset(
+	          range_map,
+	          250,
+	          &range_index,
+	          &range,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_range_map_get_range_at_offset(
+	          range_map,
+	          400,
+	          &range_index,
+	          &range,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfoverlay_range_map_get_range_at_offset(
+	          range_map,
+	          -1,
+	          &range_index,
+	          &range,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbfoverlay_range_map_get_range_at_offset(
+	          NULL,
+	          0,
+	          &range_index,
+	          &range,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_range_map_get_range_at_offset(
+	          range_map,
+	          0,
+	          NULL,
+	          &range,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbfoverlay_range_map_get_range_at_offset(
+	          range_map,
+	          0,
+	          &range_index,
+	          NULL,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfoverlay_range_map_free(
+	          &range_map,
+	          &error );
+
+	BFOVERLAY_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BFOVERLAY_TEST_ASSERT_IS_NULL(
+	 "range_map",
+	 range_map );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( range_map != NULL )
+	{
+		libbfoverlay_range_map_free(
+		 &range_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BFOVERLAY_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BFOVERLAY_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BFOVERLAY_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BFOVERLAY_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BFOVERLAY_TEST_UNREFERENCED_PARAMETER( argc )
+	BFOVERLAY_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_range_map_initialize",
+	 bfoverlay_test_range_map_initialize );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_range_map_free",
+	 bfoverlay_test_range_map_free );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_range_map_get_number_of_ranges",
+	 bfoverlay_test_range_map_get_number_of_ranges );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_range_map_get_range_by_index",
+	 bfoverlay_test_range_map_get_range_by_index );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_range_map_set_range_by_index",
+	 bfoverlay_test_range_map_set_range_by_index );
+
+	BFOVERLAY_TEST_RUN(
+	 "libbfoverlay_range_map_get_range_at_offset",
+	 bfoverlay_test_range_map_get_range_at_offset );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBBFOVERLAY_DLL_IMPORT ) */
+}
+
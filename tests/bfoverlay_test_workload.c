@@ -0,0 +1,1070 @@
+/*
+ * Synthetic workload functions
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bfoverlay_test_libbfoverlay.h"
+#include "bfoverlay_test_libcerror.h"
+#include "bfoverlay_test_workload.h"
+
+#define BFOVERLAY_TEST_WORKLOAD_BUFFER_SIZE	( 1024 * 1024 )
+
+/* Creates a workload
+ * Make sure the value workload is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_workload_initialize(
+     bfoverlay_test_workload_t **workload,
+     libcerror_error_t **error )
+{
+	static char *function = "bfoverlay_test_workload_initialize";
+
+	if( workload == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid workload.",
+		 function );
+
+		return( -1 );
+	}
+	if( *workload != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid workload value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*workload = memory_allocate_structure(
+	             bfoverlay_test_workload_t );
+
+	if( *workload == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create workload.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *workload,
+	     0,
+	     sizeof( bfoverlay_test_workload_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear workload.",
+		 function );
+
+		goto on_error;
+	}
+	( *workload )->media_size          = 64 * 1024 * 1024;
+	( *workload )->number_of_layers    = 1;
+	( *workload )->number_of_fragments = 1;
+	( *workload )->cow_block_size      = 4096;
+	( *workload )->random_state        = 1;
+
+	return( 1 );
+
+on_error:
+	if( *workload != NULL )
+	{
+		memory_free(
+		 *workload );
+
+		*workload = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a workload
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_workload_free(
+     bfoverlay_test_workload_t **workload,
+     libcerror_error_t **error )
+{
+	static char *function = "bfoverlay_test_workload_free";
+
+	if( workload == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid workload.",
+		 function );
+
+		return( -1 );
+	}
+	if( *workload != NULL )
+	{
+		memory_free(
+		 *workload );
+
+		*workload = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves the next pseudo random value
+ * This uses a xorshift64* pseudo random number generator so that the
+ * same random state always results in the same workload
+ * Returns the pseudo random value
+ */
+uint64_t bfoverlay_test_workload_get_random_value(
+          bfoverlay_test_workload_t *workload )
+{
+	if( workload == NULL )
+	{
+		return( 0 );
+	}
+	if( workload->random_state == 0 )
+	{
+		workload->random_state = 1;
+	}
+	workload->random_state ^= workload->random_state >> 12;
+	workload->random_state ^= workload->random_state << 25;
+	workload->random_state ^= workload->random_state >> 27;
+
+	return( workload->random_state * 0x2545f4914f6cdd1dULL );
+}
+
+/* Fills a buffer with the data of a layer
+ * Every 512-byte sector is filled with a byte value derived from the layer
+ * index and the offset so that the origin of the data can be determined
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_workload_fill_buffer(
+     uint8_t *buffer,
+     size_t buffer_size,
+     int layer_index,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	static char *function = "bfoverlay_test_workload_fill_buffer";
+	size_t buffer_offset  = 0;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( buffer_offset = 0;
+	     buffer_offset < buffer_size;
+	     buffer_offset++ )
+	{
+		buffer[ buffer_offset ] = (uint8_t) ( ( ( offset + buffer_offset ) / 512 ) + ( layer_index * 37 ) + 1 );
+	}
+	return( 1 );
+}
+
+/* Writes a data file of a layer
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_workload_write_data_file(
+     const char *filename,
+     size64_t data_size,
+     int layer_index,
+     libcerror_error_t **error )
+{
+	FILE *file_stream     = NULL;
+	uint8_t *buffer       = NULL;
+	static char *function = "bfoverlay_test_workload_write_data_file";
+	size64_t data_offset  = 0;
+	size_t write_size     = 0;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * BFOVERLAY_TEST_WORKLOAD_BUFFER_SIZE );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_BINARY_OPEN_WRITE );
+
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open data file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	while( data_offset < data_size )
+	{
+		write_size = BFOVERLAY_TEST_WORKLOAD_BUFFER_SIZE;
+
+		if( (size64_t) write_size > ( data_size - data_offset ) )
+		{
+			write_size = (size_t) ( data_size - data_offset );
+		}
+		if( bfoverlay_test_workload_fill_buffer(
+		     buffer,
+		     write_size,
+		     layer_index,
+		     (off64_t) data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill buffer.",
+			 function );
+
+			goto on_error;
+		}
+		if( file_stream_write(
+		     file_stream,
+		     buffer,
+		     write_size ) != write_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data file: %s.",
+			 function,
+			 filename );
+
+			goto on_error;
+		}
+		data_offset += write_size;
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		file_stream = NULL;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close data file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	memory_free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+/* Writes the descriptor file and the data files of the layers
+ * Every layer on top of the base layer consists of fragments that are spread
+ * evenly over the media, where successive layers partially overlap
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_workload_write_layers(
+     bfoverlay_test_workload_t *workload,
+     const char *name,
+     libcerror_error_t **error )
+{
+	char data_filename[ BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE + 32 ];
+	char filename[ BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE + 32 ];
+
+	FILE *file_stream       = NULL;
+	static char *function   = "bfoverlay_test_workload_write_layers";
+	size64_t fragment_size  = 0;
+	size64_t fragment_shift = 0;
+	size64_t stride_size    = 0;
+	off64_t fragment_offset = 0;
+	int fragment_index      = 0;
+	int is_sparse           = 0;
+	int layer_index         = 0;
+	int print_count         = 0;
+
+	if( workload == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid workload.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	stride_size   = workload->media_size / workload->number_of_fragments;
+	fragment_size = ( stride_size / 2 ) & ~( (size64_t) 511 );
+
+	print_count = narrow_string_snprintf(
+	               filename,
+	               BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE + 32,
+	               "%s.bfoverlay",
+	               name );
+
+	if( ( print_count < 0 )
+	 || ( print_count >= ( BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE + 32 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set descriptor filename.",
+		 function );
+
+		goto on_error;
+	}
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_OPEN_WRITE );
+
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open descriptor file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	fprintf(
+	 file_stream,
+	 "# basic file overlay descriptor file\n" );
+
+	workload->number_of_descriptor_layers = 0;
+
+	for( layer_index = 0;
+	     layer_index < workload->number_of_layers;
+	     layer_index++ )
+	{
+		is_sparse = (int) ( layer_index >= ( workload->number_of_layers - workload->number_of_sparse_layers ) );
+
+		if( is_sparse == 0 )
+		{
+			print_count = narrow_string_snprintf(
+			               data_filename,
+			               BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE + 32,
+			               "%s_layer%d.raw",
+			               name,
+			               layer_index );
+
+			if( ( print_count < 0 )
+			 || ( print_count >= ( BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE + 32 ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set layer: %d data filename.",
+				 function,
+				 layer_index );
+
+				goto on_error;
+			}
+		}
+		if( layer_index == 0 )
+		{
+			if( is_sparse == 0 )
+			{
+				if( bfoverlay_test_workload_write_data_file(
+				     data_filename,
+				     workload->media_size,
+				     layer_index,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write layer: %d data file.",
+					 function,
+					 layer_index );
+
+					goto on_error;
+				}
+				fprintf(
+				 file_stream,
+				 "layer: offset=0 size=%" PRIu64 " file=\"%s\"\n",
+				 workload->media_size,
+				 data_filename );
+			}
+			else
+			{
+				fprintf(
+				 file_stream,
+				 "layer: offset=0 size=%" PRIu64 "\n",
+				 workload->media_size );
+			}
+			workload->number_of_descriptor_layers += 1;
+
+			continue;
+		}
+		if( is_sparse == 0 )
+		{
+			if( bfoverlay_test_workload_write_data_file(
+			     data_filename,
+			     fragment_size * workload->number_of_fragments,
+			     layer_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write layer: %d data file.",
+				 function,
+				 layer_index );
+
+				goto on_error;
+			}
+		}
+		fragment_shift = ( ( fragment_size / ( workload->number_of_layers - 1 ) ) * ( layer_index - 1 ) ) & ~( (size64_t) 511 );
+
+		for( fragment_index = 0;
+		     fragment_index < workload->number_of_fragments;
+		     fragment_index++ )
+		{
+			fragment_offset = (off64_t) ( ( ( stride_size * fragment_index ) & ~( (size64_t) 511 ) ) + fragment_shift );
+
+			if( is_sparse == 0 )
+			{
+				fprintf(
+				 file_stream,
+				 "layer: offset=%" PRIi64 " size=%" PRIu64 " file=\"%s\" file_offset=%" PRIu64 "\n",
+				 fragment_offset,
+				 fragment_size,
+				 data_filename,
+				 fragment_size * fragment_index );
+			}
+			else
+			{
+				fprintf(
+				 file_stream,
+				 "layer: offset=%" PRIi64 " size=%" PRIu64 "\n",
+				 fragment_offset,
+				 fragment_size );
+			}
+			workload->number_of_descriptor_layers += 1;
+		}
+	}
+	if( workload->use_cow != 0 )
+	{
+		fprintf(
+		 file_stream,
+		 "layer: file=\"%s.cow\" copy-on-write block_size=%" PRIu32 "\n",
+		 name,
+		 workload->cow_block_size );
+
+		workload->number_of_descriptor_layers += 1;
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		file_stream = NULL;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close descriptor file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	return( -1 );
+}
+
+/* Pre-populates the COW file
+ * A contiguous COW file contains a single run of blocks that was written in
+ * order, a fragmented COW file contains blocks that were written in random order
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_workload_populate_cow_file(
+     bfoverlay_test_workload_t *workload,
+     const char *name,
+     libcerror_error_t **error )
+{
+	char filename[ BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE + 32 ];
+
+	libbfoverlay_handle_t *handle = NULL;
+	uint32_t *block_numbers       = NULL;
+	uint8_t *buffer               = NULL;
+	static char *function         = "bfoverlay_test_workload_populate_cow_file";
+	size_t write_size             = 0;
+	ssize_t write_count           = 0;
+	uint64_t block_index          = 0;
+	uint64_t number_of_blocks     = 0;
+	uint64_t random_index         = 0;
+	uint64_t start_block_number   = 0;
+	uint32_t block_number         = 0;
+	off64_t offset                = 0;
+	int print_count               = 0;
+
+	if( workload == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid workload.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	workload->number_of_cow_blocks = 0;
+
+	number_of_blocks = ( workload->media_size + workload->cow_block_size - 1 ) / workload->cow_block_size;
+
+	if( number_of_blocks > (uint64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint32_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of blocks value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	print_count = narrow_string_snprintf(
+	               filename,
+	               BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE + 32,
+	               "%s.bfoverlay",
+	               name );
+
+	if( ( print_count < 0 )
+	 || ( print_count >= ( BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE + 32 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set descriptor filename.",
+		 function );
+
+		goto on_error;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * workload->cow_block_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	block_numbers = (uint32_t *) memory_allocate(
+	                              sizeof( uint32_t ) * (size_t) number_of_blocks );
+
+	if( block_numbers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block numbers.",
+		 function );
+
+		goto on_error;
+	}
+	workload->number_of_cow_blocks = ( number_of_blocks * workload->cow_fill_percentage ) / 100;
+
+	if( workload->cow_fragmented != 0 )
+	{
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			block_numbers[ block_index ] = (uint32_t) block_index;
+		}
+		/* Partial Fisher-Yates shuffle
+		 */
+		for( block_index = 0;
+		     block_index < workload->number_of_cow_blocks;
+		     block_index++ )
+		{
+			random_index = block_index + ( bfoverlay_test_workload_get_random_value(
+			                                workload ) % ( number_of_blocks - block_index ) );
+
+			block_number                  = block_numbers[ random_index ];
+			block_numbers[ random_index ] = block_numbers[ block_index ];
+			block_numbers[ block_index ]  = block_number;
+		}
+	}
+	else
+	{
+		start_block_number = bfoverlay_test_workload_get_random_value(
+		                      workload ) % ( number_of_blocks - workload->number_of_cow_blocks + 1 );
+
+		for( block_index = 0;
+		     block_index < workload->number_of_cow_blocks;
+		     block_index++ )
+		{
+			block_numbers[ block_index ] = (uint32_t) ( start_block_number + block_index );
+		}
+	}
+	if( libbfoverlay_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_handle_open(
+	     handle,
+	     filename,
+	     LIBBFOVERLAY_OPEN_READ_WRITE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_handle_open_data_files(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open data files.",
+		 function );
+
+		goto on_error;
+	}
+	for( block_index = 0;
+	     block_index < workload->number_of_cow_blocks;
+	     block_index++ )
+	{
+		offset     = (off64_t) block_numbers[ block_index ] * workload->cow_block_size;
+		write_size = workload->cow_block_size;
+
+		if( (size64_t) write_size > ( workload->media_size - offset ) )
+		{
+			write_size = (size_t) ( workload->media_size - offset );
+		}
+		if( bfoverlay_test_workload_fill_buffer(
+		     buffer,
+		     write_size,
+		     workload->number_of_layers,
+		     offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill buffer.",
+			 function );
+
+			goto on_error;
+		}
+		write_count = libbfoverlay_handle_write_buffer_at_offset(
+		               handle,
+		               buffer,
+		               write_size,
+		               offset,
+		               error );
+
+		if( write_count != (ssize_t) write_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write block: %" PRIu32 ".",
+			 function,
+			 block_numbers[ block_index ] );
+
+			goto on_error;
+		}
+	}
+	if( libbfoverlay_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfoverlay_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 block_numbers );
+
+	memory_free(
+	 buffer );
+
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libbfoverlay_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( block_numbers != NULL )
+	{
+		memory_free(
+		 block_numbers );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+/* Generates the descriptor file, data files and COW file of a workload
+ * The files are named after name, relative to the current working directory
+ * Returns 1 if successful or -1 on error
+ */
+int bfoverlay_test_workload_generate(
+     bfoverlay_test_workload_t *workload,
+     const char *name,
+     libcerror_error_t **error )
+{
+	char filename[ BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE + 32 ];
+
+	static char *function = "bfoverlay_test_workload_generate";
+	size_t name_length    = 0;
+	int print_count       = 0;
+
+	if( workload == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid workload.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( workload->number_of_layers <= 0 )
+	 || ( workload->number_of_layers > BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NUMBER_OF_LAYERS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid workload - number of layers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( workload->number_of_sparse_layers < 0 )
+	 || ( workload->number_of_sparse_layers > workload->number_of_layers ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid workload - number of sparse layers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( workload->number_of_fragments <= 0 )
+	 || ( workload->number_of_fragments > BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NUMBER_OF_FRAGMENTS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid workload - number of fragments value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( 1 + ( ( workload->number_of_layers - 1 ) * workload->number_of_fragments ) + workload->use_cow ) > BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NUMBER_OF_LAYERS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid workload - number of descriptor layers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Every fragment must be at least 512 bytes in size
+	 */
+	if( ( workload->media_size == 0 )
+	 || ( workload->media_size > (size64_t) INT64_MAX )
+	 || ( ( workload->media_size / workload->number_of_fragments ) < 1024 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid workload - media size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( workload->use_cow != 0 )
+	{
+		if( ( workload->cow_block_size < 512 )
+		 || ( workload->cow_block_size > ( 16 * 1024 * 1024 ) )
+		 || ( ( workload->cow_block_size & ( workload->cow_block_size - 1 ) ) != 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid workload - COW block size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( workload->cow_fill_percentage > 100 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid workload - COW fill percentage value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	name_length = narrow_string_length(
+	               name );
+
+	if( ( name_length == 0 )
+	 || ( name_length >= BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( bfoverlay_test_workload_write_layers(
+	     workload,
+	     name,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write layers.",
+		 function );
+
+		return( -1 );
+	}
+	if( workload->use_cow != 0 )
+	{
+		print_count = narrow_string_snprintf(
+		               filename,
+		               BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE + 32,
+		               "%s.cow",
+		               name );
+
+		if( ( print_count < 0 )
+		 || ( print_count >= ( BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE + 32 ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set COW filename.",
+			 function );
+
+			return( -1 );
+		}
+		/* Make sure a new COW file is created
+		 */
+		remove(
+		 filename );
+
+		if( bfoverlay_test_workload_populate_cow_file(
+		     workload,
+		     name,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to populate COW file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
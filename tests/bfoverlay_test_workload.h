@@ -0,0 +1,136 @@
+/*
+ * Synthetic workload functions
+ *
+ * Copyright (C) 2020-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BFOVERLAY_TEST_WORKLOAD_H )
+#define _BFOVERLAY_TEST_WORKLOAD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "bfoverlay_test_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NAME_SIZE		256
+
+/* The descriptor file supports 26 lines, including the signature and
+ * the empty line after the last end-of-line character
+ */
+#define BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NUMBER_OF_LAYERS	24
+#define BFOVERLAY_TEST_WORKLOAD_MAXIMUM_NUMBER_OF_FRAGMENTS	23
+
+typedef struct bfoverlay_test_workload bfoverlay_test_workload_t;
+
+struct bfoverlay_test_workload
+{
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The number of layers, including the base layer and excluding the COW layer
+	 */
+	int number_of_layers;
+
+	/* The number of layers without a data file, these are the top-most layers
+	 */
+	int number_of_sparse_layers;
+
+	/* The number of fragments of every layer on top of the base layer
+	 * 1 represents a contiguous layer
+	 */
+	int number_of_fragments;
+
+	/* Value to indicate a COW layer should be added
+	 */
+	uint8_t use_cow;
+
+	/* The COW block size
+	 */
+	size32_t cow_block_size;
+
+	/* The percentage of the COW blocks that is pre-populated
+	 */
+	uint8_t cow_fill_percentage;
+
+	/* Value to indicate the COW blocks should be pre-populated in random order
+	 */
+	uint8_t cow_fragmented;
+
+	/* The pseudo random number generator state
+	 */
+	uint64_t random_state;
+
+	/* The number of layers in the generated descriptor file
+	 */
+	int number_of_descriptor_layers;
+
+	/* The number of pre-populated COW blocks
+	 */
+	uint64_t number_of_cow_blocks;
+};
+
+int bfoverlay_test_workload_initialize(
+     bfoverlay_test_workload_t **workload,
+     libcerror_error_t **error );
+
+int bfoverlay_test_workload_free(
+     bfoverlay_test_workload_t **workload,
+     libcerror_error_t **error );
+
+uint64_t bfoverlay_test_workload_get_random_value(
+          bfoverlay_test_workload_t *workload );
+
+int bfoverlay_test_workload_fill_buffer(
+     uint8_t *buffer,
+     size_t buffer_size,
+     int layer_index,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int bfoverlay_test_workload_write_data_file(
+     const char *filename,
+     size64_t data_size,
+     int layer_index,
+     libcerror_error_t **error );
+
+int bfoverlay_test_workload_write_layers(
+     bfoverlay_test_workload_t *workload,
+     const char *name,
+     libcerror_error_t **error );
+
+int bfoverlay_test_workload_populate_cow_file(
+     bfoverlay_test_workload_t *workload,
+     const char *name,
+     libcerror_error_t **error );
+
+int bfoverlay_test_workload_generate(
+     bfoverlay_test_workload_t *workload,
+     const char *name,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BFOVERLAY_TEST_WORKLOAD_H ) */
+
@@ -1,6 +1,6 @@
 # Tests library functions and types.
 
-$LibraryTests = "cow_allocation_table_block cow_file cow_file_header descriptor_file error layer notify range support"
+$LibraryTests = "cow_allocation_table_block cow_file cow_file_header descriptor_file error io_statistics layer notify range range_map support"
 $LibraryTestsWithInput = "handle"
 $OptionSets = "" -split " "
 